@@ -178,6 +178,14 @@ class Context : public IECore::RefCounted
 		ChangedSignal &changedSignal();
 
 		IECore::MurmurHash hash() const;
+		/// Returns the hash used to represent `value` within hash(). For most
+		/// types this is simply `value->Object::hash()`, but InternedStringVectorData
+		/// is hashed one element at a time, so that the hash for a vector may be
+		/// computed incrementally from the hash of its prefix, by appending each of
+		/// the remaining elements using `MurmurHash::append()`. This is used to
+		/// avoid rehashing the entire path for each location visited during scene
+		/// traversals.
+		static IECore::MurmurHash variableHash( const IECore::Data *value );
 
 		bool operator == ( const Context &other ) const;
 		bool operator != ( const Context &other ) const;
@@ -258,6 +266,14 @@ class Context : public IECore::RefCounted
 
 				template<typename T>
 				void set( const IECore::InternedString &name, const T &value );
+				/// Sets a variable without copying it, for use in performance
+				/// critical code. It is the caller's responsibility to ensure
+				/// that `value` remains alive and unchanged for the lifetime of
+				/// the scope, and that `valueHash` is equal to `variableHash( value )`
+				/// (this is asserted in debug builds). The value may be changed
+				/// in place, provided `set()` is called again before the context
+				/// is used. As with the other setters, `changedSignal()` is emitted.
+				void set( const IECore::InternedString &name, const IECore::Data *value, const IECore::MurmurHash &valueHash );
 
 				void setFrame( float frame );
 				void setFramesPerSecond( float framesPerSecond );
@@ -282,13 +298,18 @@ class Context : public IECore::RefCounted
 		// Storage for each entry.
 		struct Storage
 		{
-			Storage() : data( nullptr ), ownership( Copied ) {}
+			Storage() : data( nullptr ), ownership( Copied ), hashValid( false ) {}
 			// We reference the data with a raw pointer to avoid the compulsory
 			// overhead of an intrusive pointer.
 			const IECore::Data *data;
 			// And use this ownership flag to tell us when we need to do explicit
 			// reference count management.
 			Ownership ownership;
+			// The result of variableHash( data ), computed lazily by hash()
+			// and stored so that a Context copied from another need only
+			// rehash the values which differ.
+			mutable IECore::MurmurHash hash;
+			mutable bool hashValid;
 		};
 
 		typedef boost::container::flat_map<IECore::InternedString, Storage> Map;
@@ -181,6 +181,7 @@ void Context::set( const IECore::InternedString &name, const T &value )
 	Storage &s = m_map[name];
 	if( Accessor<T>().set( s, value ) )
 	{
+		s.hashValid = false;
 		m_hashValid = false;
 		if( m_changedSignal )
 		{
@@ -64,6 +64,9 @@ class ChannelDataProcessor : public ImageProcessor
 
 	protected :
 
+		void hash( const Gaffer::ValuePlug *output, const Gaffer::Context *context, IECore::MurmurHash &h ) const override;
+		void compute( Gaffer::ValuePlug *output, const Gaffer::Context *context ) const override;
+
 		/// This implementation queries whether or not the requested channel is masked by the channelMaskPlug().
 		bool channelEnabled( const std::string &channel ) const override;
 
@@ -79,8 +82,40 @@ class ChannelDataProcessor : public ImageProcessor
 		/// @param outData The tile where the result of the operation should be written. It is initialized with the coresponding tile data from inPlug() which should be used as the input data.
 		virtual void processChannelData( const Gaffer::Context *context, const ImagePlug *parent, const std::string &channel, IECore::FloatVectorDataPtr outData ) const = 0;
 
+		/// @name Shared planes
+		/// Many operations combine every channel with a single per-tile
+		/// operand, such as an alpha or mask plane. Derived classes may
+		/// implement the methods below to provide such an operand, which
+		/// is then computed and cached once per tile and shared by all
+		/// channels, rather than being fetched and prepared again for each
+		/// one. Within processChannelData(), the plane for the current tile
+		/// is retrieved using sharedPlane().
+		////////////////////////////////////////////////////////////////////
+		//@{
+		/// Should be implemented to return true if the input plug affects the
+		/// computation of the shared plane. The default implementation returns false.
+		virtual bool affectsSharedPlane( const Gaffer::Plug *input ) const;
+		/// Should be implemented to call the base class implementation and then
+		/// append any plugs that will be used in computing the shared plane.
+		/// Note that this is called in a context without a channel name.
+		virtual void hashSharedPlane( const Imath::V2i &tileOrigin, const Gaffer::Context *context, IECore::MurmurHash &h ) const;
+		/// Should be implemented to return the shared plane for the specified tile.
+		/// Note that this is called in a context without a channel name. The default
+		/// implementation throws.
+		virtual IECore::ConstFloatVectorDataPtr computeSharedPlane( const Imath::V2i &tileOrigin, const Gaffer::Context *context ) const;
+
+		/// Returns the hash of the shared plane for the tile
+		/// specified by `context`.
+		IECore::MurmurHash sharedPlaneHash( const Gaffer::Context *context ) const;
+		/// Returns the shared plane for the tile specified by `context`.
+		IECore::ConstFloatVectorDataPtr sharedPlane( const Gaffer::Context *context ) const;
+		//@}
+
 	private :
 
+		Gaffer::FloatVectorDataPlug *sharedPlanePlug();
+		const Gaffer::FloatVectorDataPlug *sharedPlanePlug() const;
+
 		static size_t g_firstPlugIndex;
 
 };
@@ -0,0 +1,77 @@
+//////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (c) 2018, Image Engine Design Inc. All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//
+//      * Redistributions of source code must retain the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer.
+//
+//      * Redistributions in binary form must reproduce the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer in the documentation and/or other materials provided with
+//        the distribution.
+//
+//      * Neither the name of John Haddon nor the names of
+//        any other contributors to this software may be used to endorse or
+//        promote products derived from this software without specific prior
+//        written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+//  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+//  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+//  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+//  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+//  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+//  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+//  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//////////////////////////////////////////////////////////////////////////
+
+#ifndef GAFFERIMAGE_COLORALGO_H
+#define GAFFERIMAGE_COLORALGO_H
+
+#include <cstddef>
+
+namespace GafferImage
+{
+
+namespace ColorAlgo
+{
+
+/// Per-pixel colour kernels, shared by the nodes which apply simple
+/// arithmetic to channel data. The kernels operate in place on a
+/// contiguous run of samples, and are written without branches in
+/// their inner loops so that the compiler may vectorise them.
+////////////////////////////////////////////////////////////////////////////
+
+/// Approximates `pow( x, y )` for `x >= 0` and `abs( y ) < 1e6`. The
+/// relative error is less than `3e-6 * abs( y ) + 1e-6` for results within
+/// the normalised float range, which is well below the precision of half
+/// float images. Results below that range are flushed to zero.
+inline float fastPow( float x, float y );
+
+/// Applies `pow( max( A * x + B, 0 ), invGamma )` to all samples, leaving
+/// negative values of `A * x + B` ungammaed, and optionally clamping the
+/// result to the 0-1 range. When `fast` is true, fastPow() is used in
+/// place of `std::pow()`, unless `invGamma` is outside the range for
+/// which fastPow() is accurate.
+void grade( float *data, size_t size, float a, float b, float invGamma, bool blackClamp, bool whiteClamp, bool fast = false );
+
+/// Replaces values below `minimum` with `minClampTo` and values above
+/// `maximum` with `maxClampTo`, as performed by the Clamp node.
+void clamp( float *data, size_t size, bool minimumEnabled, float minimum, float minClampTo, bool maximumEnabled, float maximum, float maxClampTo );
+
+} // namespace ColorAlgo
+
+} // namespace GafferImage
+
+#include "GafferImage/ColorAlgo.inl"
+
+#endif // GAFFERIMAGE_COLORALGO_H
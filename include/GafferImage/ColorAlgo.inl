@@ -0,0 +1,114 @@
+//////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (c) 2018, Image Engine Design Inc. All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//
+//      * Redistributions of source code must retain the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer.
+//
+//      * Redistributions in binary form must reproduce the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer in the documentation and/or other materials provided with
+//        the distribution.
+//
+//      * Neither the name of John Haddon nor the names of
+//        any other contributors to this software may be used to endorse or
+//        promote products derived from this software without specific prior
+//        written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+//  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+//  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+//  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+//  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+//  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+//  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+//  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//////////////////////////////////////////////////////////////////////////
+
+#ifndef GAFFERIMAGE_COLORALGO_INL
+#define GAFFERIMAGE_COLORALGO_INL
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+
+namespace GafferImage
+{
+
+namespace ColorAlgo
+{
+
+namespace Detail
+{
+
+// Polynomial approximations fitted on the unit interval. `log2( 1 + t )`
+// is approximated as `t * p( t )` so that it is exact at `t == 0`, with an
+// absolute error below 3.1e-6. `exp2( t )` is approximated with a relative
+// error below 2.4e-7.
+
+inline float fastLog2( float x )
+{
+	uint32_t i;
+	std::memcpy( &i, &x, sizeof( i ) );
+	const float e = (float)( (int32_t)( i >> 23 ) - 127 );
+	i = ( i & 0x007FFFFF ) | 0x3F800000;
+	float m;
+	std::memcpy( &m, &i, sizeof( m ) );
+	const float t = m - 1.0f;
+	const float p = 1.44269079f + t * ( -0.721095614f + t * ( 0.477225278f + t * ( -0.337838917f + t * ( 0.21366962f + t * ( -0.0948839865f + t * 0.0202358921f ) ) ) ) );
+	return e + t * p;
+}
+
+// Expects `x` to be finite and within the range of int32_t, which is
+// guaranteed when it is the product of fastLog2() and a reasonable
+// exponent. Clamping is performed on the integer part rather than on
+// `x` itself, because float clamps followed by a conversion prevent
+// vectorisation.
+inline float fastExp2( float x )
+{
+	// Floor, without relying on SSE4.1 rounding instructions.
+	const int32_t xt = (int32_t)x;
+	int32_t xi = xt - (int32_t)( (float)xt > x );
+	const float t = x - (float)xi;
+	const float p = 0.999999769f + t * ( 0.693156779f + t * ( 0.240131684f + t * ( 0.0558765685f + t * ( 0.00894057778f + t * 0.00189437864f ) ) ) );
+	// An exponent of -127 yields a scale of zero, flushing
+	// results below the normalised range.
+	xi = std::min( std::max( xi, -127 ), 127 );
+	const uint32_t scaleBits = (uint32_t)( xi + 127 ) << 23;
+	float scale;
+	std::memcpy( &scale, &scaleBits, sizeof( scale ) );
+	return p * scale;
+}
+
+} // namespace Detail
+
+inline float fastPow( float x, float y )
+{
+	float result = Detail::fastExp2( y * Detail::fastLog2( x ) );
+	// Zero the result for `x <= 0`. This is done with integer masking
+	// rather than a conditional, because the compiler will otherwise
+	// move the computation of `result` into a branch, preventing
+	// vectorisation.
+	int32_t xBits;
+	std::memcpy( &xBits, &x, sizeof( xBits ) );
+	uint32_t resultBits;
+	std::memcpy( &resultBits, &result, sizeof( resultBits ) );
+	resultBits &= (uint32_t)( -(int32_t)( xBits > 0 ) );
+	std::memcpy( &result, &resultBits, sizeof( result ) );
+	return result;
+}
+
+} // namespace ColorAlgo
+
+} // namespace GafferImage
+
+#endif // GAFFERIMAGE_COLORALGO_INL
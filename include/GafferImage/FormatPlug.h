@@ -88,7 +88,8 @@ class FormatPlug : public Gaffer::ValuePlug
 		/// \undoable
 		void setValue( const Format &value );
 		/// Implemented to substitute in the default format from the current
-		/// context if the current value is empty.
+		/// context if the current value is empty, and to apply the proxy
+		/// scale for plugs belonging to an ImageNode.
 		/// \note Substitution is not performed automatically when accessing
 		/// individual components (display window and pixel aspect) from the
 		/// child plugs directly.
@@ -123,6 +124,28 @@ class FormatPlug : public Gaffer::ValuePlug
 		static FormatPlug *acquireDefaultFormatPlug( Gaffer::ScriptNode *scriptNode );
 		//@}
 
+		/// @name Proxy scale
+		///
+		/// Image graphs may be evaluated at a reduced "proxy" resolution
+		/// for faster interactive feedback. The proxy scale is an integer
+		/// divisor specified via a context variable, so a proxy scale of 2
+		/// evaluates the graph at half resolution and a proxy scale of 4
+		/// at quarter resolution. The scale is applied automatically by
+		/// getValue(), and by image sources such as OpenImageIOReader. Nodes
+		/// with parameters measured in pixels are responsible for dividing
+		/// them by the proxy scale themselves.
+		////////////////////////////////////////////////////////////////////
+		//@{
+		/// Returns the proxy scale in effect for the specified context.
+		static int getProxyScale( const Gaffer::Context *context );
+		/// Sets the proxy scale for the specified context. A value of 1
+		/// restores evaluation at full resolution.
+		static void setProxyScale( Gaffer::Context *context, int proxyScale );
+		/// Returns the format that results from evaluating the specified
+		/// format at the specified proxy scale.
+		static Format proxyFormat( const Format &format, int proxyScale );
+		//@}
+
 	private :
 
 		void parentChanging( Gaffer::GraphComponent *newParent ) override;
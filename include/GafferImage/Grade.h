@@ -82,6 +82,10 @@ class Grade : public ChannelDataProcessor
 		const Gaffer::BoolPlug *blackClampPlug() const;
 		Gaffer::BoolPlug *whiteClampPlug();
 		const Gaffer::BoolPlug *whiteClampPlug() const;
+		/// When on, the gamma is applied using ColorAlgo::fastPow(),
+		/// trading a small amount of accuracy for speed.
+		Gaffer::BoolPlug *approximateGammaPlug();
+		const Gaffer::BoolPlug *approximateGammaPlug() const;
         //@}
 
 		void affects( const Gaffer::Plug *input, AffectedPlugsContainer &outputs ) const override;
@@ -73,6 +73,9 @@ class Mix : public ImageProcessor
 
 	protected :
 
+		void hash( const Gaffer::ValuePlug *output, const Gaffer::Context *context, IECore::MurmurHash &h ) const override;
+		void compute( Gaffer::ValuePlug *output, const Gaffer::Context *context ) const override;
+
 		/// Reimplemented to hash the connected input plugs
 		void hashDataWindow( const GafferImage::ImagePlug *output, const Gaffer::Context *context, IECore::MurmurHash &h ) const override;
 		void hashChannelNames( const GafferImage::ImagePlug *output, const Gaffer::Context *context, IECore::MurmurHash &h ) const override;
@@ -87,6 +90,16 @@ class Mix : public ImageProcessor
 
 	private :
 
+		// Per-tile plane containing the final mix weight for each
+		// pixel, taking into account the mix value, the mask and its
+		// data window. This is computed in a context without a channel
+		// name, so that it is shared by all channels.
+		Gaffer::FloatVectorDataPlug *maskPlanePlug();
+		const Gaffer::FloatVectorDataPlug *maskPlanePlug() const;
+
+		void hashMaskPlane( const Gaffer::Context *context, IECore::MurmurHash &h ) const;
+		IECore::ConstFloatVectorDataPtr computeMaskPlane( const Gaffer::Context *context ) const;
+
 		static size_t g_firstPlugIndex;
 
 };
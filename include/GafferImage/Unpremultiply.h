@@ -70,6 +70,10 @@ class Unpremultiply : public ChannelDataProcessor
 		void hashChannelData( const GafferImage::ImagePlug *output, const Gaffer::Context *context, IECore::MurmurHash &h ) const override;
 		void processChannelData( const Gaffer::Context *context, const ImagePlug *parent, const std::string &channelIndex, IECore::FloatVectorDataPtr outData ) const override;
 
+		bool affectsSharedPlane( const Gaffer::Plug *input ) const override;
+		void hashSharedPlane( const Imath::V2i &tileOrigin, const Gaffer::Context *context, IECore::MurmurHash &h ) const override;
+		IECore::ConstFloatVectorDataPtr computeSharedPlane( const Imath::V2i &tileOrigin, const Gaffer::Context *context ) const override;
+
 	private :
 
 		static size_t g_firstPlugIndex;
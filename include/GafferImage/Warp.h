@@ -120,6 +120,11 @@ class Warp : public ImageProcessor
 		Gaffer::ObjectPlug *enginePlug();
 		const Gaffer::ObjectPlug *enginePlug() const;
 
+		// Evaluated without a channel name in the context, and used to store
+		// everything needed to filter a tile that doesn't depend on the
+		// channel : the input positions and derivatives for each pixel,
+		// the input bound, and for separable filters, the filter weights.
+		// This allows the work to be shared by all channels.
 		Gaffer::CompoundObjectPlug *sampleRegionsPlug();
 		const Gaffer::CompoundObjectPlug *sampleRegionsPlug() const;
 
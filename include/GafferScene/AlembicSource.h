@@ -95,7 +95,15 @@ class AlembicSource : public SceneNode
 		IECore::ConstInternedStringVectorDataPtr computeSetNames( const Gaffer::Context *context, const ScenePlug *parent ) const override;
 		GafferScene::ConstPathMatcherDataPtr computeSet( const IECore::InternedString &setName, const Gaffer::Context *context, const ScenePlug *parent ) const override;
 
+		/// Returns the input for `path`, or null if no file has been specified.
+		/// Inputs are owned by the calling thread, and must not be shared with
+		/// other threads.
 		IECoreAlembic::AlembicInputPtr inputForPath( const ScenePath &path ) const;
+		/// Returns true if `time` falls on a sample of the input for `path`, so
+		/// that no interpolation is required, filling `sampleIndex` with the
+		/// index of that sample.
+		bool sampleAtTime( const ScenePath &path, double time, size_t &sampleIndex ) const;
+		void hashTime( const ScenePath &path, double time, IECore::MurmurHash &h ) const;
 
 		static size_t g_firstPlugIndex;
 
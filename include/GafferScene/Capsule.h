@@ -74,12 +74,31 @@ class Capsule : public IECoreScenePreview::Procedural
 		IE_CORE_DECLAREEXTENSIONOBJECT( GafferScene::Capsule, GafferScene::CapsuleTypeId, IECoreScenePreview::Procedural );
 
 		Imath::Box3f bound() const override;
+		/// The encapsulated subtree is expanded only when the renderer
+		/// calls `render()`. Expansions are cached, so that capsules with
+		/// identical hashes are expanded only once, no matter how many
+		/// times they are rendered.
 		void render( IECoreScenePreview::Renderer *renderer ) const override;
 
 		const ScenePlug *scene() const;
 		const ScenePlug::ScenePath &root() const;
 		const Gaffer::Context *context() const;
 
+		/// @name Expansion cache
+		/// The expansions made by `render()` are stored in a global
+		/// cache. These functions allow for management of the cache.
+		////////////////////////////////////////////////////////////////////
+		//@{
+		/// Returns the maximum amount of memory in bytes to use for the cache.
+		static size_t getExpansionCacheMemoryLimit();
+		/// Sets the maximum amount of memory the cache may use in bytes.
+		static void setExpansionCacheMemoryLimit( size_t bytes );
+		/// Returns the current memory usage of the cache in bytes.
+		static size_t expansionCacheMemoryUsage();
+		/// Clears the cache.
+		static void clearExpansionCache();
+		//@}
+
 	private :
 
 		void setScene( const ScenePlug *scene );
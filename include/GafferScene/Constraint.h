@@ -80,6 +80,9 @@ class Constraint : public SceneElementProcessor
 
 	protected :
 
+		void hash( const Gaffer::ValuePlug *output, const Gaffer::Context *context, IECore::MurmurHash &h ) const override;
+		void compute( Gaffer::ValuePlug *output, const Gaffer::Context *context ) const override;
+
 		/// Reimplemented from SceneElementProcessor to call the constraint functions below.
 		bool processesTransform() const override;
 		void hashProcessedTransform( const ScenePath &path, const Gaffer::Context *context, IECore::MurmurHash &h ) const override;
@@ -95,6 +98,16 @@ class Constraint : public SceneElementProcessor
 
 	private :
 
+		// Computes the full transform of inPlug() at the location specified
+		// by the context, using the cached result for the parent location.
+		// This means that constraining many locations only walks each
+		// ancestor once, rather than once per constrained location.
+		Gaffer::M44fPlug *fullInputTransformPlug();
+		const Gaffer::M44fPlug *fullInputTransformPlug() const;
+
+		IECore::MurmurHash fullInputTransformHash( const ScenePath &path ) const;
+		Imath::M44f fullInputTransform( const ScenePath &path ) const;
+
 		void tokenizeTargetPath( ScenePath &path ) const;
 
 		static size_t g_firstPlugIndex;
@@ -71,6 +71,7 @@ class Encapsulate : public FilteredSceneProcessor
 
 		void plugDirtied( const Gaffer::Plug *plug );
 
+		const uint64_t m_serial;
 		uint64_t m_dirtyCount;
 
 		static size_t g_firstPlugIndex;
@@ -42,6 +42,7 @@
 
 #include "GafferScene/TypeIds.h"
 #include "GafferScene/FilterPlug.h"
+#include "GafferScene/PathMatcherDataPlug.h"
 
 namespace GafferScene
 {
@@ -79,6 +80,28 @@ class Filter : public Gaffer::ComputeNode
 		void affects( const Gaffer::Plug *input, AffectedPlugsContainer &outputs ) const override;
 		virtual bool sceneAffectsMatch( const ScenePlug *scene, const Gaffer::ValuePlug *child ) const;
 
+		/// Bulk evaluation
+		/// ===============
+		///
+		/// Evaluating outPlug() requires a separate graph evaluation for
+		/// every location in the scene. Filters which are able to express
+		/// their result for all locations as a single PathMatcher may also
+		/// support bulk evaluation, whereby the PathMatcher is computed once
+		/// by matchingPathsPlug() and then queried directly by the consumer.
+
+		/// Returns true if matchingPathsPlug() may be used in place of
+		/// outPlug(). The default implementation returns false.
+		virtual bool canComputeMatchingPaths() const;
+		/// Provides a PathMatcher whose `match( path )` is equivalent to the
+		/// value of outPlug() at `path`. Must be evaluated within a
+		/// FilterPlug::MatchingPathsScope.
+		PathMatcherDataPlug *matchingPathsPlug();
+		const PathMatcherDataPlug *matchingPathsPlug() const;
+		/// Returns the Filter providing the value for `filterPlug`, provided
+		/// that it supports bulk evaluation. Returns nullptr otherwise, in
+		/// which case `filterPlug` must be evaluated per location as usual.
+		static const Filter *matchingPathsFilter( const Gaffer::Plug *filterPlug );
+
 		/// \deprecated Use FilterPlug::SceneScope instead.
 		static void setInputScene( Gaffer::Context *context, const ScenePlug *scenePlug );
 		/// \deprecated
@@ -88,9 +111,11 @@ class Filter : public Gaffer::ComputeNode
 
 	protected :
 
-		/// Implemented to call hashMatch() below when computing the hash for outPlug().
+		/// Implemented to call hashMatch() below when computing the hash for outPlug(),
+		/// and hashMatchingPaths() when computing the hash for matchingPathsPlug().
 		void hash( const Gaffer::ValuePlug *output, const Gaffer::Context *context, IECore::MurmurHash &h ) const override;
-		/// Implemented to call computeMatch() below when computing the value of outPlug().
+		/// Implemented to call computeMatch() below when computing the value of outPlug(),
+		/// and computeMatchingPaths() when computing the value of matchingPathsPlug().
 		void compute( Gaffer::ValuePlug *output, const Gaffer::Context *context ) const override;
 
 		/// Hash method for outPlug(). A derived class must either :
@@ -113,6 +138,13 @@ class Filter : public Gaffer::ComputeNode
 		/// an input connection must be made into outPlug(), so that the method is not called.
 		virtual unsigned computeMatch( const ScenePlug *scene, const Gaffer::Context *context ) const;
 
+		/// Must be implemented by derived classes which return true from
+		/// canComputeMatchingPaths(). The context will not contain a "scene:path"
+		/// variable. Derived classes should also declare that any inputs affecting
+		/// outPlug() affect matchingPathsPlug().
+		virtual void hashMatchingPaths( const ScenePlug *scene, const Gaffer::Context *context, IECore::MurmurHash &h ) const;
+		virtual ConstPathMatcherDataPtr computeMatchingPaths( const ScenePlug *scene, const Gaffer::Context *context ) const;
+
 	private :
 
 		static size_t g_firstPlugIndex;
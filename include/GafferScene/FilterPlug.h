@@ -90,6 +90,15 @@ class FilterPlug : public Gaffer::IntPlug
 			SceneScope( const Gaffer::Context *context, const ScenePlug *scenePlug );
 		};
 
+		/// Provides the input scene for a bulk evaluation of
+		/// Filter::matchingPathsPlug(), removing the "scene:path"
+		/// variable so that a single result is shared by all
+		/// locations.
+		struct MatchingPathsScope : public SceneScope
+		{
+			MatchingPathsScope( const Gaffer::Context *context, const ScenePlug *scenePlug );
+		};
+
 };
 
 IE_CORE_DECLAREPTR( FilterPlug );
@@ -90,6 +90,8 @@ class FilterProcessor : public Filter
 	protected :
 
 		/// Reimplemented to pass through the inPlug() hash when the node is disabled.
+		/// The same applies to matchingPathsPlug(), provided that the filter connected
+		/// to inPlug() supports bulk evaluation.
 		void hash( const Gaffer::ValuePlug *output, const Gaffer::Context *context, IECore::MurmurHash &h ) const override;
 		/// Reimplemented to pass through the inPlug() result when the node is disabled.
 		void compute( Gaffer::ValuePlug *output, const Gaffer::Context *context ) const override;
@@ -68,11 +68,14 @@ class FilteredSceneProcessor : public SceneProcessor
 		/// calls filterPlug()->hash() using a FilterPlug::SceneScope. Note that
 		/// if you need to make multiple queries, it is more efficient to make your
 		/// own SceneScope and then query the filter directly multiple times.
+		/// If the filter supports bulk evaluation, Filter::matchingPathsPlug()
+		/// is used in preference to filterPlug().
 		void filterHash( const Gaffer::Context *context, IECore::MurmurHash &h ) const;
 		/// Convenience method for returning the result of filterPlug()->getValue()
 		/// cast to the appropriate result type, using a using a FilterPlug::SceneScope.
 		/// Note that if you need to make multiple queries, it is more efficient to
 		/// make your own SceneScope and then query the filter directly multiple times.
+		/// As above, Filter::matchingPathsPlug() is used when possible.
 		Filter::Result filterValue( const Gaffer::Context *context ) const;
 
 		static size_t g_firstPlugIndex;
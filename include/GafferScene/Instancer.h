@@ -59,6 +59,36 @@ class Instancer : public BranchCreator
 		ScenePlug *instancePlug();
 		const ScenePlug *instancePlug() const;
 
+		/// When on, the bounds of the instances are computed from the
+		/// bound of the first instance only, rather than by evaluating
+		/// every instance individually. This is exact if the instances
+		/// don't vary according to the "instancer:id" context variable.
+		Gaffer::BoolPlug *approximateBoundsPlug();
+		const Gaffer::BoolPlug *approximateBoundsPlug() const;
+
+		/// When non-empty, the instances are taken from a small set of
+		/// prototypes, specified as the paths to their roots within
+		/// instancePlug(). Each point chooses its prototype using the
+		/// integer primitive variable named by prototypeIndexPlug().
+		/// The prototypes are evaluated without the "instancer:id" context
+		/// variable, so each prototype is computed only once and shared
+		/// by all the instances that use it. The transform of each prototype
+		/// root is included in the transform of its instances.
+		Gaffer::StringVectorDataPlug *prototypeRootsPlug();
+		const Gaffer::StringVectorDataPlug *prototypeRootsPlug() const;
+
+		Gaffer::StringPlug *prototypeIndexPlug();
+		const Gaffer::StringPlug *prototypeIndexPlug() const;
+
+		/// Names of primitive variables used to rotate and scale the
+		/// instances. Orientation is specified as a quaternion, and scale
+		/// may either be a vector or a float.
+		Gaffer::StringPlug *orientationPlug();
+		const Gaffer::StringPlug *orientationPlug() const;
+
+		Gaffer::StringPlug *scalePlug();
+		const Gaffer::StringPlug *scalePlug() const;
+
 		void affects( const Gaffer::Plug *input, AffectedPlugsContainer &outputs ) const override;
 
 	protected :
@@ -78,23 +108,50 @@ class Instancer : public BranchCreator
 		void hashBranchChildNames( const ScenePath &parentPath, const ScenePath &branchPath, const Gaffer::Context *context, IECore::MurmurHash &h ) const override;
 		IECore::ConstInternedStringVectorDataPtr computeBranchChildNames( const ScenePath &parentPath, const ScenePath &branchPath, const Gaffer::Context *context ) const override;
 
+	protected :
+
+		void hash( const Gaffer::ValuePlug *output, const Gaffer::Context *context, IECore::MurmurHash &h ) const override;
+		void compute( Gaffer::ValuePlug *output, const Gaffer::Context *context ) const override;
+
 	private :
 
+		IE_CORE_FORWARDDECLARE( EngineData );
+
+		// Evaluated with the parent location in the context, and used to
+		// store the per-point data and prototype roots needed to generate
+		// the instances. This allows the work to be shared by all the
+		// instances, rather than being repeated for each one.
+		Gaffer::ObjectPlug *enginePlug();
+		const Gaffer::ObjectPlug *enginePlug() const;
+
+		IECore::MurmurHash engineHash( const ScenePath &parentPath, const Gaffer::Context *context ) const;
+		ConstEngineDataPtr engine( const ScenePath &parentPath, const Gaffer::Context *context ) const;
+
 		struct BoundHash;
 		struct BoundUnion;
+		struct TransformedBoundUnion;
 
-		IECore::ConstV3fVectorDataPtr sourcePoints( const ScenePath &parentPath ) const;
-		static int instanceIndex( const ScenePath &branchPath );
+		static size_t instanceIndex( const ScenePath &branchPath );
 
 		struct InstanceScope : public Gaffer::Context::EditableScope
 		{
 			InstanceScope( const Gaffer::Context *context );
-			InstanceScope( const Gaffer::Context *context, const ScenePath &branchPath );
+			/// Scopes the context for evaluating instancePlug() at
+			/// the branchPath. In prototype mode this is a location below
+			/// the appropriate prototype root, and "instancer:id" is not set.
+			InstanceScope( const Instancer *instancer, const ScenePath &parentPath, const Gaffer::Context *context, const ScenePath &branchPath );
 			void update( const ScenePath &branchPath );
 			void update( const ScenePath &branchPath, int instanceId );
+			void updatePrototype( const ScenePath &prototypeRoot, const ScenePath &branchPath );
 		};
 
-		Imath::M44f instanceTransform( const IECore::V3fVectorData *p, int instanceId ) const;
+		Imath::Box3f unionOfInstanceBounds( const EngineData *engine, const std::vector<Imath::Box3f> &prototypeBounds ) const;
+
+		void hashPrototypeBound( const EngineData *engine, const Gaffer::Context *context, IECore::MurmurHash &h ) const;
+		Imath::Box3f computePrototypeBound( const EngineData *engine, const Gaffer::Context *context ) const;
+
+		void hashApproximateBound( const ScenePath &branchChildPath, const Gaffer::Context *context, IECore::MurmurHash &h ) const;
+		Imath::Box3f computeApproximateBound( const ScenePath &branchChildPath, const EngineData *engine, const Gaffer::Context *context ) const;
 
 		static size_t g_firstPlugIndex;
 
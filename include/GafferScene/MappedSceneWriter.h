@@ -0,0 +1,91 @@
+//////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (c) 2018, Image Engine Design Inc. All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//
+//      * Redistributions of source code must retain the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer.
+//
+//      * Redistributions in binary form must reproduce the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer in the documentation and/or other materials provided with
+//        the distribution.
+//
+//      * Neither the name of John Haddon nor the names of
+//        any other contributors to this software may be used to endorse or
+//        promote products derived from this software without specific prior
+//        written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+//  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+//  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+//  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+//  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+//  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+//  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+//  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//////////////////////////////////////////////////////////////////////////
+
+#ifndef GAFFERSCENE_MAPPEDSCENEWRITER_H
+#define GAFFERSCENE_MAPPEDSCENEWRITER_H
+
+#include "Gaffer/TypedPlug.h"
+
+#include "GafferDispatch/TaskNode.h"
+
+#include "GafferScene/TypeIds.h"
+#include "GafferScene/ScenePlug.h"
+
+namespace GafferScene
+{
+
+/// Writes a single frame of a scene to a pre-flattened file
+/// which can be memory mapped by MappedSceneReader. This trades
+/// the generality of SceneWriter for loads which require no
+/// parsing, and which share memory between processes.
+class MappedSceneWriter : public GafferDispatch::TaskNode
+{
+
+	public :
+
+		MappedSceneWriter( const std::string &name=defaultName<MappedSceneWriter>() );
+		~MappedSceneWriter() override;
+
+		IE_CORE_DECLARERUNTIMETYPEDEXTENSION( GafferScene::MappedSceneWriter, MappedSceneWriterTypeId, GafferDispatch::TaskNode );
+
+		Gaffer::StringPlug *fileNamePlug();
+		const Gaffer::StringPlug *fileNamePlug() const;
+
+		ScenePlug *inPlug();
+		const ScenePlug *inPlug() const;
+
+		ScenePlug *outPlug();
+		const ScenePlug *outPlug() const;
+
+		IECore::MurmurHash hash( const Gaffer::Context *context ) const override;
+
+		/// Computes the whole scene in parallel, then writes it to
+		/// a temporary file which is renamed into place. The rename
+		/// means that processes with the previous file mapped continue
+		/// to see its contents rather than a partially written file.
+		void execute() const override;
+
+	private :
+
+		static size_t g_firstPlugIndex;
+
+};
+
+IE_CORE_DECLAREPTR( MappedSceneWriter )
+
+} // namespace GafferScene
+
+#endif // GAFFERSCENE_MAPPEDSCENEWRITER_H
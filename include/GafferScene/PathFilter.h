@@ -61,6 +61,8 @@ class PathFilter : public Filter
 
 		void affects( const Gaffer::Plug *input, AffectedPlugsContainer &outputs ) const override;
 
+		bool canComputeMatchingPaths() const override;
+
 	protected :
 
 		void hash( const Gaffer::ValuePlug *output, const Gaffer::Context *context, IECore::MurmurHash &h ) const override;
@@ -69,6 +71,9 @@ class PathFilter : public Filter
 		void hashMatch( const ScenePlug *scene, const Gaffer::Context *context, IECore::MurmurHash &h ) const override;
 		unsigned computeMatch( const ScenePlug *scene, const Gaffer::Context *context ) const override;
 
+		void hashMatchingPaths( const ScenePlug *scene, const Gaffer::Context *context, IECore::MurmurHash &h ) const override;
+		ConstPathMatcherDataPtr computeMatchingPaths( const ScenePlug *scene, const Gaffer::Context *context ) const override;
+
 	private :
 
 		// Filter matches are computed using a PathMatcher data structure in one of two ways:
@@ -40,7 +40,7 @@
 
 #include "IECore/TypedData.h"
 
-#include "GafferScene/Filter.h"
+#include <limits>
 
 namespace GafferScene
 {
@@ -75,6 +75,8 @@ class PathMatcher
 
 		/// Adds all paths from the other PathMatcher, returning true if
 		/// any were added, and false if they were all already present.
+		/// This and the other set operations below use multiple threads
+		/// for wide hierarchies.
 		bool addPaths( const PathMatcher &paths );
 		/// As above, but prefixing the paths that are added.
 		bool addPaths( const PathMatcher &paths, const std::vector<IECore::InternedString> &prefix );
@@ -158,9 +160,10 @@ class PathMatcher
 			// via pointer rather than string content, which gives improved
 			// performance.
 			bool operator < ( const Name &other ) const;
+			bool operator == ( const Name &other ) const;
 
-			const IECore::InternedString name;
-			const unsigned char type;
+			IECore::InternedString name;
+			unsigned char type;
 
 		};
 
@@ -173,10 +176,70 @@ class PathMatcher
 				// We need two things out of this structure - quick access
 				// to the child with a specific name, and also partitioning
 				// between names with wildcards and those without. This is
-				// achieved by using an ordered container, and having the
-				// less than operation for Names sort first on hasWildcards
-				// and second on the name.
-				typedef std::map<Name, NodePtr> ChildMap;
+				// achieved by storing the children contiguously in a vector,
+				// with all plain names preceding all wildcarded names. Small
+				// nodes are kept sorted and searched linearly, and large nodes
+				// additionally maintain an open-addressed hash table of indices
+				// into the vector. This is far more compact than a node-based
+				// container such as `std::map`, and much kinder to the cache
+				// during traversal.
+				//
+				// The order of children within the partitions of a large node
+				// depends on the order of edits, and any edit may invalidate
+				// existing iterators.
+				class ChildMap
+				{
+
+					public :
+
+						typedef std::pair<Name, NodePtr> value_type;
+						typedef std::vector<value_type>::iterator iterator;
+						typedef std::vector<value_type>::const_iterator const_iterator;
+
+						ChildMap();
+
+						iterator begin();
+						iterator end();
+						const_iterator begin() const;
+						const_iterator end() const;
+						// Returns an iterator to the first child whose name contains
+						// wildcards.
+						const_iterator wildcardsBegin() const;
+
+						size_t size() const;
+						bool empty() const;
+
+						iterator find( const Name &name );
+						const_iterator find( const Name &name ) const;
+
+						// Returns the child with the specified name, inserting
+						// a null child if it doesn't exist yet.
+						NodePtr &operator[]( const Name &name );
+						// Returns the number of children erased.
+						size_t erase( const Name &name );
+						void clear();
+
+					private :
+
+						// Returns size() if the name isn't found.
+						size_t index( const Name &name ) const;
+						static size_t hash( const Name &name );
+						// Returns the slot in m_hashTable containing name,
+						// or the empty slot where it would be inserted.
+						size_t slot( const Name &name ) const;
+						// Moves a child to a new index, leaving `from` empty.
+						void moveChild( size_t from, size_t to );
+						void hashTableErase( const Name &name );
+						void rebuildHashTable();
+
+						std::vector<value_type> m_children;
+						// Number of plain names at the start of m_children.
+						size_t m_numPlain;
+						// Empty for small nodes.
+						std::vector<uint32_t> m_hashTable;
+
+				};
+
 				typedef ChildMap::iterator ChildMapIterator;
 				typedef ChildMap::value_type ChildMapValue;
 				typedef ChildMap::const_iterator ConstChildMapIterator;
@@ -226,6 +289,37 @@ class PathMatcher
 		NodePtr addPathsWalk( Node *node, const Node *srcNode, bool shared, bool &added );
 		NodePtr addPrefixedPathsWalk( Node *node, const Node *srcNode, const NameIterator &start, const NameIterator &end, bool shared, bool &added  );
 		NodePtr removePathsWalk( Node *node, const Node *srcNode, bool shared, bool &removed );
+		// Returns the intersection of the two trees, sharing subtrees where possible.
+		// Returns null if the intersection is empty.
+		NodePtr intersectionWalk( Node *node, Node *srcNode );
+
+		// The walks above which take a srcNode recurse to the children
+		// of node corresponding to the children of srcNode. These are
+		// independent, so for nodes with many children we walk them in
+		// parallel, and then apply the resulting edits serially.
+		enum WalkType
+		{
+			AddPaths,
+			RemovePaths,
+			Intersection
+		};
+
+		// Edit to be applied to a child after walking it.
+		struct ChildEdit
+		{
+			ChildEdit();
+			// Replacement for the child, or null to leave it as is.
+			NodePtr node;
+			bool erase;
+			// True if the walk added or removed any paths.
+			bool changed;
+		};
+
+		ChildEdit childWalk( WalkType type, Node *node, const Node::ChildMapValue &srcChild, bool shared );
+		// Walks all the children of srcNode, applying the edits to `writable( node, result, shared )`.
+		// Returns true if any of the walks added or removed paths.
+		bool childrenWalk( WalkType type, Node *node, const Node *srcNode, NodePtr &result, bool shared );
+		class ParallelChildrenWalk;
 
 		void matchWalk( const Node *node, const NameIterator &start, const NameIterator &end, unsigned &result ) const;
 
@@ -60,6 +60,118 @@ void PathMatcher::init( PathIterator pathsBegin, PathIterator pathsEnd )
 	}
 }
 
+//////////////////////////////////////////////////////////////////////////
+// Name
+//////////////////////////////////////////////////////////////////////////
+
+inline bool PathMatcher::Name::operator == ( const Name &other ) const
+{
+	return name == other.name && type == other.type;
+}
+
+//////////////////////////////////////////////////////////////////////////
+// ChildMap
+//////////////////////////////////////////////////////////////////////////
+
+inline PathMatcher::Node::ChildMap::iterator PathMatcher::Node::ChildMap::begin()
+{
+	return m_children.begin();
+}
+
+inline PathMatcher::Node::ChildMap::iterator PathMatcher::Node::ChildMap::end()
+{
+	return m_children.end();
+}
+
+inline PathMatcher::Node::ChildMap::const_iterator PathMatcher::Node::ChildMap::begin() const
+{
+	return m_children.begin();
+}
+
+inline PathMatcher::Node::ChildMap::const_iterator PathMatcher::Node::ChildMap::end() const
+{
+	return m_children.end();
+}
+
+inline PathMatcher::Node::ChildMap::const_iterator PathMatcher::Node::ChildMap::wildcardsBegin() const
+{
+	return m_children.begin() + m_numPlain;
+}
+
+inline size_t PathMatcher::Node::ChildMap::size() const
+{
+	return m_children.size();
+}
+
+inline bool PathMatcher::Node::ChildMap::empty() const
+{
+	return m_children.empty();
+}
+
+inline PathMatcher::Node::ChildMap::iterator PathMatcher::Node::ChildMap::find( const Name &name )
+{
+	return m_children.begin() + index( name );
+}
+
+inline PathMatcher::Node::ChildMap::const_iterator PathMatcher::Node::ChildMap::find( const Name &name ) const
+{
+	return m_children.begin() + index( name );
+}
+
+inline size_t PathMatcher::Node::ChildMap::index( const Name &name ) const
+{
+	if( m_hashTable.empty() )
+	{
+		// Small node - a linear search of the appropriate
+		// partition is faster than anything cleverer.
+		size_t i, e;
+		if( name.type == Name::Plain )
+		{
+			i = 0; e = m_numPlain;
+		}
+		else
+		{
+			i = m_numPlain; e = m_children.size();
+		}
+		for( ; i < e; ++i )
+		{
+			if( m_children[i].first == name )
+			{
+				return i;
+			}
+		}
+		return m_children.size();
+	}
+
+	const uint32_t i = m_hashTable[slot( name )];
+	return i == std::numeric_limits<uint32_t>::max() ? m_children.size() : i;
+}
+
+inline size_t PathMatcher::Node::ChildMap::hash( const Name &name )
+{
+	// InternedStrings are uniquely identified by their address, so we
+	// can use that as the basis for a hash, mixing it with a Fibonacci
+	// multiplier.
+	const uint64_t h = ( reinterpret_cast<uint64_t>( name.name.c_str() ) + name.type ) * 0x9E3779B97F4A7C15ull;
+	return h >> 32;
+}
+
+inline size_t PathMatcher::Node::ChildMap::slot( const Name &name ) const
+{
+	// Linear probing.
+	const size_t mask = m_hashTable.size() - 1;
+	size_t s = hash( name ) & mask;
+	while( true )
+	{
+		const uint32_t i = m_hashTable[s];
+		if( i == std::numeric_limits<uint32_t>::max() || m_children[i].first == name )
+		{
+			return s;
+		}
+		s = ( s + 1 ) & mask;
+	}
+}
+
 //////////////////////////////////////////////////////////////////////////
 // RawIterator
 //////////////////////////////////////////////////////////////////////////
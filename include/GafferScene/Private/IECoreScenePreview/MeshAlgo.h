@@ -0,0 +1,78 @@
+//////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (c) 2018, Image Engine Design Inc. All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//
+//      * Redistributions of source code must retain the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer.
+//
+//      * Redistributions in binary form must reproduce the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer in the documentation and/or other materials provided with
+//        the distribution.
+//
+//      * Neither the name of John Haddon nor the names of
+//        any other contributors to this software may be used to endorse or
+//        promote products derived from this software without specific prior
+//        written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+//  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+//  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+//  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+//  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+//  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+//  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+//  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//////////////////////////////////////////////////////////////////////////
+
+#ifndef IECORESCENEPREVIEW_MESHALGO_H
+#define IECORESCENEPREVIEW_MESHALGO_H
+
+#include "IECore/MeshPrimitive.h"
+#include "IECore/PointsPrimitive.h"
+
+namespace IECoreScenePreview
+{
+
+/// Multithreaded equivalents of functions from IECore::MeshAlgo. Work is
+/// chunked over faces and vertices using TBB, output buffers are allocated
+/// once at their final size and filled in place, and the topology tables
+/// required by a function are computed once and shared by all the primitive
+/// variables it processes. Results are independent of the number of threads.
+/// \todo Move to Cortex, replacing the single-threaded implementations.
+namespace MeshAlgo
+{
+
+/// Equivalent to `IECore::MeshAlgo::deleteFaces()`.
+IECore::MeshPrimitivePtr deleteFaces( const IECore::MeshPrimitive *mesh, const IECore::PrimitiveVariable &facesToDelete );
+
+/// Equivalent to `IECore::MeshAlgo::calculateTangents()`. Face-vertices
+/// share tangents according to the `<uvSet>Indices` primitive variable
+/// if it exists, and otherwise according to the vertex ids.
+std::pair<IECore::PrimitiveVariable, IECore::PrimitiveVariable> calculateTangents( const IECore::MeshPrimitive *mesh, const std::string &uvSet = "uv", bool orthoTangents = true, const std::string &position = "P" );
+
+/// Equivalent to `IECore::MeshAlgo::resamplePrimitiveVariable()`. Conversions
+/// between Vertex, Varying, Uniform and FaceVarying interpolation are performed
+/// in parallel for the common numeric types. All other conversions are cheap
+/// enough to be deferred to Cortex.
+void resamplePrimitiveVariable( const IECore::MeshPrimitive *mesh, IECore::PrimitiveVariable &primitiveVariable, IECore::PrimitiveVariable::Interpolation interpolation );
+
+/// Equivalent to `IECore::MeshAlgo::distributePoints()`. Non-triangular faces
+/// are fan triangulated on the fly rather than by copying the mesh, and the
+/// points are ordered by face.
+IECore::PointsPrimitivePtr distributePoints( const IECore::MeshPrimitive *mesh, float density = 100.0, const Imath::V2f &offset = Imath::V2f( 0 ), const std::string &densityMask = "density", const std::string &uvSet = "uv", const std::string &position = "P" );
+
+} // namespace MeshAlgo
+
+} // namespace IECoreScenePreview
+
+#endif // IECORESCENEPREVIEW_MESHALGO_H
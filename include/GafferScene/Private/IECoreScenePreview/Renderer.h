@@ -256,6 +256,46 @@ class Renderer : public IECore::RefCounted
 		/// As above, but specifying a deforming object.
 		virtual ObjectInterfacePtr object( const std::string &name, const std::vector<const IECore::Object *> &samples, const std::vector<float> &times, const AttributesInterface *attributes ) = 0;
 
+		IE_CORE_FORWARDDECLARE( Prototype );
+
+		/// An object which may be shared by many locations in the scene,
+		/// identified by a hash which uniquely describes its samples. The
+		/// hash is provided by the client (typically from a ScenePlug's
+		/// objectPlug()) so that renderers may use it to look up a cached
+		/// translation without hashing the object itself.
+		class Prototype : public IECore::RefCounted
+		{
+
+			public :
+
+				IE_CORE_DECLAREMEMBERPTR( Prototype );
+
+				Prototype( const IECore::MurmurHash &hash, const IECore::Object *object );
+				Prototype( const IECore::MurmurHash &hash, const std::vector<const IECore::Object *> &samples, const std::vector<float> &times );
+				~Prototype() override;
+
+				const IECore::MurmurHash &hash() const;
+				/// Contains a single sample for non-deforming prototypes.
+				const std::vector<IECore::ConstObjectPtr> &samples() const;
+				/// Empty for non-deforming prototypes.
+				const std::vector<float> &times() const;
+
+			private :
+
+				IECore::MurmurHash m_hash;
+				std::vector<IECore::ConstObjectPtr> m_samples;
+				std::vector<float> m_times;
+
+		};
+
+		/// Adds a named instance of a prototype to the render, with the initially
+		/// supplied set of attributes. The returned handle has the same semantics
+		/// as one returned by `object()`. Renderers supporting instancing should
+		/// reimplement this to translate each prototype only once for each unique
+		/// set of geometric attributes. The default implementation simply calls
+		/// `object()` with the prototype's samples.
+		virtual ObjectInterfacePtr instance( const std::string &name, const Prototype *prototype, const AttributesInterface *attributes );
+
 		/// Performs the render - should be called after the
 		/// entire scene has been specified using the methods
 		/// above. Batch and SceneDescripton renders will have
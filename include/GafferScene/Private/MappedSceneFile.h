@@ -0,0 +1,197 @@
+//////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (c) 2018, Image Engine Design Inc. All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//
+//      * Redistributions of source code must retain the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer.
+//
+//      * Redistributions in binary form must reproduce the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer in the documentation and/or other materials provided with
+//        the distribution.
+//
+//      * Neither the name of John Haddon nor the names of
+//        any other contributors to this software may be used to endorse or
+//        promote products derived from this software without specific prior
+//        written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+//  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+//  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+//  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+//  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+//  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+//  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+//  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//////////////////////////////////////////////////////////////////////////
+
+#ifndef GAFFERSCENE_MAPPEDSCENEFILE_H
+#define GAFFERSCENE_MAPPEDSCENEFILE_H
+
+#include "boost/iostreams/device/mapped_file.hpp"
+
+#include "IECore/RefCounted.h"
+#include "IECore/Object.h"
+
+#include "GafferScene/ScenePlug.h"
+
+namespace GafferScene
+{
+
+namespace Private
+{
+
+/// Provides read access to the pre-flattened scene files written by
+/// MappedSceneWriter. The file is mapped into memory rather than read,
+/// so opening it costs nothing, pages are only loaded as they are
+/// touched, and processes on the same host share the pages via the
+/// OS page cache.
+///
+/// All values are stored in native byte order, and all sections are
+/// 8 byte aligned. The file consists of :
+///
+/// - A Header.
+/// - The location table, holding one Location per location. Locations
+///   are numbered breadth first, so that the children of each location
+///   are contiguous.
+/// - The sorted children table, holding one `uint64_t` per location.
+///   For each location, the entries from `firstChild` to `firstChild + numChildren`
+///   hold its children sorted by name, to allow lookups by binary search.
+/// - The set table, holding one Set per set.
+/// - The set members table, holding the `uint64_t` location indices
+///   referenced by the set table.
+/// - The names of all locations and sets, without terminators.
+/// - Blobs, holding objects serialised via `Object::save()`. Identical
+///   objects share a single blob.
+///
+/// The extents of the tables are validated when the file is opened,
+/// and every index and range read from the file is validated as it
+/// is used, so that truncated or corrupt files result in exceptions
+/// rather than reads outside the mapping.
+class MappedSceneFile : public IECore::RefCounted
+{
+
+	public :
+
+		/// Refers to a serialised object. An empty range
+		/// indicates the absence of an object.
+		struct BlobRange
+		{
+			uint64_t offset;
+			uint64_t size;
+			/// The hash of the object, as computed by
+			/// `Object::hash()`. This depends only on the
+			/// content of the object, so may be used to
+			/// identify it across files and processes.
+			uint64_t hash[2];
+		};
+
+		struct NameRange
+		{
+			uint64_t offset;
+			uint64_t size;
+		};
+
+		struct Header
+		{
+			char magic[8];
+			uint64_t version;
+			uint64_t numLocations;
+			uint64_t locationsOffset;
+			uint64_t sortedChildrenOffset;
+			uint64_t numSets;
+			uint64_t setsOffset;
+			uint64_t setMembersOffset;
+			uint64_t namesOffset;
+			uint64_t blobsOffset;
+			BlobRange globals;
+		};
+
+		struct Location
+		{
+			NameRange name;
+			uint64_t parent;
+			uint64_t firstChild;
+			uint64_t numChildren;
+			float bound[6];
+			float transform[16];
+			BlobRange object;
+			BlobRange attributes;
+		};
+
+		struct Set
+		{
+			NameRange name;
+			uint64_t firstMember;
+			uint64_t numMembers;
+		};
+
+		static const char g_magic[8];
+		static const uint64_t g_version;
+		/// Returned by `find()` for locations that don't exist,
+		/// and used as the parent of the root location.
+		static const uint64_t g_invalidLocation;
+
+		/// Maps the file, throwing if it can't be opened or
+		/// is not a valid scene file.
+		MappedSceneFile( const std::string &fileName );
+		~MappedSceneFile() override;
+
+		IE_CORE_DECLAREMEMBERPTR( MappedSceneFile )
+
+		const Header &header() const;
+
+		/// Returns the index of the location at `path`, or
+		/// `g_invalidLocation` if it doesn't exist. Like all
+		/// the query methods, throws if the file is found to
+		/// be corrupt.
+		uint64_t find( const ScenePlug::ScenePath &path ) const;
+		/// The `firstChild` and `numChildren` fields of the
+		/// result are guaranteed to be within the location
+		/// table.
+		const Location &location( uint64_t index ) const;
+		/// Fills `path` with the path to the location.
+		void path( uint64_t index, ScenePlug::ScenePath &path ) const;
+
+		const Set &set( uint64_t index ) const;
+		const uint64_t *setMembers( const Set &set ) const;
+
+		IECore::InternedString name( const NameRange &range ) const;
+		/// Returns the object stored in the blob, or
+		/// null if the range is empty.
+		IECore::ObjectPtr object( const BlobRange &range ) const;
+		static IECore::MurmurHash hash( const BlobRange &range );
+
+	private :
+
+		// Returns a pointer to the `size` bytes at `offset` within the
+		// section spanning `[sectionBegin, sectionEnd)`, throwing if
+		// they lie outside it.
+		const char *data( uint64_t sectionBegin, uint64_t sectionEnd, uint64_t offset, uint64_t size ) const;
+		void throwCorrupt() const;
+		// Compares the stored name with `name`, returning a negative, zero
+		// or positive value in the manner of `memcmp()`.
+		int compare( const NameRange &range, const IECore::InternedString &name ) const;
+
+		const std::string m_fileName;
+		boost::iostreams::mapped_file_source m_file;
+		const Header *m_header;
+
+};
+
+IE_CORE_DECLAREPTR( MappedSceneFile )
+
+} // namespace Private
+
+} // namespace GafferScene
+
+#endif // GAFFERSCENE_MAPPEDSCENEFILE_H
@@ -38,6 +38,8 @@
 #define GAFFERSCENE_RENDERERALGO_H
 
 #include <functional>
+#include <map>
+#include <memory>
 
 #include "boost/container/flat_map.hpp"
 
@@ -97,6 +99,7 @@ class RenderSets : boost::noncopyable
 
 		RenderSets();
 		RenderSets( const ScenePlug *scene );
+		~RenderSets();
 
 		enum Changed
 		{
@@ -114,6 +117,9 @@ class RenderSets : boost::noncopyable
 		const PathMatcher &camerasSet() const;
 		const PathMatcher &lightsSet() const;
 
+		/// Returns the value for the "sets" attribute at the specified
+		/// location. Results are shared between locations with
+		/// identical set membership.
 		IECore::ConstInternedStringVectorDataPtr setsAttribute( const std::vector<IECore::InternedString> &path ) const;
 
 	private :
@@ -134,6 +140,22 @@ class RenderSets : boost::noncopyable
 		Set m_camerasSet;
 		Set m_lightsSet;
 
+		// Inverted index of m_sets, so that setsAttribute() can find
+		// all the sets for a location with a single walk down its path.
+		// Each location in the index refers to an entry in m_memberships,
+		// which maps from the indices of the sets it belongs to (directly
+		// or via an ancestor) to the value for the "sets" attribute.
+		struct IndexNode;
+		typedef std::map<std::vector<size_t>, IECore::ConstInternedStringVectorDataPtr> Memberships;
+
+		void updateIndex();
+
+		std::unique_ptr<IndexNode> m_index;
+		Memberships m_memberships;
+		// Sets containing wildcards can't be represented in the
+		// index, and are matched individually instead.
+		std::vector<size_t> m_wildcardedSets;
+
 };
 
 void outputCameras( const ScenePlug *scene, const IECore::CompoundObject *globals, const RenderSets &renderSets, IECoreScenePreview::Renderer *renderer );
@@ -41,6 +41,7 @@
 
 #include "Gaffer/NumericPlug.h"
 #include "GafferScene/ScenePlug.h"
+#include "GafferScene/Filter.h"
 
 namespace IECore
 {
@@ -73,7 +74,8 @@ bool visible( const ScenePlug *scene, const ScenePlug::ScenePath &path );
 /// Finds all the paths in the scene that are matched by the filter, and adds them into the PathMatcher.
 void matchingPaths( const Filter *filter, const ScenePlug *scene, PathMatcher &paths );
 /// As above, but specifying the filter as a plug - typically Filter::outPlug() or
-/// FilteredSceneProcessor::filterPlug() would be passed.
+/// FilteredSceneProcessor::filterPlug() would be passed. Filters supporting bulk
+/// evaluation are evaluated once via Filter::matchingPathsPlug().
 void matchingPaths( const Gaffer::IntPlug *filterPlug, const ScenePlug *scene, PathMatcher &paths );
 /// As above, but specifying the filter as a PathMatcher.
 void matchingPaths( const PathMatcher &filter, const ScenePlug *scene, PathMatcher &paths );
@@ -105,20 +107,70 @@ void matchingPaths( const PathMatcher &filter, const ScenePlug *scene, PathMatch
 template <class ThreadableFunctor>
 void parallelProcessLocations( const GafferScene::ScenePlug *scene, ThreadableFunctor &f );
 /// As above, but starting the traversal at the specified root.
+/// The children of each location are divided into ranges of at most
+/// `grainSize` locations, with each range processed serially by a
+/// single task. The default of 0 chooses the grain size automatically,
+/// based on the number of children and threads.
 template <class ThreadableFunctor>
-void parallelProcessLocations( const GafferScene::ScenePlug *scene, ThreadableFunctor &f, const ScenePlug::ScenePath &root );
+void parallelProcessLocations( const GafferScene::ScenePlug *scene, ThreadableFunctor &f, const ScenePlug::ScenePath &root, size_t grainSize = 0 );
+
+/// Utility for accumulating the full transform and attributes of each
+/// location visited by parallelProcessLocations(). The accumulator should
+/// be stored as a member of the ThreadableFunctor, and `update()` called
+/// at the start of `operator()`. Because each child functor is copied from
+/// its parent, the full values are derived from the parent's in constant
+/// time, rather than requiring the walk to the root performed by
+/// ScenePlug::fullTransform() and ScenePlug::fullAttributes().
+class LocationAccumulator
+{
+
+	public :
+
+		enum Components
+		{
+			Transform = 1,
+			Attributes = 2,
+			All = Transform | Attributes
+		};
+
+		LocationAccumulator( unsigned components = All );
+
+		/// Must be called with the context scoped for `path`, as
+		/// is the case for ThreadableFunctor::operator(). The first
+		/// call computes the full values for `path` directly, and
+		/// subsequent calls (on copies) must be for its descendants.
+		void update( const ScenePlug *scene, const ScenePlug::ScenePath &path );
+
+		/// Equivalent to `scene->fullTransform( path )`.
+		const Imath::M44f &fullTransform() const;
+		/// Equivalent to `scene->fullAttributes( path )`. Descendants
+		/// without attributes of their own share the result of their
+		/// parent, so it must not be modified.
+		const IECore::CompoundObject *fullAttributes() const;
+
+	private :
+
+		unsigned m_components;
+		bool m_initialised;
+		Imath::M44f m_fullTransform;
+		IECore::ConstCompoundObjectPtr m_fullAttributes;
+
+};
 
 /// Calls a functor on all paths in the scene
-/// The functor must take ( const ScenePlug*, const ScenePlug::ScenePath& ), and can return false to prune traversal
+/// The functor must take ( const ScenePlug*, const ScenePlug::ScenePath& ), and can return false to prune traversal.
+/// The grainSize is as for parallelProcessLocations().
 template <class ThreadableFunctor>
-void parallelTraverse( const ScenePlug *scene, ThreadableFunctor &f );
+void parallelTraverse( const ScenePlug *scene, ThreadableFunctor &f, size_t grainSize = 0 );
 
 /// Calls a functor on all paths in the scene that are matched by the filter.
 /// The functor must take ( const ScenePlug*, const ScenePlug::ScenePath& ), and can return false to prune traversal
 template <class ThreadableFunctor>
 void filteredParallelTraverse( const ScenePlug *scene, const GafferScene::Filter *filter, ThreadableFunctor &f );
 /// As above, but specifying the filter as a plug - typically Filter::outPlug() or
-/// FilteredSceneProcessor::filterPlug() would be passed.
+/// FilteredSceneProcessor::filterPlug() would be passed. If the filter supports
+/// bulk evaluation, its matchingPathsPlug() is used in preference to evaluating
+/// the plug for every location.
 template <class ThreadableFunctor>
 void filteredParallelTraverse( const ScenePlug *scene, const Gaffer::IntPlug *filterPlug, ThreadableFunctor &f );
 /// As above, but using a PathMatcher as a filter.
@@ -35,6 +35,13 @@
 //////////////////////////////////////////////////////////////////////////
 
 #include "tbb/task.h"
+#include "tbb/task_scheduler_init.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "IECore/RefCounted.h"
+
 #include "Gaffer/Context.h"
 
 namespace GafferScene
@@ -43,127 +50,188 @@ namespace GafferScene
 namespace Detail
 {
 
-template <class ThreadableFunctor>
-class TraverseTask : public tbb::task
+// A location which has been processed by the functor, and which
+// has children still to be processed. This is shared between all
+// the tasks processing ranges of the children, and holds the
+// parent's functor so that it may be copied for each child. The
+// functor is moved in rather than copied, so that each location
+// costs only the one copy made for it from its parent.
+template<typename ThreadableFunctor>
+class ParentLocation : public IECore::RefCounted
 {
 
 	public :
 
-		TraverseTask(
-			const GafferScene::ScenePlug *scene,
-			const Gaffer::Context *context,
-			ThreadableFunctor &f
-		)
-			:	m_scene( scene ), m_context( context ), m_f( f )
-		{
-		}
-
-		~TraverseTask() override
+		ParentLocation( const ScenePlug::Location &location, ThreadableFunctor &&functor, const IECore::ConstInternedStringVectorDataPtr &childNames )
+			:	location( location ), functor( std::move( functor ) ), childNames( childNames )
 		{
 		}
 
-		task *execute() override
-		{
-			ScenePlug::PathScope pathScope( m_context, m_path );
-
-			if( m_f( m_scene, m_path ) )
-			{
-				IECore::ConstInternedStringVectorDataPtr childNamesData = m_scene->childNamesPlug()->getValue();
-				const std::vector<IECore::InternedString> &childNames = childNamesData->readable();
-
-				set_ref_count( 1 + childNames.size() );
+		const ScenePlug::Location location;
+		const ThreadableFunctor functor;
+		const IECore::ConstInternedStringVectorDataPtr childNames;
 
-				ScenePlug::ScenePath childPath = m_path;
-				childPath.push_back( IECore::InternedString() ); // space for the child name
-				for( std::vector<IECore::InternedString>::const_iterator it = childNames.begin(), eIt = childNames.end(); it != eIt; it++ )
-				{
-					childPath[m_path.size()] = *it;
-					TraverseTask *t = new( allocate_child() ) TraverseTask( *this, childPath );
-					spawn( *t );
-				}
-				wait_for_all();
-			}
-
-			return nullptr;
-		}
-
-	protected :
+};
 
-		TraverseTask( const TraverseTask &other, const ScenePlug::ScenePath &path )
-			:	m_scene( other.m_scene ),
-			m_context( other.m_context ),
-			m_f( other.m_f ),
-			m_path( path )
-		{
-		}
+// Calls the functor for the location, returning the child names if
+// the traversal should continue to children, and null otherwise.
+template<typename ThreadableFunctor>
+IECore::ConstInternedStringVectorDataPtr processLocation(
+	const GafferScene::ScenePlug *scene,
+	const Gaffer::Context *context,
+	const ScenePlug::Location &location,
+	ThreadableFunctor &f
+)
+{
+	// We use a Location rather than a ScenePath so that the
+	// path can be referenced by the context without copying,
+	// and its hash derived from that of our parent.
+	ScenePlug::PathScope pathScope( context, location );
 
-	private :
+	if( !f( scene, location.path() ) )
+	{
+		return nullptr;
+	}
 
-		const GafferScene::ScenePlug *m_scene;
-		const Gaffer::Context *m_context;
-		ThreadableFunctor &m_f;
-		GafferScene::ScenePlug::ScenePath m_path;
+	IECore::ConstInternedStringVectorDataPtr childNames = scene->childNamesPlug()->getValue();
+	if( childNames->readable().empty() )
+	{
+		return nullptr;
+	}
 
-};
+	return childNames;
+}
 
+// Processes a range of the children of a ParentLocation. Large ranges
+// are split recursively until they are no bigger than the grain size,
+// so that huge flat hierarchies are divided between threads without a
+// single task having to spawn a task for every child. The tasks use
+// continuation passing rather than `wait_for_all()`, so that no thread
+// is ever blocked waiting for the tasks below it, which would otherwise
+// leave cores idle in deep hierarchies.
 template<typename ThreadableFunctor>
-class LocationTask : public tbb::task
+class LocationRangeTask : public tbb::task
 {
 
 	public :
 
-		LocationTask(
+		typedef ParentLocation<ThreadableFunctor> Parent;
+		typedef boost::intrusive_ptr<Parent> ParentPtr;
+
+		LocationRangeTask(
 			const GafferScene::ScenePlug *scene,
 			const Gaffer::Context *context,
-			const ScenePlug::ScenePath &path,
-			ThreadableFunctor &f
+			const ParentPtr &parent,
+			size_t begin,
+			size_t end,
+			size_t grainSize
 		)
-			:	m_scene( scene ), m_context( context ), m_path( path ), m_f( f )
+			:	m_scene( scene ), m_context( context ), m_parent( parent ), m_begin( begin ), m_end( end ), m_grainSize( grainSize )
 		{
 		}
 
-		~LocationTask() override
+		~LocationRangeTask() override
 		{
 		}
 
 		task *execute() override
 		{
-			ScenePlug::PathScope pathScope( m_context, m_path );
+			if( m_end - m_begin > effectiveGrainSize() )
+			{
+				// Split, processing the second half in a new task
+				// and the first half by recycling ourselves.
+				tbb::empty_task *continuation = new( allocate_continuation() ) tbb::empty_task;
+				continuation->set_ref_count( 2 );
+				const size_t middle = m_begin + ( m_end - m_begin ) / 2;
+				LocationRangeTask *t = new( continuation->allocate_child() ) LocationRangeTask( m_scene, m_context, m_parent, middle, m_end, m_grainSize );
+				spawn( *t );
+				m_end = middle;
+				recycle_as_child_of( *continuation );
+				return this;
+			}
+
+			const std::vector<IECore::InternedString> &childNames = m_parent->childNames->readable();
 
-			if( !m_f( m_scene, m_path ) )
+			std::vector<ParentPtr> parents;
+			ScenePlug::Location childLocation;
+			for( size_t i = m_begin; i < m_end; ++i )
 			{
-				return nullptr;
+				ThreadableFunctor childFunctor( m_parent->functor );
+				// Reuses the path storage from the previous sibling,
+				// unless that was retained by a ParentLocation.
+				childLocation.setChild( m_parent->location, childNames[i] );
+				if( IECore::ConstInternedStringVectorDataPtr grandChildNames = processLocation( m_scene, m_context, childLocation, childFunctor ) )
+				{
+					parents.push_back( new Parent( childLocation, std::move( childFunctor ), grandChildNames ) );
+				}
 			}
 
-			IECore::ConstInternedStringVectorDataPtr childNamesData = m_scene->childNamesPlug()->getValue();
-			const std::vector<IECore::InternedString> &childNames = childNamesData->readable();
-			if( childNames.empty() )
+			if( parents.empty() )
 			{
 				return nullptr;
 			}
 
-			std::vector<ThreadableFunctor> childFunctors( childNames.size(), m_f );
-
-			set_ref_count( 1 + childNames.size() );
-
-			ScenePlug::ScenePath childPath = m_path;
-			childPath.push_back( IECore::InternedString() ); // space for the child name
-			for( size_t i = 0, e = childNames.size(); i < e; ++i )
+			tbb::empty_task *continuation = new( allocate_continuation() ) tbb::empty_task;
+			continuation->set_ref_count( parents.size() );
+			LocationRangeTask *first = nullptr;
+			for( typename std::vector<ParentPtr>::const_iterator it = parents.begin(), eIt = parents.end(); it != eIt; ++it )
 			{
-				childPath.back() = childNames[i];
-				LocationTask *t = new( allocate_child() ) LocationTask( m_scene, m_context, childPath, childFunctors[i] );
-				spawn( *t );
+				LocationRangeTask *t = new( continuation->allocate_child() ) LocationRangeTask( m_scene, m_context, *it, 0, (*it)->childNames->readable().size(), m_grainSize );
+				if( first )
+				{
+					spawn( *t );
+				}
+				else
+				{
+					first = t;
+				}
 			}
-			wait_for_all();
 
-			return nullptr;
+			// Bypass the scheduler and execute the first child immediately.
+			return first;
 		}
 
 	private :
 
+		size_t effectiveGrainSize() const
+		{
+			if( m_grainSize )
+			{
+				return m_grainSize;
+			}
+			// Automatic. Aim for several chunks per thread, so that
+			// load balancing can cope with uneven costs per location.
+			const size_t chunksPerParent = 4 * tbb::task_scheduler_init::default_num_threads();
+			return std::max<size_t>( 1, m_parent->childNames->readable().size() / chunksPerParent );
+		}
+
 		const GafferScene::ScenePlug *m_scene;
 		const Gaffer::Context *m_context;
-		const GafferScene::ScenePlug::ScenePath m_path;
+		const ParentPtr m_parent;
+		const size_t m_begin;
+		size_t m_end;
+		const size_t m_grainSize;
+
+};
+
+// Adaptor allowing the same functor to be shared by every location
+// for parallelTraverse().
+template<class ThreadableFunctor>
+struct SharedFunctor
+{
+
+	SharedFunctor( ThreadableFunctor &f )
+		:	m_f( f )
+	{
+	}
+
+	bool operator()( const GafferScene::ScenePlug *scene, const GafferScene::ScenePlug::ScenePath &path )
+	{
+		return m_f( scene, path );
+	}
+
+	private :
+
 		ThreadableFunctor &m_f;
 
 };
@@ -234,19 +302,32 @@ void parallelProcessLocations( const GafferScene::ScenePlug *scene, ThreadableFu
 }
 
 template <class ThreadableFunctor>
-void parallelProcessLocations( const GafferScene::ScenePlug *scene, ThreadableFunctor &f, const ScenePlug::ScenePath &root )
+void parallelProcessLocations( const GafferScene::ScenePlug *scene, ThreadableFunctor &f, const ScenePlug::ScenePath &root, size_t grainSize )
 {
 	FilterPlug::SceneScope sceneScope( Gaffer::Context::current(), scene );
-	Detail::LocationTask<ThreadableFunctor> *task = new( tbb::task::allocate_root() ) Detail::LocationTask<ThreadableFunctor>( scene, Gaffer::Context::current(), root, f );
+	const Gaffer::Context *context = Gaffer::Context::current();
+
+	typedef Detail::LocationRangeTask<ThreadableFunctor> Task;
+	const ScenePlug::Location rootLocation( root );
+	IECore::ConstInternedStringVectorDataPtr childNames = Detail::processLocation( scene, context, rootLocation, f );
+	if( !childNames )
+	{
+		return;
+	}
+
+	// The caller retains ownership of `f`, so we copy it
+	// for the children rather than moving it.
+	typename Task::ParentPtr parent = new typename Task::Parent( rootLocation, ThreadableFunctor( f ), childNames );
+
+	Task *task = new( tbb::task::allocate_root() ) Task( scene, context, parent, 0, parent->childNames->readable().size(), grainSize );
 	tbb::task::spawn_root_and_wait( *task );
 }
 
 template <class ThreadableFunctor>
-void parallelTraverse( const GafferScene::ScenePlug *scene, ThreadableFunctor &f )
+void parallelTraverse( const GafferScene::ScenePlug *scene, ThreadableFunctor &f, size_t grainSize )
 {
-	FilterPlug::SceneScope sceneScope( Gaffer::Context::current(), scene );
-	Detail::TraverseTask<ThreadableFunctor> *task = new( tbb::task::allocate_root() ) Detail::TraverseTask<ThreadableFunctor>( scene, Gaffer::Context::current(), f );
-	tbb::task::spawn_root_and_wait( *task );
+	Detail::SharedFunctor<ThreadableFunctor> sharedFunctor( f );
+	parallelProcessLocations( scene, sharedFunctor, ScenePlug::ScenePath(), grainSize );
 }
 
 template <class ThreadableFunctor>
@@ -258,6 +339,17 @@ void filteredParallelTraverse( const GafferScene::ScenePlug *scene, const Gaffer
 template <class ThreadableFunctor>
 void filteredParallelTraverse( const GafferScene::ScenePlug *scene, const Gaffer::IntPlug *filterPlug, ThreadableFunctor &f )
 {
+	if( const Filter *filter = Filter::matchingPathsFilter( filterPlug ) )
+	{
+		ConstPathMatcherDataPtr filterPaths;
+		{
+			FilterPlug::MatchingPathsScope matchingPathsScope( Gaffer::Context::current(), scene );
+			filterPaths = filter->matchingPathsPlug()->getValue();
+		}
+		filteredParallelTraverse( scene, filterPaths->readable(), f );
+		return;
+	}
+
 	Detail::ThreadableFilteredFunctor<ThreadableFunctor> ff( f, filterPlug );
 	parallelTraverse( scene, ff );
 }
@@ -130,14 +130,60 @@ class ScenePlug : public Gaffer::ValuePlug
 		/// computed in a Context.
 		static const IECore::InternedString setNameContextName;
 
+		/// Handle for a location in the scene, for use in performance
+		/// critical code which visits many locations, such as
+		/// SceneAlgo::parallelTraverse(). Stores the path along with its
+		/// context hash, which is computed incrementally from the parent
+		/// location, so that a PathScope may be made for the location
+		/// without copying or rehashing the path. Copies are cheap, as
+		/// they share the same storage. Constructing a child location
+		/// copies the parent's path, because the context requires the
+		/// full path as a single InternedStringVectorData, but `setChild()`
+		/// may be used to visit siblings without a copy for each one.
+		class Location
+		{
+
+			public :
+
+				/// The root location.
+				Location();
+				explicit Location( const ScenePath &path );
+				/// The child of `parent` called `childName`.
+				Location( const Location &parent, const IECore::InternedString &childName );
+
+				/// Makes this location the child of `parent` called `childName`.
+				/// If this location is already a child of `parent`, and its storage
+				/// isn't shared with any copies, the path is updated in place rather
+				/// than copied. Any PathScope referencing this location must then be
+				/// updated using `setPath()` before it is used again.
+				void setChild( const Location &parent, const IECore::InternedString &childName );
+
+				const ScenePath &path() const;
+
+				/// The path as stored in the context by PathScope, and
+				/// its hash, as returned by `Context::variableHash()`.
+				const IECore::InternedStringVectorData *pathData() const;
+				const IECore::MurmurHash &pathHash() const;
+
+			private :
+
+				IECore::ConstInternedStringVectorDataPtr m_pathData;
+				IECore::MurmurHash m_pathHash;
+
+		};
+
 		/// Utility class to scope a temporary copy of a context,
 		/// specifying the scene path.
 		struct PathScope : public Gaffer::Context::EditableScope
 		{
 			PathScope( const Gaffer::Context *context );
 			PathScope( const Gaffer::Context *context, const ScenePath &scenePath );
+			/// The path is referenced rather than copied, so `location`
+			/// must remain alive for the lifetime of the scope.
+			PathScope( const Gaffer::Context *context, const Location &location );
 
 			void setPath( const ScenePath &scenePath );
+			void setPath( const Location &location );
 		};
 
 		/// Utility class to scope a temporary copy of a context,
@@ -207,6 +253,47 @@ class ScenePlug : public Gaffer::ValuePlug
 		IECore::MurmurHash setHash( const IECore::InternedString &setName ) const;
 		//@}
 
+		/// @name Batched queries
+		/// These functions evaluate several properties of a location in
+		/// a single call, sharing one temporary Context between them. This
+		/// is cheaper than multiple calls to the convenience accessors above,
+		/// and allows the children of a location to be evaluated in parallel,
+		/// prefetching them for code which must then visit them serially.
+		////////////////////////////////////////////////////////////////////
+		//@{
+		enum LocationComponents
+		{
+			NoComponents = 0,
+			BoundComponent = 1,
+			TransformComponent = 2,
+			AttributesComponent = 4,
+			ObjectComponent = 8,
+			ChildNamesComponent = 16,
+			AllComponents = BoundComponent | TransformComponent | AttributesComponent | ObjectComponent | ChildNamesComponent
+		};
+
+		/// Holds the properties of a single location. Only the components
+		/// requested in the query are filled in, the others being left at
+		/// their default values.
+		struct LocationBundle
+		{
+			Imath::Box3f bound;
+			Imath::M44f transform;
+			IECore::ConstCompoundObjectPtr attributes;
+			IECore::ConstObjectPtr object;
+			IECore::ConstInternedStringVectorDataPtr childNames;
+		};
+
+		/// Evaluates the requested components at the specified location.
+		void locationBundle( const ScenePath &scenePath, unsigned components, LocationBundle &bundle ) const;
+		/// As above, but avoiding the cost of copying and hashing the path.
+		void locationBundle( const Location &location, unsigned components, LocationBundle &bundle ) const;
+		/// Evaluates the requested components at all children of the specified
+		/// location, returning one bundle per child in the order of `childNames()`.
+		/// Children are evaluated in parallel.
+		void childLocationBundles( const ScenePath &scenePath, unsigned components, std::vector<LocationBundle> &bundles ) const;
+		//@}
+
 		/// Utility function to convert a string into a path by splitting on '/'.
 		/// \todo Many of the places we use this, it would be preferable if the source data was already
 		/// a path. Perhaps a ScenePathPlug could take care of this for us?
@@ -74,12 +74,28 @@ class SceneReader : public SceneNode
 		Gaffer::StringPlug *tagsPlug();
 		const Gaffer::StringPlug *tagsPlug() const;
 
+		/// When on, the modification time of the file is checked
+		/// at most once a second, and the file is reloaded automatically
+		/// if it has changed on disk. This is off by default, because
+		/// of the overhead of querying the file system.
+		Gaffer::BoolPlug *refreshOnFileChangePlug();
+		const Gaffer::BoolPlug *refreshOnFileChangePlug() const;
+
 		void affects( const Gaffer::Plug *input, AffectedPlugsContainer &outputs ) const override;
 
 		static size_t supportedExtensions( std::vector<std::string> &extensions );
 
+		/// Returns the root of the specified file, from the cache shared by
+		/// all SceneReaders. This should be preferred to SharedSceneInterfaces
+		/// by code which accesses the same files, so that they are only opened
+		/// once, and are reloaded when a SceneReader is refreshed.
+		static IECore::ConstSceneInterfacePtr cachedScene( const std::string &fileName );
+
 	protected :
 
+		void hash( const Gaffer::ValuePlug *output, const Gaffer::Context *context, IECore::MurmurHash &h ) const override;
+		void compute( Gaffer::ValuePlug *output, const Gaffer::Context *context ) const override;
+
 		/// \todo These methods defer to SceneInterface::hash() to do most of the work, but we could go further.
 		/// Currently we still hash in fileNamePlug() and refreshCountPlug() because we don't trust the current
 		/// implementation of SceneCache::hash() - it should hash the filename and modification time, but instead
@@ -107,19 +123,37 @@ class SceneReader : public SceneNode
 
 		void plugSet( Gaffer::Plug *plug );
 
+		// Holds a CompoundData mapping from each tag in the file to a
+		// PathMatcherData containing all the tagged locations. This is built
+		// in a single parallel walk of the file, and depends only on the file
+		// name and refresh count, so is computed once and shared by all sets
+		// and by the tag filtering in computeChildNames().
+		Gaffer::ObjectPlug *tagIndexPlug();
+		const Gaffer::ObjectPlug *tagIndexPlug() const;
+		// Returns the tag index for the current file name.
+		IECore::ConstCompoundDataPtr tagIndex( const Gaffer::Context *context ) const;
+
+		// Appends the refresh count, and when refreshOnFileChangePlug()
+		// is on, the modification time of the file.
+		void hashRefresh( IECore::MurmurHash &h ) const;
+
 		// The typical access patterns for the SceneReader include accessing
 		// the same file repeatedly, and also the same path within the file
 		// repeatedly (to hash a value then compute it for instance, or to get
-		// the bound and then the object). We take advantage of that by storing
-		// the last accessed scene in thread local storage - we can then avoid
-		// the relatively expensive lookups necessary to find the appropriate
-		// SceneInterfacePtr for a query.
+		// the bound and then the object), or its parent or siblings (when
+		// traversing the scene). We take advantage of that by storing
+		// the last accessed location in thread local storage, along with all
+		// its ancestors - we can then avoid the relatively expensive lookups
+		// necessary to find the appropriate SceneInterfacePtr for a query,
+		// navigating from the closest cached ancestor instead of from the root.
 		struct LastScene
 		{
 			std::string fileName;
-			IECore::ConstSceneInterfacePtr fileNameScene;
+			std::time_t modificationTime;
 			ScenePlug::ScenePath path;
-			IECore::ConstSceneInterfacePtr pathScene;
+			// Holds path.size() + 1 entries, one for
+			// the root and one per element of path.
+			std::vector<IECore::ConstSceneInterfacePtr> ancestry;
 		};
 		mutable tbb::enumerable_thread_specific<LastScene> m_lastScene;
 		// Returns the SceneInterface for the current filename (in the current Context)
@@ -72,8 +72,10 @@ class SceneWriter : public GafferDispatch::TaskNode
 
 		void execute() const override;
 
-		/// Re-implemented to open the file for writing, then iterate through the
-		/// frames, modifying the current Context and calling writeLocation().
+		/// Re-implemented to open the file for writing, then traverse the scene,
+		/// computing all frames for each location in parallel. Data which is
+		/// static across all the frames is detected via its hash, and written
+		/// only once.
 		void executeSequence( const std::vector<float> &frames ) const override;
 
 		/// Re-implemented to return true, since the entire file must be written at once.
@@ -70,6 +70,7 @@ class SetFilter : public Filter
 		void affects( const Gaffer::Plug *input, AffectedPlugsContainer &outputs ) const override;
 
 		bool sceneAffectsMatch( const ScenePlug *scene, const Gaffer::ValuePlug *child ) const override;
+		bool canComputeMatchingPaths() const override;
 
 	protected :
 
@@ -79,6 +80,9 @@ class SetFilter : public Filter
 		void hashMatch( const ScenePlug *scene, const Gaffer::Context *context, IECore::MurmurHash &h ) const override;
 		unsigned computeMatch( const ScenePlug *scene, const Gaffer::Context *context ) const override;
 
+		void hashMatchingPaths( const ScenePlug *scene, const Gaffer::Context *context, IECore::MurmurHash &h ) const override;
+		ConstPathMatcherDataPtr computeMatchingPaths( const ScenePlug *scene, const Gaffer::Context *context ) const override;
+
 	private :
 
 		GafferScene::PathMatcherDataPlug *expressionResultPlug();
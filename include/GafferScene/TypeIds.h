@@ -144,6 +144,8 @@ enum TypeId
 	CollectScenesTypeId = 110599,
 	CapsuleTypeId = 110600,
 	EncapsulateTypeId = 110601,
+	MappedSceneReaderTypeId = 110602,
+	MappedSceneWriterTypeId = 110603,
 
 	PreviewGeometryTypeId = 110648,
 	PreviewProceduralTypeId = 110649,
@@ -55,11 +55,17 @@ class UnionFilter : public FilterProcessor
 
 		void affects( const Gaffer::Plug *input, AffectedPlugsContainer &outputs ) const override;
 
+		/// Returns true if all the connected filters support bulk evaluation.
+		bool canComputeMatchingPaths() const override;
+
 	protected :
 
 		void hashMatch( const ScenePlug *scene, const Gaffer::Context *context, IECore::MurmurHash &h ) const override;
 		unsigned computeMatch( const ScenePlug *scene, const Gaffer::Context *context ) const override;
 
+		void hashMatchingPaths( const ScenePlug *scene, const Gaffer::Context *context, IECore::MurmurHash &h ) const override;
+		ConstPathMatcherDataPtr computeMatchingPaths( const ScenePlug *scene, const Gaffer::Context *context ) const override;
+
 };
 
 IE_CORE_DECLAREPTR( UnionFilter )
@@ -44,6 +44,12 @@ void testPathMatcherRawIterator();
 void testPathMatcherIteratorPrune();
 void testPathMatcherFind();
 
+// Benchmarks
+void testPathMatcherAddPerformance();
+void testPathMatcherMatchPerformance();
+void testPathMatcherIteratorPerformance();
+void testPathMatcherAddPathsPerformance();
+
 } // namespace GafferSceneTest
 
 #endif // GAFFERSCENETEST_PATHMATCHERTEST_H
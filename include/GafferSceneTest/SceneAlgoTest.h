@@ -0,0 +1,57 @@
+//////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (c) 2018, Image Engine Design Inc. All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//
+//      * Redistributions of source code must retain the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer.
+//
+//      * Redistributions in binary form must reproduce the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer in the documentation and/or other materials provided with
+//        the distribution.
+//
+//      * Neither the name of John Haddon nor the names of
+//        any other contributors to this software may be used to endorse or
+//        promote products derived from this software without specific prior
+//        written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+//  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+//  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+//  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+//  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+//  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+//  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+//  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//////////////////////////////////////////////////////////////////////////
+
+#ifndef GAFFERSCENETEST_SCENEALGOTEST_H
+#define GAFFERSCENETEST_SCENEALGOTEST_H
+
+#include "GafferScene/ScenePlug.h"
+
+namespace GafferSceneTest
+{
+
+/// Traverses the scene using SceneAlgo::LocationAccumulator, asserting that the
+/// accumulated values match ScenePlug::fullTransform() and ScenePlug::fullAttributes().
+void testLocationAccumulator( const GafferScene::ScenePlug *scene );
+/// Traverses the scene using SceneAlgo::LocationAccumulator, touching the full
+/// transform and attributes at every location, for use in performance tests.
+void accumulateFullTransformsAndAttributes( const GafferScene::ScenePlug *scene );
+/// Traverses the scene using SceneAlgo::parallelTraverse(), restricted to at
+/// most `maxThreads` threads, for use in scaling benchmarks.
+void parallelTraverseWithThreads( const GafferScene::ScenePlug *scene, int maxThreads, size_t grainSize );
+
+} // namespace GafferSceneTest
+
+#endif // GAFFERSCENETEST_SCENEALGOTEST_H
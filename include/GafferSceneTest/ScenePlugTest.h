@@ -41,6 +41,9 @@ namespace GafferSceneTest
 {
 
 void testManyStringToPathCalls();
+void testLocationPathScope();
+void testLocationSetChild();
+void testManyPathScopes();
 
 } // namespace GafferSceneTest
 
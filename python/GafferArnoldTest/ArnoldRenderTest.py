@@ -940,6 +940,53 @@ class ArnoldRenderTest( GafferSceneTest.SceneTestCase ) :
 
 		self.assertRaisesRegexp( RuntimeError, "Render aborted", s["render"]["task"].execute )
 
+	def testDuplicatedObjectsShareShape( self ) :
+
+		s = Gaffer.ScriptNode()
+
+		s["sphere"] = GafferScene.Sphere()
+
+		s["duplicate"] = GafferScene.Duplicate()
+		s["duplicate"]["in"].setInput( s["sphere"]["out"] )
+		s["duplicate"]["target"].setValue( "/sphere" )
+		s["duplicate"]["transform"]["translate"]["x"].setValue( 2 )
+		s["duplicate"]["copies"].setValue( 100 )
+
+		s["options"] = GafferScene.StandardOptions()
+		s["options"]["in"].setInput( s["duplicate"]["out"] )
+
+		s["render"] = GafferArnold.ArnoldRender()
+		s["render"]["in"].setInput( s["options"]["out"] )
+		s["render"]["mode"].setValue( s["render"].Mode.SceneDescriptionMode )
+		s["render"]["fileName"].setValue( self.temporaryDirectory() + "/test.ass" )
+
+		for deformationBlur in ( False, True ) :
+
+			s["options"]["options"]["deformationBlur"]["enabled"].setValue( True )
+			s["options"]["options"]["deformationBlur"]["value"].setValue( deformationBlur )
+			s["render"]["task"].execute()
+
+			with IECoreArnold.UniverseBlock( writable = True ) :
+
+				arnold.AiASSLoad( self.temporaryDirectory() + "/test.ass" )
+
+				meshes = []
+				instances = []
+				iterator = arnold.AiUniverseGetNodeIterator( arnold.AI_NODE_SHAPE )
+				while not arnold.AiNodeIteratorFinished( iterator ) :
+					node = arnold.AiNodeIteratorGetNext( iterator )
+					nodeType = arnold.AiNodeEntryGetName( arnold.AiNodeGetNodeEntry( node ) )
+					if nodeType == "polymesh" :
+						meshes.append( node )
+					elif nodeType == "ginstance" :
+						instances.append( node )
+				arnold.AiNodeIteratorDestroy( iterator )
+
+				self.assertEqual( len( meshes ), 1 )
+				self.assertEqual( len( instances ), 101 )
+				for instance in instances :
+					self.assertEqual( arnold.AiNodeGetPtr( instance, "node" ), arnold.AiNodeGetPtr( instances[0], "node" ) )
+
 	def __arrayToSet( self, a ) :
 
 		result = set()
@@ -860,6 +860,57 @@ class RendererTest( GafferTest.TestCase ) :
 				"subdivAdaptiveObjectSpaceAttributes2",
 			)
 
+	def testPrototypeInstancing( self ) :
+
+		r = GafferScene.Private.IECoreScenePreview.Renderer.create(
+			"Arnold",
+			GafferScene.Private.IECoreScenePreview.Renderer.RenderType.SceneDescription,
+			self.temporaryDirectory() + "/test.ass"
+		)
+
+		plane = IECore.MeshPrimitive.createPlane( IECore.Box2f( IECore.V2f( -1 ), IECore.V2f( 1 ) ) )
+
+		# The prototype hash is provided by the client, and is used in
+		# preference to the hash of the object itself, so prototypes with
+		# matching hashes share a single shape.
+
+		h = IECore.MurmurHash()
+		h.append( "plane" )
+		prototype1 = GafferScene.Private.IECoreScenePreview.Renderer.Prototype( h, plane )
+		prototype2 = GafferScene.Private.IECoreScenePreview.Renderer.Prototype( h, plane.copy() )
+		self.assertEqual( prototype1.hash(), h )
+
+		h.append( "moving" )
+		movingPrototype = GafferScene.Private.IECoreScenePreview.Renderer.Prototype(
+			h, [ plane, plane.copy() ], [ 0, 1 ]
+		)
+
+		defaultAttributes = r.attributes( IECore.CompoundObject() )
+
+		r.instance( "plane1", prototype1, defaultAttributes )
+		r.instance( "plane2", prototype1, defaultAttributes )
+		r.instance( "plane3", prototype2, defaultAttributes )
+		r.instance( "movingPlane1", movingPrototype, defaultAttributes )
+		r.instance( "movingPlane2", movingPrototype, defaultAttributes )
+
+		r.render()
+		del defaultAttributes
+		del r
+
+		with IECoreArnold.UniverseBlock( writable = True ) :
+
+			arnold.AiASSLoad( self.temporaryDirectory() + "/test.ass" )
+
+			shapes = self.__allNodes( type = arnold.AI_NODE_SHAPE )
+			numInstances = len( [ s for s in shapes if arnold.AiNodeEntryGetName( arnold.AiNodeGetNodeEntry( s ) ) == "ginstance" ] )
+			numPolyMeshes = len( [ s for s in shapes if arnold.AiNodeEntryGetName( arnold.AiNodeGetNodeEntry( s ) ) == "polymesh" ] )
+
+			self.assertEqual( numPolyMeshes, 2 )
+			self.assertEqual( numInstances, 5 )
+
+			self.__assertInstanced( "plane1", "plane2", "plane3" )
+			self.__assertInstanced( "movingPlane1", "movingPlane2" )
+
 	def testTransformTypeAttribute( self ) :
 
 		r = GafferScene.Private.IECoreScenePreview.Renderer.create(
@@ -1867,6 +1918,58 @@ class RendererTest( GafferTest.TestCase ) :
 		# Check they both have names
 		self.assertTrue( all( [ arnold.AiNodeGetName( x ) for x in trueSpheres ] ) )
 
+	def testCapsules( self ) :
+
+		sphere = GafferScene.Sphere()
+
+		duplicate = GafferScene.Duplicate()
+		duplicate["in"].setInput( sphere["out"] )
+		duplicate["target"].setValue( "/sphere" )
+		duplicate["transform"]["translate"]["x"].setValue( 2 )
+		duplicate["copies"].setValue( 10 )
+
+		group = GafferScene.Group()
+		group["in"][0].setInput( duplicate["out"] )
+
+		pathFilter = GafferScene.PathFilter()
+		pathFilter["paths"].setValue( IECore.StringVectorData( [ "/group" ] ) )
+
+		encapsulate = GafferScene.Encapsulate()
+		encapsulate["in"].setInput( group["out"] )
+		encapsulate["filter"].setInput( pathFilter["out"] )
+
+		capsule = encapsulate["out"].object( "/group" )
+		self.assertIsInstance( capsule, GafferScene.Capsule )
+
+		# Procedurals aren't instanced in interactive renders, so each
+		# of these is expanded separately, with the second reusing the
+		# cached expansion of the first.
+
+		r = GafferScene.Private.IECoreScenePreview.Renderer.create(
+			"Arnold",
+			GafferScene.Private.IECoreScenePreview.Renderer.RenderType.Interactive
+		)
+
+		attributes = r.attributes( IECore.CompoundObject() )
+		capsule1 = r.object( "/capsule1", capsule, attributes )
+		capsule2 = r.object( "/capsule2", capsule.copy(), attributes )
+
+		procedurals = self.__allNodes( nodeEntryName = "procedural" )
+		self.assertEqual( len( procedurals ), 2 )
+
+		for procedural in procedurals :
+			for i in range( 0, 11 ) :
+				name = "/sphere" + ( str( i ) if i else "" )
+				instance = arnold.AiNodeLookUpByName( name, procedural )
+				self.assertEqual( arnold.AiNodeEntryGetName( arnold.AiNodeGetNodeEntry( instance ) ), "ginstance" )
+				self.assertEqual(
+					self.__m44f( arnold.AiNodeGetMatrix( instance, "matrix" ) ),
+					IECore.M44f().translate( IECore.V3f( 2 * i, 0, 0 ) )
+				)
+
+		del capsule1, capsule2, attributes
+		del r
+
 	@staticmethod
 	def __aovShaders() :
 		options = arnold.AiUniverseGetOptions()
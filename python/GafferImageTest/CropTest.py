@@ -268,5 +268,27 @@ class CropTest( GafferImageTest.ImageTestCase ) :
 		crop["area"]["min"].setValue( IECore.V2i( 20 ) )
 		self.assertTrue( GafferImage.BufferAlgo.empty( crop["out"]["dataWindow"].getValue() ) )
 
+	def testProxyScale( self ) :
+
+		constant = GafferImage.Constant()
+		constant["format"].setValue( GafferImage.Format( 200, 100 ) )
+
+		crop = GafferImage.Crop()
+		crop["in"].setInput( constant["out"] )
+		crop["areaSource"].setValue( GafferImage.Crop.AreaSource.Area )
+		crop["area"].setValue( IECore.Box2i( IECore.V2i( 10, 20 ), IECore.V2i( 110, 70 ) ) )
+
+		# The area is specified in full resolution pixels, so
+		# must be scaled in the same way as the input format.
+		with Gaffer.Context() as context :
+
+			GafferImage.FormatPlug.setProxyScale( context, 2 )
+			self.assertEqual( crop["out"]["format"].getValue().getDisplayWindow(), IECore.Box2i( IECore.V2i( 5, 10 ), IECore.V2i( 55, 35 ) ) )
+			self.assertEqual( crop["out"]["dataWindow"].getValue(), IECore.Box2i( IECore.V2i( 5, 10 ), IECore.V2i( 55, 35 ) ) )
+
+			crop["resetOrigin"].setValue( True )
+			self.assertEqual( crop["out"]["format"].getValue().getDisplayWindow(), IECore.Box2i( IECore.V2i( 0 ), IECore.V2i( 50, 25 ) ) )
+			self.assertEqual( crop["out"]["dataWindow"].getValue(), IECore.Box2i( IECore.V2i( 0 ), IECore.V2i( 50, 25 ) ) )
+
 if __name__ == "__main__":
 	unittest.main()
@@ -217,5 +217,63 @@ class FormatPlugTest( GafferImageTest.ImageTestCase ) :
 
 		self.assertEqual( len( allHashes ), 1 )
 
+	def testProxyScale( self ) :
+
+		constant = GafferImage.Constant()
+		constant["format"].setValue( GafferImage.Format( 1920, 1080 ) )
+
+		with Gaffer.Context() as context :
+
+			self.assertEqual( GafferImage.FormatPlug.getProxyScale( context ), 1 )
+			h = constant["out"]["format"].hash()
+
+			GafferImage.FormatPlug.setProxyScale( context, 2 )
+			self.assertEqual( GafferImage.FormatPlug.getProxyScale( context ), 2 )
+			self.assertEqual( constant["out"]["format"].getValue(), GafferImage.Format( 960, 540 ) )
+			self.assertNotEqual( constant["out"]["format"].hash(), h )
+
+			GafferImage.FormatPlug.setProxyScale( context, 1 )
+			self.assertFalse( "image:proxyScale" in context.keys() )
+			self.assertEqual( constant["out"]["format"].getValue(), GafferImage.Format( 1920, 1080 ) )
+			self.assertEqual( constant["out"]["format"].hash(), h )
+
+	def testProxyFormat( self ) :
+
+		f = GafferImage.Format( IECore.Box2i( IECore.V2i( -11, 10 ), IECore.V2i( 101, 201 ) ), 2 )
+		self.assertEqual( GafferImage.FormatPlug.proxyFormat( f, 1 ), f )
+		self.assertEqual(
+			GafferImage.FormatPlug.proxyFormat( f, 2 ),
+			GafferImage.Format( IECore.Box2i( IECore.V2i( -6, 5 ), IECore.V2i( 50, 100 ) ), 2 )
+		)
+		self.assertEqual(
+			GafferImage.FormatPlug.proxyFormat( GafferImage.Format( 3, 3 ), 4 ),
+			GafferImage.Format( 1, 1 )
+		)
+
+	def testProxyScaleThroughProcessors( self ) :
+
+		constant = GafferImage.Constant()
+		constant["format"].setValue( GafferImage.Format( 1920, 1080 ) )
+
+		offset = GafferImage.Offset()
+		offset["in"].setInput( constant["out"] )
+
+		resize = GafferImage.Resize()
+		resize["in"].setInput( offset["out"] )
+		resize["format"].setValue( GafferImage.Format( 1920, 1080 ) )
+
+		with Gaffer.Context() as context :
+
+			GafferImage.FormatPlug.setProxyScale( context, 2 )
+
+			# Formats passed through from upstream have already been
+			# scaled, and mustn't be scaled again.
+			self.assertEqual( offset["out"]["format"].getValue(), GafferImage.Format( 960, 540 ) )
+			self.assertEqual( offset["out"]["dataWindow"].getValue(), constant["out"]["dataWindow"].getValue() )
+
+			# Formats specified on a node are scaled just once.
+			self.assertEqual( resize["out"]["format"].getValue(), GafferImage.Format( 960, 540 ) )
+			self.assertEqual( resize["out"]["dataWindow"].getValue(), IECore.Box2i( IECore.V2i( 0 ), IECore.V2i( 960, 540 ) ) )
+
 if __name__ == "__main__":
 	unittest.main()
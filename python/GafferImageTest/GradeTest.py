@@ -246,3 +246,71 @@ class GradeTest( GafferImageTest.ImageTestCase ) :
 
 		sampler["channels"].setValue( IECore.StringVectorData( [ "B.R", "B.G", "B.B", "B.A" ] ) )
 		self.assertEqual( sampler["color"].getValue(), IECore.Color4f( 1 ) )
+
+	def testApproximateGamma( self ) :
+
+		i = GafferImage.ImageReader()
+		i["fileName"].setValue( self.checkerFile )
+
+		exact = GafferImage.Grade()
+		exact["in"].setInput( i["out"] )
+		exact["gamma"].setValue( IECore.Color4f( 2.2, 0.5, 3.0, 1.0 ) )
+		exact["gain"].setValue( IECore.Color4f( 1.5, 2.0, 0.5, 1.0 ) )
+		exact["offset"].setValue( IECore.Color4f( -0.1 ) )
+		exact["blackClamp"].setValue( False )
+
+		approximate = GafferImage.Grade()
+		approximate["in"].setInput( i["out"] )
+		for name in ( "gamma", "gain", "offset", "blackClamp" ) :
+			approximate[name].setInput( exact[name] )
+		approximate["approximateGamma"].setValue( True )
+
+		self.assertNotEqual(
+			exact["out"].channelDataHash( "R", IECore.V2i( 0 ) ),
+			approximate["out"].channelDataHash( "R", IECore.V2i( 0 ) )
+		)
+		self.assertImagesEqual( exact["out"], approximate["out"], maxDifference = 1e-5 )
+
+	def testApproximateGammaWithExtremeExponent( self ) :
+
+		# The largest float below 1 makes the result of the gamma
+		# very sensitive to any error in the approximation.
+		c = GafferImage.Constant()
+		c["color"].setValue( IECore.Color4f( 1 - 2 ** -23, 1 - 2 ** -23, 0.5, 1 ) )
+
+		exact = GafferImage.Grade()
+		exact["in"].setInput( c["out"] )
+		exact["gamma"].setValue( IECore.Color4f( 1e-7, 2e-7, 1e-7, 1 ) )
+
+		approximate = GafferImage.Grade()
+		approximate["in"].setInput( c["out"] )
+		approximate["gamma"].setInput( exact["gamma"] )
+		approximate["approximateGamma"].setValue( True )
+
+		# An inverse gamma of 1e7 is beyond the range fastPow()
+		# supports, so the exact pow() must be used instead.
+		self.assertGreater( exact["out"].channelData( "R", IECore.V2i( 0 ) )[0], 0.25 )
+		self.assertImagesEqual( exact["out"], approximate["out"], maxDifference = 1e-5 )
+
+	def testPerformance( self ) :
+
+		# Grades a 4K frame with and without the approximate gamma.
+		# Uncomment the prints to get useful timing information.
+
+		c = GafferImage.Constant()
+		c["format"].setValue( GafferImage.Format( 4096, 2160, 1.0 ) )
+		c["color"].setValue( IECore.Color4f( 0.25, 0.5, 0.75, 1 ) )
+
+		g = GafferImage.Grade()
+		g["in"].setInput( c["out"] )
+		g["gamma"].setValue( IECore.Color4f( 2.2 ) )
+
+		t = IECore.Timer()
+		GafferImageTest.processTiles( g["out"] )
+		#print "EXACT", t.stop()
+
+		g["approximateGamma"].setValue( True )
+
+		t = IECore.Timer()
+		GafferImageTest.processTiles( g["out"] )
+		#print "APPROXIMATE", t.stop()
@@ -173,5 +173,23 @@ class OffsetTest( GafferImageTest.ImageTestCase ) :
 
 		self.assertTrue( o["out"]["dataWindow"] in { x[0] for x in cs } )
 
+	def testProxyScale( self ) :
+
+		c = GafferImage.Constant()
+		c["format"].setValue( GafferImage.Format( 100, 100 ) )
+
+		o = GafferImage.Offset()
+		o["in"].setInput( c["out"] )
+		o["offset"].setValue( IECore.V2i( 4, 6 ) )
+
+		self.assertEqual( o["out"]["dataWindow"].getValue(), IECore.Box2i( IECore.V2i( 4, 6 ), IECore.V2i( 104, 106 ) ) )
+
+		# The offset is specified in full resolution pixels,
+		# so must be scaled along with the input.
+		with Gaffer.Context() as context :
+			GafferImage.FormatPlug.setProxyScale( context, 2 )
+			self.assertEqual( o["out"]["dataWindow"].getValue(), IECore.Box2i( IECore.V2i( 2, 3 ), IECore.V2i( 52, 53 ) ) )
+			self.assertEqual( o["out"].channelData( "R", IECore.V2i( 0 ) )[3*64+2], c["out"].channelData( "R", IECore.V2i( 0 ) )[0] )
+
 if __name__ == "__main__":
 	unittest.main()
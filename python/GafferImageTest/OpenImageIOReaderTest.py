@@ -111,6 +111,87 @@ class OpenImageIOReaderTest( GafferImageTest.ImageTestCase ) :
 		image2.blindData().clear()
 		self.assertEqual( image, image2 )
 
+	def testProxyScale( self ) :
+
+		n = GafferImage.OpenImageIOReader()
+		n["fileName"].setValue( self.fileName )
+		fullImage = n["out"].image()
+
+		with Gaffer.Context() as context :
+
+			GafferImage.FormatPlug.setProxyScale( context, 2 )
+			self.assertEqual( n["out"]["format"].getValue().getDisplayWindow(), IECore.Box2i( IECore.V2i( 0 ), IECore.V2i( 100, 75 ) ) )
+			self.assertEqual( n["out"]["dataWindow"].getValue(), IECore.Box2i( IECore.V2i( 0 ), IECore.V2i( 100, 75 ) ) )
+			proxyImage = n["out"].image()
+
+		# Without MIP levels in the file, each proxy pixel should
+		# be the average of the corresponding full resolution pixels.
+		for x, y in [ ( 0, 0 ), ( 10, 20 ), ( 99, 74 ) ] :
+			expected = sum( fullImage["R"][(2*y+j)*200 + 2*x+i] for i in ( 0, 1 ) for j in ( 0, 1 ) ) / 4.0
+			self.assertAlmostEqual( proxyImage["R"][y*100+x], expected, places = 5 )
+
+	def testProxyScaleWithOddSizes( self ) :
+
+		# Crop to odd dimensions, so that dividing the height
+		# in EXR space would differ from dividing in Gaffer space.
+		r = GafferImage.OpenImageIOReader()
+		r["fileName"].setValue( self.fileName )
+
+		c = GafferImage.Crop()
+		c["in"].setInput( r["out"] )
+		c["area"].setValue( IECore.Box2i( IECore.V2i( 0 ), IECore.V2i( 101, 75 ) ) )
+
+		w = GafferImage.ImageWriter()
+		w["in"].setInput( c["out"] )
+		w["fileName"].setValue( os.path.join( self.temporaryDirectory(), "odd.exr" ) )
+		w["task"].execute()
+
+		self.__assertProxyScaleMatchesFullResolution( w["fileName"].getValue() )
+
+	def testProxyScaleWithNonZeroOrigins( self ) :
+
+		self.__assertProxyScaleMatchesFullResolution( self.negativeDataWindowFileName )
+		self.__assertProxyScaleMatchesFullResolution( self.negativeDisplayWindowFileName )
+
+	def __assertProxyScaleMatchesFullResolution( self, fileName, scales = ( 2, 3 ) ) :
+
+		n = GafferImage.OpenImageIOReader()
+		n["fileName"].setValue( fileName )
+
+		fullFormat = n["out"]["format"].getValue()
+		fullDataWindow = n["out"]["dataWindow"].getValue()
+		fullSampler = GafferImage.Sampler( n["out"], "R", fullDataWindow, GafferImage.Sampler.BoundingMode.Black )
+
+		for scale in scales :
+
+			with Gaffer.Context() as context :
+
+				GafferImage.FormatPlug.setProxyScale( context, scale )
+
+				self.assertEqual( n["out"]["format"].getValue(), GafferImage.FormatPlug.proxyFormat( fullFormat, scale ) )
+
+				dataWindow = n["out"]["dataWindow"].getValue()
+				self.assertEqual(
+					dataWindow,
+					IECore.Box2i(
+						IECore.V2i( fullDataWindow.min.x // scale, fullDataWindow.min.y // scale ),
+						IECore.V2i( ( fullDataWindow.max.x - 1 ) // scale + 1, ( fullDataWindow.max.y - 1 ) // scale + 1 ),
+					)
+				)
+
+				proxySampler = GafferImage.Sampler( n["out"], "R", dataWindow, GafferImage.Sampler.BoundingMode.Black )
+
+				# Each proxy pixel should be the average of the full
+				# resolution pixels it covers, including those at the
+				# edges of the data window.
+				for x in ( dataWindow.min.x, ( dataWindow.min.x + dataWindow.max.x ) // 2, dataWindow.max.x - 1 ) :
+					for y in ( dataWindow.min.y, ( dataWindow.min.y + dataWindow.max.y ) // 2, dataWindow.max.y - 1 ) :
+						expected = sum(
+							fullSampler.sample( scale * x + i, scale * y + j )
+							for i in range( 0, scale ) for j in range( 0, scale )
+						) / float( scale * scale )
+						self.assertAlmostEqual( proxySampler.sample( x, y ), expected, places = 5 )
+
 	def testNegativeDisplayWindowRead( self ) :
 
 		n = GafferImage.OpenImageIOReader()
@@ -204,5 +204,41 @@ class TextTest( GafferImageTest.ImageTestCase ) :
 
 		self.assertNotEqual( shadowTile, tile )
 
+	def testIntegerTranslation( self ) :
+
+		# Glyphs are cached independently of the whole-pixel part of
+		# their translation, so translating by whole tiles should give
+		# identical tiles.
+
+		text1 = GafferImage.Text()
+		text1["text"].setValue( "Hello\nWorld" )
+
+		text2 = GafferImage.Text()
+		text2["text"].setInput( text1["text"] )
+		text2["transform"]["translate"].setValue( IECore.V2f( GafferImage.ImagePlug.tileSize() ) )
+
+		dataWindow1 = text1["out"]["dataWindow"].getValue()
+		dataWindow2 = text2["out"]["dataWindow"].getValue()
+		offset = IECore.V2i( GafferImage.ImagePlug.tileSize() )
+		self.assertEqual( dataWindow2, IECore.Box2i( dataWindow1.min + offset, dataWindow1.max + offset ) )
+
+		tileOrigin = GafferImage.ImagePlug.tileOrigin( dataWindow1.min )
+		self.assertEqual(
+			text1["out"].channelData( "A", tileOrigin ),
+			text2["out"].channelData( "A", tileOrigin + offset ),
+		)
+
+	def testRepeatedText( self ) :
+
+		text1 = GafferImage.Text()
+		text1["text"].setValue( "aaaa bbbb aaaa" )
+
+		text2 = GafferImage.Text()
+		text2["text"].setInput( text1["text"] )
+
+		# Evaluating the second node will reuse the cached layout
+		# and glyphs from the first, and must give identical results.
+		self.assertImagesEqual( text1["out"], text2["out"] )
+
 if __name__ == "__main__":
 	unittest.main()
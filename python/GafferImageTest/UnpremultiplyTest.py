@@ -115,3 +115,17 @@ class UnpremultiplyTest( GafferImageTest.ImageTestCase ) :
 						self.assertEqual( result, color[channelName] )
 					else:
 						self.assertEqual( result, color[channelName] / color[alphaChannelName] )
+
+	def testDivideByInexactAlpha( self ) :
+
+		# Unpremultiply multiplies by a shared reciprocal of the alpha,
+		# which need not be exactly representable.
+
+		c = GafferImage.Constant()
+		c["color"].setValue( IECore.Color4f( 0.1, 0.2, 0.3, 0.3 ) )
+
+		u = GafferImage.Unpremultiply()
+		u["in"].setInput( c["out"] )
+
+		for channelName, expected in ( ( "R", 0.1 / 0.3 ), ( "G", 0.2 / 0.3 ), ( "B", 1.0 ) ) :
+			self.assertAlmostEqual( u["out"].channelData( channelName, IECore.V2i( 0 ) )[0], expected, places = 6 )
@@ -213,5 +213,106 @@ class VectorWarpTest( GafferImageTest.ImageTestCase ) :
 		self.assertImagesEqual( vectorWarp["out"], expectedReader["out"], maxDifference = 0.0005, ignoreMetadata = True )
 
 
+	def testScatteredInput( self ) :
+
+		# Each tile of the vector image addresses two widely separated
+		# regions of the input, so the warp's input bound for each tile is
+		# large. Check that we still sample correctly.
+
+		reader = GafferImage.ImageReader()
+		reader["fileName"].setValue( os.path.dirname( __file__ ) + "/images/checker.exr" )
+
+		texture = GafferImage.Resize()
+		texture["in"].setInput( reader["out"] )
+		texture["format"].setValue( GafferImage.Format( 1024, 1024 ) )
+		texture["fitMode"].setValue( GafferImage.Resize.FitMode.Distort )
+
+		size = IECore.V2i( 64 )
+		w = IECore.Box2i( IECore.V2i( 0 ), size - IECore.V2i( 1 ) )
+		vectorImage = IECoreImage.ImagePrimitive( w, w )
+		R = IECore.FloatVectorData( size.x * size.y )
+		G = IECore.FloatVectorData( size.x * size.y )
+		for iy in range( size.y ) :
+			for ix in range( size.x ) :
+				R[ iy * size.x + ix ] = 100.5 if ix % 2 == 0 else 900.5
+				G[ iy * size.x + ix ] = 200.5 if ix % 2 == 0 else 800.5
+		vectorImage["R"] = R
+		vectorImage["G"] = G
+
+		vector = GafferImage.ObjectToImage()
+		vector["object"].setValue( vectorImage )
+
+		vectorWarp = GafferImage.VectorWarp()
+		vectorWarp["in"].setInput( texture["out"] )
+		vectorWarp["vector"].setInput( vector["out"] )
+		vectorWarp["vectorMode"].setValue( GafferImage.VectorWarp.VectorMode.Absolute )
+		vectorWarp["vectorUnits"].setValue( GafferImage.VectorWarp.VectorUnits.Pixels )
+		vectorWarp["useDerivatives"].setValue( False )
+		vectorWarp["filter"].setValue( "box" )
+
+		textureSampler = GafferImage.ImageSampler()
+		textureSampler["image"].setInput( texture["out"] )
+
+		warpSampler = GafferImage.ImageSampler()
+		warpSampler["image"].setInput( vectorWarp["out"] )
+
+		for warpPixel, texturePixel in (
+			( IECore.V2f( 0.5, 0.5 ), IECore.V2f( 100.5, 200.5 ) ),
+			( IECore.V2f( 1.5, 0.5 ), IECore.V2f( 900.5, 800.5 ) ),
+			( IECore.V2f( 32.5, 40.5 ), IECore.V2f( 100.5, 200.5 ) ),
+			( IECore.V2f( 63.5, 63.5 ), IECore.V2f( 900.5, 800.5 ) ),
+		) :
+			warpSampler["pixel"].setValue( warpPixel )
+			textureSampler["pixel"].setValue( texturePixel )
+			self.assertEqual( warpSampler["color"].getValue(), textureSampler["color"].getValue() )
+
+	def testPerformance( self ) :
+
+		# Applies a smoothly varying STMap to a 4K image.
+		# Uncomment the print to get useful timing information.
+
+		reader = GafferImage.ImageReader()
+		reader["fileName"].setValue( os.path.dirname( __file__ ) + "/images/checker.exr" )
+
+		texture = GafferImage.Resize()
+		texture["in"].setInput( reader["out"] )
+		texture["format"].setValue( GafferImage.Format( 4096, 2160, 1.0 ) )
+		texture["fitMode"].setValue( GafferImage.Resize.FitMode.Distort )
+
+		size = IECore.V2i( 64 )
+		w = IECore.Box2i( IECore.V2i( 0 ), size - IECore.V2i( 1 ) )
+		stMapImage = IECoreImage.ImagePrimitive( w, w )
+		R = IECore.FloatVectorData( size.x * size.y )
+		G = IECore.FloatVectorData( size.x * size.y )
+		for iy in range( size.y ) :
+			for ix in range( size.x ) :
+				x = ( ix + 0.5 ) / size.x
+				y = 1 - ( iy + 0.5 ) / size.y
+				R[ iy * size.x + ix ] = x + 0.05 * math.sin( y * 8 )
+				G[ iy * size.x + ix ] = y + 0.05 * math.sin( x * 8 )
+		stMapImage["R"] = R
+		stMapImage["G"] = G
+
+		stMapSource = GafferImage.ObjectToImage()
+		stMapSource["object"].setValue( stMapImage )
+
+		stMap = GafferImage.Resize()
+		stMap["in"].setInput( stMapSource["out"] )
+		stMap["format"].setValue( GafferImage.Format( 4096, 2160, 1.0 ) )
+		stMap["fitMode"].setValue( GafferImage.Resize.FitMode.Distort )
+
+		vectorWarp = GafferImage.VectorWarp()
+		vectorWarp["in"].setInput( texture["out"] )
+		vectorWarp["vector"].setInput( stMap["out"] )
+
+		# Compute the inputs up front, so we time only the warp.
+		GafferImageTest.processTiles( texture["out"] )
+		GafferImageTest.processTiles( stMap["out"] )
+
+		t = IECore.Timer()
+		GafferImageTest.processTiles( vectorWarp["out"] )
+		#print "VECTORWARP 4K", t.stop()
+
+
 if __name__ == "__main__":
 	unittest.main()
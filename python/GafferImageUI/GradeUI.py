@@ -146,6 +146,19 @@ Gaffer.Metadata.registerNode(
 
 		],
 
+		"approximateGamma" : [
+
+			"description",
+			"""
+			Uses a fast approximation when applying the gamma,
+			rather than an exact power function. The relative
+			error is small enough to be invisible in practice,
+			but the result may differ very slightly from that
+			of the exact calculation.
+			""",
+
+		],
+
 	}
 
 )
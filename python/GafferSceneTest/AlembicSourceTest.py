@@ -151,5 +151,72 @@ class AlembicSourceTest( GafferSceneTest.SceneTestCase ) :
 
 		self.assertRaises( RuntimeError, a["out"].childNames, "/" )
 
+		# Hashing doesn't need to read the file successfully,
+		# so errors are reported by the compute alone.
+		a["out"].objectHash( "/" )
+		a["out"].transformHash( "/" )
+		self.assertRaises( RuntimeError, a["out"].object, "/" )
+
+	def testStaticHashesIndependentOfTime( self ) :
+
+		a = GafferScene.AlembicSource()
+		a["fileName"].setValue( os.path.dirname( __file__ ) + "/alembicFiles/cube.abc" )
+
+		for path in ( "/group1", "/group1/pCube1", "/group1/pCube1/pCubeShape1" ) :
+			hashes = set()
+			for frame in ( 1, 1.5, 10, 100 ) :
+				with Gaffer.Context() as c :
+					c.setFrame( frame )
+					hashes.add( ( a["out"].objectHash( path ), a["out"].transformHash( path ) ) )
+			self.assertEqual( len( hashes ), 1 )
+
+	def testSamples( self ) :
+
+		a = GafferScene.AlembicSource()
+		a["fileName"].setValue( os.path.dirname( __file__ ) + "/alembicFiles/animatedCube.abc" )
+
+		b = IECoreAlembic.AlembicInput( os.path.dirname( __file__ ) + "/alembicFiles/animatedCube.abc" )
+		c = b.child( "pCube1" ).child( "pCubeShape1" )
+
+		for i in range( 0, c.numSamples() ) :
+
+			# Times that fall on a sample should read that sample directly,
+			# and share the results of all other such times.
+			time = c.timeAtSample( i )
+			with Gaffer.Context() as context :
+				context.setTime( time )
+				self.assertEqual( a["out"].object( "/pCube1/pCubeShape1" ), c.objectAtSample( i ) )
+				h = a["out"].objectHash( "/pCube1/pCubeShape1" )
+				context.setTime( time + 0.00001 )
+				self.assertEqual( a["out"].objectHash( "/pCube1/pCubeShape1" ), h )
+
+			# Times between samples must be interpolated.
+			if i < c.numSamples() - 1 :
+				time = ( c.timeAtSample( i ) + c.timeAtSample( i + 1 ) ) / 2.0
+				with Gaffer.Context() as context :
+					context.setTime( time )
+					self.assertEqual( a["out"].object( "/pCube1/pCubeShape1" ), c.objectAtTime( context.getTime() ) )
+
+	def testTraversalPerformance( self ) :
+
+		a = GafferScene.AlembicSource()
+		a["fileName"].setValue( os.path.dirname( __file__ ) + "/alembicFiles/animatedCube.abc" )
+
+		b = IECoreAlembic.AlembicInput( a["fileName"].getValue() )
+		startTime = b.timeAtSample( 0 )
+		endTime = b.timeAtSample( b.numSamples() - 1 )
+
+		for threads in ( 1, 8, 32 ) :
+
+			Gaffer.ValuePlug.clearCache()
+			a["refreshCount"].setValue( a["refreshCount"].getValue() + 1 )
+
+			t = IECore.Timer()
+			with Gaffer.Context() as c :
+				for i in range( 0, 100 ) :
+					c.setTime( startTime + ( endTime - startTime ) * i / 99.0 )
+					GafferSceneTest.parallelTraverseWithThreads( a["out"], threads )
+			#print threads, t.stop()
+
 if __name__ == "__main__":
 	unittest.main()
@@ -38,11 +38,14 @@ import inspect
 import unittest
 
 import IECore
+import IECoreGL
 
 import Gaffer
 import GafferScene
 import GafferSceneTest
 
+IECoreGL.init( False )
+
 class CapsuleTest( GafferSceneTest.SceneTestCase ) :
 
 	def test( self ) :
@@ -84,5 +87,59 @@ class CapsuleTest( GafferSceneTest.SceneTestCase ) :
 		self.assertRaisesRegexp( RuntimeError, "Capsule has expired", capsuleCopy.hash )
 		self.assertRaisesRegexp( RuntimeError, "Capsule has expired", capsuleCopy.bound )
 
+	def testExpansionIsCached( self ) :
+
+		sphere = GafferScene.Sphere()
+
+		h = IECore.MurmurHash()
+		for path in ( "/", "/sphere" ) :
+			for method in ( "boundHash", "transformHash", "objectHash", "attributesHash" ) :
+				h.append( getattr( sphere["out"], method )( path ) )
+
+		capsule = GafferScene.Capsule(
+			sphere["out"],
+			"/",
+			Gaffer.Context(),
+			h,
+			sphere["out"].bound( "/" )
+		)
+
+		GafferScene.Capsule.clearExpansionCache()
+		Gaffer.ValuePlug.clearCache()
+
+		with Gaffer.PerformanceMonitor() as m :
+			capsule.render( GafferScene.Private.IECoreScenePreview.Renderer.create( "OpenGL" ) )
+
+		self.assertEqual( m.plugStatistics( sphere["out"]["object"] ).computeCount, 1 )
+		self.assertGreater( GafferScene.Capsule.expansionCacheMemoryUsage(), 0 )
+
+		# Rendering again must reuse the cached expansion rather than
+		# traversing the scene, even when the compute cache is empty.
+
+		Gaffer.ValuePlug.clearCache()
+		with Gaffer.PerformanceMonitor() as m :
+			capsule.render( GafferScene.Private.IECoreScenePreview.Renderer.create( "OpenGL" ) )
+
+		self.assertEqual( m.plugStatistics( sphere["out"]["object"] ).computeCount, 0 )
+
+		# Until the expansion cache is cleared.
+
+		GafferScene.Capsule.clearExpansionCache()
+		self.assertEqual( GafferScene.Capsule.expansionCacheMemoryUsage(), 0 )
+
+		Gaffer.ValuePlug.clearCache()
+		with Gaffer.PerformanceMonitor() as m :
+			capsule.render( GafferScene.Private.IECoreScenePreview.Renderer.create( "OpenGL" ) )
+
+		self.assertEqual( m.plugStatistics( sphere["out"]["object"] ).computeCount, 1 )
+
+	def testExpansionCacheMemoryLimit( self ) :
+
+		limit = GafferScene.Capsule.getExpansionCacheMemoryLimit()
+		self.addCleanup( GafferScene.Capsule.setExpansionCacheMemoryLimit, limit )
+
+		GafferScene.Capsule.setExpansionCacheMemoryLimit( 1024 )
+		self.assertEqual( GafferScene.Capsule.getExpansionCacheMemoryLimit(), 1024 )
+
 if __name__ == "__main__":
 	unittest.main()
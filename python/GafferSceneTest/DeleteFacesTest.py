@@ -103,3 +103,72 @@ class DeleteFacesTest( GafferSceneTest.SceneTestCase ) :
 		expectedBoundingBox = IECore.Box3f( IECore.V3f( 0, 0, 0 ), IECore.V3f( 1, 1, 0 ) )
 
 		self.assertEqual( actualFaceDeletedBounds, expectedBoundingBox )
+
+	def __planeScene( self, divisions ) :
+
+		mesh = IECore.MeshPrimitive.createPlane( IECore.Box2f( IECore.V2f( -1 ), IECore.V2f( 1 ) ), IECore.V2i( divisions ) )
+		mesh["deleteFaces"] = IECore.PrimitiveVariable(
+			IECore.PrimitiveVariable.Interpolation.Uniform,
+			IECore.IntVectorData( [ 1 if i % 3 == 0 or ( i / divisions ) % 2 else 0 for i in range( 0, mesh.numFaces() ) ] )
+		)
+		mesh["uniform"] = IECore.PrimitiveVariable( IECore.PrimitiveVariable.Interpolation.Uniform, IECore.IntVectorData( range( 0, mesh.numFaces() ) ) )
+		mesh["constant"] = IECore.PrimitiveVariable( IECore.PrimitiveVariable.Interpolation.Constant, IECore.StringData( "test" ) )
+
+		objectToScene = GafferScene.ObjectToScene()
+		objectToScene["object"].setValue( mesh )
+
+		return objectToScene
+
+	def testParallelMatchesSerial( self ) :
+
+		planeScene = self.__planeScene( 20 )
+
+		pathFilter = GafferScene.PathFilter()
+		pathFilter["paths"].setValue( IECore.StringVectorData( [ "/object" ] ) )
+
+		deleteFaces = GafferScene.DeleteFaces()
+		deleteFaces["in"].setInput( planeScene["out"] )
+		deleteFaces["filter"].setInput( pathFilter["out"] )
+
+		self.assertFalse( deleteFaces["parallel"].getValue() )
+		deleteFaces["parallel"].setValue( True )
+		parallelObject = deleteFaces["out"].object( "/object" )
+		parallelHash = deleteFaces["out"].objectHash( "/object" )
+
+		deleteFaces["parallel"].setValue( False )
+		serialObject = deleteFaces["out"].object( "/object" )
+		self.assertNotEqual( deleteFaces["out"].objectHash( "/object" ), parallelHash )
+
+		self.assertTrue( parallelObject.arePrimitiveVariablesValid() )
+		self.assertLess( parallelObject.numFaces(), planeScene["out"].object( "/object" ).numFaces() )
+		self.assertEqual( parallelObject.verticesPerFace, serialObject.verticesPerFace )
+		self.assertEqual( parallelObject.vertexIds, serialObject.vertexIds )
+		self.assertEqual( sorted( parallelObject.keys() ), sorted( serialObject.keys() ) )
+		for name in parallelObject.keys() :
+			self.assertEqual( parallelObject[name].interpolation, serialObject[name].interpolation )
+			self.assertEqual( parallelObject[name].data, serialObject[name].data )
+
+	def testPerformance( self ) :
+
+		planeScene = self.__planeScene( 100 )
+
+		pathFilter = GafferScene.PathFilter()
+		pathFilter["paths"].setValue( IECore.StringVectorData( [ "/object" ] ) )
+
+		deleteFaces = GafferScene.DeleteFaces()
+		deleteFaces["in"].setInput( planeScene["out"] )
+		deleteFaces["filter"].setInput( pathFilter["out"] )
+
+		planeScene["out"].object( "/object" )
+
+		deleteFaces["parallel"].setValue( True )
+
+		t = IECore.Timer()
+		deleteFaces["out"].object( "/object" )
+		#print "PARALLEL", t.stop()
+
+		deleteFaces["parallel"].setValue( False )
+
+		t = IECore.Timer()
+		deleteFaces["out"].object( "/object" )
+		#print "SERIAL", t.stop()
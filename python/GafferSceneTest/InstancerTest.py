@@ -546,5 +546,271 @@ class InstancerTest( GafferSceneTest.SceneTestCase ) :
 				c.setFrame( i )
 				dispatcher.dispatch( [ script["pythonCommand"] ] )
 
+	def testApproximateBounds( self ) :
+
+		script = Gaffer.ScriptNode()
+
+		script["plane"] = GafferScene.Plane()
+		script["plane"]["divisions"].setValue( IECore.V2i( 10 ) )
+
+		script["sphere"] = GafferScene.Sphere()
+
+		script["instancer"] = GafferScene.Instancer()
+		script["instancer"]["in"].setInput( script["plane"]["out"] )
+		script["instancer"]["instance"].setInput( script["sphere"]["out"] )
+		script["instancer"]["parent"].setValue( "/plane" )
+
+		exactBound = script["instancer"]["out"].bound( "/plane/instances" )
+		exactHash = script["instancer"]["out"].boundHash( "/plane/instances" )
+
+		self.assertTrue( script["instancer"]["out"]["bound"] in script["instancer"].affects( script["instancer"]["approximateBounds"] ) )
+
+		# Identical instances, so the approximation is exact.
+
+		script["instancer"]["approximateBounds"].setValue( True )
+		self.assertNotEqual( script["instancer"]["out"].boundHash( "/plane/instances" ), exactHash )
+		self.assertEqual( script["instancer"]["out"].bound( "/plane/instances" ), exactBound )
+		self.assertSceneValid( script["instancer"]["out"] )
+
+		# Instances varying by id, so the approximation uses
+		# only the first instance.
+
+		script["expression"] = Gaffer.Expression()
+		script["expression"].setExpression( 'parent["sphere"]["radius"] = 1 + context.get( "instancer:id", 0 )' )
+
+		script["instancer"]["approximateBounds"].setValue( False )
+		exactBound = script["instancer"]["out"].bound( "/plane/instances" )
+
+		script["instancer"]["approximateBounds"].setValue( True )
+		approximateBound = script["instancer"]["out"].bound( "/plane/instances" )
+
+		self.assertNotEqual( approximateBound, exactBound )
+		union = IECore.Box3f( exactBound.min, exactBound.max )
+		union.extendBy( approximateBound )
+		self.assertEqual( union, exactBound )
+
+	def testApproximateBoundsPerformance( self ) :
+
+		# Ten thousand instances. Uncomment the prints to get
+		# useful timing information.
+
+		plane = GafferScene.Plane()
+		plane["divisions"].setValue( IECore.V2i( 99 ) )
+
+		sphere = GafferScene.Sphere()
+
+		instancer = GafferScene.Instancer()
+		instancer["in"].setInput( plane["out"] )
+		instancer["parent"].setValue( "/plane" )
+		instancer["instance"].setInput( sphere["out"] )
+
+		t = IECore.Timer()
+		exactBound = instancer["out"].bound( "/plane/instances" )
+		#print "EXACT BOUND", t.stop()
+
+		instancer["approximateBounds"].setValue( True )
+
+		t = IECore.Timer()
+		approximateBound = instancer["out"].bound( "/plane/instances" )
+		#print "APPROXIMATE BOUND", t.stop()
+
+		self.assertEqual( approximateBound, exactBound )
+
+	def __pointsScene( self, numPoints, orientation = False, scale = False ) :
+
+		points = IECore.PointsPrimitive( IECore.V3fVectorData( [ IECore.V3f( i, 0, 0 ) for i in range( 0, numPoints ) ] ) )
+		points["prototypeIndex"] = IECore.PrimitiveVariable(
+			IECore.PrimitiveVariable.Interpolation.Vertex,
+			IECore.IntVectorData( [ i % 3 for i in range( 0, numPoints ) ] )
+		)
+		if orientation :
+			orientations = IECore.QuatfVectorData()
+			for i in range( 0, numPoints ) :
+				q = IECore.Quatf()
+				q.setAxisAngle( IECore.V3f( 0, 1, 0 ), i )
+				orientations.append( q )
+			points["orientation"] = IECore.PrimitiveVariable( IECore.PrimitiveVariable.Interpolation.Vertex, orientations )
+		if scale :
+			points["scale"] = IECore.PrimitiveVariable(
+				IECore.PrimitiveVariable.Interpolation.Vertex,
+				IECore.FloatVectorData( [ 1 + i for i in range( 0, numPoints ) ] )
+			)
+
+		objectToScene = GafferScene.ObjectToScene()
+		objectToScene["object"].setValue( points )
+
+		return objectToScene
+
+	def __prototypesScene( self ) :
+
+		sphere = GafferScene.Sphere()
+		cube = GafferScene.Cube()
+		plane = GafferScene.Plane()
+
+		group = GafferScene.Group()
+		group["in"][0].setInput( sphere["out"] )
+		group["in"][1].setInput( cube["out"] )
+		group["in"][2].setInput( plane["out"] )
+
+		return group, ( sphere, cube, plane )
+
+	def testPrototypes( self ) :
+
+		points = self.__pointsScene( 10 )
+		prototypes, upstream = self.__prototypesScene()
+
+		instancer = GafferScene.Instancer()
+		instancer["in"].setInput( points["out"] )
+		instancer["instance"].setInput( prototypes["out"] )
+		instancer["parent"].setValue( "/object" )
+		instancer["prototypeRoots"].setValue( IECore.StringVectorData( [ "/group/sphere", "/group/cube", "/group/plane" ] ) )
+
+		self.assertSceneValid( instancer["out"] )
+
+		for i in range( 0, 10 ) :
+			instancePath = "/object/instances/%d" % i
+			prototypePath = [ "/group/sphere", "/group/cube", "/group/plane" ][i % 3]
+			self.assertEqual( instancer["out"].object( instancePath ), prototypes["out"].object( prototypePath ) )
+			self.assertEqual( instancer["out"].objectHash( instancePath ), prototypes["out"].objectHash( prototypePath ) )
+			self.assertEqual( instancer["out"].bound( instancePath ), prototypes["out"].bound( prototypePath ) )
+			self.assertEqual( instancer["out"].transform( instancePath ), IECore.M44f.createTranslated( IECore.V3f( i, 0, 0 ) ) )
+
+		# Instances of the same prototype share the same objects.
+
+		self.assertTrue(
+			instancer["out"].object( "/object/instances/0", _copy = False ).isSame(
+				instancer["out"].object( "/object/instances/3", _copy = False )
+			)
+		)
+
+		# Bounds are computed from the prototype bounds.
+
+		expectedBound = IECore.Box3f()
+		for i in range( 0, 10 ) :
+			instancePath = "/object/instances/%d" % i
+			expectedBound.extendBy( instancer["out"].bound( instancePath ).transform( instancer["out"].transform( instancePath ) ) )
+
+		self.assertEqual( instancer["out"].bound( "/object/instances" ), expectedBound )
+
+		# Out of range indices are wrapped.
+
+		instancer["prototypeRoots"].setValue( IECore.StringVectorData( [ "/group/sphere", "/group/cube" ] ) )
+		self.assertEqual( instancer["out"].object( "/object/instances/2" ), prototypes["out"].object( "/group/sphere" ) )
+
+		self.assertTrue( instancer["__engine"] in instancer.affects( instancer["prototypeRoots"] ) )
+		self.assertTrue( instancer["__engine"] in instancer.affects( instancer["prototypeIndex"] ) )
+		self.assertTrue( instancer["out"]["object"] in instancer.affects( instancer["__engine"] ) )
+		self.assertTrue( instancer["out"]["transform"] in instancer.affects( instancer["__engine"] ) )
+
+	def testPrototypeRootTransforms( self ) :
+
+		points = self.__pointsScene( 10 )
+		prototypes, ( sphere, cube, plane ) = self.__prototypesScene()
+		sphere["transform"]["translate"].setValue( IECore.V3f( 0, 2, 0 ) )
+		cube["transform"]["scale"].setValue( IECore.V3f( 3 ) )
+
+		instancer = GafferScene.Instancer()
+		instancer["in"].setInput( points["out"] )
+		instancer["instance"].setInput( prototypes["out"] )
+		instancer["parent"].setValue( "/object" )
+		instancer["prototypeRoots"].setValue( IECore.StringVectorData( [ "/group/sphere", "/group/cube", "/group/plane" ] ) )
+
+		self.assertSceneValid( instancer["out"] )
+
+		for i in range( 0, 10 ) :
+			instancePath = "/object/instances/%d" % i
+			prototypePath = [ "/group/sphere", "/group/cube", "/group/plane" ][i % 3]
+			self.assertEqual(
+				instancer["out"].transform( instancePath ),
+				prototypes["out"].transform( prototypePath ) * IECore.M44f.createTranslated( IECore.V3f( i, 0, 0 ) )
+			)
+
+		# Changing a prototype transform dirties the instance
+		# transforms and bounds, and updates them.
+
+		cs = GafferTest.CapturingSlot( instancer.plugDirtiedSignal() )
+		sphere["transform"]["translate"].setValue( IECore.V3f( 0, 4, 0 ) )
+		dirtiedPlugs = set( [ x[0] for x in cs ] )
+		self.assertTrue( instancer["out"]["transform"] in dirtiedPlugs )
+		self.assertTrue( instancer["out"]["bound"] in dirtiedPlugs )
+
+		self.assertEqual(
+			instancer["out"].transform( "/object/instances/3" ),
+			IECore.M44f.createTranslated( IECore.V3f( 3, 4, 0 ) )
+		)
+		self.assertSceneValid( instancer["out"] )
+
+	def testPrototypeIndexIgnoredWithoutPrototypeRoots( self ) :
+
+		points = IECore.PointsPrimitive( IECore.V3fVectorData( [ IECore.V3f( i, 0, 0 ) for i in range( 0, 4 ) ] ) )
+		# Wrong size, but irrelevant because we're not in prototype mode.
+		points["prototypeIndex"] = IECore.PrimitiveVariable(
+			IECore.PrimitiveVariable.Interpolation.Constant,
+			IECore.IntVectorData( [ 0, 1 ] )
+		)
+
+		objectToScene = GafferScene.ObjectToScene()
+		objectToScene["object"].setValue( points )
+
+		sphere = GafferScene.Sphere()
+
+		instancer = GafferScene.Instancer()
+		instancer["in"].setInput( objectToScene["out"] )
+		instancer["instance"].setInput( sphere["out"] )
+		instancer["parent"].setValue( "/object" )
+
+		self.assertEqual( instancer["out"].childNames( "/object/instances" ), IECore.InternedStringVectorData( [ "0", "1", "2", "3" ] ) )
+		self.assertSceneValid( instancer["out"] )
+
+		instancer["prototypeRoots"].setValue( IECore.StringVectorData( [ "/sphere" ] ) )
+		self.assertRaises( RuntimeError, instancer["out"].childNames, "/object/instances" )
+
+	def testOrientationAndScale( self ) :
+
+		points = self.__pointsScene( 10, orientation = True, scale = True )
+		sphere = GafferScene.Sphere()
+
+		instancer = GafferScene.Instancer()
+		instancer["in"].setInput( points["out"] )
+		instancer["instance"].setInput( sphere["out"] )
+		instancer["parent"].setValue( "/object" )
+
+		self.assertEqual( instancer["out"].transform( "/object/instances/2" ), IECore.M44f.createTranslated( IECore.V3f( 2, 0, 0 ) ) )
+
+		instancer["orientation"].setValue( "orientation" )
+		instancer["scale"].setValue( "scale" )
+
+		for i in range( 0, 10 ) :
+			m = instancer["out"].transform( "/object/instances/%d" % i )
+			self.assertTrue( m.translation().equalWithAbsError( IECore.V3f( i, 0, 0 ), 0.0001 ) )
+			self.assertTrue( m.extractScaling().equalWithAbsError( IECore.V3f( 1 + i ), 0.0001 ) )
+
+		self.assertSceneValid( instancer["out"] )
+
+		instancer["approximateBounds"].setValue( True )
+		self.assertSceneValid( instancer["out"] )
+
+	def testPrototypesPerformance( self ) :
+
+		# Ten thousand instances of three prototypes. Uncomment
+		# the prints to get useful timing information.
+
+		points = self.__pointsScene( 10000 )
+		prototypes, upstream = self.__prototypesScene()
+
+		instancer = GafferScene.Instancer()
+		instancer["in"].setInput( points["out"] )
+		instancer["instance"].setInput( prototypes["out"] )
+		instancer["parent"].setValue( "/object" )
+		instancer["prototypeRoots"].setValue( IECore.StringVectorData( [ "/group/sphere", "/group/cube", "/group/plane" ] ) )
+
+		t = IECore.Timer()
+		instancer["out"].bound( "/object" )
+		#print "BOUND", t.stop()
+
+		t = IECore.Timer()
+		GafferSceneTest.traverseScene( instancer["out"] )
+		#print "TRAVERSE", t.stop()
+
 if __name__ == "__main__":
 	unittest.main()
@@ -0,0 +1,256 @@
+##########################################################################
+#
+#  Copyright (c) 2018, Image Engine Design Inc. All rights reserved.
+#
+#  Redistribution and use in source and binary forms, with or without
+#  modification, are permitted provided that the following conditions are
+#  met:
+#
+#      * Redistributions of source code must retain the above
+#        copyright notice, this list of conditions and the following
+#        disclaimer.
+#
+#      * Redistributions in binary form must reproduce the above
+#        copyright notice, this list of conditions and the following
+#        disclaimer in the documentation and/or other materials provided with
+#        the distribution.
+#
+#      * Neither the name of John Haddon nor the names of
+#        any other contributors to this software may be used to endorse or
+#        promote products derived from this software without specific prior
+#        written permission.
+#
+#  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+#  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+#  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+#  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+#  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+#  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+#  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+#  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+#  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+#  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+#  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#
+##########################################################################
+
+import os
+import unittest
+
+import IECore
+
+import Gaffer
+import GafferScene
+import GafferSceneTest
+
+class MappedSceneReaderTest( GafferSceneTest.SceneTestCase ) :
+
+	def __writeScene( self, scene, fileName ) :
+
+		writer = GafferScene.MappedSceneWriter()
+		writer["in"].setInput( scene )
+		writer["fileName"].setValue( fileName )
+		writer["task"].execute()
+
+	def __testScene( self ) :
+
+		s = Gaffer.ScriptNode()
+
+		s["sphere"] = GafferScene.Sphere()
+		s["plane"] = GafferScene.Plane()
+		s["plane"]["transform"]["translate"]["y"].setValue( 2 )
+
+		s["group"] = GafferScene.Group()
+		s["group"]["in"][0].setInput( s["sphere"]["out"] )
+		s["group"]["in"][1].setInput( s["plane"]["out"] )
+		s["group"]["transform"]["rotate"]["z"].setValue( 45 )
+
+		s["duplicate"] = GafferScene.Duplicate()
+		s["duplicate"]["in"].setInput( s["group"]["out"] )
+		s["duplicate"]["target"].setValue( "/group/sphere" )
+		s["duplicate"]["copies"].setValue( 10 )
+		s["duplicate"]["transform"]["translate"]["x"].setValue( 1 )
+
+		s["attributes"] = GafferScene.StandardAttributes()
+		s["attributes"]["in"].setInput( s["duplicate"]["out"] )
+		s["attributes"]["attributes"]["doubleSided"]["enabled"].setValue( True )
+		s["attributesFilter"] = GafferScene.PathFilter()
+		s["attributesFilter"]["paths"].setValue( IECore.StringVectorData( [ "/group/plane" ] ) )
+		s["attributes"]["filter"].setInput( s["attributesFilter"]["out"] )
+
+		s["set"] = GafferScene.Set()
+		s["set"]["in"].setInput( s["attributes"]["out"] )
+		s["set"]["paths"].setValue( IECore.StringVectorData( [ "/group/sphere1", "/group/plane" ] ) )
+
+		s["options"] = GafferScene.CustomOptions()
+		s["options"]["in"].setInput( s["set"]["out"] )
+		s["options"]["options"].addMember( "test", IECore.IntData( 10 ) )
+
+		return s
+
+	def testRoundTrip( self ) :
+
+		s = self.__testScene()
+		fileName = self.temporaryDirectory() + "/test.msc"
+		self.__writeScene( s["options"]["out"], fileName )
+
+		# Temporary files should have been removed
+		self.assertEqual( os.listdir( self.temporaryDirectory() ), [ "test.msc" ] )
+
+		reader = GafferScene.MappedSceneReader()
+		reader["fileName"].setValue( fileName )
+
+		self.assertSceneValid( reader["out"] )
+		self.assertScenesEqual( reader["out"], s["options"]["out"] )
+		self.assertEqual( reader["out"]["globals"].getValue(), s["options"]["out"]["globals"].getValue() )
+		self.assertEqual( reader["out"]["setNames"].getValue(), s["options"]["out"]["setNames"].getValue() )
+		for setName in reader["out"]["setNames"].getValue() :
+			self.assertEqual( reader["out"].set( setName ).value, s["options"]["out"].set( setName ).value )
+
+		self.assertFalse( GafferScene.SceneAlgo.exists( reader["out"], "/group/nonexistent" ) )
+
+	def testIdenticalObjectsShareHashes( self ) :
+
+		s = self.__testScene()
+		fileName = self.temporaryDirectory() + "/test.msc"
+		self.__writeScene( s["options"]["out"], fileName )
+
+		reader = GafferScene.MappedSceneReader()
+		reader["fileName"].setValue( fileName )
+
+		self.assertEqual( reader["out"].objectHash( "/group/sphere" ), reader["out"].objectHash( "/group/sphere5" ) )
+		self.assertTrue( reader["out"].object( "/group/sphere", _copy = False ).isSame( reader["out"].object( "/group/sphere5", _copy = False ) ) )
+		self.assertNotEqual( reader["out"].objectHash( "/group/sphere" ), reader["out"].objectHash( "/group/plane" ) )
+
+	def testIdenticalObjectsWrittenOnce( self ) :
+
+		sphere = GafferScene.Sphere()
+		sphere["type"].setValue( GafferScene.Sphere.Type.Mesh )
+
+		duplicate = GafferScene.Duplicate()
+		duplicate["in"].setInput( sphere["out"] )
+		duplicate["target"].setValue( "/sphere" )
+		duplicate["copies"].setValue( 10 )
+
+		self.__writeScene( sphere["out"], self.temporaryDirectory() + "/single.msc" )
+		self.__writeScene( duplicate["out"], self.temporaryDirectory() + "/duplicated.msc" )
+
+		self.assertLess(
+			os.path.getsize( self.temporaryDirectory() + "/duplicated.msc" ),
+			os.path.getsize( self.temporaryDirectory() + "/single.msc" ) * 2
+		)
+
+	def testHashesIdentifyContent( self ) :
+
+		# Objects with identical content share hashes even when written
+		# from different nodes, and objects with different content don't,
+		# regardless of how the plug hashes they were written from relate.
+
+		sphere1 = GafferScene.Sphere()
+		sphere2 = GafferScene.Sphere()
+		sphere3 = GafferScene.Sphere()
+		sphere3["radius"].setValue( 2 )
+
+		readers = []
+		for i, sphere in enumerate( [ sphere1, sphere2, sphere3 ] ) :
+			fileName = self.temporaryDirectory() + "/test%d.msc" % i
+			self.__writeScene( sphere["out"], fileName )
+			reader = GafferScene.MappedSceneReader()
+			reader["fileName"].setValue( fileName )
+			readers.append( reader )
+
+		self.assertEqual( readers[0]["out"].objectHash( "/sphere" ), readers[1]["out"].objectHash( "/sphere" ) )
+		self.assertNotEqual( readers[0]["out"].objectHash( "/sphere" ), readers[2]["out"].objectHash( "/sphere" ) )
+		self.assertEqual( readers[2]["out"].object( "/sphere" ), sphere3["out"].object( "/sphere" ) )
+
+	def testEmptyFileName( self ) :
+
+		reader = GafferScene.MappedSceneReader()
+		self.assertSceneValid( reader["out"] )
+		self.assertEqual( reader["out"].childNames( "/" ), IECore.InternedStringVectorData() )
+
+	def testInvalidFile( self ) :
+
+		fileName = self.temporaryDirectory() + "/invalid.msc"
+		with open( fileName, "w" ) as f :
+			f.write( "notAMappedSceneFile" )
+
+		reader = GafferScene.MappedSceneReader()
+		reader["fileName"].setValue( fileName )
+		self.assertRaises( RuntimeError, reader["out"].childNames, "/" )
+
+	def testTruncatedFile( self ) :
+
+		s = self.__testScene()
+		fileName = self.temporaryDirectory() + "/test.msc"
+		self.__writeScene( s["options"]["out"], fileName )
+
+		with open( fileName, "rb" ) as f :
+			data = f.read()
+
+		# Blobs are padded to 8 bytes, so removing 8 bytes always
+		# truncates the final blob, and the other lengths truncate
+		# the blobs, names and tables.
+		for i, length in enumerate( [ len( data ) - 8, len( data ) / 2, 512, 128, 8 ] ) :
+
+			truncatedFileName = self.temporaryDirectory() + "/truncated%d.msc" % i
+			with open( truncatedFileName, "wb" ) as f :
+				f.write( data[:length] )
+
+			reader = GafferScene.MappedSceneReader()
+			reader["fileName"].setValue( truncatedFileName )
+
+			def traverse() :
+				reader["out"]["globals"].getValue()
+				for setName in reader["out"]["setNames"].getValue() :
+					reader["out"].set( setName )
+				GafferSceneTest.traverseScene( reader["out"] )
+
+			Gaffer.ValuePlug.clearCache()
+			self.assertRaises( RuntimeError, traverse )
+
+	def testRefresh( self ) :
+
+		fileName = self.temporaryDirectory() + "/test.msc"
+
+		sphere = GafferScene.Sphere()
+		self.__writeScene( sphere["out"], fileName )
+
+		reader = GafferScene.MappedSceneReader()
+		reader["fileName"].setValue( fileName )
+		self.assertEqual( reader["out"].childNames( "/" ), IECore.InternedStringVectorData( [ "sphere" ] ) )
+
+		# Rewriting the file doesn't affect the mapping we already
+		# hold, so we see the old contents until we refresh.
+
+		plane = GafferScene.Plane()
+		self.__writeScene( plane["out"], fileName )
+		self.assertEqual( reader["out"].childNames( "/" ), IECore.InternedStringVectorData( [ "sphere" ] ) )
+
+		reader["refreshCount"].setValue( reader["refreshCount"].getValue() + 1 )
+		self.assertEqual( reader["out"].childNames( "/" ), IECore.InternedStringVectorData( [ "plane" ] ) )
+		self.assertScenesEqual( reader["out"], plane["out"] )
+
+	def testLoadPerformance( self ) :
+
+		sphere = GafferScene.Sphere()
+		duplicate = GafferScene.Duplicate()
+		duplicate["in"].setInput( sphere["out"] )
+		duplicate["target"].setValue( "/sphere" )
+		duplicate["copies"].setValue( 10000 )
+
+		fileName = self.temporaryDirectory() + "/test.msc"
+		self.__writeScene( duplicate["out"], fileName )
+
+		reader = GafferScene.MappedSceneReader()
+		reader["fileName"].setValue( fileName )
+
+		for i in range( 0, 2 ) :
+			Gaffer.ValuePlug.clearCache()
+			reader["refreshCount"].setValue( reader["refreshCount"].getValue() + 1 )
+			t = IECore.Timer()
+			GafferSceneTest.traverseScene( reader["out"] )
+			#print t.stop()
+
+if __name__ == "__main__":
+	unittest.main()
@@ -35,6 +35,7 @@
 ##########################################################################
 
 import os
+import random
 import unittest
 
 import IECore
@@ -188,3 +189,118 @@ class MeshTangentsTest( GafferSceneTest.SceneTestCase ) :
 
 		for v in vTangent.data :
 			self.failUnless( v.equalWithAbsError( IECore.V3f( 1, 0, 0 ), 0.000001 ) )
+
+	def __triangulatedPlaneScene( self, divisions, jitter = 0 ) :
+
+		r = random.Random( divisions )
+
+		verticesPerFace = []
+		vertexIds = []
+		for y in range( 0, divisions ) :
+			for x in range( 0, divisions ) :
+				i = y * ( divisions + 1 ) + x
+				verticesPerFace.extend( [ 3, 3 ] )
+				vertexIds.extend( [ i, i + 1, i + divisions + 2, i, i + divisions + 2, i + divisions + 1 ] )
+
+		p = []
+		for y in range( 0, divisions + 1 ) :
+			for x in range( 0, divisions + 1 ) :
+				p.append( IECore.V3f( x + r.uniform( -jitter, jitter ), y + r.uniform( -jitter, jitter ), ( x * y ) % 3 ) )
+
+		uv = [ IECore.V2f( x / float( divisions ), y / float( divisions ) ) for y in range( 0, divisions + 1 ) for x in range( 0, divisions + 1 ) ]
+		uv = [ v + IECore.V2f( r.uniform( -jitter, jitter ), r.uniform( -jitter, jitter ) ) / divisions for v in uv ]
+
+		mesh = IECore.MeshPrimitive( IECore.IntVectorData( verticesPerFace ), IECore.IntVectorData( vertexIds ), "linear", IECore.V3fVectorData( p ) )
+		mesh["uv"] = IECore.PrimitiveVariable(
+			IECore.PrimitiveVariable.Interpolation.FaceVarying,
+			IECore.V2fVectorData(
+				[ uv[i] for i in vertexIds ],
+				IECore.GeometricData.Interpretation.UV
+			)
+		)
+
+		objectToScene = GafferScene.ObjectToScene()
+		objectToScene["object"].setValue( mesh )
+
+		return objectToScene
+
+	def testParallelMatchesSerial( self ) :
+
+		planeScene = self.__triangulatedPlaneScene( 10 )
+
+		pathFilter = GafferScene.PathFilter()
+		pathFilter["paths"].setValue( IECore.StringVectorData( [ "/object" ] ) )
+
+		meshTangents = GafferScene.MeshTangents()
+		meshTangents["in"].setInput( planeScene["out"] )
+		meshTangents["filter"].setInput( pathFilter["out"] )
+
+		self.assertFalse( meshTangents["parallel"].getValue() )
+
+		for orthogonal in ( True, False ) :
+
+			meshTangents["orthogonal"].setValue( orthogonal )
+
+			meshTangents["parallel"].setValue( True )
+			parallelObject = meshTangents["out"].object( "/object" )
+			meshTangents["parallel"].setValue( False )
+			serialObject = meshTangents["out"].object( "/object" )
+
+			for name in ( "uTangent", "vTangent" ) :
+				self.assertEqual( parallelObject[name].interpolation, IECore.PrimitiveVariable.Interpolation.FaceVarying )
+				self.assertEqual( len( parallelObject[name].data ), len( serialObject[name].data ) )
+				for a, b in zip( parallelObject[name].data, serialObject[name].data ) :
+					self.assertTrue( a.equalWithAbsError( b, 0.0001 ) )
+
+	def testParallelMatchesSerialOnIrregularMesh( self ) :
+
+		# Faces of differing areas and uv distortions, so that the
+		# weighting of each face's contribution to the shared
+		# tangents matters.
+		planeScene = self.__triangulatedPlaneScene( 10, jitter = 0.4 )
+
+		pathFilter = GafferScene.PathFilter()
+		pathFilter["paths"].setValue( IECore.StringVectorData( [ "/object" ] ) )
+
+		meshTangents = GafferScene.MeshTangents()
+		meshTangents["in"].setInput( planeScene["out"] )
+		meshTangents["filter"].setInput( pathFilter["out"] )
+
+		for orthogonal in ( True, False ) :
+
+			meshTangents["orthogonal"].setValue( orthogonal )
+
+			meshTangents["parallel"].setValue( True )
+			parallelObject = meshTangents["out"].object( "/object" )
+			meshTangents["parallel"].setValue( False )
+			serialObject = meshTangents["out"].object( "/object" )
+
+			for name in ( "uTangent", "vTangent" ) :
+				self.assertEqual( len( parallelObject[name].data ), len( serialObject[name].data ) )
+				for a, b in zip( parallelObject[name].data, serialObject[name].data ) :
+					self.assertTrue( a.equalWithAbsError( b, 0.0001 ) )
+
+	def testPerformance( self ) :
+
+		planeScene = self.__triangulatedPlaneScene( 100 )
+
+		pathFilter = GafferScene.PathFilter()
+		pathFilter["paths"].setValue( IECore.StringVectorData( [ "/object" ] ) )
+
+		meshTangents = GafferScene.MeshTangents()
+		meshTangents["in"].setInput( planeScene["out"] )
+		meshTangents["filter"].setInput( pathFilter["out"] )
+
+		planeScene["out"].object( "/object" )
+
+		meshTangents["parallel"].setValue( True )
+
+		t = IECore.Timer()
+		meshTangents["out"].object( "/object" )
+		#print "PARALLEL", t.stop()
+
+		meshTangents["parallel"].setValue( False )
+
+		t = IECore.Timer()
+		meshTangents["out"].object( "/object" )
+		#print "SERIAL", t.stop()
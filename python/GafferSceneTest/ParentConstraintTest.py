@@ -161,5 +161,54 @@ class ParentConstraintTest( GafferSceneTest.SceneTestCase ) :
 
 		self.assertEqual( parent["out"].fullTransform( "/target/constrained" ), constraint["out"].fullTransform( "/group/constrained" ) )
 
+	def testDeepHierarchy( self ) :
+
+		plane = GafferScene.Plane()
+		plane["divisions"].setValue( IECore.V2i( 9 ) )
+
+		sphere = GafferScene.Sphere()
+		sphere["transform"]["translate"].setValue( IECore.V3f( 0, 1, 0 ) )
+
+		instancer = GafferScene.Instancer()
+		instancer["in"].setInput( plane["out"] )
+		instancer["parent"].setValue( "/plane" )
+		instancer["instance"].setInput( sphere["out"] )
+
+		groups = []
+		for i in range( 0, 50 ) :
+			group = GafferScene.Group()
+			group["in"][0].setInput( groups[-1]["out"] if groups else instancer["out"] )
+			group["transform"]["translate"].setValue( IECore.V3f( 1, 0, 0 ) )
+			group["transform"]["rotate"].setValue( IECore.V3f( 0, 1, 0 ) )
+			groups.append( group )
+
+		targetPath = "/group" * 50 + "/plane/instances/0/sphere"
+
+		filter = GafferScene.PathFilter()
+		filter["paths"].setValue( IECore.StringVectorData( [ "/group" * 50 + "/plane/instances/*/sphere" ] ) )
+
+		constraint = GafferScene.ParentConstraint()
+		constraint["in"].setInput( groups[-1]["out"] )
+		constraint["filter"].setInput( filter["out"] )
+		constraint["target"].setValue( targetPath )
+
+		self.assertSceneValid( constraint["out"] )
+
+		def assertConstrained( path ) :
+
+			self.assertTrue(
+				constraint["out"].fullTransform( path ).equalWithAbsError(
+					groups[-1]["out"].transform( path ) * groups[-1]["out"].fullTransform( targetPath ), 0.0001
+				)
+			)
+
+		for i in range( 0, 100 ) :
+			assertConstrained( "/group" * 50 + "/plane/instances/%d/sphere" % i )
+
+		# Changing an ancestor transform must be reflected in the
+		# cached full transforms.
+		groups[10]["transform"]["translate"].setValue( IECore.V3f( 0, 0, 5 ) )
+		assertConstrained( "/group" * 50 + "/plane/instances/10/sphere" )
+
 if __name__ == "__main__":
 	unittest.main()
@@ -217,5 +217,78 @@ class PathFilterTest( GafferSceneTest.SceneTestCase ) :
 			c["scene:path"] = IECore.InternedStringVectorData( [ "a" ] )
 			self.assertEqual( f["out"].getValue(), GafferScene.Filter.Result.NoMatch )
 
+	def testMatchingPaths( self ) :
+
+		f = GafferScene.PathFilter()
+		f["paths"].setValue( IECore.StringVectorData( [ "/a", "/b/.../c" ] ) )
+
+		self.assertTrue( f.canComputeMatchingPaths() )
+		self.assertTrue( GafferScene.Filter.matchingPathsFilter( f["out"] ).isSame( f ) )
+		self.assertEqual(
+			f["__matchingPaths"].getValue().value,
+			GafferScene.PathMatcher( [ "/a", "/b/.../c" ] )
+		)
+
+		cs = GafferTest.CapturingSlot( f.plugDirtiedSignal() )
+		f["paths"].setValue( IECore.StringVectorData( [ "/d" ] ) )
+		self.assertTrue( f["__matchingPaths"] in [ x[0] for x in cs ] )
+		self.assertEqual( f["__matchingPaths"].getValue().value, GafferScene.PathMatcher( [ "/d" ] ) )
+
+		f["enabled"].setValue( False )
+		self.assertTrue( f["__matchingPaths"].getValue().value.isEmpty() )
+
+	def testMatchingPathsWithComputedPaths( self ) :
+
+		s = Gaffer.ScriptNode()
+
+		s["f"] = GafferScene.PathFilter()
+		s["e"] = Gaffer.Expression()
+		s["e"].setExpression(
+			"import IECore\n"
+			"parent['f']['paths'] = IECore.StringVectorData( [ '/frame%d' % context.getFrame() ] )"
+		)
+
+		# Computed paths might depend on "scene:path", which isn't
+		# available during bulk evaluation, so we must fall back to
+		# evaluating per location.
+		self.assertFalse( s["f"].canComputeMatchingPaths() )
+		self.assertEqual( GafferScene.Filter.matchingPathsFilter( s["f"]["out"] ), None )
+
+		for frame in ( 1, 2 ) :
+			with Gaffer.Context() as c :
+				c.setFrame( frame )
+				self.assertEqual(
+					s["f"]["__matchingPaths"].getValue().value,
+					GafferScene.PathMatcher( [ "/frame%d" % frame ] )
+				)
+
+	def testFilteredSceneProcessorUsesMatchingPaths( self ) :
+
+		# Bulk evaluation must give identical results to evaluating
+		# the filter at each location.
+
+		sphere = GafferScene.Sphere()
+		group = GafferScene.Group()
+		for i in range( 0, 3 ) :
+			group["in"][i].setInput( sphere["out"] )
+
+		f = GafferScene.PathFilter()
+		f["paths"].setValue( IECore.StringVectorData( [ "/group/sphere1", "/group/sphere2/..." ] ) )
+
+		a = GafferScene.StandardAttributes()
+		a["in"].setInput( group["out"] )
+		a["attributes"]["doubleSided"]["enabled"].setValue( True )
+		a["filter"].setInput( f["out"] )
+
+		self.assertSceneValid( a["out"] )
+		self.assertFalse( "doubleSided" in a["out"].attributes( "/group" ) )
+		self.assertFalse( "doubleSided" in a["out"].attributes( "/group/sphere" ) )
+		self.assertTrue( "doubleSided" in a["out"].attributes( "/group/sphere1" ) )
+		self.assertTrue( "doubleSided" in a["out"].attributes( "/group/sphere2" ) )
+
+		m = GafferScene.PathMatcher()
+		GafferScene.SceneAlgo.matchingPaths( a["filter"], a["in"], m )
+		self.assertEqual( set( m.paths() ), { "/group/sphere1", "/group/sphere2" } )
+
 if __name__ == "__main__":
 	unittest.main()
@@ -1010,5 +1010,95 @@ class PathMatcherTest( GafferSceneTest.SceneTestCase ) :
 
 		self.assertEqual( m3.paths(), [ "/a/b/c/d/myTest" ] )
 
+	def testSelfRemoval( self ) :
+
+		m = GafferScene.PathMatcher( [ "/a", "/a/b", "/c/d" ] )
+		self.assertTrue( m.removePaths( m ) )
+		self.assertTrue( m.isEmpty() )
+		self.assertFalse( m.removePaths( m ) )
+
+	def testWideHierarchy( self ) :
+
+		# Enough children to exercise both the small and
+		# large node representations, with wildcards mixed in.
+
+		paths = [ "/a/b{0}".format( i ) for i in range( 0, 100 ) ]
+		paths += [ "/a/*{0}".format( i ) for i in range( 0, 10 ) ]
+
+		m = GafferScene.PathMatcher()
+		for p in paths :
+			self.assertTrue( m.addPath( p ) )
+		self.assertEqual( set( m.paths() ), set( paths ) )
+
+		for p in paths :
+			self.assertTrue( m.match( p ) & GafferScene.Filter.Result.ExactMatch )
+		self.assertEqual( m.match( "/a/c" ), GafferScene.Filter.Result.NoMatch )
+		self.assertTrue( m.match( "/a/x3" ) & GafferScene.Filter.Result.ExactMatch )
+
+		for p in paths[::2] :
+			self.assertTrue( m.removePath( p ) )
+		self.assertEqual( set( m.paths() ), set( paths[1::2] ) )
+
+		for p in paths[1::2] :
+			self.assertTrue( m.removePath( p ) )
+		self.assertTrue( m.isEmpty() )
+
+	def testWideSetOperations( self ) :
+
+		# Enough children for the operations to be parallelised,
+		# at several levels of the hierarchy.
+
+		r = random.Random( 42 )
+		def paths( n ) :
+			return set( [ "/a{0}/b{1}/c{2}".format( r.randint( 0, 9 ), r.randint( 0, 199 ), r.randint( 0, 99 ) ) for i in range( 0, n ) ] )
+
+		p1 = paths( 20000 )
+		p2 = paths( 20000 ) | set( list( p1 )[:5000] )
+		m1 = GafferScene.PathMatcher( list( p1 ) )
+		m2 = GafferScene.PathMatcher( list( p2 ) )
+
+		m = GafferScene.PathMatcher( m1 )
+		self.assertTrue( m.addPaths( m2 ) )
+		self.assertEqual( set( m.paths() ), p1 | p2 )
+		self.assertFalse( m.addPaths( m2 ) )
+
+		self.assertTrue( m.removePaths( m1 ) )
+		self.assertEqual( set( m.paths() ), p2 - p1 )
+		self.assertFalse( m.removePaths( m1 ) )
+
+		self.assertEqual( set( m1.intersection( m2 ).paths() ), p1 & p2 )
+		self.assertEqual( set( m2.intersection( m1 ).paths() ), p1 & p2 )
+		self.assertEqual( m1.intersection( m1 ), m1 )
+		self.assertTrue( m.intersection( m1 ).isEmpty() )
+
+		# Source matchers must be unaffected.
+		self.assertEqual( set( m1.paths() ), p1 )
+		self.assertEqual( set( m2.paths() ), p2 )
+
+	def testAddPerformance( self ) :
+
+		# uncomment the timers to get useful information printed out.
+		t = IECore.Timer()
+		GafferSceneTest.testPathMatcherAddPerformance()
+		#print "ADD", t.stop()
+
+	def testMatchPerformance( self ) :
+
+		t = IECore.Timer()
+		GafferSceneTest.testPathMatcherMatchPerformance()
+		#print "MATCH", t.stop()
+
+	def testIteratorPerformance( self ) :
+
+		t = IECore.Timer()
+		GafferSceneTest.testPathMatcherIteratorPerformance()
+		#print "ITERATE", t.stop()
+
+	def testAddPathsPerformance( self ) :
+
+		t = IECore.Timer()
+		GafferSceneTest.testPathMatcherAddPathsPerformance()
+		#print "ADD PATHS", t.stop()
+
 if __name__ == "__main__":
 	unittest.main()
@@ -38,6 +38,7 @@ import unittest
 
 import IECore
 
+import Gaffer
 import GafferScene
 import GafferSceneTest
 
@@ -83,5 +84,106 @@ class RendererAlgoTest( GafferSceneTest.SceneTestCase ) :
 		GafferSceneTest.SceneTestCase.tearDown( self )
 		GafferScene.deregisterAdaptor( "Test" )
 
+	def testRenderSets( self ) :
+
+		sphere = GafferScene.Sphere()
+		group = GafferScene.Group()
+		group["in"][0].setInput( sphere["out"] )
+
+		setA = GafferScene.Set()
+		setA["in"].setInput( group["out"] )
+		setA["name"].setValue( "render:A" )
+		setA["paths"].setValue( IECore.StringVectorData( [ "/group" ] ) )
+
+		setB = GafferScene.Set()
+		setB["in"].setInput( setA["out"] )
+		setB["name"].setValue( "render:B" )
+		setB["paths"].setValue( IECore.StringVectorData( [ "/group/sphere", "/other" ] ) )
+
+		setC = GafferScene.Set()
+		setC["in"].setInput( setB["out"] )
+		setC["name"].setValue( "notARenderSet" )
+		setC["paths"].setValue( IECore.StringVectorData( [ "/group" ] ) )
+
+		renderSets = GafferScene.RenderSets()
+		self.assertTrue( renderSets.update( setC["out"] ) & GafferScene.RenderSets.Changed.RenderSetsChanged )
+
+		def assertSets( path, sets ) :
+
+			self.assertEqual( set( renderSets.setsAttribute( path ) ), set( sets ) )
+
+		assertSets( "/", [] )
+		assertSets( "/group", [ "A" ] )
+		assertSets( "/group/sphere", [ "A", "B" ] )
+		assertSets( "/group/sphere/child", [ "A", "B" ] )
+		assertSets( "/other", [ "B" ] )
+		assertSets( "/another", [] )
+
+		self.assertEqual( renderSets.setsAttribute( "/group/sphere" ), renderSets.setsAttribute( "/group/sphere/child" ) )
+
+		# Sets containing wildcards
+
+		setC["name"].setValue( "render:C" )
+		setC["paths"].setValue( IECore.StringVectorData( [ "/group/*", "/.../another" ] ) )
+		self.assertTrue( renderSets.update( setC["out"] ) & GafferScene.RenderSets.Changed.RenderSetsChanged )
+
+		assertSets( "/", [] )
+		assertSets( "/group", [ "A" ] )
+		assertSets( "/group/sphere", [ "A", "B", "C" ] )
+		assertSets( "/group/sphere/child", [ "A", "B", "C" ] )
+		assertSets( "/other", [ "B" ] )
+		assertSets( "/another", [ "C" ] )
+		assertSets( "/other/another", [ "B", "C" ] )
+
+		# Updates
+
+		self.assertEqual( renderSets.update( setC["out"] ), GafferScene.RenderSets.Changed.NothingChanged )
+
+		setA["paths"].setValue( IECore.StringVectorData( [ "/" ] ) )
+		self.assertTrue( renderSets.update( setC["out"] ) & GafferScene.RenderSets.Changed.RenderSetsChanged )
+		assertSets( "/", [ "A" ] )
+		assertSets( "/another", [ "A", "C" ] )
+
+		renderSets.clear()
+		assertSets( "/group/sphere", [] )
+
+	def testRenderSetsPerformance( self ) :
+
+		script = Gaffer.ScriptNode()
+		script["plane"] = GafferScene.Plane()
+		lastOut = script["plane"]["out"]
+		for i in range( 0, 200 ) :
+			s = GafferScene.Set()
+			s["in"].setInput( lastOut )
+			s["name"].setValue( "render:set{0}".format( i ) )
+			s["paths"].setValue( IECore.StringVectorData( [ "/plane/instances/{0}/sphere".format( j ) for j in range( i, 40000, 200 ) ] ) )
+			script.addChild( s )
+			lastOut = s["out"]
+
+		renderSets = GafferScene.RenderSets()
+		renderSets.update( lastOut )
+
+		t = IECore.Timer()
+		for i in range( 0, 40000 ) :
+			self.assertEqual( list( renderSets.setsAttribute( "/plane/instances/{0}/sphere".format( i ) ) ), [ "set{0}".format( i % 200 ) ] )
+		# uncomment for timing information
+		#print t.stop()
+
+	def testOutputObjectsSharesPrototypes( self ) :
+
+		sphere = GafferScene.Sphere()
+		duplicate = GafferScene.Duplicate()
+		duplicate["in"].setInput( sphere["out"] )
+		duplicate["target"].setValue( "/sphere" )
+		duplicate["transform"]["translate"].setValue( IECore.V3f( 1, 0, 0 ) )
+		duplicate["copies"].setValue( 1000 )
+
+		cube = GafferScene.Cube()
+		group = GafferScene.Group()
+		group["in"][0].setInput( duplicate["out"] )
+		group["in"][1].setInput( cube["out"] )
+
+		GafferSceneTest.testOutputObjectsSharesPrototypes( group["out"] )
+
 if __name__ == "__main__":
 	unittest.main()
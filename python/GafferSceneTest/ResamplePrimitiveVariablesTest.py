@@ -132,4 +132,85 @@ class ResamplePrimitiveVariablesTest( GafferSceneTest.SceneTestCase ) :
 		resample["interpolation"].setValue( IECore.PrimitiveVariable.Interpolation.Invalid )  # invalid
 		resample['names'].setValue( "a" )
 
-		self.assertRaises( RuntimeError, lambda : resample["out"].object( "/object" ) )
\ No newline at end of file
+		self.assertRaises( RuntimeError, lambda : resample["out"].object( "/object" ) )
+
+	def __planeScene( self, divisions ) :
+
+		mesh = IECore.MeshPrimitive.createPlane( IECore.Box2f( IECore.V2f( -1 ), IECore.V2f( 1 ) ), IECore.V2i( divisions ) )
+
+		numVertices = mesh.variableSize( IECore.PrimitiveVariable.Interpolation.Vertex )
+		numFaceVertices = mesh.variableSize( IECore.PrimitiveVariable.Interpolation.FaceVarying )
+		mesh["vertex"] = IECore.PrimitiveVariable( IECore.PrimitiveVariable.Interpolation.Vertex, IECore.FloatVectorData( range( 0, numVertices ) ) )
+		mesh["uniform"] = IECore.PrimitiveVariable( IECore.PrimitiveVariable.Interpolation.Uniform, IECore.V3fVectorData( [ IECore.V3f( i ) for i in range( 0, mesh.numFaces() ) ] ) )
+		mesh["faceVarying"] = IECore.PrimitiveVariable( IECore.PrimitiveVariable.Interpolation.FaceVarying, IECore.Color3fVectorData( [ IECore.Color3f( i, 1, 2 ) for i in range( 0, numFaceVertices ) ] ) )
+
+		objectToScene = GafferScene.ObjectToScene()
+		objectToScene["object"].setValue( mesh )
+
+		return objectToScene
+
+	def testParallelMatchesSerial( self ) :
+
+		planeScene = self.__planeScene( 10 )
+
+		pathFilter = GafferScene.PathFilter()
+		pathFilter["paths"].setValue( IECore.StringVectorData( [ "/object" ] ) )
+
+		resample = GafferScene.ResamplePrimitiveVariables()
+		resample["in"].setInput( planeScene["out"] )
+		resample["filter"].setInput( pathFilter["out"] )
+		resample["names"].setValue( "vertex uniform faceVarying" )
+
+		self.assertFalse( resample["parallel"].getValue() )
+
+		for interpolation in (
+			IECore.PrimitiveVariable.Interpolation.Uniform,
+			IECore.PrimitiveVariable.Interpolation.Vertex,
+			IECore.PrimitiveVariable.Interpolation.FaceVarying,
+		) :
+
+			resample["interpolation"].setValue( interpolation )
+
+			resample["parallel"].setValue( True )
+			parallelObject = resample["out"].object( "/object" )
+			resample["parallel"].setValue( False )
+			serialObject = resample["out"].object( "/object" )
+
+			self.assertTrue( parallelObject.arePrimitiveVariablesValid() )
+			for name in ( "vertex", "uniform", "faceVarying" ) :
+				self.assertEqual( parallelObject[name].interpolation, interpolation )
+				self.assertEqual( parallelObject[name].interpolation, serialObject[name].interpolation )
+				self.assertEqual( len( parallelObject[name].data ), len( serialObject[name].data ) )
+				for a, b in zip( parallelObject[name].data, serialObject[name].data ) :
+					if name == "vertex" :
+						self.assertAlmostEqual( a, b, places = 4 )
+					else :
+						for i in range( 0, 3 ) :
+							self.assertAlmostEqual( a[i], b[i], places = 4 )
+
+	def testPerformance( self ) :
+
+		planeScene = self.__planeScene( 100 )
+
+		pathFilter = GafferScene.PathFilter()
+		pathFilter["paths"].setValue( IECore.StringVectorData( [ "/object" ] ) )
+
+		resample = GafferScene.ResamplePrimitiveVariables()
+		resample["in"].setInput( planeScene["out"] )
+		resample["filter"].setInput( pathFilter["out"] )
+		resample["names"].setValue( "faceVarying" )
+		resample["interpolation"].setValue( IECore.PrimitiveVariable.Interpolation.Vertex )
+
+		planeScene["out"].object( "/object" )
+
+		resample["parallel"].setValue( True )
+
+		t = IECore.Timer()
+		resample["out"].object( "/object" )
+		#print "PARALLEL", t.stop()
+
+		resample["parallel"].setValue( False )
+
+		t = IECore.Timer()
+		resample["out"].object( "/object" )
+		#print "SERIAL", t.stop()
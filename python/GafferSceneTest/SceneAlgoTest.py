@@ -185,6 +185,160 @@ class SceneAlgoTest( GafferSceneTest.SceneTestCase ) :
 
 		self.assertEqual( set( m.paths() ), { "/group/sphere", "/group/sphere1", "/group/sphere2" } )
 
+	def testMatchingPathsPreservesExistingPaths( self ) :
+
+		s = GafferScene.Sphere()
+		g = GafferScene.Group()
+		g["in"][0].setInput( s["out"] )
+		g["in"][1].setInput( s["out"] )
+
+		m = GafferScene.PathMatcher( [ "/a/b", "/group" ] )
+		GafferScene.SceneAlgo.matchingPaths( GafferScene.PathMatcher( [ "/group/sphere1", "/" ] ), g["out"], m )
+
+		self.assertEqual( set( m.paths() ), { "/a/b", "/group", "/group/sphere1", "/" } )
+
+	def testMatchingPathsPerformance( self ) :
+
+		# Ten thousand instances, each with a child. Uncomment
+		# the print to get useful timing information.
+
+		sphere = GafferScene.Sphere()
+
+		plane = GafferScene.Plane()
+		plane["divisions"].setValue( IECore.V2i( 99 ) )
+
+		instancer = GafferScene.Instancer()
+		instancer["in"].setInput( plane["out"] )
+		instancer["parent"].setValue( "/plane" )
+		instancer["instance"].setInput( sphere["out"] )
+
+		pathFilter = GafferScene.PathFilter()
+		pathFilter["paths"].setValue( IECore.StringVectorData( [ "/plane/instances/*/sphere" ] ) )
+
+		# Compute the scene first, so that we time only the filtering.
+		GafferSceneTest.traverseScene( instancer["out"] )
+
+		m = GafferScene.PathMatcher()
+		t = IECore.Timer()
+		GafferScene.SceneAlgo.matchingPaths( pathFilter, instancer["out"], m )
+		#print "MATCHINGPATHS 10K", t.stop()
+
+		self.assertEqual( m.match( "/plane/instances/9999/sphere" ), GafferScene.Filter.Result.ExactMatch )
+
+	def testLocationAccumulator( self ) :
+
+		sphere = GafferScene.Sphere()
+		sphere["transform"]["translate"].setValue( IECore.V3f( 1, 0, 0 ) )
+
+		plane = GafferScene.Plane()
+		plane["transform"]["rotate"].setValue( IECore.V3f( 0, 45, 0 ) )
+
+		innerGroup = GafferScene.Group()
+		innerGroup["in"][0].setInput( sphere["out"] )
+		innerGroup["in"][1].setInput( plane["out"] )
+		innerGroup["transform"]["scale"].setValue( IECore.V3f( 2 ) )
+
+		outerGroup = GafferScene.Group()
+		outerGroup["in"][0].setInput( innerGroup["out"] )
+		outerGroup["transform"]["translate"].setValue( IECore.V3f( 0, 1, 0 ) )
+
+		groupFilter = GafferScene.PathFilter()
+		groupFilter["paths"].setValue( IECore.StringVectorData( [ "/group/group" ] ) )
+
+		groupAttributes = GafferScene.CustomAttributes()
+		groupAttributes["in"].setInput( outerGroup["out"] )
+		groupAttributes["filter"].setInput( groupFilter["out"] )
+		groupAttributes["attributes"].addMember( "a", 1 )
+		groupAttributes["attributes"].addMember( "b", 2 )
+
+		sphereFilter = GafferScene.PathFilter()
+		sphereFilter["paths"].setValue( IECore.StringVectorData( [ "/group/group/sphere" ] ) )
+
+		sphereAttributes = GafferScene.CustomAttributes()
+		sphereAttributes["in"].setInput( groupAttributes["out"] )
+		sphereAttributes["filter"].setInput( sphereFilter["out"] )
+		sphereAttributes["attributes"].addMember( "b", 3 )
+		sphereAttributes["attributes"].addMember( "c", 4 )
+
+		GafferSceneTest.testLocationAccumulator( sphereAttributes["out"] )
+
+	def testLocationAccumulatorPerformance( self ) :
+
+		# A hierarchy 100 levels deep, with a thousand leaf
+		# locations. Uncomment the print to get useful timing
+		# information.
+
+		plane = GafferScene.Plane()
+		plane["divisions"].setValue( IECore.V2i( 9, 99 ) )
+
+		sphere = GafferScene.Sphere()
+
+		instancer = GafferScene.Instancer()
+		instancer["in"].setInput( plane["out"] )
+		instancer["parent"].setValue( "/plane" )
+		instancer["instance"].setInput( sphere["out"] )
+
+		groups = []
+		for i in range( 0, 100 ) :
+			group = GafferScene.Group()
+			group["in"][0].setInput( groups[-1]["out"] if groups else instancer["out"] )
+			group["transform"]["translate"].setValue( IECore.V3f( 1, 0, 0 ) )
+			groups.append( group )
+
+		# Compute the scene first, so that we time only the accumulation.
+		GafferSceneTest.traverseScene( groups[-1]["out"] )
+
+		t = IECore.Timer()
+		GafferSceneTest.accumulateFullTransformsAndAttributes( groups[-1]["out"] )
+		#print "ACCUMULATE DEEP", t.stop()
+
+	def testParallelTraverseFlatPerformance( self ) :
+
+		# Ten thousand locations under a single parent.
+
+		plane = GafferScene.Plane()
+		plane["divisions"].setValue( IECore.V2i( 99, 99 ) )
+
+		sphere = GafferScene.Sphere()
+
+		instancer = GafferScene.Instancer()
+		instancer["in"].setInput( plane["out"] )
+		instancer["parent"].setValue( "/plane" )
+		instancer["instance"].setInput( sphere["out"] )
+
+		self.__testParallelTraverseScaling( instancer["out"], "FLAT" )
+
+	def testParallelTraverseDeepPerformance( self ) :
+
+		# A binary tree 12 levels deep.
+
+		sphere = GafferScene.Sphere()
+		scene = sphere["out"]
+
+		groups = []
+		for i in range( 0, 12 ) :
+			group = GafferScene.Group()
+			group["in"][0].setInput( scene )
+			group["in"][1].setInput( scene )
+			groups.append( group )
+			scene = group["out"]
+
+		self.__testParallelTraverseScaling( scene, "DEEP" )
+
+	def __testParallelTraverseScaling( self, scene, name ) :
+
+		# Compute the scene first, so that we time only the traversal.
+		GafferSceneTest.traverseScene( scene )
+
+		# Uncomment the print to get useful timing information
+		# for a range of thread counts and grain sizes.
+
+		for threads in ( 1, 8 ) :
+			for grainSize in ( 0, 1000 ) :
+				t = IECore.Timer()
+				GafferSceneTest.parallelTraverseWithThreads( scene, threads, grainSize )
+				#print "TRAVERSE", name, threads, grainSize, t.stop()
+
 	def testSetsNeedContextEntry( self ) :
 
 		script = Gaffer.ScriptNode()
@@ -208,6 +208,18 @@ class ScenePlugTest( GafferSceneTest.SceneTestCase ) :
 
 		GafferSceneTest.testManyStringToPathCalls()
 
+	def testLocationPathScope( self ) :
+
+		GafferSceneTest.testLocationPathScope()
+
+	def testLocationSetChild( self ) :
+
+		GafferSceneTest.testLocationSetChild()
+
+	def testManyPathScopes( self ) :
+
+		GafferSceneTest.testManyPathScopes()
+
 	def testSetPlugs( self ) :
 
 		p = GafferScene.ScenePlug()
@@ -233,5 +245,77 @@ class ScenePlugTest( GafferSceneTest.SceneTestCase ) :
 		self.assertEqual( p.globalsHash(), p["globals"].hash() )
 		self.assertEqual( p.setNamesHash(), p["setNames"].hash() )
 
+	def testLocationBundle( self ) :
+
+		sphere = GafferScene.Sphere()
+		sphere["transform"]["translate"].setValue( IECore.V3f( 1, 2, 3 ) )
+
+		plane = GafferScene.Plane()
+
+		group = GafferScene.Group()
+		group["in"][0].setInput( sphere["out"] )
+		group["in"][1].setInput( plane["out"] )
+
+		attributes = GafferScene.CustomAttributes()
+		attributes["in"].setInput( group["out"] )
+		attributes["attributes"].addMember( "a", 10 )
+
+		pathFilter = GafferScene.PathFilter()
+		pathFilter["paths"].setValue( IECore.StringVectorData( [ "/group/sphere" ] ) )
+		attributes["filter"].setInput( pathFilter["out"] )
+
+		scene = attributes["out"]
+
+		def assertBundle( bundle, path ) :
+
+			self.assertEqual( bundle["bound"], scene.bound( path ) )
+			self.assertEqual( bundle["transform"], scene.transform( path ) )
+			self.assertEqual( bundle["attributes"], scene.attributes( path ) )
+			self.assertEqual( bundle["object"], scene.object( path ) )
+			self.assertEqual( bundle["childNames"], scene.childNames( path ) )
+
+		for path in ( "/", "/group", "/group/sphere", "/group/plane" ) :
+			assertBundle( scene.locationBundle( path ), path )
+
+		bundles = scene.childLocationBundles( "/group" )
+		self.assertEqual( len( bundles ), 2 )
+		assertBundle( bundles[0], "/group/sphere" )
+		assertBundle( bundles[1], "/group/plane" )
+
+		self.assertEqual( scene.childLocationBundles( "/group/sphere" ), [] )
+
+		bundle = scene.locationBundle( "/group/sphere", GafferScene.ScenePlug.LocationComponents.Bound | GafferScene.ScenePlug.LocationComponents.Attributes )
+		self.assertEqual( set( bundle.keys() ), { "bound", "attributes" } )
+		self.assertEqual( bundle["bound"], scene.bound( "/group/sphere" ) )
+		self.assertEqual( bundle["attributes"], scene.attributes( "/group/sphere" ) )
+
+	def testChildLocationBundlesPerformance( self ) :
+
+		# A million instances under a single parent. Uncomment
+		# the prints to get useful timing information.
+
+		plane = GafferScene.Plane()
+		plane["divisions"].setValue( IECore.V2i( 999 ) )
+
+		sphere = GafferScene.Sphere()
+
+		instancer = GafferScene.Instancer()
+		instancer["in"].setInput( plane["out"] )
+		instancer["parent"].setValue( "/plane" )
+		instancer["instance"].setInput( sphere["out"] )
+
+		components = GafferScene.ScenePlug.LocationComponents.Bound | GafferScene.ScenePlug.LocationComponents.Transform
+
+		t = IECore.Timer()
+		bundles = instancer["out"].childLocationBundles( "/plane/instances", components )
+		#print "CHILDLOCATIONBUNDLES COMPUTE", t.stop()
+
+		t = IECore.Timer()
+		bundles = instancer["out"].childLocationBundles( "/plane/instances", components )
+		#print "CHILDLOCATIONBUNDLES CACHED", t.stop()
+
+		self.assertEqual( len( bundles ), 1000000 )
+		self.assertEqual( bundles[-1]["transform"], instancer["out"].transform( "/plane/instances/999999" ) )
+
 if __name__ == "__main__":
 	unittest.main()
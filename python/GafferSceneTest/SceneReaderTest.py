@@ -35,6 +35,7 @@
 ##########################################################################
 
 import os
+import time
 import unittest
 
 import IECore
@@ -492,6 +493,196 @@ class SceneReaderTest( GafferSceneTest.SceneTestCase ) :
 		r1 = GafferScene.SceneReader()
 		self.assertEqual( r1["out"].set( "blahblah" ).value.paths(), [] )
 
+	def __writeTaggedHierarchy( self, numGroups, numChildren ) :
+
+		s = IECore.SceneCache( self.__testFile, IECore.IndexedIO.OpenMode.Write )
+
+		expectedSets = {
+			"group" : GafferScene.PathMatcher(),
+			"even" : GafferScene.PathMatcher(),
+			"odd" : GafferScene.PathMatcher(),
+		}
+
+		for i in range( 0, numGroups ) :
+			group = s.createChild( "group%d" % i )
+			if i % 10 == 0 :
+				group.writeTags( [ "group" ] )
+				expectedSets["group"].addPath( "/group%d" % i )
+			for j in range( 0, numChildren ) :
+				child = group.createChild( "child%d" % j )
+				child.writeObject( IECore.SpherePrimitive(), 0 )
+				tag = "even" if j % 2 == 0 else "odd"
+				child.writeTags( [ tag ] )
+				expectedSets[tag].addPath( "/group%d/child%d" % ( i, j ) )
+				del child
+			del group
+
+		del s
+
+		return expectedSets
+
+	def testSetsFromTagIndex( self ) :
+
+		expectedSets = self.__writeTaggedHierarchy( 20, 10 )
+
+		r = GafferScene.SceneReader()
+		r["fileName"].setValue( self.__testFile )
+		r["refreshCount"].setValue( self.uniqueInt( self.__testFile ) )
+
+		for name, paths in expectedSets.items() :
+			self.assertEqual( r["out"].set( name ).value, paths )
+
+		self.assertEqual( r["out"].set( "notATag" ).value.paths(), [] )
+
+		# Tag filtering keeps locations which have the tag themselves,
+		# or on an ancestor or a descendant.
+
+		r["tags"].setValue( "group" )
+		self.assertEqual( [ str( x ) for x in r["out"].childNames( "/" ) ], [ "group%d" % i for i in range( 0, 20, 10 ) ] )
+		self.assertEqual( len( r["out"].childNames( "/group0" ) ), 10 )
+
+		r["tags"].setValue( "odd notATag" )
+		self.assertEqual( len( r["out"].childNames( "/" ) ), 20 )
+		self.assertEqual( [ str( x ) for x in r["out"].childNames( "/group1" ) ], [ "child%d" % j for j in range( 1, 10, 2 ) ] )
+
+		# Rewriting the file and refreshing must rebuild the index.
+
+		self.__writeTaggedHierarchy( 2, 2 )
+		r["tags"].setValue( "" )
+		r["refreshCount"].setValue( self.uniqueInt( self.__testFile ) )
+		self.assertEqual( r["out"].set( "odd" ).value.paths(), [ "/group0/child1", "/group1/child1" ] )
+
+	def testTagIndexPerformance( self ) :
+
+		self.__writeTaggedHierarchy( 10, 1000 )
+
+		r = GafferScene.SceneReader()
+		r["fileName"].setValue( self.__testFile )
+		r["refreshCount"].setValue( self.uniqueInt( self.__testFile ) )
+		r["tags"].setValue( "odd" )
+
+		t = IECore.Timer()
+		GafferScene.SceneAlgo.sets( r["out"] )
+		GafferSceneTest.traverseScene( r["out"] )
+		#print t.stop()
+
+	def __writeChildren( self, fileName, childNames ) :
+
+		s = IECore.SceneCache( fileName, IECore.IndexedIO.OpenMode.Write )
+		for name in childNames :
+			s.createChild( name )
+		del s
+
+	def testRefreshIsPerFile( self ) :
+
+		fileName1 = self.temporaryDirectory() + "/test1.scc"
+		fileName2 = self.temporaryDirectory() + "/test2.scc"
+
+		self.__writeChildren( fileName1, [ "a" ] )
+		self.__writeChildren( fileName2, [ "b" ] )
+
+		r1 = GafferScene.SceneReader()
+		r1["fileName"].setValue( fileName1 )
+		r1["refreshCount"].setValue( self.uniqueInt( fileName1 ) )
+
+		r2 = GafferScene.SceneReader()
+		r2["fileName"].setValue( fileName2 )
+		r2["refreshCount"].setValue( self.uniqueInt( fileName2 ) )
+
+		self.assertEqual( r1["out"].childNames( "/" ), IECore.InternedStringVectorData( [ "a" ] ) )
+		self.assertEqual( r2["out"].childNames( "/" ), IECore.InternedStringVectorData( [ "b" ] ) )
+
+		self.__writeChildren( fileName1, [ "c" ] )
+		self.__writeChildren( fileName2, [ "d" ] )
+
+		# Refreshing the first reader reloads its file, but
+		# doesn't evict the second file from the cache.
+
+		r1["refreshCount"].setValue( self.uniqueInt( fileName1 ) )
+		self.assertEqual( r1["out"].childNames( "/" ), IECore.InternedStringVectorData( [ "c" ] ) )
+
+		r3 = GafferScene.SceneReader()
+		r3["fileName"].setValue( fileName2 )
+		self.assertEqual( r3["out"].childNames( "/" ), IECore.InternedStringVectorData( [ "b" ] ) )
+
+		r2["refreshCount"].setValue( self.uniqueInt( fileName2 ) )
+		self.assertEqual( r2["out"].childNames( "/" ), IECore.InternedStringVectorData( [ "d" ] ) )
+
+	def testCachedScene( self ) :
+
+		self.__writeChildren( self.__testFile, [ "a" ] )
+
+		r1 = GafferScene.SceneReader()
+		r1["fileName"].setValue( self.__testFile )
+		r1["refreshCount"].setValue( self.uniqueInt( self.__testFile ) )
+		self.assertEqual( r1["out"].childNames( "/" ), IECore.InternedStringVectorData( [ "a" ] ) )
+
+		# Refreshing one reader reloads the scene shared by all
+		# readers of the file, including those created later.
+
+		self.__writeChildren( self.__testFile, [ "b" ] )
+		r1["refreshCount"].setValue( self.uniqueInt( self.__testFile ) )
+
+		r2 = GafferScene.SceneReader()
+		r2["fileName"].setValue( self.__testFile )
+		self.assertEqual( r2["out"].childNames( "/" ), IECore.InternedStringVectorData( [ "b" ] ) )
+
+	def testCachedSceneBoundSampleTimes( self ) :
+
+		s = IECore.SceneCache( self.__testFile, IECore.IndexedIO.OpenMode.Write )
+		c = s.createChild( "a" )
+		c.writeObject( IECore.SpherePrimitive( 1 ), 0.0 )
+		c.writeObject( IECore.SpherePrimitive( 2 ), 1.0 )
+		del c, s
+
+		r = GafferScene.SceneReader()
+		r["fileName"].setValue( self.__testFile )
+		r["refreshCount"].setValue( self.uniqueInt( self.__testFile ) )
+
+		self.assertEqual( GafferScene.SceneReader.cachedSceneBoundSampleTimes( self.__testFile ), [ 0.0, 1.0 ] )
+
+	def testRefreshOnFileChange( self ) :
+
+		self.__writeChildren( self.__testFile, [ "a" ] )
+
+		r = GafferScene.SceneReader()
+		r["fileName"].setValue( self.__testFile )
+		r["refreshCount"].setValue( self.uniqueInt( self.__testFile ) )
+		r["refreshOnFileChange"].setValue( True )
+
+		self.assertEqual( r["out"].childNames( "/" ), IECore.InternedStringVectorData( [ "a" ] ) )
+
+		# Make sure the modification time changes, even on
+		# file systems with a coarse resolution.
+		self.__writeChildren( self.__testFile, [ "b" ] )
+		modificationTime = os.stat( self.__testFile ).st_mtime + 10
+		os.utime( self.__testFile, ( modificationTime, modificationTime ) )
+
+		# The modification time is only queried once a second,
+		# so we must wait for the change to be seen.
+		time.sleep( 1.1 )
+		self.assertEqual( r["out"].childNames( "/" ), IECore.InternedStringVectorData( [ "b" ] ) )
+
+	def testTraversalPerformance( self ) :
+
+		s = IECore.SceneCache( self.__testFile, IECore.IndexedIO.OpenMode.Write )
+		for i in range( 0, 10 ) :
+			group = s.createChild( "group%d" % i )
+			for j in range( 0, 1000 ) :
+				child = group.createChild( "child%d" % j )
+				child.writeObject( IECore.SpherePrimitive(), 0 )
+				del child
+			del group
+		del s
+
+		r = GafferScene.SceneReader()
+		r["fileName"].setValue( self.__testFile )
+		r["refreshCount"].setValue( self.uniqueInt( self.__testFile ) )
+
+		t = IECore.Timer()
+		GafferSceneTest.traverseScene( r["out"] )
+		#print t.stop()
+
 	def testAlembic( self ) :
 
 		r = GafferScene.SceneReader()
@@ -275,5 +275,96 @@ class SceneWriterTest( GafferSceneTest.SceneTestCase ) :
 		ss = s.serialise()
 		self.assertFalse( "out" in ss )
 
+	def testStaticDataWrittenOnce( self ) :
+
+		script = Gaffer.ScriptNode()
+		script["sphere"] = GafferScene.Sphere()
+		script["group"] = GafferScene.Group()
+		script["group"]["in"][0].setInput( script["sphere"]["out"] )
+		script["expression"] = Gaffer.Expression()
+		script["expression"].setExpression( 'parent["group"]["transform"]["translate"]["x"] = context.getFrame()' )
+		script["writer"] = GafferScene.SceneWriter()
+		script["writer"]["in"].setInput( script["group"]["out"] )
+		script["writer"]["fileName"].setValue( self.temporaryDirectory() + "/test.scc" )
+
+		with Gaffer.Context() :
+			script["writer"].executeSequence( [ 3, 1, 2 ] )
+
+		sc = IECore.SceneCache( self.temporaryDirectory() + "/test.scc", IECore.IndexedIO.OpenMode.Read )
+
+		group = sc.child( "group" )
+		self.assertEqual( group.numTransformSamples(), 3 )
+		for frame in ( 1, 2, 3 ) :
+			self.assertEqual( group.readTransformAsMatrix( frame / 24.0 ), IECore.M44d.createTranslated( IECore.V3d( frame, 0, 0 ) ) )
+
+		sphere = group.child( "sphere" )
+		self.assertEqual( sphere.numObjectSamples(), 1 )
+		self.assertEqual( sphere.numTransformSamples(), 1 )
+		self.assertEqual( sphere.readObject( 0 ), script["sphere"]["out"].object( "/sphere" ) )
+
+	def testWriteMostlyStaticSequencePerformance( self ) :
+
+		# Ten thousand static locations, with only the
+		# parent transform animated. Uncomment the print
+		# to get useful timing information.
+
+		instancer, upstream = self.__instancedScene( IECore.V2i( 99 ) )
+
+		script = Gaffer.ScriptNode()
+		script["plane"] = upstream[0]
+		script["expression"] = Gaffer.Expression()
+		script["expression"].setExpression( 'parent["plane"]["transform"]["translate"]["x"] = context.getFrame()' )
+		script["writer"] = GafferScene.SceneWriter()
+		script["writer"]["in"].setInput( instancer["out"] )
+		script["writer"]["fileName"].setValue( self.temporaryDirectory() + "/test.scc" )
+
+		t = IECore.Timer()
+		with Gaffer.Context() :
+			script["writer"].executeSequence( range( 1, 25 ) )
+		#print t.stop()
+
+	def __instancedScene( self, divisions ) :
+
+		plane = GafferScene.Plane()
+		plane["divisions"].setValue( divisions )
+
+		sphere = GafferScene.Sphere()
+
+		instancer = GafferScene.Instancer()
+		instancer["in"].setInput( plane["out"] )
+		instancer["parent"].setValue( "/plane" )
+		instancer["instance"].setInput( sphere["out"] )
+
+		return instancer, ( plane, sphere )
+
+	def testWriteManyLocations( self ) :
+
+		instancer, upstream = self.__instancedScene( IECore.V2i( 49 ) )
+
+		writer = GafferScene.SceneWriter()
+		writer["in"].setInput( instancer["out"] )
+		writer["fileName"].setValue( self.temporaryDirectory() + "/test.scc" )
+		writer["task"].execute()
+
+		reader = GafferScene.SceneReader()
+		reader["fileName"].setInput( writer["fileName"] )
+
+		self.assertScenesEqual( reader["out"], instancer["out"], childPlugNames = ( "transform", "object" ) )
+
+	def testWritePerformance( self ) :
+
+		# Ten thousand locations. Uncomment the print
+		# to get useful timing information.
+
+		instancer, upstream = self.__instancedScene( IECore.V2i( 99 ) )
+
+		writer = GafferScene.SceneWriter()
+		writer["in"].setInput( instancer["out"] )
+		writer["fileName"].setValue( self.temporaryDirectory() + "/test.scc" )
+
+		t = IECore.Timer()
+		writer["task"].execute()
+		#print t.stop()
+
 if __name__ == "__main__":
 	unittest.main()
@@ -223,5 +223,55 @@ class SeedsTest( GafferSceneTest.SceneTestCase ) :
 		primitiveVariables["primitiveVariables"].addMember( "d", IECore.FloatData( 0.5 ) )
 		self.assertLessEqual( seeds["out"].object( "/plane/seeds" ).numPoints, p.numPoints )
 
+	def testParallelMatchesSerial( self ) :
+
+		plane = GafferScene.Plane()
+		plane["divisions"].setValue( IECore.V2i( 10 ) )
+
+		seeds = GafferScene.Seeds()
+		seeds["in"].setInput( plane["out"] )
+		seeds["parent"].setValue( "/plane" )
+		seeds["density"].setValue( 1000 )
+
+		self.assertFalse( seeds["parallel"].getValue() )
+		serialPoints = seeds["out"].object( "/plane/seeds" )
+		serialHash = seeds["out"].objectHash( "/plane/seeds" )
+
+		seeds["parallel"].setValue( True )
+		parallelPoints = seeds["out"].object( "/plane/seeds" )
+		self.assertNotEqual( seeds["out"].objectHash( "/plane/seeds" ), serialHash )
+
+		# The plane's uvs are undistorted, so the two methods
+		# should distribute the same points, albeit possibly in
+		# a different order.
+		self.assertEqual( parallelPoints.numPoints, serialPoints.numPoints )
+		self.assertEqual( parallelPoints["type"], serialPoints["type"] )
+
+		sortedPositions = lambda points : sorted( points["P"].data, key = lambda p : ( p.x, p.y, p.z ) )
+		for a, b in zip( sortedPositions( parallelPoints ), sortedPositions( serialPoints ) ) :
+			self.assertTrue( a.equalWithAbsError( b, 0.0001 ) )
+
+	def testPerformance( self ) :
+
+		plane = GafferScene.Plane()
+		plane["divisions"].setValue( IECore.V2i( 100 ) )
+
+		seeds = GafferScene.Seeds()
+		seeds["in"].setInput( plane["out"] )
+		seeds["parent"].setValue( "/plane" )
+		seeds["density"].setValue( 10000 )
+
+		plane["out"].object( "/plane" )
+
+		t = IECore.Timer()
+		seeds["out"].object( "/plane/seeds" )
+		#print "SERIAL", t.stop()
+
+		seeds["parallel"].setValue( True )
+
+		t = IECore.Timer()
+		seeds["out"].object( "/plane/seeds" )
+		#print "PARALLEL", t.stop()
+
 if __name__ == "__main__":
 	unittest.main()
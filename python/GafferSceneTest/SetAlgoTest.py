@@ -35,9 +35,11 @@
 ##########################################################################
 
 import functools
+import inspect
 
 import IECore
 
+import Gaffer
 import GafferScene
 import GafferSceneTest
 
@@ -159,6 +161,65 @@ class SetAlgoTest( GafferSceneTest.SceneTestCase ) :
 		self.assertCorrectEvaluation( setA["out"], "MySets:setA", [ "/MyObject:sphere1" ] )
 		self.assertCorrectEvaluation( setA["out"], "/MyObject:sphere1", [ "/MyObject:sphere1" ] )
 
+	def testLargeSets( self ) :
+
+		# Wide enough for the set operations to be parallelised.
+
+		setA = GafferScene.Set( "SetA" )
+		setA["name"].setValue( "setA" )
+		setA["paths"].setValue( IECore.StringVectorData( [ "/a/b{0}/c".format( i ) for i in range( 0, 1000 ) ] ) )
+
+		setB = GafferScene.Set( "SetB" )
+		setB["in"].setInput( setA["out"] )
+		setB["name"].setValue( "setB" )
+		setB["paths"].setValue( IECore.StringVectorData( [ "/a/b{0}".format( i ) for i in range( 500, 1500 ) ] ) )
+
+		setC = GafferScene.Set( "SetC" )
+		setC["in"].setInput( setB["out"] )
+		setC["name"].setValue( "setC" )
+		setC["paths"].setValue( IECore.StringVectorData( [ "/a/b{0}/c".format( i ) for i in range( 0, 1000, 3 ) ] ) )
+
+		setD = GafferScene.Set( "SetD" )
+		setD["in"].setInput( setC["out"] )
+		setD["name"].setValue( "setD" )
+		setD["paths"].setValue( IECore.StringVectorData( [ "/a/b{0}/c".format( i ) for i in range( 0, 2000, 2 ) ] + [ "/a/b{0}".format( i ) for i in range( 0, 2000, 2 ) ] ) )
+
+		sets = { n : set( setD["out"].set( n ).value.paths() ) for n in ( "setA", "setB", "setC", "setD" ) }
+
+		self.assertCorrectEvaluation( setD["out"], "setA | setB", sets["setA"] | sets["setB"] )
+		self.assertCorrectEvaluation( setD["out"], "setA & setD", sets["setA"] & sets["setD"] )
+		self.assertCorrectEvaluation( setD["out"], "setA - setC", sets["setA"] - sets["setC"] )
+		self.assertCorrectEvaluation( setD["out"], "(setA | setB) - setC & setD", ( ( sets["setA"] | sets["setB"] ) - sets["setC"] ) & sets["setD"] )
+		self.assertCorrectEvaluation( setD["out"], "(setA | setB) - (setC | setD)", ( sets["setA"] | sets["setB"] ) - ( sets["setC"] | sets["setD"] ) )
+
+	def testConcurrentOperandsUseContext( self ) :
+
+		setA = GafferScene.Set( "SetA" )
+		setA["name"].setValue( "setA" )
+
+		setB = GafferScene.Set( "SetB" )
+		setB["in"].setInput( setA["out"] )
+		setB["name"].setValue( "setB" )
+
+		script = Gaffer.ScriptNode()
+		script["setA"] = setA
+		script["setB"] = setB
+		script["expression"] = Gaffer.Expression()
+		script["expression"].setExpression( inspect.cleandoc(
+			"""
+			f = int( context.getFrame() )
+			parent["setA"]["paths"] = IECore.StringVectorData( [ "/a{0}".format( f ), "/b" ] )
+			parent["setB"]["paths"] = IECore.StringVectorData( [ "/c{0}".format( f ), "/b" ] )
+			"""
+		) )
+
+		for frame in range( 0, 10 ) :
+			with Gaffer.Context() as c :
+				c.setFrame( frame )
+				self.assertCorrectEvaluation( setB["out"], "setA | setB", [ "/a{0}".format( frame ), "/b", "/c{0}".format( frame ) ] )
+				self.assertCorrectEvaluation( setB["out"], "setA & setB", [ "/b" ] )
+				self.assertCorrectEvaluation( setB["out"], "setA - setB", [ "/a{0}".format( frame ) ] )
+
 	def assertCorrectEvaluation( self, scenePlug, expression, expectedContents ) :
 
 		result = set( GafferScene.SetAlgo.evaluateSetExpression( expression, scenePlug ).paths() )
@@ -45,6 +45,25 @@ import GafferSceneTest
 
 class SetFilterTest( GafferSceneTest.SceneTestCase ) :
 
+	def testMatchingPaths( self ) :
+
+		p = GafferScene.Plane()
+		s = GafferScene.Set()
+		s["in"].setInput( p["out"] )
+		s["paths"].setValue( IECore.StringVectorData( [ "/plane" ] ) )
+
+		f = GafferScene.SetFilter()
+		f["setExpression"].setValue( "set" )
+		self.assertTrue( f.canComputeMatchingPaths() )
+
+		with Gaffer.Context() as c :
+
+			GafferScene.Filter.setInputScene( c, s["out"] )
+			self.assertEqual( f["__matchingPaths"].getValue().value, GafferScene.PathMatcher( [ "/plane" ] ) )
+
+			f["enabled"].setValue( False )
+			self.assertTrue( f["__matchingPaths"].getValue().value.isEmpty() )
+
 	def test( self ) :
 
 		p1 = GafferScene.Plane()
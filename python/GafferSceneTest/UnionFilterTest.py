@@ -246,5 +246,43 @@ class UnionFilterTest( GafferSceneTest.SceneTestCase ) :
 			c["scene:path"] = IECore.InternedStringVectorData( [ "b" ] )
 			self.assertEqual( unionFilter["out"].getValue(), unionFilter.Result.NoMatch )
 
+	def testMatchingPaths( self ) :
+
+		pathFilterA = GafferScene.PathFilter()
+		pathFilterB = GafferScene.PathFilter()
+
+		pathFilterA["paths"].setValue( IECore.StringVectorData( [ "/a" ] ) )
+		pathFilterB["paths"].setValue( IECore.StringVectorData( [ "/b" ] ) )
+
+		unionFilter = GafferScene.UnionFilter()
+		self.assertTrue( unionFilter.canComputeMatchingPaths() )
+		self.assertTrue( unionFilter["__matchingPaths"].getValue().value.isEmpty() )
+
+		unionFilter["in"][0].setInput( pathFilterA["out"] )
+		unionFilter["in"][1].setInput( pathFilterB["out"] )
+
+		self.assertTrue( unionFilter.canComputeMatchingPaths() )
+		self.assertEqual( unionFilter["__matchingPaths"].getValue().value, GafferScene.PathMatcher( [ "/a", "/b" ] ) )
+
+		pathFilterB["enabled"].setValue( False )
+		self.assertEqual( unionFilter["__matchingPaths"].getValue().value, GafferScene.PathMatcher( [ "/a" ] ) )
+
+		pathFilterB["enabled"].setValue( True )
+		unionFilter["enabled"].setValue( False )
+		self.assertEqual( unionFilter["__matchingPaths"].getValue().value, GafferScene.PathMatcher( [ "/a" ] ) )
+
+		# Filters without bulk support mean that the union
+		# must be evaluated per location.
+
+		s = Gaffer.ScriptNode()
+		s["switch"] = GafferScene.FilterSwitch()
+		s["expression"] = Gaffer.Expression()
+		s["expression"].setExpression( 'parent["switch"]["index"] = 0' )
+		self.assertFalse( s["switch"].canComputeMatchingPaths() )
+
+		unionFilter["in"][2].setInput( s["switch"]["out"] )
+		self.assertFalse( unionFilter.canComputeMatchingPaths() )
+		self.assertEqual( GafferScene.Filter.matchingPathsFilter( unionFilter["out"] ), None )
+
 if __name__ == "__main__":
 	unittest.main()
@@ -81,6 +81,7 @@ from MapOffsetTest import MapOffsetTest
 from PointConstraintTest import PointConstraintTest
 from SceneReaderTest import SceneReaderTest
 from SceneWriterTest import SceneWriterTest
+from MappedSceneReaderTest import MappedSceneReaderTest
 from IsolateTest import IsolateTest
 from DeleteAttributesTest import DeleteAttributesTest
 from UnionFilterTest import UnionFilterTest
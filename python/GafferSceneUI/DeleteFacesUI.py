@@ -53,6 +53,15 @@ Gaffer.Metadata.registerNode(
 			"""
 			Uniformly interpolated int, float or bool primitive variable to choose which faces to delete. Note a non-zero value indicates the face will be deleted.  
 			"""
+		],
+
+		"parallel" : [
+			"description",
+			"""
+			Deletes the faces using multiple threads. This is off by
+			default, so that the original single threaded implementation
+			is used unless the parallel one is explicitly requested.
+			"""
 		]
 	}
 
@@ -105,6 +105,69 @@ Gaffer.Metadata.registerNode(
 
 		],
 
+		"approximateBounds" : [
+
+			"description",
+			"""
+			Computes the bounds of the instances using the
+			bound of the first instance only, rather than by
+			evaluating every instance individually. This is
+			much quicker for large numbers of points, and gives
+			exact results provided that the instance doesn't
+			vary according to the ${instancer:id} variable.
+			""",
+
+		],
+
+		"prototypeRoots" : [
+
+			"description",
+			"""
+			Enables prototype mode, in which each point chooses
+			one of a small set of prototypes from the instance
+			scene, specified here as the paths to their root
+			locations. Each prototype is evaluated only once and
+			shared between all the instances using it, which is
+			much faster for large numbers of points. Note that
+			the ${instancer:id} variable is not available in this
+			mode.
+			""",
+
+		],
+
+		"prototypeIndex" : [
+
+			"description",
+			"""
+			The name of an integer primitive variable used to
+			choose the prototype for each point. Indices are wrapped
+			to the number of prototypes, and if the variable doesn't
+			exist, the first prototype is used for all points.
+			""",
+
+		],
+
+		"orientation" : [
+
+			"description",
+			"""
+			The name of a quaternion primitive variable used to
+			orient the instances.
+			""",
+
+		],
+
+		"scale" : [
+
+			"description",
+			"""
+			The name of a primitive variable used to scale the
+			instances. This may either be a vector, for non-uniform
+			scaling, or a float.
+			""",
+
+		],
+
 	}
 
 )
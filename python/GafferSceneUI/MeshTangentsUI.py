@@ -81,6 +81,15 @@ Gaffer.Metadata.registerNode(
 			"""
 			Name of the primitive variable which will contain the vTangent data. 
 			""",
+		],
+
+		"parallel" : [
+			"description",
+			"""
+			Computes the tangents using multiple threads. This is off
+			by default, so that the original single threaded implementation
+			is used unless the parallel one is explicitly requested.
+			""",
 		]
 	}
 
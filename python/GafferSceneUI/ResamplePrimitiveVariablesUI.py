@@ -180,6 +180,19 @@ Gaffer.Metadata.registerNode(
 
 			"plugValueWidget:type", "GafferUI.PresetsPlugValueWidget",
 
+		],
+
+		"parallel" : [
+
+			"description",
+			"""
+			Resamples mesh primitive variables using multiple threads.
+			Indexed primitive variables and conversions to or from Constant
+			interpolation always use the single threaded implementation,
+			which is also used for everything when this is turned off,
+			as it is by default.
+			""",
+
 		]
 	}
 
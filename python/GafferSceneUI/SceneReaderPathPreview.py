@@ -140,12 +140,10 @@ class SceneReaderPathPreview( GafferUI.PathPreviewWidget ) :
 			self.__script["SceneReader"]["fileName"].setValue( fileName )
 			outPlug = self.__script["SceneReader"]["out"]
 
-			scene = IECore.SharedSceneInterfaces.get( fileName )
-			if hasattr( scene, "numBoundSamples" ) :
-				numSamples = scene.numBoundSamples()
-				if numSamples > 1 :
-					startFrame = int( round( scene.boundSampleTime( 0 ) * 24.0 ) )
-					endFrame = int( round( scene.boundSampleTime( numSamples - 1 ) * 24.0 ) )
+			sampleTimes = GafferScene.SceneReader.cachedSceneBoundSampleTimes( fileName )
+			if len( sampleTimes ) > 1 :
+				startFrame = int( round( sampleTimes[0] * 24.0 ) )
+				endFrame = int( round( sampleTimes[-1] * 24.0 ) )
 
 		elif ext in IECore.Reader.supportedExtensions() :
 
@@ -100,6 +100,19 @@ Gaffer.Metadata.registerNode(
 
 		],
 
+		"refreshOnFileChange" : [
+
+			"description",
+			"""
+			Automatically reloads the file when it is modified
+			on disk, without needing to increment the refresh
+			count. The modification time of the file is queried
+			at most once a second, so changes may take up to a
+			second to be detected.
+			""",
+
+		],
+
 	}
 
 )
@@ -129,13 +142,12 @@ def __tagsPopupMenu( menuDefinition, plugValueWidget ) :
 	if plug != node["tags"] :
 		return
 
-	fileName = plugValueWidget.getContext().substitute( node["fileName"].getValue() )
 	try :
-		scene = IECore.SharedSceneInterfaces.get( fileName )
+		with plugValueWidget.getContext() :
+			sceneTags = node["out"]["setNames"].getValue()
 	except :
 		return
 
-	sceneTags = scene.readTags( scene.TagFilter.EveryTag )
 	if not sceneTags :
 		return
 	sceneTags = sorted( [ str( tag ) for tag in sceneTags ] )
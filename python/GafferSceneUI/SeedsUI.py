@@ -113,6 +113,21 @@ Gaffer.Metadata.registerNode(
 
 			"plugValueWidget:type", "GafferUI.PresetsPlugValueWidget",
 
+		],
+
+		"parallel" : [
+
+			"description",
+			"""
+			Distributes the points over the faces of the mesh using
+			multiple threads. Turning this off uses the original single
+			threaded implementation, which triangulates the whole mesh
+			first. The parallel implementation measures density triangle
+			by triangle, so results may differ slightly where the uvs are
+			distorted relative to the surface. For this reason it is off
+			by default, so that existing scenes are unchanged.
+			""",
+
 		]
 
 	}
@@ -99,6 +99,8 @@ import ParametersUI
 import TextUI
 import AimConstraintUI
 import AlembicSourceUI
+import MappedSceneReaderUI
+import MappedSceneWriterUI
 import CoordinateSystemUI
 import DeleteAttributesUI
 import SeedsUI
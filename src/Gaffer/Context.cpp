@@ -45,12 +45,14 @@ static char **environ = *_NSGetEnviron();
 #endif
 
 #include <stack>
+#include <cassert>
 
 #include "tbb/enumerable_thread_specific.h"
 
 #include "boost/lexical_cast.hpp"
 
 #include "IECore/SimpleTypedData.h"
+#include "IECore/VectorTypedData.h"
 
 #include "Gaffer/Context.h"
 
@@ -208,6 +210,12 @@ void Context::removeMatching( const StringAlgo::MatchPattern &pattern )
 
 void Context::changed( const IECore::InternedString &name )
 {
+	Map::iterator it = m_map.find( name );
+	if( it != m_map.end() )
+	{
+		it->second.hashValid = false;
+	}
+
 	m_hashValid = false;
 	if( m_changedSignal )
 	{
@@ -288,13 +296,36 @@ IECore::MurmurHash Context::hash() const
 		{
 			continue;
 		}
+		const Storage &s = it->second;
+		if( !s.hashValid )
+		{
+			s.hash = variableHash( s.data );
+			s.hashValid = true;
+		}
 		m_hash.append( (uint64_t)&name );
-		it->second.data->hash( m_hash );
+		m_hash.append( s.hash );
 	}
 	m_hashValid = true;
 	return m_hash;
 }
 
+IECore::MurmurHash Context::variableHash( const IECore::Data *value )
+{
+	if( const InternedStringVectorData *v = runTimeCast<const InternedStringVectorData>( value ) )
+	{
+		IECore::MurmurHash result;
+		result.append( (int)InternedStringVectorDataTypeId );
+		const std::vector<InternedString> &names = v->readable();
+		for( std::vector<InternedString>::const_iterator it = names.begin(), eIt = names.end(); it != eIt; ++it )
+		{
+			result.append( *it );
+		}
+		return result;
+	}
+
+	return value->Object::hash();
+}
+
 bool Context::operator == ( const Context &other ) const
 {
 	if( m_map.size() != other.m_map.size() )
@@ -566,6 +597,33 @@ Context::EditableScope::~EditableScope()
 	stack.pop();
 }
 
+void Context::EditableScope::set( const IECore::InternedString &name, const IECore::Data *value, const IECore::MurmurHash &valueHash )
+{
+	// We trust the caller for performance, but check in debug builds.
+	assert( valueHash == Context::variableHash( value ) );
+
+	Storage &s = m_context->m_map[name];
+	if( s.data == value && s.hashValid && s.hash == valueHash )
+	{
+		return;
+	}
+
+	if( s.data && s.ownership != Borrowed )
+	{
+		s.data->removeRef();
+	}
+
+	s.data = value;
+	s.ownership = Borrowed;
+	s.hash = valueHash;
+	s.hashValid = true;
+	m_context->m_hashValid = false;
+	if( m_context->m_changedSignal )
+	{
+		(*m_context->m_changedSignal)( m_context.get(), name );
+	}
+}
+
 void Context::EditableScope::setFrame( float frame )
 {
 	m_context->setFrame( frame );
@@ -294,6 +294,7 @@ class ArnoldRendererBase : public IECoreScenePreview::Renderer
 		ObjectInterfacePtr light( const std::string &name, const IECore::Object *object, const AttributesInterface *attributes ) override;
 		Renderer::ObjectInterfacePtr object( const std::string &name, const IECore::Object *object, const AttributesInterface *attributes ) override;
 		ObjectInterfacePtr object( const std::string &name, const std::vector<const IECore::Object *> &samples, const std::vector<float> &times, const AttributesInterface *attributes ) override;
+		ObjectInterfacePtr instance( const std::string &name, const Prototype *prototype, const AttributesInterface *attributes ) override;
 
 	protected :
 
@@ -1406,6 +1407,31 @@ class InstanceCache : public IECore::RefCounted
 			return Instance( a->second, m_nodeDeleter, nodeName, m_parentNode );
 		}
 
+		// As above, but using the hash provided by the prototype rather
+		// than hashing the object samples.
+		Instance get( const IECoreScenePreview::Renderer::Prototype *prototype, const IECoreScenePreview::Renderer::AttributesInterface *attributes, const std::string &nodeName )
+		{
+			const ArnoldAttributes *arnoldAttributes = static_cast<const ArnoldAttributes *>( attributes );
+			const IECore::Object *object = prototype->samples().front().get();
+
+			if( !canInstance( object, arnoldAttributes ) )
+			{
+				return Instance( convert( prototype, arnoldAttributes, nodeName ) );
+			}
+
+			IECore::MurmurHash h = prototype->hash();
+			arnoldAttributes->hashGeometry( object, h );
+
+			Cache::accessor a;
+			m_cache.insert( a, h );
+			if( !a->second )
+			{
+				a->second = convert( prototype, arnoldAttributes, "instance:" + h.toString() );
+			}
+
+			return Instance( a->second, m_nodeDeleter, nodeName, m_parentNode );
+		}
+
 		// Must not be called concurrently with anything.
 		void clearUnused()
 		{
@@ -1504,6 +1530,22 @@ class InstanceCache : public IECore::RefCounted
 
 		}
 
+		SharedAtNodePtr convert( const IECoreScenePreview::Renderer::Prototype *prototype, const ArnoldAttributes *attributes, const std::string &nodeName )
+		{
+			if( prototype->times().empty() )
+			{
+				return convert( prototype->samples().front().get(), attributes, nodeName );
+			}
+
+			std::vector<const IECore::Object *> samples;
+			samples.reserve( prototype->samples().size() );
+			for( std::vector<IECore::ConstObjectPtr>::const_iterator it = prototype->samples().begin(), eIt = prototype->samples().end(); it != eIt; ++it )
+			{
+				samples.push_back( it->get() );
+			}
+			return convert( samples, prototype->times(), attributes, nodeName );
+		}
+
 		NodeDeleter m_nodeDeleter;
 		AtNode *m_parentNode;
 
@@ -1824,6 +1866,17 @@ class ProceduralRenderer final : public ArnoldRendererBase
 			return result;
 		}
 
+		ObjectInterfacePtr instance( const std::string &name, const Prototype *prototype, const AttributesInterface *attributes ) override
+		{
+			ArnoldObjectPtr result = static_pointer_cast<ArnoldObject>(
+				ArnoldRendererBase::instance( name, prototype, attributes )
+			);
+
+			NodesCreatedMutex::scoped_lock lock( m_nodesCreatedMutex );
+			result->instance().nodesCreated( m_nodesCreated );
+			return result;
+		}
+
 		virtual void render() override
 		{
 			IECore::msg( IECore::Msg::Warning, "ArnoldRenderer", "Procedurals can not call render()" );
@@ -2614,6 +2667,14 @@ ArnoldRendererBase::ObjectInterfacePtr ArnoldRendererBase::object( const std::st
 	return result;
 }
 
+ArnoldRendererBase::ObjectInterfacePtr ArnoldRendererBase::instance( const std::string &name, const Prototype *prototype, const AttributesInterface *attributes )
+{
+	Instance instance = m_instanceCache->get( prototype, attributes, name );
+	ObjectInterfacePtr result = new ArnoldObject( instance );
+	result->attributes( attributes );
+	return result;
+}
+
 } // namespace
 
 //////////////////////////////////////////////////////////////////////////
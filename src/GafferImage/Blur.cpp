@@ -39,6 +39,7 @@
 #include "GafferImage/Blur.h"
 #include "GafferImage/Resample.h"
 #include "GafferImage/FilterAlgo.h"
+#include "GafferImage/FormatPlug.h"
 
 using namespace Imath;
 using namespace Gaffer;
@@ -188,6 +189,7 @@ void Blur::hash( const ValuePlug *output, const Context *context, IECore::Murmur
 	if( output->parent<ValuePlug>() == filterScalePlug() )
 	{
 		radiusPlug()->getChild<ValuePlug>( output->getName() )->hash( h );
+		h.append( FormatPlug::getProxyScale( context ) );
 	}
 }
 
@@ -207,8 +209,12 @@ void Blur::compute( ValuePlug *output, const Context *context ) const
 		// that we are just sampling straight back onto the same pixel centers, we know this isn't a
 		// problem for blur.
 
+		// The radius is specified in full resolution pixels, so must be reduced
+		// to match when we're evaluated at a proxy resolution.
+		const float radius = radiusPlug()->getChild<FloatPlug>( output->getName() )->getValue() / (float)FormatPlug::getProxyScale( context );
+
 		static_cast<FloatPlug *>( output )->setValue(
-			2.0f / filterSupport * ( 1.0f + radiusPlug()->getChild<FloatPlug>( output->getName() )->getValue() )
+			2.0f / filterSupport * ( 1.0f + radius )
 		);
 		return;
 	}
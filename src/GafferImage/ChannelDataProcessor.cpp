@@ -35,13 +35,21 @@
 //
 //////////////////////////////////////////////////////////////////////////
 
+#include "Gaffer/Context.h"
 #include "Gaffer/StringAlgo.h"
 
 #include "GafferImage/ChannelDataProcessor.h"
+#include "GafferImage/Private/SharedPlaneScope.h"
 
+using namespace Imath;
+using namespace IECore;
 using namespace Gaffer;
 using namespace GafferImage;
 
+//////////////////////////////////////////////////////////////////////////
+// ChannelDataProcessor
+//////////////////////////////////////////////////////////////////////////
+
 IE_CORE_DEFINERUNTIMETYPED( ChannelDataProcessor );
 
 size_t ChannelDataProcessor::g_firstPlugIndex = 0;
@@ -52,6 +60,7 @@ ChannelDataProcessor::ChannelDataProcessor( const std::string &name )
 	storeIndexOfNextChild( g_firstPlugIndex );
 
 	addChild( new StringPlug( "channels", Gaffer::Plug::In, "[RGB]" ) );
+	addChild( new FloatVectorDataPlug( "__sharedPlane", Gaffer::Plug::Out, ImagePlug::blackTile() ) );
 
 	// We don't ever want to change these, so we make pass-through connections.
 	outPlug()->formatPlug()->setInput( inPlug()->formatPlug() );
@@ -74,17 +83,56 @@ const Gaffer::StringPlug *ChannelDataProcessor::channelsPlug() const
 	return getChild<StringPlug>( g_firstPlugIndex );
 }
 
+Gaffer::FloatVectorDataPlug *ChannelDataProcessor::sharedPlanePlug()
+{
+	return getChild<FloatVectorDataPlug>( g_firstPlugIndex + 1 );
+}
+
+const Gaffer::FloatVectorDataPlug *ChannelDataProcessor::sharedPlanePlug() const
+{
+	return getChild<FloatVectorDataPlug>( g_firstPlugIndex + 1 );
+}
+
 void ChannelDataProcessor::affects( const Gaffer::Plug *input, AffectedPlugsContainer &outputs ) const
 {
 	ImageProcessor::affects( input, outputs );
 
 	if(
 		input == inPlug()->channelDataPlug() ||
-		input == channelsPlug()
+		input == channelsPlug() ||
+		input == sharedPlanePlug()
 	)
 	{
 		outputs.push_back( outPlug()->channelDataPlug() );
 	}
+
+	if( affectsSharedPlane( input ) )
+	{
+		outputs.push_back( sharedPlanePlug() );
+	}
+}
+
+void ChannelDataProcessor::hash( const Gaffer::ValuePlug *output, const Gaffer::Context *context, IECore::MurmurHash &h ) const
+{
+	ImageProcessor::hash( output, context, h );
+
+	if( output == sharedPlanePlug() )
+	{
+		hashSharedPlane( context->get<V2i>( ImagePlug::tileOriginContextName ), context, h );
+	}
+}
+
+void ChannelDataProcessor::compute( Gaffer::ValuePlug *output, const Gaffer::Context *context ) const
+{
+	if( output == sharedPlanePlug() )
+	{
+		static_cast<FloatVectorDataPlug *>( output )->setValue(
+			computeSharedPlane( context->get<V2i>( ImagePlug::tileOriginContextName ), context )
+		);
+		return;
+	}
+
+	ImageProcessor::compute( output, context );
 }
 
 bool ChannelDataProcessor::channelEnabled( const std::string &channel ) const
@@ -103,3 +151,29 @@ IECore::ConstFloatVectorDataPtr ChannelDataProcessor::computeChannelData( const
 	processChannelData( context, parent, channelName, outData );
 	return outData;
 }
+
+bool ChannelDataProcessor::affectsSharedPlane( const Gaffer::Plug *input ) const
+{
+	return false;
+}
+
+void ChannelDataProcessor::hashSharedPlane( const Imath::V2i &tileOrigin, const Gaffer::Context *context, IECore::MurmurHash &h ) const
+{
+}
+
+IECore::ConstFloatVectorDataPtr ChannelDataProcessor::computeSharedPlane( const Imath::V2i &tileOrigin, const Gaffer::Context *context ) const
+{
+	throw IECore::NotImplementedException( std::string( typeName() ) + "::computeSharedPlane" );
+}
+
+IECore::MurmurHash ChannelDataProcessor::sharedPlaneHash( const Gaffer::Context *context ) const
+{
+	GafferImage::Private::SharedPlaneScope s( context );
+	return sharedPlanePlug()->hash();
+}
+
+IECore::ConstFloatVectorDataPtr ChannelDataProcessor::sharedPlane( const Gaffer::Context *context ) const
+{
+	GafferImage::Private::SharedPlaneScope s( context );
+	return sharedPlanePlug()->getValue();
+}
@@ -37,6 +37,7 @@
 #include "Gaffer/Context.h"
 
 #include "GafferImage/Clamp.h"
+#include "GafferImage/ColorAlgo.h"
 #include "GafferImage/ImageAlgo.h"
 
 using namespace IECore;
@@ -218,41 +219,9 @@ void Clamp::processChannelData( const Gaffer::Context *context, const ImagePlug
 	const bool maxClampToEnabled = maxClampToEnabledPlug()->getValue();
 
 	std::vector<float> &out = outData->writable();
-
-	std::vector<float>::iterator outDataIterator;
-
-	for (outDataIterator = out.begin(); outDataIterator != out.end(); ++outDataIterator)
-	{
-
-		if (minimumEnabled)
-		{
-			if (*outDataIterator < minimum)
-			{
-				if (minClampToEnabled)
-				{
-					*outDataIterator = minClampTo;
-				}
-				else
-				{
-					*outDataIterator = minimum;
-				}
-			}
-		}
-
-		if (maximumEnabled)
-		{
-			if (*outDataIterator > maximum)
-			{
-				if (maxClampToEnabled)
-				{
-					*outDataIterator = maxClampTo;
-				}
-				else
-				{
-					*outDataIterator = maximum;
-				}
-			}
-		}
-
-	}
+	ColorAlgo::clamp(
+		out.data(), out.size(),
+		minimumEnabled, minimum, minClampToEnabled ? minClampTo : minimum,
+		maximumEnabled, maximum, maxClampToEnabled ? maxClampTo : maximum
+	);
 }
@@ -0,0 +1,172 @@
+//////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (c) 2018, Image Engine Design Inc. All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//
+//      * Redistributions of source code must retain the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer.
+//
+//      * Redistributions in binary form must reproduce the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer in the documentation and/or other materials provided with
+//        the distribution.
+//
+//      * Neither the name of John Haddon nor the names of
+//        any other contributors to this software may be used to endorse or
+//        promote products derived from this software without specific prior
+//        written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+//  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+//  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+//  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+//  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+//  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+//  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+//  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//////////////////////////////////////////////////////////////////////////
+
+#include "GafferImage/ColorAlgo.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+using namespace GafferImage;
+
+//////////////////////////////////////////////////////////////////////////
+// Internal utilities
+//////////////////////////////////////////////////////////////////////////
+
+namespace
+{
+
+enum GammaMode
+{
+	NoGamma,
+	ExactGamma,
+	FastGamma
+};
+
+// The options are template parameters so that each combination gets
+// its own loop, free of the branches that would otherwise prevent
+// vectorisation.
+template<GammaMode gammaMode, bool blackClamp, bool whiteClamp>
+void gradeLoop( float * __restrict data, size_t size, float a, float b, float invGamma )
+{
+	for( size_t i = 0; i < size; ++i )
+	{
+		float c = a * data[i] + b;
+		if( gammaMode == ExactGamma )
+		{
+			c = c >= 0.0f ? std::pow( c, invGamma ) : c;
+		}
+		else if( gammaMode == FastGamma )
+		{
+			// fastPow() returns 0 for negative values, so we can pass
+			// them through without a conditional. See comments in
+			// fastPow() for why we avoid conditionals here.
+			c = ColorAlgo::fastPow( c, invGamma ) + std::min( c, 0.0f );
+		}
+		if( blackClamp )
+		{
+			c = c < 0.0f ? 0.0f : c;
+		}
+		if( whiteClamp )
+		{
+			c = c > 1.0f ? 1.0f : c;
+		}
+		data[i] = c;
+	}
+}
+
+template<GammaMode gammaMode>
+void gradeLoop( float *data, size_t size, float a, float b, float invGamma, bool blackClamp, bool whiteClamp )
+{
+	if( blackClamp )
+	{
+		if( whiteClamp )
+		{
+			gradeLoop<gammaMode, true, true>( data, size, a, b, invGamma );
+		}
+		else
+		{
+			gradeLoop<gammaMode, true, false>( data, size, a, b, invGamma );
+		}
+	}
+	else
+	{
+		if( whiteClamp )
+		{
+			gradeLoop<gammaMode, false, true>( data, size, a, b, invGamma );
+		}
+		else
+		{
+			gradeLoop<gammaMode, false, false>( data, size, a, b, invGamma );
+		}
+	}
+}
+
+} // namespace
+
+//////////////////////////////////////////////////////////////////////////
+// Kernels
+//////////////////////////////////////////////////////////////////////////
+
+namespace GafferImage
+{
+
+namespace ColorAlgo
+{
+
+void grade( float *data, size_t size, float a, float b, float invGamma, bool blackClamp, bool whiteClamp, bool fast )
+{
+	if( invGamma == 1.0f )
+	{
+		gradeLoop<NoGamma>( data, size, a, b, invGamma, blackClamp, whiteClamp );
+	}
+	else if( fast && std::abs( invGamma ) < 1e6f )
+	{
+		// The condition is written so that NaN exponents also
+		// fall back to the exact path.
+		gradeLoop<FastGamma>( data, size, a, b, invGamma, blackClamp, whiteClamp );
+	}
+	else
+	{
+		gradeLoop<ExactGamma>( data, size, a, b, invGamma, blackClamp, whiteClamp );
+	}
+}
+
+void clamp( float * __restrict data, size_t size, bool minimumEnabled, float minimum, float minClampTo, bool maximumEnabled, float maximum, float maxClampTo )
+{
+	// Disabled limits are replaced with values which never
+	// trigger, so that a single loop serves all cases.
+	if( !minimumEnabled )
+	{
+		minimum = -std::numeric_limits<float>::infinity();
+	}
+	if( !maximumEnabled )
+	{
+		maximum = std::numeric_limits<float>::infinity();
+	}
+
+	for( size_t i = 0; i < size; ++i )
+	{
+		float c = data[i];
+		c = c < minimum ? minClampTo : c;
+		c = c > maximum ? maxClampTo : c;
+		data[i] = c;
+	}
+}
+
+} // namespace ColorAlgo
+
+} // namespace GafferImage
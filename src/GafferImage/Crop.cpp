@@ -35,6 +35,8 @@
 //
 //////////////////////////////////////////////////////////////////////////
 
+#include "OpenEXR/ImathFun.h"
+
 #include "GafferImage/Crop.h"
 #include "GafferImage/BufferAlgo.h"
 #include "GafferImage/Offset.h"
@@ -45,6 +47,19 @@ using namespace IECore;
 using namespace Gaffer;
 using namespace GafferImage;
 
+namespace
+{
+
+// As for the Offset node, our offset is in full resolution pixels.
+V2i proxyOffset( const V2iPlug *offsetPlug, const Context *context )
+{
+	const int proxyScale = FormatPlug::getProxyScale( context );
+	const V2i offset = offsetPlug->getValue();
+	return V2i( divp( offset.x, proxyScale ), divp( offset.y, proxyScale ) );
+}
+
+} // namespace
+
 IE_CORE_DEFINERUNTIMETYPED( Crop );
 
 size_t Crop::g_firstPlugIndex = 0;
@@ -248,7 +263,7 @@ GafferImage::Format Crop::computeFormat( const Gaffer::Context *context, const I
 	}
 
 	Imath::Box2i displayWindow = cropWindowPlug()->getValue();
-	const Imath::V2i offset = offsetPlug()->getValue();
+	const Imath::V2i offset = proxyOffset( offsetPlug(), context );
 
 	displayWindow.max += offset;
 	displayWindow.min += offset;
@@ -272,7 +287,7 @@ Imath::Box2i Crop::computeDataWindow( const Gaffer::Context *context, const Imag
 {
 	Box2i result = inPlug()->dataWindowPlug()->getValue();
 	const Box2i cropWindow = cropWindowPlug()->getValue();
-	const V2i offset = offsetPlug()->getValue();
+	const V2i offset = proxyOffset( offsetPlug(), context );
 	if( affectDataWindowPlug()->getValue() )
 	{
 		result = BufferAlgo::intersection( result, cropWindow );
@@ -319,6 +334,7 @@ void Crop::hash( const Gaffer::ValuePlug *output, const Gaffer::Context *context
 			default:
 			{
 				areaPlug()->hash( h );
+				h.append( FormatPlug::getProxyScale( context ) );
 				break;
 			}
 		}
@@ -333,6 +349,7 @@ void Crop::hash( const Gaffer::ValuePlug *output, const Gaffer::Context *context
 		{
 			inPlug()->formatPlug()->hash( h );
 		}
+		h.append( FormatPlug::getProxyScale( context ) );
 	}
 }
 
@@ -370,7 +387,12 @@ void Crop::compute( Gaffer::ValuePlug *output, const Gaffer::Context *context )
 			}
 			default:
 			{
-				cropWindow = areaPlug()->getValue();
+				// The area is specified in full resolution pixels,
+				// so is scaled in the same way as a format.
+				cropWindow = FormatPlug::proxyFormat(
+					GafferImage::Format( areaPlug()->getValue() ),
+					FormatPlug::getProxyScale( context )
+				).getDisplayWindow();
 				break;
 			}
 		}
@@ -392,6 +414,10 @@ void Crop::compute( Gaffer::ValuePlug *output, const Gaffer::Context *context )
 				offset -= cropWindowPlug()->getValue().min - formatPlug()->getValue().getDisplayWindow().min;
 			}
 		}
+		// The crop window is in proxy pixels, but the offset is
+		// specified in full resolution pixels, as the internal
+		// Offset node divides it by the proxy scale itself.
+		offset *= FormatPlug::getProxyScale( context );
 		static_cast<IntPlug *>( output )->setValue(
 			output == offsetPlug()->getChild( 0 ) ? offset[0] : offset[1]
 		);
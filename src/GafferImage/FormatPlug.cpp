@@ -36,12 +36,16 @@
 
 #include "boost/bind.hpp"
 
+#include "OpenEXR/ImathFun.h"
+
 #include "Gaffer/ScriptNode.h"
 #include "Gaffer/Context.h"
 #include "Gaffer/Process.h"
 
 #include "GafferImage/FormatPlug.h"
 #include "GafferImage/FormatData.h"
+#include "GafferImage/ImageNode.h"
+#include "GafferImage/ImagePlug.h"
 
 using namespace Gaffer;
 using namespace GafferImage;
@@ -50,8 +54,28 @@ IE_CORE_DEFINERUNTIMETYPED( FormatPlug );
 
 const IECore::InternedString g_defaultFormatContextName( "image:defaultFormat" );
 static const IECore::InternedString g_defaultFormatPlugName( "defaultFormat" );
+static const IECore::InternedString g_proxyScaleContextName( "image:proxyScale" );
 static const Format g_defaultFormatFallback( 1920, 1080 );
 
+namespace
+{
+
+// We only apply the proxy scale to user-facing format parameters
+// belonging directly to an ImageNode. This avoids applying it twice
+// when utility nodes such as Expressions read a format from one plug
+// and write it to another, or when a format is read from an ImagePlug,
+// whose value was already scaled upstream.
+bool appliesProxyScale( const FormatPlug *plug )
+{
+	if( !IECore::runTimeCast<const ImageNode>( plug->node() ) )
+	{
+		return false;
+	}
+	return !IECore::runTimeCast<const ImagePlug>( plug->parent() );
+}
+
+} // namespace
+
 FormatPlug::FormatPlug( const std::string &name, Direction direction, Format defaultValue, unsigned flags )
 	:	ValuePlug( name, direction, flags ), m_defaultValue( defaultValue )
 {
@@ -108,9 +132,17 @@ void FormatPlug::setValue( const Format &value )
 Format FormatPlug::getValue() const
 {
 	Format result( displayWindowPlug()->getValue(), pixelAspectPlug()->getValue() );
-	if( direction() == Plug::In && result.getDisplayWindow().isEmpty() && Process::current() )
+	if( direction() == Plug::In && Process::current() )
 	{
-		return getDefaultFormat( Context::current() );
+		const Context *context = Context::current();
+		if( result.getDisplayWindow().isEmpty() )
+		{
+			result = getDefaultFormat( context );
+		}
+		if( appliesProxyScale( this ) )
+		{
+			result = proxyFormat( result, getProxyScale( context ) );
+		}
 	}
 	return result;
 }
@@ -119,10 +151,15 @@ IECore::MurmurHash FormatPlug::hash() const
 {
 	if( direction() == Plug::In )
 	{
+		const Context *context = Context::current();
 		Format v( displayWindowPlug()->getValue(), pixelAspectPlug()->getValue() );
 		if( v.getDisplayWindow().isEmpty() )
 		{
-			v = getDefaultFormat( Context::current() );
+			v = getDefaultFormat( context );
+		}
+		if( appliesProxyScale( this ) )
+		{
+			v = proxyFormat( v, getProxyScale( context ) );
 		}
 
 		IECore::MurmurHash result;
@@ -144,6 +181,46 @@ void FormatPlug::setDefaultFormat( Gaffer::Context *context, const Format &forma
 	context->set( g_defaultFormatContextName, format );
 }
 
+int FormatPlug::getProxyScale( const Gaffer::Context *context )
+{
+	return std::max( 1, context->get<int>( g_proxyScaleContextName, 1 ) );
+}
+
+void FormatPlug::setProxyScale( Gaffer::Context *context, int proxyScale )
+{
+	if( proxyScale > 1 )
+	{
+		context->set( g_proxyScaleContextName, proxyScale );
+	}
+	else
+	{
+		// Removing rather than storing 1 means that full resolution
+		// evaluation shares cache entries with contexts which never
+		// specified a proxy scale at all.
+		context->remove( g_proxyScaleContextName );
+	}
+}
+
+Format FormatPlug::proxyFormat( const Format &format, int proxyScale )
+{
+	const Imath::Box2i &displayWindow = format.getDisplayWindow();
+	if( proxyScale <= 1 || displayWindow.isEmpty() )
+	{
+		return format;
+	}
+
+	// We round down at both ends, matching the convention used
+	// when generating the lower levels of a MIP map.
+	Imath::Box2i result(
+		Imath::V2i( Imath::divp( displayWindow.min.x, proxyScale ), Imath::divp( displayWindow.min.y, proxyScale ) ),
+		Imath::V2i( Imath::divp( displayWindow.max.x, proxyScale ), Imath::divp( displayWindow.max.y, proxyScale ) )
+	);
+	result.max.x = std::max( result.max.x, result.min.x + 1 );
+	result.max.y = std::max( result.max.y, result.min.y + 1 );
+
+	return Format( result, format.getPixelAspect() );
+}
+
 FormatPlug *FormatPlug::acquireDefaultFormatPlug( Gaffer::ScriptNode *scriptNode )
 {
 	if( FormatPlug *p = scriptNode->getChild<FormatPlug>( g_defaultFormatPlugName ) )
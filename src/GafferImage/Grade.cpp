@@ -36,6 +36,7 @@
 
 #include "Gaffer/Context.h"
 
+#include "GafferImage/ColorAlgo.h"
 #include "GafferImage/Grade.h"
 #include "GafferImage/ImageAlgo.h"
 
@@ -73,6 +74,7 @@ Grade::Grade( const std::string &name )
 	addChild( new Color4fPlug( "gamma", Gaffer::Plug::In, Imath::Color4f( 1.0f ), Imath::Color4f( 0.0f ) ) );
 	addChild( new BoolPlug( "blackClamp", Gaffer::Plug::In, true ) );
 	addChild( new BoolPlug( "whiteClamp" ) );
+	addChild( new BoolPlug( "approximateGamma" ) );
 }
 
 Grade::~Grade()
@@ -169,6 +171,16 @@ const Gaffer::BoolPlug *Grade::whiteClampPlug() const
 	return getChild<BoolPlug>( g_firstPlugIndex+8 );
 }
 
+Gaffer::BoolPlug *Grade::approximateGammaPlug()
+{
+	return getChild<BoolPlug>( g_firstPlugIndex+9 );
+}
+
+const Gaffer::BoolPlug *Grade::approximateGammaPlug() const
+{
+	return getChild<BoolPlug>( g_firstPlugIndex+9 );
+}
+
 bool Grade::channelEnabled( const std::string &channel ) const
 {
 	if ( !ChannelDataProcessor::channelEnabled( channel ) )
@@ -216,7 +228,8 @@ void Grade::affects( const Gaffer::Plug *input, AffectedPlugsContainer &outputs
 	// Process all other plugs.
 	if( input == inPlug()->channelDataPlug() ||
 			input == blackClampPlug() ||
-			input == whiteClampPlug()
+			input == whiteClampPlug() ||
+			input == approximateGammaPlug()
 	  )
 	{
 		outputs.push_back( outPlug()->channelDataPlug() );
@@ -244,42 +257,27 @@ void Grade::hashChannelData( const GafferImage::ImagePlug *output, const Gaffer:
 	gammaPlug()->getChild( channelIndex )->hash( h );
 	blackClampPlug()->hash( h );
 	whiteClampPlug()->hash( h );
+	approximateGammaPlug()->hash( h );
 }
 
 void Grade::processChannelData( const Gaffer::Context *context, const ImagePlug *parent, const std::string &channel, FloatVectorDataPtr outData ) const
 {
-	// Calculate the valid data window that we are to merge.
-	const int dataWidth = ImagePlug::tileSize()*ImagePlug::tileSize();
-
 	// Do some pre-processing.
 	float A, B, gamma;
-	bool whiteClamp, blackClamp;
+	bool whiteClamp, blackClamp, approximateGamma;
 	{
-		GradeParametersScope s( context );	
+		GradeParametersScope s( context );
 		parameters( std::max( 0, ImageAlgo::colorIndex( channel ) ), A, B, gamma );
 		whiteClamp = whiteClampPlug()->getValue();
 		blackClamp = blackClampPlug()->getValue();
+		approximateGamma = approximateGammaPlug()->getValue();
 	}
 	const float invGamma = 1. / gamma;
 
-	// Get some useful pointers.
-	float *outPtr = &(outData->writable()[0]);
-	const float *END = outPtr + dataWidth;
-
-	while (outPtr != END)
-	{
-		// Calculate the colour of the graded pixel.
-		float colour = *outPtr;	// As the input has been copied to outData, grab the input colour from there.
-		const float c = A * colour + B;
-		colour = ( c >= 0.f && invGamma != 1.f ? (float)pow( c, invGamma ) : c );
-
-		// Clamp the white and blacks if necessary.
-		if ( blackClamp && colour < 0.f ) colour = 0.f;
-		if ( whiteClamp && colour > 1.f ) colour = 1.f;
-
-		// Write back the result.
-		*outPtr++ = colour;
-	}
+	// Apply the grade. As the input has been copied to outData, we can
+	// modify it in place.
+	std::vector<float> &out = outData->writable();
+	ColorAlgo::grade( out.data(), out.size(), A, B, invGamma, blackClamp, whiteClamp, approximateGamma );
 }
 
 void Grade::parameters( size_t channelIndex, float &a, float &b, float &gamma ) const
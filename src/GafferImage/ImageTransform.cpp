@@ -42,6 +42,7 @@
 
 #include "GafferImage/ImageTransform.h"
 #include "GafferImage/ImagePlug.h"
+#include "GafferImage/FormatPlug.h"
 #include "GafferImage/Sampler.h"
 #include "GafferImage/Resample.h"
 
@@ -218,6 +219,7 @@ void ImageTransform::hash( const ValuePlug *output, const Context *context, IECo
 		transformPlug()->translatePlug()->hash( h );
 		transformPlug()->scalePlug()->hash( h );
 		transformPlug()->pivotPlug()->hash( h );
+		h.append( FormatPlug::getProxyScale( context ) );
 	}
 }
 
@@ -339,8 +341,11 @@ unsigned ImageTransform::operation( Imath::M33f &matrix, Imath::M33f &resampleMa
 {
 	const Transform2DPlug *plug = transformPlug();
 
-	const V2f pivot = plug->pivotPlug()->getValue();
-	const V2f translate = plug->translatePlug()->getValue();
+	// Pivot and translation are specified in full resolution
+	// pixels, so must be adjusted for the proxy scale.
+	const float proxyScale = FormatPlug::getProxyScale( Context::current() );
+	const V2f pivot = plug->pivotPlug()->getValue() / proxyScale;
+	const V2f translate = plug->translatePlug()->getValue() / proxyScale;
 	const V2f scale = plug->scalePlug()->getValue();
 	const float rotate = plug->rotatePlug()->getValue();
 
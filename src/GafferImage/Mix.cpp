@@ -41,6 +41,7 @@
 
 #include "GafferImage/Mix.h"
 #include "GafferImage/ImageAlgo.h"
+#include "GafferImage/Private/SharedPlaneScope.h"
 
 using namespace std;
 using namespace Imath;
@@ -48,6 +49,10 @@ using namespace IECore;
 using namespace Gaffer;
 using namespace GafferImage;
 
+//////////////////////////////////////////////////////////////////////////
+// Mix
+//////////////////////////////////////////////////////////////////////////
+
 IE_CORE_DEFINERUNTIMETYPED( Mix );
 
 size_t Mix::g_firstPlugIndex = 0;
@@ -62,6 +67,8 @@ Mix::Mix( const std::string &name )
 
 	addChild( new StringPlug( "maskChannel", Plug::In, "A") );
 
+	addChild( new FloatVectorDataPlug( "__maskPlane", Plug::Out, ImagePlug::blackTile() ) );
+
 	// We don't ever want to change these, so we make pass-through connections.
 	outPlug()->formatPlug()->setInput( inPlug()->formatPlug() );
 	outPlug()->metadataPlug()->setInput( inPlug()->metadataPlug() );
@@ -101,11 +108,36 @@ const Gaffer::StringPlug *Mix::maskChannelPlug() const
 	return getChild<StringPlug>( g_firstPlugIndex + 2 );
 }
 
+Gaffer::FloatVectorDataPlug *Mix::maskPlanePlug()
+{
+	return getChild<FloatVectorDataPlug>( g_firstPlugIndex + 3 );
+}
+
+const Gaffer::FloatVectorDataPlug *Mix::maskPlanePlug() const
+{
+	return getChild<FloatVectorDataPlug>( g_firstPlugIndex + 3 );
+}
+
 void Mix::affects( const Gaffer::Plug *input, AffectedPlugsContainer &outputs ) const
 {
 	ImageProcessor::affects( input, outputs );
 
-	if( input == maskChannelPlug() || input == mixPlug() || input == maskPlug()->channelDataPlug() )
+	if(
+		input == maskChannelPlug() ||
+		input == mixPlug() ||
+		input == maskPlug()->channelDataPlug() ||
+		input == maskPlug()->channelNamesPlug() ||
+		input == maskPlug()->dataWindowPlug()
+	)
+	{
+		outputs.push_back( maskPlanePlug() );
+	}
+
+	if( input == maskPlanePlug() )
+	{
+		outputs.push_back( outPlug()->channelDataPlug() );
+	}
+	else if( input == maskChannelPlug() || input == mixPlug() || input == maskPlug()->channelDataPlug() )
 	{
 		outputs.push_back( outPlug()->channelDataPlug() );
 
@@ -123,6 +155,27 @@ void Mix::affects( const Gaffer::Plug *input, AffectedPlugsContainer &outputs )
 	}
 }
 
+void Mix::hash( const Gaffer::ValuePlug *output, const Gaffer::Context *context, IECore::MurmurHash &h ) const
+{
+	ImageProcessor::hash( output, context, h );
+
+	if( output == maskPlanePlug() )
+	{
+		hashMaskPlane( context, h );
+	}
+}
+
+void Mix::compute( Gaffer::ValuePlug *output, const Gaffer::Context *context ) const
+{
+	if( output == maskPlanePlug() )
+	{
+		static_cast<FloatVectorDataPlug *>( output )->setValue( computeMaskPlane( context ) );
+		return;
+	}
+
+	ImageProcessor::compute( output, context );
+}
+
 void Mix::hashDataWindow( const GafferImage::ImagePlug *output, const Gaffer::Context *context, IECore::MurmurHash &h ) const
 {
 	const float mix = mixPlug()->getValue();
@@ -291,23 +344,10 @@ void Mix::hashChannelData( const GafferImage::ImagePlug *output, const Gaffer::C
 		h.append( validBound );
 	}
 
-	IECore::ConstStringVectorDataPtr maskChannelNamesData;
-	Box2i maskDataWindow;
 	{
-		ImagePlug::GlobalScope c( Context::current() );
-		maskChannelNamesData = maskPlug()->channelNamesPlug()->getValue();
-		maskDataWindow = maskPlug()->dataWindowPlug()->getValue();
+		GafferImage::Private::SharedPlaneScope maskPlaneScope( context );
+		maskPlanePlug()->hash( h );
 	}
-
-
-	const std::string &maskChannel = maskChannelPlug()->getValue();
-	if( maskPlug()->getInput<ValuePlug>() && ImageAlgo::channelExists( maskChannelNamesData->readable(), maskChannel ) )
-	{
-		h.append( maskPlug()->channelDataHash( maskChannel, tileOrigin ) );
-	}
-
-	const Box2i maskValidBound = boxIntersection( tileBound, maskDataWindow );
-	h.append( maskValidBound );
 }
 
 IECore::ConstFloatVectorDataPtr Mix::computeChannelData( const std::string &channelName, const Imath::V2i &tileOrigin, const Gaffer::Context *context, const ImagePlug *parent ) const
@@ -326,21 +366,10 @@ IECore::ConstFloatVectorDataPtr Mix::computeChannelData( const std::string &chan
 
 	const Box2i tileBound( tileOrigin, tileOrigin + V2i( ImagePlug::tileSize() ) );
 
-	IECore::ConstStringVectorDataPtr maskChannelNamesData;
-	Box2i maskDataWindow;
-	{
-		ImagePlug::GlobalScope c( Context::current() );
-		maskChannelNamesData = maskPlug()->channelNamesPlug()->getValue();
-		maskDataWindow = maskPlug()->dataWindowPlug()->getValue();
-	}
-
-	const std::string &maskChannel = maskChannelPlug()->getValue();
-	ConstFloatVectorDataPtr maskData = nullptr;
-	Box2i maskValidBound;
-	if( maskPlug()->getInput<ValuePlug>() && ImageAlgo::channelExists( maskChannelNamesData->readable(), maskChannel ) )
+	ConstFloatVectorDataPtr maskPlaneData;
 	{
-		maskData = maskPlug()->channelData( maskChannel, tileOrigin );
-		maskValidBound = boxIntersection( tileBound, maskDataWindow );
+		GafferImage::Private::SharedPlaneScope maskPlaneScope( context );
+		maskPlaneData = maskPlanePlug()->getValue();
 	}
 
 	ConstFloatVectorDataPtr channelData[2];
@@ -378,13 +407,12 @@ IECore::ConstFloatVectorDataPtr Mix::computeChannelData( const std::string &chan
 	float *R = &resultData->writable().front();
 	const float *A = channelData[0] ? &channelData[0]->readable().front() : nullptr;
 	const float *B = channelData[1] ? &channelData[1]->readable().front() : nullptr;
-	const float *M = maskData ? &maskData->readable().front() : nullptr;
+	const float *M = &maskPlaneData->readable().front();
 
 	for( int y = tileBound.min.y; y < tileBound.max.y; ++y )
 	{
 		const bool yValidIn0 = y >= validBound[0].min.y && y < validBound[0].max.y;
 		const bool yValidIn1 = y >= validBound[1].min.y && y < validBound[1].max.y;
-		const bool yValidMask = y >= maskValidBound.min.y && y < maskValidBound.max.y;
 
 		for( int x = tileBound.min.x; x < tileBound.max.x; ++x )
 		{
@@ -400,12 +428,7 @@ IECore::ConstFloatVectorDataPtr Mix::computeChannelData( const std::string &chan
 				b = *B;
 			}
 
-			float m = mix;
-			if( yValidMask && x >= maskValidBound.min.x && x < maskValidBound.max.x )
-			{
-				m *= std::max( 0.0f, std::min( 1.0f, *M ) );
-			}
-
+			const float m = *M;
 			*R = a * ( 1 - m ) + b * m;
 
 			++R; ++A; ++B; ++M;
@@ -414,3 +437,69 @@ IECore::ConstFloatVectorDataPtr Mix::computeChannelData( const std::string &chan
 
 	return resultData;
 }
+
+void Mix::hashMaskPlane( const Gaffer::Context *context, IECore::MurmurHash &h ) const
+{
+	const V2i tileOrigin = context->get<V2i>( ImagePlug::tileOriginContextName );
+	const Box2i tileBound( tileOrigin, tileOrigin + V2i( ImagePlug::tileSize() ) );
+
+	mixPlug()->hash( h );
+
+	IECore::ConstStringVectorDataPtr maskChannelNamesData;
+	Box2i maskDataWindow;
+	{
+		ImagePlug::GlobalScope c( context );
+		maskChannelNamesData = maskPlug()->channelNamesPlug()->getValue();
+		maskDataWindow = maskPlug()->dataWindowPlug()->getValue();
+	}
+
+	const std::string &maskChannel = maskChannelPlug()->getValue();
+	if( maskPlug()->getInput<ValuePlug>() && ImageAlgo::channelExists( maskChannelNamesData->readable(), maskChannel ) )
+	{
+		h.append( maskPlug()->channelDataHash( maskChannel, tileOrigin ) );
+		h.append( boxIntersection( tileBound, maskDataWindow ) );
+	}
+}
+
+IECore::ConstFloatVectorDataPtr Mix::computeMaskPlane( const Gaffer::Context *context ) const
+{
+	const V2i tileOrigin = context->get<V2i>( ImagePlug::tileOriginContextName );
+	const Box2i tileBound( tileOrigin, tileOrigin + V2i( ImagePlug::tileSize() ) );
+
+	const float mix = mixPlug()->getValue();
+
+	IECore::ConstStringVectorDataPtr maskChannelNamesData;
+	Box2i maskDataWindow;
+	{
+		ImagePlug::GlobalScope c( context );
+		maskChannelNamesData = maskPlug()->channelNamesPlug()->getValue();
+		maskDataWindow = maskPlug()->dataWindowPlug()->getValue();
+	}
+
+	FloatVectorDataPtr resultData = new FloatVectorData;
+	std::vector<float> &result = resultData->writable();
+	result.resize( ImagePlug::tileSize() * ImagePlug::tileSize(), mix );
+
+	const std::string &maskChannel = maskChannelPlug()->getValue();
+	if( !maskPlug()->getInput<ValuePlug>() || !ImageAlgo::channelExists( maskChannelNamesData->readable(), maskChannel ) )
+	{
+		return resultData;
+	}
+
+	ConstFloatVectorDataPtr maskData = maskPlug()->channelData( maskChannel, tileOrigin );
+	const std::vector<float> &mask = maskData->readable();
+
+	// Pixels outside the mask's data window are treated as unmasked,
+	// and take the mix value as is.
+	const Box2i maskValidBound = boxIntersection( tileBound, maskDataWindow );
+	for( int y = maskValidBound.min.y; y < maskValidBound.max.y; ++y )
+	{
+		const int offset = ( y - tileBound.min.y ) * ImagePlug::tileSize() - tileBound.min.x;
+		for( int x = maskValidBound.min.x; x < maskValidBound.max.x; ++x )
+		{
+			result[offset + x] = mix * std::max( 0.0f, std::min( 1.0f, mask[offset + x] ) );
+		}
+	}
+
+	return resultData;
+}
@@ -34,10 +34,13 @@
 //
 //////////////////////////////////////////////////////////////////////////
 
+#include "OpenEXR/ImathFun.h"
+
 #include "Gaffer/Context.h"
 
 #include "GafferImage/Offset.h"
 #include "GafferImage/BufferAlgo.h"
+#include "GafferImage/FormatPlug.h"
 
 using namespace std;
 using namespace Imath;
@@ -45,6 +48,24 @@ using namespace IECore;
 using namespace Gaffer;
 using namespace GafferImage;
 
+//////////////////////////////////////////////////////////////////////////
+// Internal utilities
+//////////////////////////////////////////////////////////////////////////
+
+namespace
+{
+
+// The offset is specified in full resolution pixels, so must be divided
+// by the proxy scale. We round down, as FormatPlug::proxyFormat() does.
+V2i proxyOffset( const V2iPlug *offsetPlug, const Context *context )
+{
+	const int proxyScale = FormatPlug::getProxyScale( context );
+	const V2i offset = offsetPlug->getValue();
+	return V2i( divp( offset.x, proxyScale ), divp( offset.y, proxyScale ) );
+}
+
+} // namespace
+
 //////////////////////////////////////////////////////////////////////////
 // Offset node
 //////////////////////////////////////////////////////////////////////////
@@ -101,7 +122,7 @@ void Offset::affects( const Gaffer::Plug *input, AffectedPlugsContainer &outputs
 
 void Offset::hashDataWindow( const GafferImage::ImagePlug *parent, const Gaffer::Context *context, IECore::MurmurHash &h ) const
 {
-	const V2i offset = offsetPlug()->getValue();
+	const V2i offset = proxyOffset( offsetPlug(), context );
 	if( offset == V2i( 0 ) )
 	{
 		h = inPlug()->dataWindowPlug()->hash();
@@ -110,14 +131,14 @@ void Offset::hashDataWindow( const GafferImage::ImagePlug *parent, const Gaffer:
 	{
 		ImageProcessor::hashDataWindow( parent, context, h );
 		inPlug()->dataWindowPlug()->hash( h );
-		offsetPlug()->hash( h );
+		h.append( offset );
 	}
 }
 
 Imath::Box2i Offset::computeDataWindow( const Gaffer::Context *context, const ImagePlug *parent ) const
 {
 	Box2i dataWindow = inPlug()->dataWindowPlug()->getValue();
-	const V2i offset = offsetPlug()->getValue();
+	const V2i offset = proxyOffset( offsetPlug(), context );
 	dataWindow.min += offset;
 	dataWindow.max += offset;
 	return dataWindow;
@@ -127,7 +148,7 @@ void Offset::hashChannelData( const GafferImage::ImagePlug *parent, const Gaffer
 {
 	ImagePlug::ChannelDataScope offsetScope( context );
 
-	const V2i offset = offsetPlug()->getValue();
+	const V2i offset = proxyOffset( offsetPlug(), context );
 	const V2i tileOrigin = context->get<V2i>( ImagePlug::tileOriginContextName );
 	if( offset.x % ImagePlug::tileSize() == 0 && offset.y % ImagePlug::tileSize() == 0 )
 	{
@@ -159,7 +180,7 @@ IECore::ConstFloatVectorDataPtr Offset::computeChannelData( const std::string &c
 {
 	ImagePlug::ChannelDataScope offsetScope( context );
 
-	const V2i offset = offsetPlug()->getValue();
+	const V2i offset = proxyOffset( offsetPlug(), context );
 	if( offset.x % ImagePlug::tileSize() == 0 && offset.y % ImagePlug::tileSize() == 0 )
 	{
 		offsetScope.setTileOrigin( tileOrigin - offset );
@@ -40,6 +40,7 @@
 #include "boost/regex.hpp"
 
 #include "OpenEXR/half.h"
+#include "OpenEXR/ImathFun.h"
 
 #include "OpenImageIO/imagecache.h"
 OIIO_NAMESPACE_USING
@@ -54,6 +55,7 @@ OIIO_NAMESPACE_USING
 
 #include "GafferImage/OpenImageIOReader.h"
 #include "GafferImage/FormatPlug.h"
+#include "GafferImage/BufferAlgo.h"
 
 using namespace std;
 using namespace tbb;
@@ -170,6 +172,99 @@ const ImageSpec *imageSpec( std::string &fileName, OpenImageIOReader::MissingFra
 	return spec;
 }
 
+// Returns the format for the file, as it should be
+// presented at the specified proxy scale.
+Format format( const ImageSpec *spec, int proxyScale )
+{
+	return FormatPlug::proxyFormat(
+		Format(
+			Imath::Box2i(
+				Imath::V2i( spec->full_x, spec->full_y ),
+				Imath::V2i( spec->full_x + spec->full_width, spec->full_y + spec->full_height )
+			),
+			spec->get_float_attribute( "PixelAspectRatio", 1.0f )
+		),
+		proxyScale
+	);
+}
+
+// Describes how pixels are obtained from a file at a particular
+// proxy scale. Where the file contains MIP levels we read from the
+// lowest one which doesn't exceed the proxy resolution, and make up
+// any remaining reduction by box filtering the pixels ourselves.
+struct ProxyLevel
+{
+	// The MIP level to read pixels from.
+	int mipLevel;
+	// The spec for that MIP level.
+	const ImageSpec *spec;
+	// The format of the pixels in that MIP level, used to
+	// convert between its EXR space and Gaffer space.
+	Format format;
+	// The width (and height) of the box filter applied
+	// to the pixels read from `mipLevel`.
+	int filterSize;
+};
+
+ProxyLevel proxyLevel( const std::string &fileName, const ImageSpec *spec, int proxyScale )
+{
+	ProxyLevel result = { 0, spec, format( spec, 1 ), std::max( 1, proxyScale ) };
+	if( result.filterSize == 1 )
+	{
+		return result;
+	}
+
+	// Proxy formats are derived by dividing in Gaffer space, where
+	// y increases upwards, whereas MIP levels are derived by dividing
+	// in EXR space, where y increases downwards. They only line up when
+	// the data window matches a display window at the origin, and the
+	// height divides exactly.
+	if(
+		spec->x != 0 || spec->y != 0 || spec->full_x != 0 || spec->full_y != 0 ||
+		spec->width != spec->full_width || spec->height != spec->full_height
+	)
+	{
+		return result;
+	}
+
+	ImageCache *cache = imageCache();
+	const ustring uFileName( fileName );
+
+	int numMipLevels = 1;
+	cache->get_image_info( uFileName, 0, 0, ustring( "miplevels" ), TypeDesc::TypeInt, &numMipLevels );
+
+	while( result.filterSize % 2 == 0 && result.mipLevel + 1 < numMipLevels )
+	{
+		const int mipLevel = result.mipLevel + 1;
+		const ImageSpec *mipSpec = cache->imagespec( uFileName, 0, mipLevel );
+		if( !mipSpec )
+		{
+			// Clear the error so it isn't reported against
+			// some unrelated call later.
+			cache->geterror();
+			break;
+		}
+
+		// We only accept levels which are exact power-of-two
+		// reductions of the original, so that they line up
+		// with our proxy formats.
+		if(
+			mipSpec->width != std::max( 1, spec->width >> mipLevel ) ||
+			( mipSpec->height << mipLevel ) != spec->height
+		)
+		{
+			break;
+		}
+
+		result.mipLevel = mipLevel;
+		result.spec = mipSpec;
+		result.format = format( spec, 1 << mipLevel );
+		result.filterSize /= 2;
+	}
+
+	return result;
+}
+
 } // namespace
 
 //////////////////////////////////////////////////////////////////////////
@@ -349,6 +444,7 @@ void OpenImageIOReader::hashFormat( const GafferImage::ImagePlug *output, const
 	hashFileName( context, h );
 	refreshCountPlug()->hash( h );
 	missingFrameModePlug()->hash( h );
+	h.append( FormatPlug::getProxyScale( context ) );
 }
 
 GafferImage::Format OpenImageIOReader::computeFormat( const Gaffer::Context *context, const ImagePlug *parent ) const
@@ -359,18 +455,13 @@ GafferImage::Format OpenImageIOReader::computeFormat( const Gaffer::Context *con
 	MissingFrameMode mode = (MissingFrameMode)missingFrameModePlug()->getValue();
 	mode = ( mode == Black ) ? Hold : mode;
 	const ImageSpec *spec = imageSpec( fileName, mode, this, context );
+	const int proxyScale = FormatPlug::getProxyScale( context );
 	if( !spec )
 	{
-		return FormatPlug::getDefaultFormat( context );
+		return FormatPlug::proxyFormat( FormatPlug::getDefaultFormat( context ), proxyScale );
 	}
 
-	return GafferImage::Format(
-		Imath::Box2i(
-			Imath::V2i( spec->full_x, spec->full_y ),
-			Imath::V2i( spec->full_x + spec->full_width, spec->full_y + spec->full_height )
-		),
-		spec->get_float_attribute( "PixelAspectRatio", 1.0f )
-	);
+	return ::format( spec, proxyScale );
 }
 
 void OpenImageIOReader::hashDataWindow( const GafferImage::ImagePlug *output, const Gaffer::Context *context, IECore::MurmurHash &h ) const
@@ -379,6 +470,7 @@ void OpenImageIOReader::hashDataWindow( const GafferImage::ImagePlug *output, co
 	hashFileName( context, h );
 	refreshCountPlug()->hash( h );
 	missingFrameModePlug()->hash( h );
+	h.append( FormatPlug::getProxyScale( context ) );
 }
 
 Imath::Box2i OpenImageIOReader::computeDataWindow( const Gaffer::Context *context, const ImagePlug *parent ) const
@@ -390,10 +482,37 @@ Imath::Box2i OpenImageIOReader::computeDataWindow( const Gaffer::Context *contex
 		return parent->dataWindowPlug()->defaultValue();
 	}
 
-	Format format( Imath::Box2i( Imath::V2i( spec->full_x, spec->full_y ), Imath::V2i( spec->full_width + spec->full_x, spec->full_height + spec->full_y ) ) );
-	Imath::Box2i dataWindow( Imath::V2i( spec->x, spec->y ), Imath::V2i( spec->width + spec->x - 1, spec->height + spec->y - 1 ) );
+	const int proxyScale = FormatPlug::getProxyScale( context );
+	const ProxyLevel level = proxyLevel( fileName, spec, proxyScale );
+	const ImageSpec *levelSpec = level.spec;
+
+	// Convert to Gaffer space before dividing by the filter size, so
+	// that we divide in the same space as FormatPlug::proxyFormat().
+	const Imath::Box2i levelDataWindow = level.format.fromEXRSpace(
+		Imath::Box2i(
+			Imath::V2i( levelSpec->x, levelSpec->y ),
+			Imath::V2i( levelSpec->x + levelSpec->width - 1, levelSpec->y + levelSpec->height - 1 )
+		)
+	);
+
+	if( level.filterSize == 1 || BufferAlgo::empty( levelDataWindow ) )
+	{
+		return levelDataWindow;
+	}
 
-	return format.fromEXRSpace( dataWindow );
+	// Dividing the inclusive bounds by the filter size (rounding
+	// down) yields all the proxy pixels which receive any
+	// contribution from the data window.
+	return Imath::Box2i(
+		Imath::V2i(
+			Imath::divp( levelDataWindow.min.x, level.filterSize ),
+			Imath::divp( levelDataWindow.min.y, level.filterSize )
+		),
+		Imath::V2i(
+			Imath::divp( levelDataWindow.max.x - 1, level.filterSize ) + 1,
+			Imath::divp( levelDataWindow.max.y - 1, level.filterSize ) + 1
+		)
+	);
 }
 
 void OpenImageIOReader::hashMetadata( const GafferImage::ImagePlug *output, const Gaffer::Context *context, IECore::MurmurHash &h ) const
@@ -490,6 +609,8 @@ void OpenImageIOReader::hashChannelData( const GafferImage::ImagePlug *output, c
 		refreshCountPlug()->hash( h );
 		missingFrameModePlug()->hash( h );
 	}
+
+	h.append( FormatPlug::getProxyScale( context ) );
 }
 
 IECore::ConstFloatVectorDataPtr OpenImageIOReader::computeChannelData( const std::string &channelName, const Imath::V2i &tileOrigin, const Gaffer::Context *context, const ImagePlug *parent ) const
@@ -515,16 +636,25 @@ IECore::ConstFloatVectorDataPtr OpenImageIOReader::computeChannelData( const std
 		}
 	}
 
-	Format format( Imath::Box2i( Imath::V2i( spec->full_x, spec->full_y ), Imath::V2i( spec->full_width + spec->full_x, spec->full_height + spec->full_y ) ) );
-	const int newY = format.toEXRSpace( tileOrigin.y + ImagePlug::tileSize() - 1 );
+	const int proxyScale = FormatPlug::getProxyScale( context );
+	const ProxyLevel level = proxyLevel( fileName, spec, proxyScale );
+
+	// Read the region of the MIP level that corresponds
+	// to the tile, taking into account any additional filtering
+	// we need to do to reach the proxy resolution. The region is
+	// found in Gaffer space, and only then converted to EXR space,
+	// to match the division made by FormatPlug::proxyFormat().
+	const int filterSize = level.filterSize;
+	const int regionSize = ImagePlug::tileSize() * filterSize;
+	const int newY = level.format.toEXRSpace( ( tileOrigin.y + ImagePlug::tileSize() ) * filterSize - 1 );
 
-	std::vector<float> channelData( ImagePlug::tileSize() * ImagePlug::tileSize() );
+	std::vector<float> channelData( regionSize * regionSize );
 	size_t channelIndex = channelIt - spec->channelnames.begin();
 	imageCache()->get_pixels(
 		ustring( fileName ),
-		0, 0, // subimage, miplevel
-		tileOrigin.x, tileOrigin.x + ImagePlug::tileSize(),
-		newY, newY + ImagePlug::tileSize(),
+		0, level.mipLevel, // subimage, miplevel
+		tileOrigin.x * filterSize, tileOrigin.x * filterSize + regionSize,
+		newY, newY + regionSize,
 		0, 1,
 		channelIndex, channelIndex + 1,
 		TypeDesc::FLOAT,
@@ -536,10 +666,37 @@ IECore::ConstFloatVectorDataPtr OpenImageIOReader::computeChannelData( const std
 	vector<float> &result = resultData->writable();
 	result.resize( ImagePlug::tileSize() * ImagePlug::tileSize() );
 
-	// Flip the tile in the Y axis to convert it to our internal image data representation.
-	for( int y = 0; y < ImagePlug::tileSize(); ++y )
+	if( filterSize == 1 )
+	{
+		// Flip the tile in the Y axis to convert it to our internal image data representation.
+		for( int y = 0; y < ImagePlug::tileSize(); ++y )
+		{
+			memcpy( &(result[ ( ImagePlug::tileSize() - y - 1 ) * ImagePlug::tileSize() ]), &(channelData[ y * ImagePlug::tileSize() ]), sizeof(float)*ImagePlug::tileSize()  );
+		}
+	}
+	else
 	{
-		memcpy( &(result[ ( ImagePlug::tileSize() - y - 1 ) * ImagePlug::tileSize() ]), &(channelData[ y * ImagePlug::tileSize() ]), sizeof(float)*ImagePlug::tileSize()  );
+		// Box filter down to the proxy resolution, flipping in the
+		// Y axis at the same time.
+		const float weight = 1.0f / (float)( filterSize * filterSize );
+		for( int y = 0; y < ImagePlug::tileSize(); ++y )
+		{
+			float *dst = &(result[ ( ImagePlug::tileSize() - y - 1 ) * ImagePlug::tileSize() ]);
+			for( int x = 0; x < ImagePlug::tileSize(); ++x )
+			{
+				float sum = 0.0f;
+				const float *src = &(channelData[ y * filterSize * regionSize + x * filterSize ]);
+				for( int fy = 0; fy < filterSize; ++fy )
+				{
+					for( int fx = 0; fx < filterSize; ++fx )
+					{
+						sum += src[fx];
+					}
+					src += regionSize;
+				}
+				*dst++ = sum * weight;
+			}
+		}
 	}
 
 	return resultData;
@@ -49,6 +49,7 @@
 
 #include "GafferImage/Text.h"
 #include "GafferImage/BufferAlgo.h"
+#include "GafferImage/FormatPlug.h"
 
 using namespace std;
 using namespace Imath;
@@ -190,6 +191,235 @@ struct Line
 	int width;
 };
 
+// The word wrapping performed by computeLayout() depends only on the
+// text, font, size and area, so we cache it separately from the rest
+// of the layout. This allows it to be reused when only the transform
+// or alignment changes, and by all nodes displaying the same text.
+// All measurements are in FreeType's 26.6 fixed point format.
+struct LineLayout
+{
+	vector<Line> lines;
+	// Final position of the pen, used for vertical alignment.
+	int penY;
+	int descender;
+};
+
+typedef std::shared_ptr<const LineLayout> ConstLineLayoutPtr;
+
+struct LineLayoutCacheGetterKey
+{
+
+	LineLayoutCacheGetterKey()
+		:	text( nullptr ), font( nullptr )
+	{
+	}
+
+	LineLayoutCacheGetterKey( const string &text, const string &font, const V2i &size, const Box2i &area )
+		:	text( &text ), font( &font ), size( size ), area( area )
+	{
+		hash.append( text );
+		hash.append( font );
+		hash.append( size );
+		hash.append( area );
+	}
+
+	operator const IECore::MurmurHash & () const
+	{
+		return hash;
+	}
+
+	const string *text;
+	const string *font;
+	V2i size;
+	Box2i area;
+	MurmurHash hash;
+
+};
+
+ConstLineLayoutPtr lineLayoutGetter( const LineLayoutCacheGetterKey &key, size_t &cost )
+{
+	FacePtr face = ::face( *key.font, key.size );
+	const Box2i &area = key.area;
+
+	std::shared_ptr<LineLayout> result( new LineLayout );
+	result->descender = face->size->metrics.descender;
+
+	V2i pen = V2i( area.min.x, area.max.y - face->size->metrics.ascender );
+
+	vector<Line> &lines = result->lines;
+	lines.push_back( Line( pen.y ) );
+
+	int penYCutoff = area.min.y - face->size->metrics.descender;
+
+	typedef boost::tokenizer<boost::char_separator<char> > Tokenizer;
+	boost::char_separator<char> separator( "", " \n\t" );
+	Tokenizer tokenizer( *key.text, separator );
+	for( Tokenizer::iterator it = tokenizer.begin(), eIt = tokenizer.end(); it != eIt; ++it )
+	{
+		if( *it == "\n" )
+		{
+			pen.x = area.min.x;
+
+			if( pen.y - face->size->metrics.height < penYCutoff )
+			{
+				// We ran out of vertical space.
+				break;
+			}
+
+			pen.y -= face->size->metrics.height;
+			lines.push_back( Line( pen.y ) );
+		}
+		else if( *it == " " || *it =="\t" )
+		{
+			pen.x += ::width( *it, face.get() );
+		}
+		else
+		{
+			int width = ::width( *it, face.get() );
+			if( pen.x + width > area.max.x )
+			{
+				pen.x = area.min.x;
+
+				if( pen.y - face->size->metrics.height < penYCutoff )
+				{
+					// We ran out of vertical space.
+					break;
+				}
+
+				pen.y -= face->size->metrics.height;
+				lines.push_back( Line( pen.y ) );
+			}
+
+			lines.back().words.push_back( Word( *it, pen.x ) );
+			pen.x += width;
+			lines.back().width = pen.x - area.min.x;
+		}
+	}
+
+	result->penY = pen.y;
+
+	cost = 1;
+	return result;
+}
+
+typedef LRUCache<IECore::MurmurHash, ConstLineLayoutPtr, LRUCachePolicy::Parallel, LineLayoutCacheGetterKey> LineLayoutCache;
+LineLayoutCache g_lineLayoutCache( lineLayoutGetter, 1000 );
+
+// Rasterising glyphs is by far the most expensive part of drawing text,
+// and the same glyphs are needed repeatedly - by every tile they overlap,
+// by every frame of a sequence, and by every character they represent.
+// So we keep a cache of rasterised glyphs, shared between all threads.
+// Glyphs are keyed on the linear part of their transform and the
+// subpixel part of their translation; the integer part of the translation
+// merely offsets the bitmap, so is applied after lookup.
+struct Glyph
+{
+	// Bound of the bitmap in pixels, relative to the integer
+	// part of the translation.
+	Box2i bound;
+	// Coverage values, stored top row first, as given by FreeType.
+	vector<unsigned char> coverage;
+	// Advance in 26.6 format.
+	V2i advance;
+};
+
+typedef std::shared_ptr<const Glyph> ConstGlyphPtr;
+
+struct GlyphCacheGetterKey
+{
+
+	GlyphCacheGetterKey()
+		:	font( nullptr ), character( 0 )
+	{
+	}
+
+	GlyphCacheGetterKey( const string &font, const V2i &size, char character, const FT_Matrix &matrix, const FT_Vector &delta )
+		:	font( &font ), size( size ), character( character ), matrix( matrix ), delta( delta )
+	{
+		hash.append( font );
+		hash.append( size );
+		hash.append( character );
+		hash.append( (int64_t)matrix.xx );
+		hash.append( (int64_t)matrix.xy );
+		hash.append( (int64_t)matrix.yx );
+		hash.append( (int64_t)matrix.yy );
+		hash.append( (int64_t)delta.x );
+		hash.append( (int64_t)delta.y );
+	}
+
+	operator const IECore::MurmurHash & () const
+	{
+		return hash;
+	}
+
+	const string *font;
+	V2i size;
+	char character;
+	FT_Matrix matrix;
+	FT_Vector delta;
+	MurmurHash hash;
+
+};
+
+ConstGlyphPtr glyphGetter( const GlyphCacheGetterKey &key, size_t &cost )
+{
+	FacePtr face = ::face( *key.font, key.size );
+
+	FT_Matrix matrix = key.matrix;
+	FT_Vector delta = key.delta;
+	FT_Set_Transform( face.get(), &matrix, &delta );
+
+	cost = sizeof( Glyph );
+
+	FT_Error e = FT_Load_Char( face.get(), key.character, FT_LOAD_RENDER );
+	if( e )
+	{
+		return nullptr;
+	}
+
+	const FT_GlyphSlot slot = face->glyph;
+	const FT_Bitmap &bitmap = slot->bitmap;
+
+	std::shared_ptr<Glyph> result( new Glyph );
+	result->bound = Box2i(
+		V2i( slot->bitmap_left, slot->bitmap_top - bitmap.rows ),
+		V2i( slot->bitmap_left + bitmap.width, slot->bitmap_top )
+	);
+	result->advance = V2i( slot->advance.x, slot->advance.y );
+
+	result->coverage.resize( bitmap.width * bitmap.rows );
+	for( unsigned int y = 0; y < bitmap.rows; ++y )
+	{
+		const unsigned char *src = bitmap.buffer + y * bitmap.pitch;
+		std::copy( src, src + bitmap.width, result->coverage.begin() + y * bitmap.width );
+	}
+
+	cost += result->coverage.size();
+	return result;
+}
+
+typedef LRUCache<IECore::MurmurHash, ConstGlyphPtr, LRUCachePolicy::Parallel, GlyphCacheGetterKey> GlyphCache;
+GlyphCache g_glyphCache( glyphGetter, 100 * 1024 * 1024 );
+
+// Returns the glyph for `character` with the specified transform, along
+// with the integer pixel offset that must be applied to its bound. Returns
+// null if FreeType could not render the glyph.
+ConstGlyphPtr glyph( const string &font, const V2i &size, char character, const M33f &transform, V2i &offset )
+{
+	FT_Vector delta;
+	const FT_Matrix matrix = ::transform( transform, delta );
+
+	// Split the 26.6 delta into whole pixels and a subpixel
+	// remainder. Shifting the outline by whole pixels shifts the
+	// rendered bitmap by exactly the same amount, so only the
+	// remainder needs to be part of the key.
+	offset = V2i( delta.x >> 6, delta.y >> 6 );
+	delta.x &= 63;
+	delta.y &= 63;
+
+	return g_glyphCache.get( GlyphCacheGetterKey( font, size, character, matrix, delta ) );
+}
+
 } // namespace
 
 //////////////////////////////////////////////////////////////////////////
@@ -356,82 +586,39 @@ void Text::hashLayout( const Gaffer::Context *context, IECore::MurmurHash &h ) c
 	horizontalAlignmentPlug()->hash( h );
 	verticalAlignmentPlug()->hash( h );
 	transformPlug()->hash( h );
+	h.append( FormatPlug::getProxyScale( context ) );
 }
 
 IECore::ConstCompoundObjectPtr Text::computeLayout( const Gaffer::Context *context ) const
 {
 
-	// Get the face.
-
-	const V2i size = sizePlug()->getValue();
-	const string font = fontPlug()->getValue();
-	FacePtr face = ::face( font, size );
-
 	// For simplicity we start by performing the word wrapping
 	// and layout in the untransformed axis-aligned space specified by
 	// the area plug. We use FreeType's 26.6 fixed integer format for
 	// this stage, which measures in 64ths of a pixel. We store the layout
-	// in a vector of Lines made up of Words.
+	// in a vector of Lines made up of Words, which is cached for reuse
+	// by subsequent computes.
+
+	// When evaluating at a proxy resolution, we perform the layout
+	// at full resolution and then scale the result down. This keeps
+	// the word wrapping identical to that at full resolution.
+	const int proxyScale = FormatPlug::getProxyScale( context );
 
 	Box2i area = areaPlug()->getValue();
 	if( BufferAlgo::empty( area ) )
 	{
 		area = inPlug()->formatPlug()->getValue().getDisplayWindow();
+		area.min *= proxyScale; area.max *= proxyScale;
 	}
 
 	area.min *= 64; area.max *= 64;
-	V2i pen = V2i( area.min.x, area.max.y - face->size->metrics.ascender );
-
-	vector<Line> lines;
-	lines.push_back( Line( pen.y ) );
-
-	int penYCutoff = area.min.y - face->size->metrics.descender;
 
+	const V2i size = sizePlug()->getValue();
+	const string font = fontPlug()->getValue();
 	const std::string text = textPlug()->getValue();
-	typedef boost::tokenizer<boost::char_separator<char> > Tokenizer;
-	boost::char_separator<char> separator( "", " \n\t" );
-	Tokenizer tokenizer( text, separator );
-	for( Tokenizer::iterator it = tokenizer.begin(), eIt = tokenizer.end(); it != eIt; ++it )
-	{
-		if( *it == "\n" )
-		{
-			pen.x = area.min.x;
-
-			if( pen.y - face->size->metrics.height < penYCutoff )
-			{
-				// We ran out of vertical space.
-				break;
-			}
-
-			pen.y -= face->size->metrics.height;
-			lines.push_back( Line( pen.y ) );
-		}
-		else if( *it == " " || *it =="\t" )
-		{
-			pen.x += ::width( *it, face.get() );
-		}
-		else
-		{
-			int width = ::width( *it, face.get() );
-			if( pen.x + width > area.max.x )
-			{
-				pen.x = area.min.x;
-
-				if( pen.y - face->size->metrics.height < penYCutoff )
-				{
-					// We ran out of vertical space.
-					break;
-				}
-
-				pen.y -= face->size->metrics.height;
-				lines.push_back( Line( pen.y ) );
-			}
 
-			lines.back().words.push_back( Word( *it, pen.x ) );
-			pen.x += width;
-			lines.back().width = pen.x - area.min.x;
-		}
-	}
+	ConstLineLayoutPtr lineLayout = g_lineLayoutCache.get( LineLayoutCacheGetterKey( text, font, size, area ) );
+	const vector<Line> &lines = lineLayout->lines;
 
 	// Now we'll take that basic layout and apply the transform
 	// to it, generating everything we'll need later in
@@ -460,20 +647,22 @@ IECore::ConstCompoundObjectPtr Text::computeLayout( const Gaffer::Context *conte
 
 	const HorizontalAlignment horizontalAlignment = (HorizontalAlignment)horizontalAlignmentPlug()->getValue();
 	const VerticalAlignment verticalAlignment = (VerticalAlignment)verticalAlignmentPlug()->getValue();
-	const M33f transform = transformPlug()->matrix();
+	M33f transform = transformPlug()->matrix();
+	if( proxyScale > 1 )
+	{
+		transform *= M33f().setScale( V2f( 1.0f / proxyScale ) );
+	}
 
 	float yOffset = 0;
 	if( verticalAlignment == Bottom )
 	{
-		yOffset = (float)(area.min.y - (pen.y + face->size->metrics.descender) ) / 64.0f;
+		yOffset = (float)(area.min.y - (lineLayout->penY + lineLayout->descender) ) / 64.0f;
 	}
 	else if( verticalAlignment == VerticalCenter )
 	{
-		yOffset = (float)(area.min.y - (pen.y + face->size->metrics.descender) ) / (64.0f * 2.0f);
+		yOffset = (float)(area.min.y - (lineLayout->penY + lineLayout->descender) ) / (64.0f * 2.0f);
 	}
 
-	FT_GlyphSlot slot = face->glyph;
-
 	for( vector<Line>::const_iterator lIt = lines.begin(), leIt = lines.end(); lIt != leIt; ++lIt )
 	{
 		float xOffset = 0;
@@ -495,28 +684,19 @@ IECore::ConstCompoundObjectPtr Text::computeLayout( const Gaffer::Context *conte
 
 			for( const char *c = wIt->text.c_str(); *c; ++c )
 			{
-				FT_Vector delta;
-				FT_Matrix matrix = ::transform( characterTransform, delta );
-				FT_Set_Transform( face.get(), &matrix, &delta );
-
-				FT_Error e = FT_Load_Char( face.get(), *c, FT_LOAD_RENDER );
-				if( e )
+				V2i offset;
+				ConstGlyphPtr glyph = ::glyph( font, size, *c, characterTransform, offset );
+				if( !glyph )
 				{
 					continue;
 				}
 
-				const FT_Bitmap &bitmap = slot->bitmap;
-				const Box2i bound(
-					V2i( slot->bitmap_left, slot->bitmap_top - bitmap.rows ),
-					V2i( slot->bitmap_left + bitmap.width, slot->bitmap_top )
-				);
-
 				characters->writable().push_back( *c );
 				transforms->writable().push_back( characterTransform );
-				bounds->writable().push_back( bound );
+				bounds->writable().push_back( Box2i( glyph->bound.min + offset, glyph->bound.max + offset ) );
 
-				characterTransform[2][0] += (float)slot->advance.x / 64.0f;
-				characterTransform[2][1] += (float)slot->advance.y / 64.0f;
+				characterTransform[2][0] += (float)glyph->advance.x / 64.0f;
+				characterTransform[2][1] += (float)glyph->advance.y / 64.0f;
 			}
 		}
 	}
@@ -586,8 +766,8 @@ IECore::ConstFloatVectorDataPtr Text::computeShapeChannelData(  const Imath::V2i
 	const vector<M33f> &transforms = layout->member<M33fVectorData>( "transforms" )->readable();
 	const vector<Box2i> &bounds = layout->member<Box2iVectorData>( "bounds" )->readable();
 
-	FacePtr face = ::face( layout->member<StringData>( "font" )->readable(), layout->member<V2iData>( "size" )->readable() );
-	FT_GlyphSlot slot = face->glyph;
+	const string &font = layout->member<StringData>( "font" )->readable();
+	const V2i &size = layout->member<V2iData>( "size" )->readable();
 
 	FloatVectorDataPtr resultData = new FloatVectorData();
 	vector<float> &result = resultData->writable();
@@ -604,22 +784,19 @@ IECore::ConstFloatVectorDataPtr Text::computeShapeChannelData(  const Imath::V2i
 			continue;
 		}
 
-		FT_Vector delta;
-		FT_Matrix matrix = transform( transforms[i], delta );
-		FT_Set_Transform( face.get(), &matrix, &delta );
-
-		FT_Error error = FT_Load_Char( face.get(), characters[i], FT_LOAD_RENDER );
-		if( error )
+		V2i offset;
+		ConstGlyphPtr glyph = ::glyph( font, size, characters[i], transforms[i], offset );
+		if( !glyph )
 		{
 			continue;
 		}
 
-		const FT_Bitmap &bitmap = slot->bitmap;
+		const int pitch = bitmapBound.size().x;
 
 		V2i p;
 		for( p.y = validBound.min.y; p.y < validBound.max.y; ++p.y )
 		{
-			const unsigned char *src = bitmap.buffer + ( bitmapBound.max.y - 1 - p.y ) * bitmap.pitch + validBound.min.x - bitmapBound.min.x;
+			const unsigned char *src = glyph->coverage.data() + ( bitmapBound.max.y - 1 - p.y ) * pitch + validBound.min.x - bitmapBound.min.x;
 			vector<float>::iterator dst = result.begin() + ( p.y - tileBound.min.y ) * ImagePlug::tileSize() + validBound.min.x - tileBound.min.x;
 			for( p.x = validBound.min.x; p.x < validBound.max.x; ++p.x )
 			{
@@ -74,8 +74,7 @@ void Unpremultiply::affects( const Gaffer::Plug *input, AffectedPlugsContainer &
 {
 	ChannelDataProcessor::affects( input, outputs );
 
-	if( input == inPlug()->channelDataPlug() ||
-	    input == alphaChannelPlug() )
+	if( input == alphaChannelPlug() )
 	{
 		outputs.push_back( outPlug()->channelDataPlug() );
 	}
@@ -83,27 +82,52 @@ void Unpremultiply::affects( const Gaffer::Plug *input, AffectedPlugsContainer &
 
 void Unpremultiply::hashChannelData( const GafferImage::ImagePlug *output, const Gaffer::Context *context, IECore::MurmurHash &h ) const
 {
-	std::string alphaChannel = alphaChannelPlug()->getValue();
-
 	ChannelDataProcessor::hashChannelData( output, context, h );
 
 	inPlug()->channelDataPlug()->hash( h );
-
-	ImagePlug::ChannelDataScope channelDataScope( context );
-	channelDataScope.setChannelName( alphaChannel );
-
-	inPlug()->channelDataPlug()->hash( h );
+	h.append( sharedPlaneHash( context ) );
 }
 
 void Unpremultiply::processChannelData( const Gaffer::Context *context, const ImagePlug *parent, const std::string &channel, FloatVectorDataPtr outData ) const
 {
-	std::string alphaChannel = alphaChannelPlug()->getValue();
-
-	if ( channel == alphaChannel )
+	if ( channel == alphaChannelPlug()->getValue() )
 	{
 		return;
 	}
 
+	// The reciprocal of the alpha tile is computed once per
+	// tile and shared between all the channels we process,
+	// so that each channel requires only a multiplication.
+	ConstFloatVectorDataPtr rData = sharedPlane( context );
+	const std::vector<float> &r = rData->readable();
+	std::vector<float> &out = outData->writable();
+
+	std::vector<float>::const_iterator rIt = r.begin();
+	for ( std::vector<float>::iterator outIt = out.begin(), outItEnd = out.end(); outIt != outItEnd; ++outIt, ++rIt )
+	{
+		*outIt *= *rIt;
+	}
+}
+
+bool Unpremultiply::affectsSharedPlane( const Gaffer::Plug *input ) const
+{
+	return
+		input == inPlug()->channelDataPlug() ||
+		input == inPlug()->channelNamesPlug() ||
+		input == alphaChannelPlug()
+	;
+}
+
+void Unpremultiply::hashSharedPlane( const Imath::V2i &tileOrigin, const Gaffer::Context *context, IECore::MurmurHash &h ) const
+{
+	ChannelDataProcessor::hashSharedPlane( tileOrigin, context, h );
+	h.append( inPlug()->channelDataHash( alphaChannelPlug()->getValue(), tileOrigin ) );
+}
+
+IECore::ConstFloatVectorDataPtr Unpremultiply::computeSharedPlane( const Imath::V2i &tileOrigin, const Gaffer::Context *context ) const
+{
+	const std::string alphaChannel = alphaChannelPlug()->getValue();
+
 	ConstStringVectorDataPtr inChannelNamesPtr;
 	{
 		ImagePlug::GlobalScope c( context );
@@ -118,21 +142,20 @@ void Unpremultiply::processChannelData( const Gaffer::Context *context, const Im
 		throw( IECore::Exception( channelError.str() ) );
 	}
 
-	ImagePlug::ChannelDataScope channelDataScope( context );
-	channelDataScope.setChannelName( alphaChannel );
-
-	ConstFloatVectorDataPtr aData = inPlug()->channelDataPlug()->getValue();
+	ConstFloatVectorDataPtr aData = inPlug()->channelData( alphaChannel, tileOrigin );
 	const std::vector<float> &a = aData->readable();
-	std::vector<float> &out = outData->writable();
 
-	std::vector<float>::const_iterator aIt = a.begin();
-	for ( std::vector<float>::iterator outIt = out.begin(), outItEnd = out.end(); outIt != outItEnd; ++outIt, ++aIt )
+	// Pixels with zero alpha are left unchanged, so
+	// we use a reciprocal of 1 for them.
+	FloatVectorDataPtr resultData = new FloatVectorData;
+	std::vector<float> &result = resultData->writable();
+	result.reserve( a.size() );
+	for( std::vector<float>::const_iterator aIt = a.begin(), aItEnd = a.end(); aIt != aItEnd; ++aIt )
 	{
-		if ( *aIt != 0.0f )
-		{
-			*outIt /= *aIt;
-		}
+		result.push_back( *aIt != 0.0f ? 1.0f / *aIt : 1.0f );
 	}
+
+	return resultData;
 }
 
 } // namespace GafferImage
@@ -55,6 +55,9 @@ namespace
 	static IECore::InternedString g_tileInputBoundName( "tileInputBound"  );
 	static IECore::InternedString g_pixelInputPositionsName( "pixelInputPositions"  );
 	static IECore::InternedString g_pixelInputDerivativesName( "pixelInputDerivatives"  );
+	static IECore::InternedString g_pixelFilterBoundsName( "pixelFilterBounds"  );
+	static IECore::InternedString g_pixelFilterWeightsName( "pixelFilterWeights"  );
+	static IECore::InternedString g_pixelFilterWeightOffsetsName( "pixelFilterWeightOffsets"  );
 
 	const CompoundObject *sampleRegionsEmptyTile()
 	{
@@ -83,6 +86,122 @@ namespace
 			return nullptr;
 		}
 	}
+
+	// For separable filters, the filter weights for each output pixel
+	// are independent of the channel being sampled, so we compute them
+	// once per tile and store them alongside the input positions.
+	// For each pixel we store the bound of the input pixels it covers,
+	// followed by its normalised x weights and then its normalised y
+	// weights in a single flattened array.
+	void computeSeparableFilterWeights(
+		const std::vector<V2f> &pixelInputPositions, const std::vector<V2f> &pixelInputDerivatives,
+		const OIIO::Filter2D *filter, const V2f &black,
+		std::vector<Box2i> &pixelFilterBounds, std::vector<float> &pixelFilterWeights, std::vector<int> &pixelFilterWeightOffsets
+	)
+	{
+		const float filterWidth = filter->width();
+
+		pixelFilterBounds.reserve( pixelInputPositions.size() );
+		pixelFilterWeightOffsets.reserve( pixelInputPositions.size() );
+
+		for( size_t i = 0, e = pixelInputPositions.size(); i < e; ++i )
+		{
+			pixelFilterWeightOffsets.push_back( pixelFilterWeights.size() );
+
+			const V2f &p = pixelInputPositions[i];
+			if( p == black )
+			{
+				pixelFilterBounds.push_back( Box2i( V2i( 0 ) ) );
+				continue;
+			}
+
+			const V2f &d = pixelInputDerivatives[i];
+			const Box2f bounds = FilterAlgo::filterSupport( p, d.x, d.y, filterWidth );
+
+			// Include any pixels where the corner max bound is above the pixel center, and
+			// the corner min bound is below the pixel center. This must match sampleBox().
+			const Box2i pixelBounds(
+				V2i( (int)ceilf( bounds.min.x - 0.5 ), (int)ceilf( bounds.min.y - 0.5 ) ),
+				V2i( (int)floorf( bounds.max.x - 0.5 ) + 1, (int)floorf( bounds.max.y - 0.5 ) + 1 )
+			);
+			pixelFilterBounds.push_back( pixelBounds );
+
+			const float xScale = 1.0f / d.x;
+			const float yScale = 1.0f / d.y;
+
+			const size_t xOffset = pixelFilterWeights.size();
+			float xTotal = 0.0f;
+			for( int x = pixelBounds.min.x; x < pixelBounds.max.x; ++x )
+			{
+				const float w = filter->xfilt( ( x + 0.5f - p.x ) * xScale );
+				pixelFilterWeights.push_back( w );
+				xTotal += w;
+			}
+
+			const size_t yOffset = pixelFilterWeights.size();
+			float yTotal = 0.0f;
+			for( int y = pixelBounds.min.y; y < pixelBounds.max.y; ++y )
+			{
+				const float w = filter->yfilt( ( y + 0.5f - p.y ) * yScale );
+				pixelFilterWeights.push_back( w );
+				yTotal += w;
+			}
+
+			// The total weight of the 2d filter is the product of the
+			// totals for each axis, so we can normalise each axis
+			// independently. As in sampleBox(), we don't normalise if the
+			// total is zero.
+			if( xTotal * yTotal != 0.0f )
+			{
+				for( size_t j = xOffset; j < yOffset; ++j )
+				{
+					pixelFilterWeights[j] /= xTotal;
+				}
+				for( size_t j = yOffset, je = pixelFilterWeights.size(); j < je; ++j )
+				{
+					pixelFilterWeights[j] /= yTotal;
+				}
+			}
+		}
+	}
+
+	// Filters a single pixel using weights from computeSeparableFilterWeights(),
+	// reading from `input`, which holds the pixels in `inputBound`. We first
+	// accumulate weighted rows into `columnSums` and then take a weighted sum
+	// of those. This keeps the inner loops free of reductions, so they may be
+	// vectorised.
+	float filterSeparable( const float *input, const Box2i &inputBound, const Box2i &pixelBounds, const float *weights, std::vector<float> &columnSums )
+	{
+		const int width = pixelBounds.size().x;
+		const int inputWidth = inputBound.size().x;
+		const float *xWeights = weights;
+		const float *yWeights = weights + width;
+
+		columnSums.assign( width, 0.0f );
+		float *columnSumsPtr = columnSums.data();
+
+		const float *row = input + ( pixelBounds.min.y - inputBound.min.y ) * inputWidth + pixelBounds.min.x - inputBound.min.x;
+		for( int y = pixelBounds.min.y; y < pixelBounds.max.y; ++y, row += inputWidth )
+		{
+			const float yWeight = *yWeights++;
+			for( int x = 0; x < width; ++x )
+			{
+				columnSumsPtr[x] += yWeight * row[x];
+			}
+		}
+
+		float v = 0.0f;
+		for( int x = 0; x < width; ++x )
+		{
+			v += xWeights[x] * columnSumsPtr[x];
+		}
+		return v;
+	}
+
+	// Beyond this many pixels per tile, we sample the input directly rather
+	// than gathering it into a contiguous buffer first. This avoids pathological
+	// memory use when warps scatter a tile over a large area of the input.
+	const int g_maxGatherArea = 16 * ImagePlug::tileSize() * ImagePlug::tileSize();
 }
 
 float Warp::approximateDerivative( float upper, float center, float lower )
@@ -583,6 +702,20 @@ void Warp::compute( Gaffer::ValuePlug *output, const Gaffer::Context *context )
 		sampleRegions->members()[ g_tileInputBoundName ] = new Box2iData( inputPixelBound );
 		sampleRegions->members()[ g_pixelInputPositionsName ] = pixelInputPositionsData;
 		sampleRegions->members()[ g_pixelInputDerivativesName ] = pixelInputDerivativesData;
+
+		if( filter->separable() )
+		{
+			Box2iVectorDataPtr pixelFilterBoundsData = new Box2iVectorData;
+			FloatVectorDataPtr pixelFilterWeightsData = new FloatVectorData;
+			IntVectorDataPtr pixelFilterWeightOffsetsData = new IntVectorData;
+			computeSeparableFilterWeights(
+				pixelInputPositions, pixelInputDerivatives, filter, Engine::black,
+				pixelFilterBoundsData->writable(), pixelFilterWeightsData->writable(), pixelFilterWeightOffsetsData->writable()
+			);
+			sampleRegions->members()[ g_pixelFilterBoundsName ] = pixelFilterBoundsData;
+			sampleRegions->members()[ g_pixelFilterWeightsName ] = pixelFilterWeightsData;
+			sampleRegions->members()[ g_pixelFilterWeightOffsetsName ] = pixelFilterWeightOffsetsData;
+		}
 		static_cast<CompoundObjectPlug *>( output )->setValue( sampleRegions );
 		return;
 	}
@@ -670,7 +803,59 @@ IECore::ConstFloatVectorDataPtr Warp::computeChannelData( const std::string &cha
 		(Sampler::BoundingMode)boundingModePlug()->getValue()
 	);
 
-	std::vector<float> scratchMemory;
+	const Box2iVectorData *pixelFilterBoundsData = sampleRegions->member<Box2iVectorData>( g_pixelFilterBoundsName );
+	if( !pixelFilterBoundsData )
+	{
+		// Non-separable filter. Filter each pixel individually.
+		std::vector<float> scratchMemory;
+		int i = 0;
+		V2i oP;
+		for( oP.y = 0; oP.y < ImagePlug::tileSize(); ++oP.y )
+		{
+			for( oP.x = 0; oP.x < ImagePlug::tileSize(); ++oP.x, ++i )
+			{
+				float v = 0;
+				if( BufferAlgo::contains( validPixelsRelativeToTile , oP ) )
+				{
+					const V2f &input = pixelInputPositions[i];
+					if( input != Engine::black )
+					{
+						v = FilterAlgo::sampleBox( sampler, input, pixelInputDerivatives[i].x, pixelInputDerivatives[i].y, filter, scratchMemory );
+					}
+				}
+				result.push_back( v );
+			}
+		}
+
+		return resultData;
+	}
+
+	// Separable filter. The weights were computed along with the
+	// sample regions, so are shared by all channels. We first gather
+	// the input pixels into a contiguous buffer, so that the filtering
+	// loops can operate directly on rows of memory.
+
+	const std::vector<Box2i> &pixelFilterBounds = pixelFilterBoundsData->readable();
+	const std::vector<float> &pixelFilterWeights = sampleRegions->member<FloatVectorData>( g_pixelFilterWeightsName, true )->readable();
+	const std::vector<int> &pixelFilterWeightOffsets = sampleRegions->member<IntVectorData>( g_pixelFilterWeightOffsetsName, true )->readable();
+
+	const V2i inputSize = tileInputBound.size();
+	const bool gather = (int64_t)inputSize.x * (int64_t)inputSize.y <= g_maxGatherArea;
+
+	std::vector<float> input;
+	if( gather )
+	{
+		input.reserve( inputSize.x * inputSize.y );
+		for( int y = tileInputBound.min.y; y < tileInputBound.max.y; ++y )
+		{
+			for( int x = tileInputBound.min.x; x < tileInputBound.max.x; ++x )
+			{
+				input.push_back( sampler.sample( x, y ) );
+			}
+		}
+	}
+
+	std::vector<float> columnSums;
 	int i = 0;
 	V2i oP;
 	for( oP.y = 0; oP.y < ImagePlug::tileSize(); ++oP.y )
@@ -678,19 +863,33 @@ IECore::ConstFloatVectorDataPtr Warp::computeChannelData( const std::string &cha
 		for( oP.x = 0; oP.x < ImagePlug::tileSize(); ++oP.x, ++i )
 		{
 			float v = 0;
-			if( BufferAlgo::contains( validPixelsRelativeToTile , oP ) )
+			if( BufferAlgo::contains( validPixelsRelativeToTile , oP ) && pixelInputPositions[i] != Engine::black )
 			{
-				const V2f &input = pixelInputPositions[i];
-				if( input != Engine::black )
+				const Box2i &pixelBounds = pixelFilterBounds[i];
+				const float *weights = pixelFilterWeights.data() + pixelFilterWeightOffsets[i];
+				if( gather )
 				{
-					v = FilterAlgo::sampleBox( sampler, input, pixelInputDerivatives[i].x, pixelInputDerivatives[i].y, filter, scratchMemory );
+					v = filterSeparable( input.data(), tileInputBound, pixelBounds, weights, columnSums );
+				}
+				else
+				{
+					const int width = pixelBounds.size().x;
+					const float *yWeights = weights + width;
+					for( int y = pixelBounds.min.y; y < pixelBounds.max.y; ++y )
+					{
+						float rowSum = 0.0f;
+						for( int x = pixelBounds.min.x; x < pixelBounds.max.x; ++x )
+						{
+							rowSum += weights[x - pixelBounds.min.x] * sampler.sample( x, y );
+						}
+						v += *yWeights++ * rowSum;
+					}
 				}
 			}
 			result.push_back( v );
 		}
 	}
 
-
 	return resultData;
 }
 
@@ -278,6 +278,12 @@ void GafferImageModule::bindCore()
 		.staticmethod( "getDefaultFormat" )
 		.def( "acquireDefaultFormatPlug", &FormatPlug::acquireDefaultFormatPlug, return_value_policy<IECorePython::CastToIntrusivePtr>() )
 		.staticmethod( "acquireDefaultFormatPlug" )
+		.def( "setProxyScale", &FormatPlug::setProxyScale )
+		.staticmethod( "setProxyScale" )
+		.def( "getProxyScale", &FormatPlug::getProxyScale )
+		.staticmethod( "getProxyScale" )
+		.def( "proxyFormat", &FormatPlug::proxyFormat )
+		.staticmethod( "proxyFormat" )
 	;
 
 	Serialisation::registerSerialiser( FormatPlug::staticTypeId(), new FormatPlugSerialiser );
@@ -35,6 +35,13 @@
 //
 //////////////////////////////////////////////////////////////////////////
 
+#include <algorithm>
+#include <memory>
+#include <unordered_map>
+
+#include "tbb/enumerable_thread_specific.h"
+#include "tbb/spin_mutex.h"
+
 #include "boost/bind.hpp"
 
 #include "IECore/LRUCache.h"
@@ -54,32 +61,200 @@ using namespace GafferScene;
 IE_CORE_DEFINERUNTIMETYPED( AlembicSource );
 
 //////////////////////////////////////////////////////////////////////////
-// Implementation of an LRUCache of FileIndexedIOs.
+// Per-thread archives
 //////////////////////////////////////////////////////////////////////////
 
-namespace GafferScene
+namespace
 {
 
-namespace Detail
+// Sharing a single AlembicInput between all threads causes heavy
+// contention when traversing a large archive in parallel, because
+// reads through the same archive are serialised. So each thread opens
+// its own archive for each file. Each thread also keeps the ancestry of
+// the location it visited last, so queries for the same location, or
+// for a sibling or child, don't need to navigate from the root.
+
+struct ThreadArchive
 {
+	ScenePlug::ScenePath path;
+	// The input for the root, each ancestor of `path`, and
+	// finally `path` itself.
+	std::vector<AlembicInputPtr> ancestry;
+};
 
-AlembicInputPtr alembicInputGetter( const std::string &fileName, size_t &cost )
+struct ThreadArchives
 {
-	cost = 1;
-	return new AlembicInput( fileName );
+
+	ThreadArchives()
+	{
+	}
+
+	// The mutex isn't copied, but enumerable_thread_specific
+	// requires us to be copyable.
+	ThreadArchives( const ThreadArchives &other )
+		:	archives( other.archives )
+	{
+	}
+
+	// Only ever contended when a refresh closes the
+	// archives from another thread.
+	tbb::spin_mutex mutex;
+	std::unordered_map<std::string, ThreadArchive> archives;
+
+};
+
+typedef tbb::enumerable_thread_specific<ThreadArchives> ThreadSpecificArchives;
+ThreadSpecificArchives g_threadArchives;
+
+// Limits the number of archives held open by each thread. This is
+// multiplied by the number of threads, so must be kept small.
+const size_t g_maxArchivesPerThread = 8;
+
+AlembicInputPtr threadInput( const std::string &fileName, const ScenePlug::ScenePath &path )
+{
+	ThreadArchives &threadArchives = g_threadArchives.local();
+	tbb::spin_mutex::scoped_lock lock( threadArchives.mutex );
+
+	std::unordered_map<std::string, ThreadArchive>::iterator it = threadArchives.archives.find( fileName );
+	if( it == threadArchives.archives.end() )
+	{
+		AlembicInputPtr root = new AlembicInput( fileName );
+		if( threadArchives.archives.size() >= g_maxArchivesPerThread )
+		{
+			threadArchives.archives.clear();
+		}
+		it = threadArchives.archives.insert( std::make_pair( fileName, ThreadArchive() ) ).first;
+		it->second.ancestry.push_back( root );
+	}
+
+	ThreadArchive &archive = it->second;
+
+	size_t commonSize = 0;
+	while( commonSize < path.size() && commonSize < archive.path.size() && path[commonSize] == archive.path[commonSize] )
+	{
+		commonSize++;
+	}
+
+	archive.path.resize( commonSize );
+	archive.ancestry.resize( commonSize + 1 );
+
+	for( ScenePlug::ScenePath::const_iterator pIt = path.begin() + commonSize, pEIt = path.end(); pIt != pEIt; ++pIt )
+	{
+		AlembicInputPtr child = archive.ancestry.back()->child( pIt->value() );
+		archive.ancestry.push_back( child );
+		archive.path.push_back( *pIt );
+	}
+
+	return archive.ancestry.back();
+}
+
+// Closes the archives for `fileName` on all threads.
+void closeThreadInputs( const std::string &fileName )
+{
+	for( ThreadSpecificArchives::iterator it = g_threadArchives.begin(), eIt = g_threadArchives.end(); it != eIt; ++it )
+	{
+		tbb::spin_mutex::scoped_lock lock( it->mutex );
+		it->archives.erase( fileName );
+	}
 }
 
-typedef LRUCache<std::string, AlembicInputPtr> AlembicInputCache;
+} // namespace
+
+//////////////////////////////////////////////////////////////////////////
+// Sample time cache
+//////////////////////////////////////////////////////////////////////////
+
+namespace
+{
+
+// Mapping a time to a sample requires the sample times for the
+// location. We memoise these in a cache shared between all threads,
+// so that hashes can be computed without needing to read the archive.
+
+typedef std::vector<double> SampleTimes;
+typedef std::shared_ptr<const SampleTimes> ConstSampleTimesPtr;
+
+struct SampleTimesCacheGetterKey
+{
+
+	SampleTimesCacheGetterKey()
+		:	fileName( nullptr ), path( nullptr )
+	{
+	}
+
+	SampleTimesCacheGetterKey( const std::string &fileName, const ScenePlug::ScenePath &path )
+		:	fileName( &fileName ), path( &path )
+	{
+		hash.append( fileName );
+		hash.append( path.size() ? &(path[0]) : nullptr, path.size() );
+	}
+
+	operator const IECore::MurmurHash & () const
+	{
+		return hash;
+	}
+
+	const std::string *fileName;
+	const ScenePlug::ScenePath *path;
+	MurmurHash hash;
 
-AlembicInputCache *alembicInputCache()
+};
+
+ConstSampleTimesPtr sampleTimesGetter( const SampleTimesCacheGetterKey &key, size_t &cost )
 {
-	static AlembicInputCache *c = new AlembicInputCache( alembicInputGetter, 200 );
-	return c;
+	AlembicInputPtr i = threadInput( *key.fileName, *key.path );
+
+	std::shared_ptr<SampleTimes> result( new SampleTimes );
+	const size_t numSamples = i->numSamples();
+	result->reserve( numSamples );
+	for( size_t s = 0; s < numSamples; ++s )
+	{
+		result->push_back( i->timeAtSample( s ) );
+	}
+
+	cost = numSamples + 1;
+	return result;
 }
 
-} // namespace Detail
+typedef LRUCache<IECore::MurmurHash, ConstSampleTimesPtr, LRUCachePolicy::Parallel, SampleTimesCacheGetterKey> SampleTimesCache;
+SampleTimesCache g_sampleTimesCache( sampleTimesGetter, 10000000 );
 
-} // namespace GafferScene
+// Times within this tolerance of a sample are read from the sample
+// directly, matching `AlembicInput::sampleIntervalAtTime()`.
+const double g_sampleTolerance = 0.0001;
+
+// Returns true if `time` maps onto a single sample, without interpolation,
+// and fills `sampleIndex` with the index of that sample.
+bool exactSample( const SampleTimes &times, double time, size_t &sampleIndex )
+{
+	if( times.size() <= 1 || time <= times.front() )
+	{
+		sampleIndex = 0;
+		return true;
+	}
+	else if( time >= times.back() )
+	{
+		sampleIndex = times.size() - 1;
+		return true;
+	}
+
+	const size_t ceilIndex = std::upper_bound( times.begin(), times.end(), time ) - times.begin();
+	const size_t floorIndex = ceilIndex - 1;
+	if( time - times[floorIndex] < g_sampleTolerance )
+	{
+		sampleIndex = floorIndex;
+		return true;
+	}
+	else if( times[ceilIndex] - time < g_sampleTolerance )
+	{
+		sampleIndex = ceilIndex;
+		return true;
+	}
+
+	return false;
+}
+
+} // namespace
 
 //////////////////////////////////////////////////////////////////////////
 // AlembicSource implementation
@@ -87,8 +262,6 @@ AlembicInputCache *alembicInputCache()
 
 size_t AlembicSource::g_firstPlugIndex = 0;
 
-using namespace GafferScene::Detail;
-
 AlembicSource::AlembicSource( const std::string &name )
 	:	SceneNode( name )
 {
@@ -139,7 +312,12 @@ void AlembicSource::plugSet( Gaffer::Plug *plug )
 {
 	if( plug == refreshCountPlug() )
 	{
-		alembicInputCache()->clear();
+		const std::string fileName = fileNamePlug()->getValue();
+		if( fileName.size() )
+		{
+			closeThreadInputs( fileName );
+		}
+		g_sampleTimesCache.clear();
 	}
 }
 
@@ -179,7 +357,7 @@ void AlembicSource::hashTransform( const ScenePath &path, const Gaffer::Context
 	refreshCountPlug()->hash( h );
 
 	h.append( &(path[0]), path.size() );
-	h.append( context->getTime() );
+	hashTime( path, context->getTime(), h );
 }
 
 Imath::M44f AlembicSource::computeTransform( const ScenePath &path, const Gaffer::Context *context, const ScenePlug *parent ) const
@@ -187,7 +365,8 @@ Imath::M44f AlembicSource::computeTransform( const ScenePath &path, const Gaffer
 	M44f result;
 	if( AlembicInputPtr i = inputForPath( path ) )
 	{
-		M44d t = i->transformAtTime( context->getTime() );
+		size_t sampleIndex;
+		M44d t = sampleAtTime( path, context->getTime(), sampleIndex ) ? i->transformAtSample( sampleIndex ) : i->transformAtTime( context->getTime() );
 		/// \todo Maybe we should be using doubles for bounds and transforms anyway?
 		result = M44f(
 			t[0][0], t[0][1], t[0][2], t[0][3],
@@ -218,7 +397,7 @@ void AlembicSource::hashObject( const ScenePath &path, const Gaffer::Context *co
 	refreshCountPlug()->hash( h );
 
 	h.append( &(path[0]), path.size() );
-	h.append( context->getTime() );
+	hashTime( path, context->getTime(), h );
 }
 
 IECore::ConstObjectPtr AlembicSource::computeObject( const ScenePath &path, const Gaffer::Context *context, const ScenePlug *parent ) const
@@ -227,7 +406,10 @@ IECore::ConstObjectPtr AlembicSource::computeObject( const ScenePath &path, cons
 	if( AlembicInputPtr i = inputForPath( path ) )
 	{
 		/// \todo Maybe template objectAtTime and then we don't need the cast.
-		ConstRenderablePtr renderable = runTimeCast<Renderable>( i->objectAtTime( context->getTime(), IECore::RenderableTypeId ) );
+		size_t sampleIndex;
+		ConstRenderablePtr renderable = runTimeCast<Renderable>(
+			sampleAtTime( path, context->getTime(), sampleIndex ) ? i->objectAtSample( sampleIndex, IECore::RenderableTypeId ) : i->objectAtTime( context->getTime(), IECore::RenderableTypeId )
+		);
 		if( renderable )
 		{
 			result = renderable;
@@ -300,11 +482,47 @@ IECoreAlembic::AlembicInputPtr AlembicSource::inputForPath( const ScenePath &pat
 		return nullptr;
 	}
 
-	AlembicInputPtr result = Detail::alembicInputCache()->get( fileName );
-	for( ScenePath::const_iterator it = path.begin(), eIt = path.end(); it != eIt; it++ )
+	return threadInput( fileName, path );
+}
+
+bool AlembicSource::sampleAtTime( const ScenePath &path, double time, size_t &sampleIndex ) const
+{
+	const std::string fileName = fileNamePlug()->getValue();
+	if( !fileName.size() )
 	{
-		result = result->child( it->value() );
+		return false;
 	}
 
-	return result;
+	ConstSampleTimesPtr sampleTimes = g_sampleTimesCache.get( SampleTimesCacheGetterKey( fileName, path ) );
+	return exactSample( *sampleTimes, time, sampleIndex );
+}
+
+void AlembicSource::hashTime( const ScenePath &path, double time, IECore::MurmurHash &h ) const
+{
+	// Times that map onto the same sample produce identical results,
+	// so we hash the sample index rather than the time. This allows
+	// results to be shared between frames - most notably for static
+	// locations. Finding the sample requires reading the archive,
+	// so if that fails we fall back to hashing the time, leaving the
+	// error to be reported by the compute.
+	size_t sampleIndex;
+	bool exact = false;
+	try
+	{
+		exact = sampleAtTime( path, time, sampleIndex );
+	}
+	catch( ... )
+	{
+	}
+
+	if( exact )
+	{
+		h.append( true );
+		h.append( (uint64_t)sampleIndex );
+	}
+	else
+	{
+		h.append( false );
+		h.append( time );
+	}
 }
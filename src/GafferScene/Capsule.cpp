@@ -34,18 +34,353 @@
 //
 //////////////////////////////////////////////////////////////////////////
 
+#include <map>
+#include <unordered_map>
+
+#include "tbb/concurrent_vector.h"
+#include "tbb/parallel_for.h"
+#include "tbb/blocked_range.h"
+
 #include "boost/bind.hpp"
 
 #include "IECore/MessageHandler.h"
+#include "IECore/LRUCache.h"
 
 #include "GafferScene/Capsule.h"
 #include "GafferScene/ScenePlug.h"
 #include "GafferScene/RendererAlgo.h"
 
+using namespace std;
+using namespace Imath;
 using namespace IECore;
 using namespace Gaffer;
 using namespace GafferScene;
 
+//////////////////////////////////////////////////////////////////////////
+// Expansion cache
+//////////////////////////////////////////////////////////////////////////
+
+namespace
+{
+
+// Expanding a capsule requires a full traversal of the encapsulated
+// subtree, which is expensive, and renderers may expand identical
+// capsules many times - once per instance of a capsule that is referenced
+// from many locations, and once per render for interactive edits. So we
+// expand each capsule just once, capturing the flattened list of locations
+// with a CaptureRenderer, and cache the result so it can be replayed
+// cheaply into any number of real renderers.
+
+class CapturedAttributes : public IECoreScenePreview::Renderer::AttributesInterface
+{
+
+	public :
+
+		CapturedAttributes( const CompoundObject *attributes )
+			:	m_attributes( attributes )
+		{
+		}
+
+		const CompoundObject *attributes() const
+		{
+			return m_attributes.get();
+		}
+
+	private :
+
+		ConstCompoundObjectPtr m_attributes;
+
+};
+
+IE_CORE_DECLAREPTR( CapturedAttributes )
+
+class CapturedObject : public IECoreScenePreview::Renderer::ObjectInterface
+{
+
+	public :
+
+		CapturedObject( const std::string &name, const IECoreScenePreview::Renderer::Prototype *prototype, const CapturedAttributes *attributes )
+			:	m_name( name ), m_prototype( prototype ), m_attributes( attributes )
+		{
+		}
+
+		void transform( const Imath::M44f &transform ) override
+		{
+			m_transformSamples.assign( 1, transform );
+			m_transformTimes.clear();
+		}
+
+		void transform( const std::vector<Imath::M44f> &samples, const std::vector<float> &times ) override
+		{
+			m_transformSamples = samples;
+			m_transformTimes = times;
+		}
+
+		bool attributes( const IECoreScenePreview::Renderer::AttributesInterface *attributes ) override
+		{
+			m_attributes = static_cast<const CapturedAttributes *>( attributes );
+			return true;
+		}
+
+		const CapturedAttributes *attributes() const
+		{
+			return m_attributes.get();
+		}
+
+		const IECoreScenePreview::Renderer::Prototype *prototype() const
+		{
+			return m_prototype.get();
+		}
+
+		void render( IECoreScenePreview::Renderer *renderer, const IECoreScenePreview::Renderer::AttributesInterface *attributes ) const
+		{
+			IECoreScenePreview::Renderer::ObjectInterfacePtr objectInterface = renderer->instance( m_name, m_prototype.get(), attributes );
+			if( !objectInterface || m_transformSamples.empty() )
+			{
+				return;
+			}
+
+			if( m_transformTimes.empty() )
+			{
+				objectInterface->transform( m_transformSamples[0] );
+			}
+			else
+			{
+				objectInterface->transform( m_transformSamples, m_transformTimes );
+			}
+		}
+
+	private :
+
+		const std::string m_name;
+		IECoreScenePreview::Renderer::ConstPrototypePtr m_prototype;
+		ConstCapturedAttributesPtr m_attributes;
+		vector<M44f> m_transformSamples;
+		vector<float> m_transformTimes;
+
+};
+
+IE_CORE_DECLAREPTR( CapturedObject )
+
+// Records the objects output by `RendererAlgo::outputObjects()`.
+// Capsules only output objects, so everything else is ignored.
+class CaptureRenderer : public IECoreScenePreview::Renderer
+{
+
+	public :
+
+		typedef tbb::concurrent_vector<CapturedObjectPtr> Objects;
+
+		void option( const IECore::InternedString &name, const IECore::Object *value ) override
+		{
+		}
+
+		void output( const IECore::InternedString &name, const Output *output ) override
+		{
+		}
+
+		AttributesInterfacePtr attributes( const IECore::CompoundObject *attributes ) override
+		{
+			return new CapturedAttributes( attributes );
+		}
+
+		ObjectInterfacePtr camera( const std::string &name, const IECore::Camera *camera, const AttributesInterface *attributes ) override
+		{
+			return nullptr;
+		}
+
+		ObjectInterfacePtr light( const std::string &name, const IECore::Object *object, const AttributesInterface *attributes ) override
+		{
+			return nullptr;
+		}
+
+		ObjectInterfacePtr object( const std::string &name, const IECore::Object *object, const AttributesInterface *attributes ) override
+		{
+			PrototypePtr prototype = new Prototype( object->hash(), object );
+			return instance( name, prototype.get(), attributes );
+		}
+
+		ObjectInterfacePtr object( const std::string &name, const std::vector<const IECore::Object *> &samples, const std::vector<float> &times, const AttributesInterface *attributes ) override
+		{
+			MurmurHash h;
+			for( size_t i = 0; i < samples.size(); ++i )
+			{
+				samples[i]->hash( h );
+				h.append( times[i] );
+			}
+			PrototypePtr prototype = new Prototype( h, samples, times );
+			return instance( name, prototype.get(), attributes );
+		}
+
+		ObjectInterfacePtr instance( const std::string &name, const Prototype *prototype, const AttributesInterface *attributes ) override
+		{
+			CapturedObjectPtr result = new CapturedObject( name, prototype, static_cast<const CapturedAttributes *>( attributes ) );
+			m_objects.push_back( result );
+			return result;
+		}
+
+		void render() override
+		{
+		}
+
+		void pause() override
+		{
+		}
+
+		Objects &objects()
+		{
+			return m_objects;
+		}
+
+	private :
+
+		Objects m_objects;
+
+};
+
+IE_CORE_DECLAREPTR( CaptureRenderer )
+
+class Expansion : public IECore::RefCounted
+{
+
+	public :
+
+		IE_CORE_DECLAREMEMBERPTR( Expansion )
+
+		Expansion( CaptureRenderer::Objects &objects )
+			:	m_objects( objects.begin(), objects.end() )
+		{
+		}
+
+		size_t memoryUsage() const
+		{
+			// Prototypes and attributes are typically shared between
+			// many objects, and the accumulator only counts each once.
+			Object::MemoryAccumulator accumulator;
+			for( vector<ConstCapturedObjectPtr>::const_iterator it = m_objects.begin(), eIt = m_objects.end(); it != eIt; ++it )
+			{
+				const vector<ConstObjectPtr> &samples = (*it)->prototype()->samples();
+				for( vector<ConstObjectPtr>::const_iterator sIt = samples.begin(), sEIt = samples.end(); sIt != sEIt; ++sIt )
+				{
+					accumulator.accumulate( sIt->get() );
+				}
+				accumulator.accumulate( (*it)->attributes()->attributes() );
+			}
+			return accumulator.total() + m_objects.size() * sizeof( CapturedObject );
+		}
+
+		void render( IECoreScenePreview::Renderer *renderer ) const
+		{
+			// Make one AttributesInterface for each unique block of
+			// captured attributes, so that sharing is preserved. We key
+			// by content hash rather than by pointer, so that equal
+			// attributes captured from different locations are shared
+			// too. The pointer map avoids rehashing shared blocks.
+			AttributesMap attributes;
+			std::map<MurmurHash, IECoreScenePreview::Renderer::AttributesInterfacePtr> uniqueAttributes;
+			for( vector<ConstCapturedObjectPtr>::const_iterator it = m_objects.begin(), eIt = m_objects.end(); it != eIt; ++it )
+			{
+				IECoreScenePreview::Renderer::AttributesInterfacePtr &a = attributes[(*it)->attributes()];
+				if( !a )
+				{
+					const CompoundObject *capturedAttributes = (*it)->attributes()->attributes();
+					IECoreScenePreview::Renderer::AttributesInterfacePtr &u = uniqueAttributes[capturedAttributes->Object::hash()];
+					if( !u )
+					{
+						u = renderer->attributes( capturedAttributes );
+					}
+					a = u;
+				}
+			}
+
+			RenderObjects renderObjects( m_objects, attributes, renderer );
+			tbb::parallel_for( tbb::blocked_range<size_t>( 0, m_objects.size() ), renderObjects );
+		}
+
+	private :
+
+		typedef std::unordered_map<const CapturedAttributes *, IECoreScenePreview::Renderer::AttributesInterfacePtr> AttributesMap;
+
+		struct RenderObjects
+		{
+
+			RenderObjects( const vector<ConstCapturedObjectPtr> &objects, const AttributesMap &attributes, IECoreScenePreview::Renderer *renderer )
+				:	m_objects( objects ), m_attributes( attributes ), m_renderer( renderer )
+			{
+			}
+
+			void operator()( const tbb::blocked_range<size_t> &range ) const
+			{
+				for( size_t i = range.begin(); i != range.end(); ++i )
+				{
+					const CapturedObject *object = m_objects[i].get();
+					object->render( m_renderer, m_attributes.find( object->attributes() )->second.get() );
+				}
+			}
+
+			private :
+
+				const vector<ConstCapturedObjectPtr> &m_objects;
+				const AttributesMap &m_attributes;
+				IECoreScenePreview::Renderer *m_renderer;
+
+		};
+
+		vector<ConstCapturedObjectPtr> m_objects;
+
+};
+
+IE_CORE_DECLAREPTR( Expansion )
+
+struct ExpansionCacheGetterKey
+{
+
+	ExpansionCacheGetterKey()
+		:	capsule( nullptr )
+	{
+	}
+
+	ExpansionCacheGetterKey( const Capsule *capsule, const IECore::MurmurHash &hash )
+		:	capsule( capsule ), hash( hash )
+	{
+	}
+
+	operator const IECore::MurmurHash & () const
+	{
+		return hash;
+	}
+
+	const Capsule *capsule;
+	MurmurHash hash;
+
+};
+
+ConstExpansionPtr expansionGetter( const ExpansionCacheGetterKey &key, size_t &cost )
+{
+	const ScenePlug *scene = key.capsule->scene();
+
+	ScenePlug::GlobalScope globalScope( key.capsule->context() );
+	ConstCompoundObjectPtr globals = scene->globalsPlug()->getValue();
+	RendererAlgo::RenderSets renderSets( scene );
+
+	CaptureRendererPtr renderer = new CaptureRenderer;
+	Context::Scope scope( key.capsule->context() );
+	RendererAlgo::outputObjects( scene, globals.get(), renderSets, renderer.get(), key.capsule->root() );
+
+	ExpansionPtr result = new Expansion( renderer->objects() );
+	cost = result->memoryUsage();
+	return result;
+}
+
+typedef LRUCache<IECore::MurmurHash, ConstExpansionPtr, LRUCachePolicy::Parallel, ExpansionCacheGetterKey> ExpansionCache;
+ExpansionCache g_expansionCache( expansionGetter, 500 * 1024 * 1024 );
+
+} // namespace
+
+//////////////////////////////////////////////////////////////////////////
+// Capsule
+//////////////////////////////////////////////////////////////////////////
+
 IE_CORE_DEFINEOBJECTTYPEDESCRIPTION( Capsule );
 
 Capsule::Capsule()
@@ -165,10 +500,17 @@ Imath::Box3f Capsule::bound() const
 void Capsule::render( IECoreScenePreview::Renderer *renderer ) const
 {
 	throwIfExpired();
-	IECore::ConstCompoundObjectPtr globals = m_scene->globalsPlug()->getValue();
-	RendererAlgo::RenderSets renderSets( m_scene );
-	Context::Scope scope( m_context.get() );
-	RendererAlgo::outputObjects( m_scene, globals.get(), renderSets, renderer, m_root );
+
+	// The expansion depends on the globals as well as the
+	// encapsulated subtree, because they specify motion blur.
+	MurmurHash h = m_hash;
+	{
+		ScenePlug::GlobalScope globalScope( m_context.get() );
+		h.append( m_scene->globalsPlug()->hash() );
+	}
+
+	ConstExpansionPtr expansion = g_expansionCache.get( ExpansionCacheGetterKey( this, h ) );
+	expansion->render( renderer );
 }
 
 const ScenePlug *Capsule::scene() const
@@ -189,6 +531,26 @@ const Gaffer::Context *Capsule::context() const
 	return m_context.get();
 }
 
+size_t Capsule::getExpansionCacheMemoryLimit()
+{
+	return g_expansionCache.getMaxCost();
+}
+
+void Capsule::setExpansionCacheMemoryLimit( size_t bytes )
+{
+	g_expansionCache.setMaxCost( bytes );
+}
+
+size_t Capsule::expansionCacheMemoryUsage()
+{
+	return g_expansionCache.currentCost();
+}
+
+void Capsule::clearExpansionCache()
+{
+	g_expansionCache.clear();
+}
+
 void Capsule::plugDirtied( const Gaffer::Plug *plug )
 {
 	if( plug->parent() == m_scene && plug != m_scene->globalsPlug() )
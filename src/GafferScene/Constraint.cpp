@@ -34,6 +34,7 @@
 //
 //////////////////////////////////////////////////////////////////////////
 
+#include "Gaffer/Context.h"
 #include "Gaffer/StringPlug.h"
 
 #include "GafferScene/Constraint.h"
@@ -54,6 +55,7 @@ Constraint::Constraint( const std::string &name )
 	addChild( new StringPlug( "target" ) );
 	addChild( new IntPlug( "targetMode", Plug::In, Origin, Origin, BoundCenter ) );
 	addChild( new V3fPlug( "targetOffset" ) );
+	addChild( new M44fPlug( "__fullInputTransform", Plug::Out ) );
 
 	// Pass through things we don't want to modify
 	outPlug()->attributesPlug()->setInput( inPlug()->attributesPlug() );
@@ -94,11 +96,27 @@ const Gaffer::V3fPlug *Constraint::targetOffsetPlug() const
 	return getChild<Gaffer::V3fPlug>( g_firstPlugIndex + 2 );
 }
 
+Gaffer::M44fPlug *Constraint::fullInputTransformPlug()
+{
+	return getChild<Gaffer::M44fPlug>( g_firstPlugIndex + 3 );
+}
+
+const Gaffer::M44fPlug *Constraint::fullInputTransformPlug() const
+{
+	return getChild<Gaffer::M44fPlug>( g_firstPlugIndex + 3 );
+}
+
 void Constraint::affects( const Gaffer::Plug *input, AffectedPlugsContainer &outputs ) const
 {
 	SceneElementProcessor::affects( input, outputs );
 
+	if( input == inPlug()->transformPlug() )
+	{
+		outputs.push_back( fullInputTransformPlug() );
+	}
+
 	if(
+		input == fullInputTransformPlug() ||
 		input == targetPlug() ||
 		input == targetModePlug() ||
 		input->parent<Plug>() == targetOffsetPlug() ||
@@ -112,6 +130,42 @@ void Constraint::affects( const Gaffer::Plug *input, AffectedPlugsContainer &out
 	}
 }
 
+void Constraint::hash( const Gaffer::ValuePlug *output, const Gaffer::Context *context, IECore::MurmurHash &h ) const
+{
+	SceneElementProcessor::hash( output, context, h );
+
+	if( output == fullInputTransformPlug() )
+	{
+		const ScenePath &path = context->get<ScenePath>( ScenePlug::scenePathContextName );
+		if( path.size() )
+		{
+			ScenePath parentPath = path;
+			parentPath.pop_back();
+			h.append( fullInputTransformHash( parentPath ) );
+			inPlug()->transformPlug()->hash( h );
+		}
+	}
+}
+
+void Constraint::compute( Gaffer::ValuePlug *output, const Gaffer::Context *context ) const
+{
+	if( output == fullInputTransformPlug() )
+	{
+		const ScenePath &path = context->get<ScenePath>( ScenePlug::scenePathContextName );
+		M44f result;
+		if( path.size() )
+		{
+			ScenePath parentPath = path;
+			parentPath.pop_back();
+			result = inPlug()->transformPlug()->getValue() * fullInputTransform( parentPath );
+		}
+		static_cast<M44fPlug *>( output )->setValue( result );
+		return;
+	}
+
+	SceneElementProcessor::compute( output, context );
+}
+
 bool Constraint::processesTransform() const
 {
 	return true;
@@ -121,11 +175,11 @@ void Constraint::hashProcessedTransform( const ScenePath &path, const Gaffer::Co
 {
 	ScenePath parentPath = path;
 	parentPath.pop_back();
-	h.append( inPlug()->fullTransformHash( parentPath ) );
+	h.append( fullInputTransformHash( parentPath ) );
 
 	ScenePath targetPath;
 	tokenizeTargetPath( targetPath );
-	h.append( inPlug()->fullTransformHash( targetPath ) );
+	h.append( fullInputTransformHash( targetPath ) );
 
 	const TargetMode targetMode = (TargetMode)targetModePlug()->getValue();
 	h.append( targetMode );
@@ -144,12 +198,12 @@ Imath::M44f Constraint::computeProcessedTransform( const ScenePath &path, const
 	ScenePath parentPath = path;
 	parentPath.pop_back();
 
-	const M44f parentTransform = inPlug()->fullTransform( parentPath );
-	const M44f fullInputTransform = inputTransform * parentTransform;
+	const M44f parentTransform = fullInputTransform( parentPath );
+	const M44f inputFullTransform = inputTransform * parentTransform;
 
 	ScenePath targetPath;
 	tokenizeTargetPath( targetPath );
-	M44f fullTargetTransform = inPlug()->fullTransform( targetPath );
+	M44f fullTargetTransform = fullInputTransform( targetPath );
 
 	const TargetMode targetMode = (TargetMode)targetModePlug()->getValue();
 	if( targetMode != Origin )
@@ -176,10 +230,22 @@ Imath::M44f Constraint::computeProcessedTransform( const ScenePath &path, const
 
 	fullTargetTransform.translate( targetOffsetPlug()->getValue() );
 
-	const M44f fullConstrainedTransform = computeConstraint( fullTargetTransform, fullInputTransform, inputTransform );
+	const M44f fullConstrainedTransform = computeConstraint( fullTargetTransform, inputFullTransform, inputTransform );
 	return fullConstrainedTransform * parentTransform.inverse();
 }
 
+IECore::MurmurHash Constraint::fullInputTransformHash( const ScenePath &path ) const
+{
+	ScenePlug::PathScope scope( Context::current(), path );
+	return fullInputTransformPlug()->hash();
+}
+
+Imath::M44f Constraint::fullInputTransform( const ScenePath &path ) const
+{
+	ScenePlug::PathScope scope( Context::current(), path );
+	return fullInputTransformPlug()->getValue();
+}
+
 void Constraint::tokenizeTargetPath( ScenePath &path ) const
 {
 	std::string targetPathAsString = targetPlug()->getValue();
@@ -43,6 +43,7 @@
 #include "Gaffer/StringPlug.h"
 
 #include "GafferScene/DeleteFaces.h"
+#include "GafferScene/Private/IECoreScenePreview/MeshAlgo.h"
 
 using namespace IECore;
 using namespace Gaffer;
@@ -57,6 +58,7 @@ DeleteFaces::DeleteFaces( const std::string &name ) : SceneElementProcessor( nam
 	storeIndexOfNextChild( g_firstPlugIndex );
 
 	addChild( new StringPlug( "faces", Plug::In, "deleteFaces" ) );
+	addChild( new BoolPlug( "parallel", Plug::In, false ) );
 
 	// Fast pass-through for things we don't modify
 	outPlug()->attributesPlug()->setInput( inPlug()->attributesPlug() );
@@ -77,11 +79,21 @@ const Gaffer::StringPlug *DeleteFaces::facesPlug() const
 	return getChild<StringPlug>( g_firstPlugIndex );
 }
 
+Gaffer::BoolPlug *DeleteFaces::parallelPlug()
+{
+	return getChild<BoolPlug>( g_firstPlugIndex + 1 );
+}
+
+const Gaffer::BoolPlug *DeleteFaces::parallelPlug() const
+{
+	return getChild<BoolPlug>( g_firstPlugIndex + 1 );
+}
+
 void DeleteFaces::affects( const Gaffer::Plug *input, AffectedPlugsContainer &outputs ) const
 {
 	SceneElementProcessor::affects( input, outputs );
 
-	if( input == facesPlug() )
+	if( input == facesPlug() || input == parallelPlug() )
 	{
 		outputs.push_back( outPlug()->objectPlug() );
 	}
@@ -120,6 +132,7 @@ bool DeleteFaces::processesObject() const
 void DeleteFaces::hashProcessedObject( const ScenePath &path, const Gaffer::Context *context, IECore::MurmurHash &h ) const
 {
 	facesPlug()->hash( h );
+	parallelPlug()->hash( h );
 }
 
 IECore::ConstObjectPtr DeleteFaces::computeProcessedObject( const ScenePath &path, const Gaffer::Context *context, IECore::ConstObjectPtr inputObject ) const
@@ -144,5 +157,9 @@ IECore::ConstObjectPtr DeleteFaces::computeProcessedObject( const ScenePath &pat
 		throw InvalidArgumentException( boost::str( boost::format( "DeleteFaces : No primitive variable \"%s\" found" ) % deletePrimVarName ) );
 	}
 
+	if( parallelPlug()->getValue() )
+	{
+		return IECoreScenePreview::MeshAlgo::deleteFaces( mesh, it->second );
+	}
 	return MeshAlgo::deleteFaces( mesh, it->second );
 }
@@ -36,6 +36,8 @@
 
 #include "boost/bind.hpp"
 
+#include "tbb/atomic.h"
+
 #include "GafferScene/Encapsulate.h"
 #include "GafferScene/Capsule.h"
 
@@ -47,8 +49,18 @@ IE_CORE_DEFINERUNTIMETYPED( Encapsulate );
 
 size_t Encapsulate::g_firstPlugIndex = 0;
 
+namespace
+{
+
+// Used to give each Encapsulate node a unique identity for use in
+// the capsule hash. Unlike the node's address, this is never reused
+// when one node is destroyed and another created in its place.
+tbb::atomic<uint64_t> g_serial;
+
+} // namespace
+
 Encapsulate::Encapsulate( const std::string &name )
-	:	FilteredSceneProcessor( name, Filter::NoMatch ), m_dirtyCount( 0 )
+	:	FilteredSceneProcessor( name, Filter::NoMatch ), m_serial( ++g_serial ), m_dirtyCount( 0 )
 {
 	storeIndexOfNextChild( g_firstPlugIndex );
 
@@ -144,7 +156,7 @@ void Encapsulate::hashObject( const ScenePath &path, const Gaffer::Context *cont
 		/// \todo Is this the right approach? Should we just suck it
 		/// up and compute the accurate hash? Or at least provide the
 		/// option?
-		h.append( reinterpret_cast<uint64_t>( this ) );
+		h.append( m_serial );
 		h.append( m_dirtyCount );
 		h.append( context->hash() );
 		inPlug()->boundPlug()->hash( h );
@@ -53,6 +53,7 @@ Filter::Filter( const std::string &name )
 	storeIndexOfNextChild( g_firstPlugIndex );
 	addChild( new BoolPlug( "enabled", Gaffer::Plug::In, true ) );
 	addChild( new FilterPlug( "out", Gaffer::Plug::Out, Plug::Default & ( ~Plug::Cacheable ) ) );
+	addChild( new PathMatcherDataPlug( "__matchingPaths", Gaffer::Plug::Out, new PathMatcherData ) );
 }
 
 Filter::~Filter()
@@ -79,6 +80,16 @@ const FilterPlug *Filter::outPlug() const
 	return getChild<FilterPlug>( g_firstPlugIndex + 1 );
 }
 
+PathMatcherDataPlug *Filter::matchingPathsPlug()
+{
+	return getChild<PathMatcherDataPlug>( g_firstPlugIndex + 2 );
+}
+
+const PathMatcherDataPlug *Filter::matchingPathsPlug() const
+{
+	return getChild<PathMatcherDataPlug>( g_firstPlugIndex + 2 );
+}
+
 void Filter::affects( const Gaffer::Plug *input, AffectedPlugsContainer &outputs ) const
 {
 	ComputeNode::affects( input, outputs );
@@ -86,6 +97,7 @@ void Filter::affects( const Gaffer::Plug *input, AffectedPlugsContainer &outputs
 	if( input == enabledPlug() )
 	{
 		outputs.push_back( outPlug() );
+		outputs.push_back( matchingPathsPlug() );
 	}
 }
 
@@ -94,6 +106,23 @@ bool Filter::sceneAffectsMatch( const ScenePlug *scene, const Gaffer::ValuePlug
 	return false;
 }
 
+bool Filter::canComputeMatchingPaths() const
+{
+	return false;
+}
+
+const Filter *Filter::matchingPathsFilter( const Gaffer::Plug *filterPlug )
+{
+	const Plug *source = filterPlug->source();
+	const Filter *filter = IECore::runTimeCast<const Filter>( source->node() );
+	if( !filter || source != filter->outPlug() )
+	{
+		return nullptr;
+	}
+
+	return filter->canComputeMatchingPaths() ? filter : nullptr;
+}
+
 void Filter::setInputScene( Gaffer::Context *context, const ScenePlug *scenePlug )
 {
 	context->set( inputSceneContextName, (uint64_t)scenePlug );
@@ -122,6 +151,13 @@ void Filter::hash( const Gaffer::ValuePlug *output, const Gaffer::Context *conte
 			hashMatch( getInputScene( context ), context, h );
 		}
 	}
+	else if( output == matchingPathsPlug() )
+	{
+		if( enabledPlug()->getValue() )
+		{
+			hashMatchingPaths( getInputScene( context ), context, h );
+		}
+	}
 }
 
 void Filter::compute( ValuePlug *output, const Context *context ) const
@@ -136,6 +172,20 @@ void Filter::compute( ValuePlug *output, const Context *context ) const
 		static_cast<FilterPlug *>( output )->setValue( match );
 		return;
 	}
+	else if( output == matchingPathsPlug() )
+	{
+		ConstPathMatcherDataPtr matchingPaths;
+		if( enabledPlug()->getValue() )
+		{
+			matchingPaths = computeMatchingPaths( getInputScene( context ), context );
+		}
+		else
+		{
+			matchingPaths = matchingPathsPlug()->defaultValue();
+		}
+		static_cast<PathMatcherDataPlug *>( output )->setValue( matchingPaths );
+		return;
+	}
 
 	ComputeNode::compute( output, context );
 }
@@ -149,3 +199,12 @@ unsigned Filter::computeMatch( const ScenePlug *scene, const Gaffer::Context *co
 {
 	return NoMatch;
 }
+
+void Filter::hashMatchingPaths( const ScenePlug *scene, const Gaffer::Context *context, IECore::MurmurHash &h ) const
+{
+}
+
+ConstPathMatcherDataPtr Filter::computeMatchingPaths( const ScenePlug *scene, const Gaffer::Context *context ) const
+{
+	throw IECore::Exception( "Filter::computeMatchingPaths() not implemented" );
+}
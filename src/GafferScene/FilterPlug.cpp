@@ -41,6 +41,7 @@
 
 #include "GafferScene/FilterPlug.h"
 #include "GafferScene/Filter.h"
+#include "GafferScene/ScenePlug.h"
 
 using namespace IECore;
 using namespace Gaffer;
@@ -123,3 +124,9 @@ FilterPlug::SceneScope::SceneScope( const Gaffer::Context *context, const SceneP
 {
 	set( inputSceneContextName, (uint64_t)scenePlug );
 }
+
+FilterPlug::MatchingPathsScope::MatchingPathsScope( const Gaffer::Context *context, const ScenePlug *scenePlug )
+	:	SceneScope( context, scenePlug )
+{
+	remove( ScenePlug::scenePathContextName );
+}
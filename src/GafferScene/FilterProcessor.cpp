@@ -138,11 +138,18 @@ void FilterProcessor::hash( const Gaffer::ValuePlug *output, const Gaffer::Conte
 	if( output == outPlug() && !enabledPlug()->getValue() )
 	{
 		h = inPlug()->hash();
+		return;
 	}
-	else
+	else if( output == matchingPathsPlug() && !enabledPlug()->getValue() )
 	{
-		Filter::hash( output, context, h );
+		if( const Filter *filter = matchingPathsFilter( inPlug() ) )
+		{
+			h = filter->matchingPathsPlug()->hash();
+			return;
+		}
 	}
+
+	Filter::hash( output, context, h );
 }
 
 void FilterProcessor::compute( Gaffer::ValuePlug *output, const Gaffer::Context *context ) const
@@ -150,9 +157,16 @@ void FilterProcessor::compute( Gaffer::ValuePlug *output, const Gaffer::Context
 	if( output == outPlug() && !enabledPlug()->getValue() )
 	{
 		output->setFrom( inPlug() );
+		return;
 	}
-	else
+	else if( output == matchingPathsPlug() && !enabledPlug()->getValue() )
 	{
-		Filter::compute( output, context );
+		if( const Filter *filter = matchingPathsFilter( inPlug() ) )
+		{
+			output->setFrom( filter->matchingPathsPlug() );
+			return;
+		}
 	}
+
+	Filter::compute( output, context );
 }
@@ -43,6 +43,37 @@ using namespace IECore;
 using namespace Gaffer;
 using namespace GafferScene;
 
+namespace
+{
+
+typedef IECore::TypedData<ScenePlug::ScenePath> ScenePathData;
+
+// Computes the filter result for the current location using bulk evaluation,
+// returning false if the filter doesn't support it. This avoids a graph
+// evaluation of the filter for every location, because the PathMatcher is
+// computed once for all locations.
+bool matchingPathsFilterValue( const FilterPlug *filterPlug, const ScenePlug *scene, const Gaffer::Context *context, unsigned &result )
+{
+	const ScenePathData *pathData = context->get<ScenePathData>( ScenePlug::scenePathContextName, nullptr );
+	if( !pathData )
+	{
+		return false;
+	}
+
+	const Filter *filter = Filter::matchingPathsFilter( filterPlug );
+	if( !filter )
+	{
+		return false;
+	}
+
+	FilterPlug::MatchingPathsScope matchingPathsScope( context, scene );
+	ConstPathMatcherDataPtr matchingPaths = filter->matchingPathsPlug()->getValue();
+	result = matchingPaths->readable().match( pathData->readable() );
+	return true;
+}
+
+} // namespace
+
 IE_CORE_DEFINERUNTIMETYPED( FilteredSceneProcessor );
 
 size_t FilteredSceneProcessor::g_firstPlugIndex = 0;
@@ -85,12 +116,27 @@ void FilteredSceneProcessor::affects( const Gaffer::Plug *input, AffectedPlugsCo
 
 void FilteredSceneProcessor::filterHash( const Gaffer::Context *context, IECore::MurmurHash &h ) const
 {
+	unsigned match;
+	if( matchingPathsFilterValue( filterPlug(), inPlug(), context, match ) )
+	{
+		// The result itself is a perfectly good hash, and allows
+		// all locations with the same result to share it.
+		h.append( match );
+		return;
+	}
+
 	FilterPlug::SceneScope sceneScope( context, inPlug() );
 	filterPlug()->hash( h );
 }
 
 Filter::Result FilteredSceneProcessor::filterValue( const Gaffer::Context *context ) const
 {
+	unsigned match;
+	if( matchingPathsFilterValue( filterPlug(), inPlug(), context, match ) )
+	{
+		return (Filter::Result)match;
+	}
+
 	FilterPlug::SceneScope sceneScope( context, inPlug() );
 	return (Filter::Result)filterPlug()->getValue();
 }
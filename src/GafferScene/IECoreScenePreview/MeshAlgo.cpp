@@ -0,0 +1,1464 @@
+//////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (c) 2018, Image Engine Design Inc. All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//
+//      * Redistributions of source code must retain the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer.
+//
+//      * Redistributions in binary form must reproduce the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer in the documentation and/or other materials provided with
+//        the distribution.
+//
+//      * Neither the name of John Haddon nor the names of
+//        any other contributors to this software may be used to endorse or
+//        promote products derived from this software without specific prior
+//        written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+//  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+//  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+//  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+//  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+//  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+//  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+//  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//////////////////////////////////////////////////////////////////////////
+
+#include "GafferScene/Private/IECoreScenePreview/MeshAlgo.h"
+
+#include "IECore/DespatchTypedData.h"
+#include "IECore/GeometricTypedData.h"
+#include "IECore/MeshAlgo.h"
+#include "IECore/PointDistribution.h"
+#include "IECore/TypeTraits.h"
+#include "IECore/VectorTypedData.h"
+
+#include "tbb/atomic.h"
+#include "tbb/parallel_for.h"
+#include "tbb/parallel_scan.h"
+
+#include "boost/format.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+using namespace std;
+using namespace Imath;
+using namespace IECore;
+
+//////////////////////////////////////////////////////////////////////////
+// Utilities
+//////////////////////////////////////////////////////////////////////////
+
+namespace
+{
+
+// Body for `tbb::parallel_scan()`, computing the exclusive
+// prefix sum of `input` into `output`.
+class ExclusiveScan
+{
+
+	public :
+
+		ExclusiveScan( const std::vector<int> &input, std::vector<int> &output )
+			:	m_input( input ), m_output( output ), m_sum( 0 )
+		{
+		}
+
+		ExclusiveScan( ExclusiveScan &other, tbb::split )
+			:	m_input( other.m_input ), m_output( other.m_output ), m_sum( 0 )
+		{
+		}
+
+		template<typename Tag>
+		void operator()( const tbb::blocked_range<size_t> &r, Tag )
+		{
+			int sum = m_sum;
+			for( size_t i = r.begin(); i != r.end(); ++i )
+			{
+				if( Tag::is_final_scan() )
+				{
+					m_output[i] = sum;
+				}
+				sum += m_input[i];
+			}
+			m_sum = sum;
+		}
+
+		void reverse_join( ExclusiveScan &left )
+		{
+			m_sum = left.m_sum + m_sum;
+		}
+
+		void assign( ExclusiveScan &other )
+		{
+			m_sum = other.m_sum;
+		}
+
+		int sum() const
+		{
+			return m_sum;
+		}
+
+	private :
+
+		const std::vector<int> &m_input;
+		std::vector<int> &m_output;
+		int m_sum;
+
+};
+
+// Fills `output` with the exclusive prefix sum of `input`,
+// returning the total. Space is reserved for the caller
+// to append the total if required.
+int exclusiveScan( const std::vector<int> &input, std::vector<int> &output )
+{
+	output.reserve( input.size() + 1 );
+	output.resize( input.size() );
+	ExclusiveScan scan( input, output );
+	tbb::parallel_scan( tbb::blocked_range<size_t>( 0, input.size() ), scan );
+	return scan.sum();
+}
+
+// Fills `offsets` with the index of the first face-vertex of each
+// face, followed by the total number of face-vertices.
+void faceOffsets( const MeshPrimitive *mesh, std::vector<int> &offsets )
+{
+	const int total = exclusiveScan( mesh->verticesPerFace()->readable(), offsets );
+	offsets.push_back( total );
+}
+
+class FaceIndices
+{
+
+	public :
+
+		FaceIndices( const std::vector<int> &faceOffsets, std::vector<int> &faceIndices )
+			:	m_faceOffsets( faceOffsets ), m_faceIndices( faceIndices )
+		{
+		}
+
+		void operator()( const tbb::blocked_range<size_t> &r ) const
+		{
+			for( size_t f = r.begin(); f != r.end(); ++f )
+			{
+				for( int i = m_faceOffsets[f]; i < m_faceOffsets[f+1]; ++i )
+				{
+					m_faceIndices[i] = f;
+				}
+			}
+		}
+
+	private :
+
+		const std::vector<int> &m_faceOffsets;
+		std::vector<int> &m_faceIndices;
+
+};
+
+// Fills `faceIndices` with the index of the face each
+// face-vertex belongs to.
+void faceIndices( const std::vector<int> &faceOffsets, std::vector<int> &faceIndices )
+{
+	faceIndices.resize( faceOffsets.back() );
+	tbb::parallel_for( tbb::blocked_range<size_t>( 0, faceOffsets.size() - 1 ), FaceIndices( faceOffsets, faceIndices ) );
+}
+
+typedef std::vector<tbb::atomic<int> > AtomicIntVector;
+
+class CountReferences
+{
+
+	public :
+
+		CountReferences( const std::vector<int> &ids, AtomicIntVector &counts )
+			:	m_ids( ids ), m_counts( counts )
+		{
+		}
+
+		void operator()( const tbb::blocked_range<size_t> &r ) const
+		{
+			for( size_t i = r.begin(); i != r.end(); ++i )
+			{
+				m_counts[m_ids[i]].fetch_and_increment();
+			}
+		}
+
+	private :
+
+		const std::vector<int> &m_ids;
+		AtomicIntVector &m_counts;
+
+};
+
+class CopyAtomics
+{
+
+	public :
+
+		CopyAtomics( AtomicIntVector &atomics, std::vector<int> &ints, bool toAtomics )
+			:	m_atomics( atomics ), m_ints( ints ), m_toAtomics( toAtomics )
+		{
+		}
+
+		void operator()( const tbb::blocked_range<size_t> &r ) const
+		{
+			for( size_t i = r.begin(); i != r.end(); ++i )
+			{
+				if( m_toAtomics )
+				{
+					m_atomics[i] = m_ints[i];
+				}
+				else
+				{
+					m_ints[i] = m_atomics[i];
+				}
+			}
+		}
+
+	private :
+
+		AtomicIntVector &m_atomics;
+		std::vector<int> &m_ints;
+		bool m_toAtomics;
+
+};
+
+class FillReferences
+{
+
+	public :
+
+		FillReferences( const std::vector<int> &ids, AtomicIntVector &cursors, std::vector<int> &references )
+			:	m_ids( ids ), m_cursors( cursors ), m_references( references )
+		{
+		}
+
+		void operator()( const tbb::blocked_range<size_t> &r ) const
+		{
+			for( size_t i = r.begin(); i != r.end(); ++i )
+			{
+				m_references[m_cursors[m_ids[i]].fetch_and_increment()] = i;
+			}
+		}
+
+	private :
+
+		const std::vector<int> &m_ids;
+		AtomicIntVector &m_cursors;
+		std::vector<int> &m_references;
+
+};
+
+// Maps from each of a set of elements to the positions in an
+// id list which reference that element. The references for
+// element `i` are `references[offsets[i]]` to `references[offsets[i+1]-1]`.
+struct Adjacency
+{
+	std::vector<int> offsets;
+	std::vector<int> references;
+};
+
+class SortReferences
+{
+
+	public :
+
+		SortReferences( Adjacency &adjacency )
+			:	m_adjacency( adjacency )
+		{
+		}
+
+		void operator()( const tbb::blocked_range<size_t> &r ) const
+		{
+			std::vector<int> &references = m_adjacency.references;
+			for( size_t i = r.begin(); i != r.end(); ++i )
+			{
+				std::sort( references.begin() + m_adjacency.offsets[i], references.begin() + m_adjacency.offsets[i+1] );
+			}
+		}
+
+	private :
+
+		Adjacency &m_adjacency;
+
+};
+
+// Builds the adjacency for `numElements` elements referenced by `ids`.
+// The references for each element are sorted, so that anything
+// accumulated from them is independent of the order in which
+// the threads ran.
+void buildAdjacency( const std::vector<int> &ids, size_t numElements, Adjacency &adjacency )
+{
+	// Value initialisation zeroes the atomics.
+	AtomicIntVector atomics( numElements );
+	tbb::parallel_for( tbb::blocked_range<size_t>( 0, ids.size() ), CountReferences( ids, atomics ) );
+
+	std::vector<int> counts( numElements );
+	tbb::parallel_for( tbb::blocked_range<size_t>( 0, numElements ), CopyAtomics( atomics, counts, false ) );
+	const int total = exclusiveScan( counts, adjacency.offsets );
+	adjacency.offsets.push_back( total );
+
+	tbb::parallel_for( tbb::blocked_range<size_t>( 0, numElements ), CopyAtomics( atomics, adjacency.offsets, true ) );
+	adjacency.references.resize( total );
+	tbb::parallel_for( tbb::blocked_range<size_t>( 0, ids.size() ), FillReferences( ids, atomics, adjacency.references ) );
+
+	tbb::parallel_for( tbb::blocked_range<size_t>( 0, numElements ), SortReferences( adjacency ) );
+}
+
+// Copies geometric interpretation where the
+// data types support it.
+void copyInterpretation( const Data *, Data * )
+{
+}
+
+template<typename T>
+void copyInterpretation( const GeometricTypedData<T> *src, GeometricTypedData<T> *dst )
+{
+	dst->setInterpretation( src->getInterpretation() );
+}
+
+template<typename T>
+class Gather
+{
+
+	public :
+
+		Gather( const std::vector<T> &input, const std::vector<int> &indices, std::vector<T> &output )
+			:	m_input( input ), m_indices( indices ), m_output( output )
+		{
+		}
+
+		void operator()( const tbb::blocked_range<size_t> &r ) const
+		{
+			for( size_t i = r.begin(); i != r.end(); ++i )
+			{
+				m_output[i] = m_input[m_indices[i]];
+			}
+		}
+
+	private :
+
+		const std::vector<T> &m_input;
+		const std::vector<int> &m_indices;
+		std::vector<T> &m_output;
+
+};
+
+// Fills `output` with the elements of `input` specified by `indices`.
+template<typename T>
+void gather( const std::vector<T> &input, const std::vector<int> &indices, std::vector<T> &output )
+{
+	output.resize( indices.size() );
+	tbb::parallel_for( tbb::blocked_range<size_t>( 0, indices.size() ), Gather<T>( input, indices, output ) );
+}
+
+// `std::vector<bool>` packs elements into shared words,
+// so can't be written concurrently.
+void gather( const std::vector<bool> &input, const std::vector<int> &indices, std::vector<bool> &output )
+{
+	output.resize( indices.size() );
+	for( size_t i = 0, e = indices.size(); i < e; ++i )
+	{
+		output[i] = input[indices[i]];
+	}
+}
+
+class Gatherer
+{
+
+	public :
+
+		typedef DataPtr ReturnType;
+
+		Gatherer( const std::vector<int> &indices )
+			:	m_indices( indices )
+		{
+		}
+
+		template<typename T>
+		ReturnType operator()( T *data )
+		{
+			typename T::Ptr result = new T;
+			copyInterpretation( data, result.get() );
+			gather( data->readable(), m_indices, result->writable() );
+			return result;
+		}
+
+	private :
+
+		const std::vector<int> &m_indices;
+
+};
+
+DataPtr gatherData( const Data *data, const std::vector<int> &indices )
+{
+	Gatherer gatherer( indices );
+	DataPtr result = despatchTypedData<Gatherer, TypeTraits::IsVectorTypedData, DespatchTypedDataIgnoreError>( const_cast<Data *>( data ), gatherer );
+	if( !result )
+	{
+		throw InvalidArgumentException( boost::str( boost::format( "MeshAlgo : Unsupported primitive variable type \"%s\"" ) % data->typeName() ) );
+	}
+	return result;
+}
+
+} // namespace
+
+//////////////////////////////////////////////////////////////////////////
+// Delete faces
+//////////////////////////////////////////////////////////////////////////
+
+namespace
+{
+
+template<typename T>
+class FlagKeptFaces
+{
+
+	public :
+
+		FlagKeptFaces( const std::vector<T> &deleteFlags, std::vector<int> &keptFaces )
+			:	m_deleteFlags( deleteFlags ), m_keptFaces( keptFaces )
+		{
+		}
+
+		void operator()( const tbb::blocked_range<size_t> &r ) const
+		{
+			for( size_t i = r.begin(); i != r.end(); ++i )
+			{
+				m_keptFaces[i] = m_deleteFlags[i] ? 0 : 1;
+			}
+		}
+
+	private :
+
+		const std::vector<T> &m_deleteFlags;
+		std::vector<int> &m_keptFaces;
+
+};
+
+template<typename T>
+void flagKeptFaces( const Data *deleteFlagsData, std::vector<int> &keptFaces )
+{
+	const std::vector<T> &deleteFlags = static_cast<const TypedData<std::vector<T> > *>( deleteFlagsData )->readable();
+	if( deleteFlags.size() != keptFaces.size() )
+	{
+		throw InvalidArgumentException( "MeshAlgo::deleteFaces : Primitive variable has incorrect size" );
+	}
+	tbb::parallel_for( tbb::blocked_range<size_t>( 0, keptFaces.size() ), FlagKeptFaces<T>( deleteFlags, keptFaces ) );
+}
+
+class KeptVerticesPerFace
+{
+
+	public :
+
+		KeptVerticesPerFace( const std::vector<int> &verticesPerFace, const std::vector<int> &keptFaces, std::vector<int> &keptVerticesPerFace )
+			:	m_verticesPerFace( verticesPerFace ), m_keptFaces( keptFaces ), m_keptVerticesPerFace( keptVerticesPerFace )
+		{
+		}
+
+		void operator()( const tbb::blocked_range<size_t> &r ) const
+		{
+			for( size_t i = r.begin(); i != r.end(); ++i )
+			{
+				m_keptVerticesPerFace[i] = m_keptFaces[i] ? m_verticesPerFace[i] : 0;
+			}
+		}
+
+	private :
+
+		const std::vector<int> &m_verticesPerFace;
+		const std::vector<int> &m_keptFaces;
+		std::vector<int> &m_keptVerticesPerFace;
+
+};
+
+// The state for deleteFaces(). Each kept element of the input mesh
+// is given a new index by a prefix sum over the elements, and the
+// `kept*` vectors record the input index for each output index, so
+// that primitive variables can be filled with a parallel gather.
+struct DeleteFacesState
+{
+
+	DeleteFacesState( const MeshPrimitive *mesh )
+		:	verticesPerFace( mesh->verticesPerFace()->readable() ),
+			vertexIds( mesh->vertexIds()->readable() ),
+			keptFaceFlags( verticesPerFace.size() ),
+			usedVertices( mesh->variableSize( PrimitiveVariable::Vertex ) )
+	{
+	}
+
+	const std::vector<int> &verticesPerFace;
+	const std::vector<int> &vertexIds;
+
+	std::vector<int> faceOffsets;
+	std::vector<int> keptFaceFlags;
+	std::vector<int> newFaceIndices;
+	std::vector<int> newFaceOffsets;
+	AtomicIntVector usedVertices;
+
+	std::vector<int> newVerticesPerFace;
+	std::vector<int> keptFaces;
+	std::vector<int> keptFaceVertices;
+
+	std::vector<int> newVertexIndices;
+	std::vector<int> keptVertices;
+
+};
+
+class FillKeptFaces
+{
+
+	public :
+
+		FillKeptFaces( DeleteFacesState &state )
+			:	m_state( state )
+		{
+		}
+
+		void operator()( const tbb::blocked_range<size_t> &r ) const
+		{
+			for( size_t f = r.begin(); f != r.end(); ++f )
+			{
+				if( !m_state.keptFaceFlags[f] )
+				{
+					continue;
+				}
+
+				const int newFaceIndex = m_state.newFaceIndices[f];
+				m_state.newVerticesPerFace[newFaceIndex] = m_state.verticesPerFace[f];
+				m_state.keptFaces[newFaceIndex] = f;
+
+				const int faceOffset = m_state.faceOffsets[f];
+				const int newFaceOffset = m_state.newFaceOffsets[f];
+				for( int i = 0, e = m_state.verticesPerFace[f]; i < e; ++i )
+				{
+					m_state.keptFaceVertices[newFaceOffset+i] = faceOffset + i;
+					m_state.usedVertices[m_state.vertexIds[faceOffset+i]] = 1;
+				}
+			}
+		}
+
+	private :
+
+		DeleteFacesState &m_state;
+
+};
+
+class FillKeptVertices
+{
+
+	public :
+
+		FillKeptVertices( DeleteFacesState &state, const std::vector<int> &usedVertices )
+			:	m_state( state ), m_usedVertices( usedVertices )
+		{
+		}
+
+		void operator()( const tbb::blocked_range<size_t> &r ) const
+		{
+			for( size_t v = r.begin(); v != r.end(); ++v )
+			{
+				if( m_usedVertices[v] )
+				{
+					m_state.keptVertices[m_state.newVertexIndices[v]] = v;
+				}
+			}
+		}
+
+	private :
+
+		DeleteFacesState &m_state;
+		const std::vector<int> &m_usedVertices;
+
+};
+
+class RemapVertexIds
+{
+
+	public :
+
+		RemapVertexIds( const DeleteFacesState &state, std::vector<int> &newVertexIds )
+			:	m_state( state ), m_newVertexIds( newVertexIds )
+		{
+		}
+
+		void operator()( const tbb::blocked_range<size_t> &r ) const
+		{
+			for( size_t i = r.begin(); i != r.end(); ++i )
+			{
+				m_newVertexIds[i] = m_state.newVertexIndices[m_state.vertexIds[m_state.keptFaceVertices[i]]];
+			}
+		}
+
+	private :
+
+		const DeleteFacesState &m_state;
+		std::vector<int> &m_newVertexIds;
+
+};
+
+} // namespace
+
+MeshPrimitivePtr IECoreScenePreview::MeshAlgo::deleteFaces( const MeshPrimitive *mesh, const PrimitiveVariable &facesToDelete )
+{
+	if( facesToDelete.interpolation != PrimitiveVariable::Uniform )
+	{
+		throw InvalidArgumentException( "MeshAlgo::deleteFaces requires an Uniform [Int|Bool|Float]VectorData primitiveVariable" );
+	}
+
+	DeleteFacesState state( mesh );
+	const size_t numFaces = state.verticesPerFace.size();
+	const size_t numVertices = state.usedVertices.size();
+
+	// Flag the faces to keep, and assign new indices to them
+	// and their face-vertices.
+
+	const Data *deleteFlagsData = facesToDelete.data.get();
+	switch( deleteFlagsData->typeId() )
+	{
+		case IntVectorDataTypeId :
+			flagKeptFaces<int>( deleteFlagsData, state.keptFaceFlags );
+			break;
+		case BoolVectorDataTypeId :
+			flagKeptFaces<bool>( deleteFlagsData, state.keptFaceFlags );
+			break;
+		case FloatVectorDataTypeId :
+			flagKeptFaces<float>( deleteFlagsData, state.keptFaceFlags );
+			break;
+		default :
+			throw InvalidArgumentException( "MeshAlgo::deleteFaces requires an Uniform [Int|Bool|Float]VectorData primitiveVariable" );
+	}
+
+	exclusiveScan( state.verticesPerFace, state.faceOffsets );
+	const int numKeptFaces = exclusiveScan( state.keptFaceFlags, state.newFaceIndices );
+
+	std::vector<int> keptVerticesPerFace( numFaces );
+	tbb::parallel_for( tbb::blocked_range<size_t>( 0, numFaces ), KeptVerticesPerFace( state.verticesPerFace, state.keptFaceFlags, keptVerticesPerFace ) );
+	const int numKeptFaceVertices = exclusiveScan( keptVerticesPerFace, state.newFaceOffsets );
+
+	// Fill the topology for the kept faces, and find
+	// the vertices they use.
+
+	state.newVerticesPerFace.resize( numKeptFaces );
+	state.keptFaces.resize( numKeptFaces );
+	state.keptFaceVertices.resize( numKeptFaceVertices );
+	tbb::parallel_for( tbb::blocked_range<size_t>( 0, numFaces ), FillKeptFaces( state ) );
+
+	IntVectorDataPtr newVerticesPerFaceData = new IntVectorData;
+	newVerticesPerFaceData->writable().swap( state.newVerticesPerFace );
+
+	// Assign new indices to the used vertices, and
+	// remap the vertex ids to use them.
+
+	std::vector<int> usedVertices( numVertices );
+	tbb::parallel_for( tbb::blocked_range<size_t>( 0, numVertices ), CopyAtomics( state.usedVertices, usedVertices, false ) );
+	const int numKeptVertices = exclusiveScan( usedVertices, state.newVertexIndices );
+	state.keptVertices.resize( numKeptVertices );
+	tbb::parallel_for( tbb::blocked_range<size_t>( 0, numVertices ), FillKeptVertices( state, usedVertices ) );
+
+	IntVectorDataPtr newVertexIdsData = new IntVectorData;
+	newVertexIdsData->writable().resize( numKeptFaceVertices );
+	tbb::parallel_for( tbb::blocked_range<size_t>( 0, numKeptFaceVertices ), RemapVertexIds( state, newVertexIdsData->writable() ) );
+
+	// Build the new mesh, gathering the kept elements of
+	// each primitive variable.
+
+	MeshPrimitivePtr result = new MeshPrimitive( newVerticesPerFaceData, newVertexIdsData, mesh->interpolation() );
+	for( PrimitiveVariableMap::const_iterator it = mesh->variables.begin(), eIt = mesh->variables.end(); it != eIt; ++it )
+	{
+		const PrimitiveVariable &variable = it->second;
+
+		const std::vector<int> *kept = nullptr;
+		switch( variable.interpolation )
+		{
+			case PrimitiveVariable::Uniform :
+				kept = &state.keptFaces;
+				break;
+			case PrimitiveVariable::Vertex :
+			case PrimitiveVariable::Varying :
+				kept = &state.keptVertices;
+				break;
+			case PrimitiveVariable::FaceVarying :
+				kept = &state.keptFaceVertices;
+				break;
+			default :
+				break;
+		}
+
+		if( !kept )
+		{
+			result->variables[it->first] = variable;
+		}
+		else
+		{
+			result->variables[it->first] = PrimitiveVariable( variable.interpolation, gatherData( variable.data.get(), *kept ) );
+		}
+	}
+
+	return result;
+}
+
+//////////////////////////////////////////////////////////////////////////
+// Tangents
+//////////////////////////////////////////////////////////////////////////
+
+namespace
+{
+
+class FaceTangents
+{
+
+	public :
+
+		FaceTangents( const std::vector<V3f> &positions, const std::vector<int> &vertexIds, const std::vector<V2f> &uvs, std::vector<V3f> &tangents, std::vector<V3f> &bitangents, std::vector<V3f> &normals )
+			:	m_positions( positions ), m_vertexIds( vertexIds ), m_uvs( uvs ), m_tangents( tangents ), m_bitangents( bitangents ), m_normals( normals )
+		{
+		}
+
+		void operator()( const tbb::blocked_range<size_t> &r ) const
+		{
+			for( size_t f = r.begin(); f != r.end(); ++f )
+			{
+				const size_t fv0 = f * 3;
+				const size_t fv1 = fv0 + 1;
+				const size_t fv2 = fv0 + 2;
+
+				const V3f &p0 = m_positions[m_vertexIds[fv0]];
+				const V3f &p1 = m_positions[m_vertexIds[fv1]];
+				const V3f &p2 = m_positions[m_vertexIds[fv2]];
+
+				const V3f e0 = p1 - p0;
+				const V3f e1 = p2 - p0;
+				const V2f e0uv = m_uvs[fv1] - m_uvs[fv0];
+				const V2f e1uv = m_uvs[fv2] - m_uvs[fv0];
+
+				const float determinant = e0uv.x * e1uv.y - e1uv.x * e0uv.y;
+				const float r = determinant != 0.0f ? 1.0f / determinant : 0.0f;
+
+				// Not normalised, so that each face is weighted
+				// in the same way as the serial Cortex implementation
+				// when the tangents are accumulated.
+				m_tangents[f] = ( e0 * e1uv.y - e1 * e0uv.y ) * r;
+				m_bitangents[f] = ( e1 * e0uv.x - e0 * e1uv.x ) * r;
+				m_normals[f] = ( p2 - p1 ).cross( p0 - p1 ).normalized();
+			}
+		}
+
+	private :
+
+		const std::vector<V3f> &m_positions;
+		const std::vector<int> &m_vertexIds;
+		const std::vector<V2f> &m_uvs;
+		std::vector<V3f> &m_tangents;
+		std::vector<V3f> &m_bitangents;
+		std::vector<V3f> &m_normals;
+
+};
+
+// Accumulates the tangents of all the faces sharing each uv,
+// orthogonalising them against the accumulated normal and
+// ensuring that they form a right handed basis.
+class SharedTangents
+{
+
+	public :
+
+		SharedTangents( const Adjacency &uvAdjacency, const std::vector<V3f> &faceTangents, const std::vector<V3f> &faceBitangents, const std::vector<V3f> &faceNormals, bool orthoTangents, std::vector<V3f> &uTangents, std::vector<V3f> &vTangents )
+			:	m_uvAdjacency( uvAdjacency ), m_faceTangents( faceTangents ), m_faceBitangents( faceBitangents ), m_faceNormals( faceNormals ), m_orthoTangents( orthoTangents ), m_uTangents( uTangents ), m_vTangents( vTangents )
+		{
+		}
+
+		void operator()( const tbb::blocked_range<size_t> &r ) const
+		{
+			for( size_t uv = r.begin(); uv != r.end(); ++uv )
+			{
+				V3f uTangent( 0 );
+				V3f vTangent( 0 );
+				V3f normal( 0 );
+				for( int i = m_uvAdjacency.offsets[uv]; i < m_uvAdjacency.offsets[uv+1]; ++i )
+				{
+					const size_t face = m_uvAdjacency.references[i] / 3;
+					uTangent += m_faceTangents[face];
+					vTangent += m_faceBitangents[face];
+					normal += m_faceNormals[face];
+				}
+
+				normal.normalize();
+				uTangent.normalize();
+				vTangent.normalize();
+
+				uTangent -= normal * uTangent.dot( normal );
+				vTangent -= normal * vTangent.dot( normal );
+				uTangent.normalize();
+				vTangent.normalize();
+
+				if( m_orthoTangents )
+				{
+					vTangent = normal.cross( uTangent ).normalized();
+				}
+
+				if( uTangent.cross( vTangent ).dot( normal ) < 0.0f )
+				{
+					vTangent *= -1.0f;
+				}
+
+				m_uTangents[uv] = uTangent;
+				m_vTangents[uv] = vTangent;
+			}
+		}
+
+	private :
+
+		const Adjacency &m_uvAdjacency;
+		const std::vector<V3f> &m_faceTangents;
+		const std::vector<V3f> &m_faceBitangents;
+		const std::vector<V3f> &m_faceNormals;
+		bool m_orthoTangents;
+		std::vector<V3f> &m_uTangents;
+		std::vector<V3f> &m_vTangents;
+
+};
+
+} // namespace
+
+std::pair<PrimitiveVariable, PrimitiveVariable> IECoreScenePreview::MeshAlgo::calculateTangents( const MeshPrimitive *mesh, const std::string &uvSet, bool orthoTangents, const std::string &position )
+{
+	if( mesh->minVerticesPerFace() != 3 || mesh->maxVerticesPerFace() != 3 )
+	{
+		throw InvalidArgumentException( "MeshAlgo::calculateTangents : MeshPrimitive must only contain triangles" );
+	}
+
+	const V3fVectorData *positionData = mesh->variableData<V3fVectorData>( position );
+	if( !positionData )
+	{
+		throw InvalidArgumentException( boost::str( boost::format( "MeshAlgo::calculateTangents : MeshPrimitive has no Vertex \"%s\" primitive variable." ) % position ) );
+	}
+
+	const V2fVectorData *uvData = mesh->variableData<V2fVectorData>( uvSet, PrimitiveVariable::FaceVarying );
+	if( !uvData || uvData->readable().size() != mesh->vertexIds()->readable().size() )
+	{
+		throw InvalidArgumentException( boost::str( boost::format( "MeshAlgo::calculateTangents : MeshPrimitive has no FaceVarying V2fVectorData primitive variable named \"%s\"." ) % uvSet ) );
+	}
+
+	const std::vector<int> &vertexIds = mesh->vertexIds()->readable();
+	const size_t numFaces = mesh->numFaces();
+
+	// Face-vertices with the same uv index share their tangents. When there
+	// are no uv indices, face-vertices sharing a vertex share tangents instead.
+
+	const IntVectorData *uvIndicesData = mesh->variableData<IntVectorData>( uvSet + "Indices", PrimitiveVariable::FaceVarying );
+	if( uvIndicesData && uvIndicesData->readable().size() != vertexIds.size() )
+	{
+		uvIndicesData = nullptr;
+	}
+	const std::vector<int> &uvIndices = uvIndicesData ? uvIndicesData->readable() : vertexIds;
+	size_t numUVs = mesh->variableSize( PrimitiveVariable::Vertex );
+	if( uvIndicesData )
+	{
+		numUVs = uvIndices.size() ? *std::max_element( uvIndices.begin(), uvIndices.end() ) + 1 : 0;
+	}
+
+	// Compute tangents for each face.
+
+	std::vector<V3f> faceTangents( numFaces );
+	std::vector<V3f> faceBitangents( numFaces );
+	std::vector<V3f> faceNormals( numFaces );
+
+	FaceTangents faceTangentsFunctor( positionData->readable(), vertexIds, uvData->readable(), faceTangents, faceBitangents, faceNormals );
+	tbb::parallel_for( tbb::blocked_range<size_t>( 0, numFaces ), faceTangentsFunctor );
+
+	// Accumulate them for each uv, and output them
+	// as FaceVarying variables.
+
+	Adjacency uvAdjacency;
+	buildAdjacency( uvIndices, numUVs, uvAdjacency );
+
+	std::vector<V3f> uvUTangents( numUVs );
+	std::vector<V3f> uvVTangents( numUVs );
+	SharedTangents sharedTangents( uvAdjacency, faceTangents, faceBitangents, faceNormals, orthoTangents, uvUTangents, uvVTangents );
+	tbb::parallel_for( tbb::blocked_range<size_t>( 0, numUVs ), sharedTangents );
+
+	V3fVectorDataPtr uTangentsData = new V3fVectorData;
+	V3fVectorDataPtr vTangentsData = new V3fVectorData;
+	gather( uvUTangents, uvIndices, uTangentsData->writable() );
+	gather( uvVTangents, uvIndices, vTangentsData->writable() );
+
+	return std::make_pair(
+		PrimitiveVariable( PrimitiveVariable::FaceVarying, uTangentsData ),
+		PrimitiveVariable( PrimitiveVariable::FaceVarying, vTangentsData )
+	);
+}
+
+//////////////////////////////////////////////////////////////////////////
+// Resampling
+//////////////////////////////////////////////////////////////////////////
+
+namespace
+{
+
+bool isVertex( PrimitiveVariable::Interpolation interpolation )
+{
+	return interpolation == PrimitiveVariable::Vertex || interpolation == PrimitiveVariable::Varying;
+}
+
+bool isTopological( PrimitiveVariable::Interpolation interpolation )
+{
+	return isVertex( interpolation ) || interpolation == PrimitiveVariable::Uniform || interpolation == PrimitiveVariable::FaceVarying;
+}
+
+// Averages groups of input elements to make each output element.
+// The input elements for output `i` are given by `references[offsets[i]]`
+// to `references[offsets[i+1]-1]`, or by `offsets[i]` to `offsets[i+1]-1`
+// if no references are provided.
+template<typename T>
+class Average
+{
+
+	public :
+
+		Average( const std::vector<T> &input, const std::vector<int> &offsets, const std::vector<int> *references, std::vector<T> &output )
+			:	m_input( input ), m_offsets( offsets ), m_references( references ), m_output( output )
+		{
+		}
+
+		void operator()( const tbb::blocked_range<size_t> &r ) const
+		{
+			for( size_t o = r.begin(); o != r.end(); ++o )
+			{
+				const int begin = m_offsets[o];
+				const int end = m_offsets[o+1];
+				T total( 0 );
+				for( int i = begin; i < end; ++i )
+				{
+					total += m_input[m_references ? (*m_references)[i] : i];
+				}
+				if( end > begin )
+				{
+					total /= ( end - begin );
+				}
+				m_output[o] = total;
+			}
+		}
+
+	private :
+
+		const std::vector<T> &m_input;
+		const std::vector<int> &m_offsets;
+		const std::vector<int> *m_references;
+		std::vector<T> &m_output;
+
+};
+
+class Averager
+{
+
+	public :
+
+		typedef DataPtr ReturnType;
+
+		Averager( const std::vector<int> &offsets, const std::vector<int> *references )
+			:	m_offsets( offsets ), m_references( references )
+		{
+		}
+
+		template<typename T>
+		ReturnType operator()( const T *data ) const
+		{
+			typedef typename T::ValueType::value_type ElementType;
+
+			typename T::Ptr result = new T;
+			copyInterpretation( data, result.get() );
+			std::vector<ElementType> &output = result->writable();
+			output.resize( m_offsets.size() - 1 );
+
+			Average<ElementType> average( data->readable(), m_offsets, m_references, output );
+			tbb::parallel_for( tbb::blocked_range<size_t>( 0, output.size() ), average );
+			return result;
+		}
+
+	private :
+
+		const std::vector<int> &m_offsets;
+		const std::vector<int> *m_references;
+
+};
+
+// Returns null for types which we don't know how to average.
+DataPtr average( const Data *data, const std::vector<int> &offsets, const std::vector<int> *references )
+{
+	const Averager averager( offsets, references );
+	switch( data->typeId() )
+	{
+		case FloatVectorDataTypeId :
+			return averager( static_cast<const FloatVectorData *>( data ) );
+		case DoubleVectorDataTypeId :
+			return averager( static_cast<const DoubleVectorData *>( data ) );
+		case IntVectorDataTypeId :
+			return averager( static_cast<const IntVectorData *>( data ) );
+		case V2fVectorDataTypeId :
+			return averager( static_cast<const V2fVectorData *>( data ) );
+		case V3fVectorDataTypeId :
+			return averager( static_cast<const V3fVectorData *>( data ) );
+		case Color3fVectorDataTypeId :
+			return averager( static_cast<const Color3fVectorData *>( data ) );
+		case Color4fVectorDataTypeId :
+			return averager( static_cast<const Color4fVectorData *>( data ) );
+		default :
+			return nullptr;
+	}
+}
+
+class RemapReferences
+{
+
+	public :
+
+		RemapReferences( const std::vector<int> &map, std::vector<int> &references )
+			:	m_map( map ), m_references( references )
+		{
+		}
+
+		void operator()( const tbb::blocked_range<size_t> &r ) const
+		{
+			for( size_t i = r.begin(); i != r.end(); ++i )
+			{
+				m_references[i] = m_map[m_references[i]];
+			}
+		}
+
+	private :
+
+		const std::vector<int> &m_map;
+		std::vector<int> &m_references;
+
+};
+
+} // namespace
+
+void IECoreScenePreview::MeshAlgo::resamplePrimitiveVariable( const MeshPrimitive *mesh, PrimitiveVariable &primitiveVariable, PrimitiveVariable::Interpolation interpolation )
+{
+	const PrimitiveVariable::Interpolation srcInterpolation = primitiveVariable.interpolation;
+	if( srcInterpolation == interpolation )
+	{
+		return;
+	}
+
+	if( isVertex( srcInterpolation ) && isVertex( interpolation ) )
+	{
+		// Vertex and Varying variables have the same
+		// size on meshes, so no resampling is needed.
+		primitiveVariable.interpolation = interpolation;
+		return;
+	}
+
+	if(
+		!isTopological( srcInterpolation ) ||
+		!isTopological( interpolation ) ||
+		!mesh->isPrimitiveVariableValid( primitiveVariable )
+	)
+	{
+		IECore::MeshAlgo::resamplePrimitiveVariable( mesh, primitiveVariable, interpolation );
+		return;
+	}
+
+	const Data *data = primitiveVariable.data.get();
+	const std::vector<int> &vertexIds = mesh->vertexIds()->readable();
+
+	DataPtr result;
+	if( interpolation == PrimitiveVariable::FaceVarying )
+	{
+		// Each face-vertex takes the value from its vertex
+		// or face, so this is just a gather.
+		if( isVertex( srcInterpolation ) )
+		{
+			result = gatherData( data, vertexIds );
+		}
+		else
+		{
+			std::vector<int> offsets;
+			faceOffsets( mesh, offsets );
+			std::vector<int> indices;
+			faceIndices( offsets, indices );
+			result = gatherData( data, indices );
+		}
+	}
+	else if( interpolation == PrimitiveVariable::Uniform )
+	{
+		// Each face averages the values from its face-vertices,
+		// which are contiguous.
+		std::vector<int> offsets;
+		faceOffsets( mesh, offsets );
+		result = average( data, offsets, isVertex( srcInterpolation ) ? &vertexIds : nullptr );
+	}
+	else
+	{
+		// Each vertex averages the values from the face-vertices
+		// or faces which reference it.
+		Adjacency adjacency;
+		buildAdjacency( vertexIds, mesh->variableSize( PrimitiveVariable::Vertex ), adjacency );
+		if( srcInterpolation == PrimitiveVariable::Uniform )
+		{
+			std::vector<int> offsets;
+			faceOffsets( mesh, offsets );
+			std::vector<int> indices;
+			faceIndices( offsets, indices );
+			RemapReferences remap( indices, adjacency.references );
+			tbb::parallel_for( tbb::blocked_range<size_t>( 0, adjacency.references.size() ), remap );
+		}
+		result = average( data, adjacency.offsets, &adjacency.references );
+	}
+
+	if( !result )
+	{
+		IECore::MeshAlgo::resamplePrimitiveVariable( mesh, primitiveVariable, interpolation );
+		return;
+	}
+
+	primitiveVariable = PrimitiveVariable( interpolation, result );
+}
+
+//////////////////////////////////////////////////////////////////////////
+// Point distribution
+//////////////////////////////////////////////////////////////////////////
+
+namespace
+{
+
+// A single triangle from the (possibly fan-triangulated) mesh.
+struct Triangle
+{
+
+	int face;
+	int faceVertices[3];
+	int vertices[3];
+	V3f positions[3];
+	V2f uvs[3];
+
+	// Returns true if `uv` is inside the triangle, filling
+	// `result` with its barycentric coordinates.
+	bool barycentric( const V2f &uv, V3f &result ) const
+	{
+		const V2f e0 = uvs[1] - uvs[0];
+		const V2f e1 = uvs[2] - uvs[0];
+		const V2f e2 = uv - uvs[0];
+		const float determinant = e0.x * e1.y - e1.x * e0.y;
+		if( determinant == 0.0f )
+		{
+			return false;
+		}
+
+		result[1] = ( e2.x * e1.y - e1.x * e2.y ) / determinant;
+		result[2] = ( e0.x * e2.y - e2.x * e0.y ) / determinant;
+		result[0] = 1.0f - result[1] - result[2];
+		return result[0] >= 0.0f && result[1] >= 0.0f && result[2] >= 0.0f;
+	}
+
+};
+
+class DensityMask
+{
+
+	public :
+
+		DensityMask( const MeshPrimitive *mesh, const std::string &name )
+			:	m_interpolation( PrimitiveVariable::Invalid ), m_constant( 1.0f ), m_data( nullptr )
+		{
+			PrimitiveVariableMap::const_iterator it = mesh->variables.find( name );
+			if( it == mesh->variables.end() || !mesh->isPrimitiveVariableValid( it->second ) )
+			{
+				return;
+			}
+
+			if( const FloatData *constantData = runTimeCast<const FloatData>( it->second.data.get() ) )
+			{
+				m_constant = constantData->readable();
+			}
+			else if( const FloatVectorData *vectorData = runTimeCast<const FloatVectorData>( it->second.data.get() ) )
+			{
+				if( it->second.interpolation != PrimitiveVariable::Constant )
+				{
+					m_interpolation = it->second.interpolation;
+					m_data = &vectorData->readable();
+				}
+			}
+		}
+
+		float operator()( const Triangle &triangle, const V3f &barycentric ) const
+		{
+			switch( m_interpolation )
+			{
+				case PrimitiveVariable::Uniform :
+					return value( triangle.face );
+				case PrimitiveVariable::Vertex :
+				case PrimitiveVariable::Varying :
+					return interpolate( triangle.vertices, barycentric );
+				case PrimitiveVariable::FaceVarying :
+					return interpolate( triangle.faceVertices, barycentric );
+				default :
+					return m_constant;
+			}
+		}
+
+	private :
+
+		float value( int index ) const
+		{
+			return (*m_data)[index];
+		}
+
+		float interpolate( const int indices[3], const V3f &barycentric ) const
+		{
+			return value( indices[0] ) * barycentric[0] + value( indices[1] ) * barycentric[1] + value( indices[2] ) * barycentric[2];
+		}
+
+		PrimitiveVariable::Interpolation m_interpolation;
+		float m_constant;
+		const std::vector<float> *m_data;
+
+};
+
+// Density function for PointDistribution, restricting
+// the points to the interior of a triangle.
+class TriangleDensity
+{
+
+	public :
+
+		TriangleDensity( const Triangle &triangle, const DensityMask &densityMask )
+			:	m_triangle( triangle ), m_densityMask( densityMask )
+		{
+		}
+
+		float operator()( const V2f &uv ) const
+		{
+			V3f barycentric;
+			if( !m_triangle.barycentric( uv, barycentric ) )
+			{
+				return 0.0f;
+			}
+			return m_densityMask( m_triangle, barycentric );
+		}
+
+	private :
+
+		const Triangle &m_triangle;
+		const DensityMask &m_densityMask;
+
+};
+
+// Point function for PointDistribution, mapping
+// points from uv space onto the triangle.
+class TriangleEmitter
+{
+
+	public :
+
+		TriangleEmitter( const Triangle &triangle, std::vector<V3f> &points )
+			:	m_triangle( triangle ), m_points( points )
+		{
+		}
+
+		void operator()( const V2f &uv )
+		{
+			V3f barycentric;
+			if( m_triangle.barycentric( uv, barycentric ) )
+			{
+				m_points.push_back(
+					m_triangle.positions[0] * barycentric[0] +
+					m_triangle.positions[1] * barycentric[1] +
+					m_triangle.positions[2] * barycentric[2]
+				);
+			}
+		}
+
+	private :
+
+		const Triangle &m_triangle;
+		std::vector<V3f> &m_points;
+
+};
+
+struct DistributionState
+{
+	const std::vector<int> *verticesPerFace;
+	const std::vector<int> *vertexIds;
+	const std::vector<V3f> *positions;
+	const std::vector<V2f> *uvs;
+	std::vector<int> faceOffsets;
+	float density;
+	V2f offset;
+	const DensityMask *densityMask;
+	size_t chunkSize;
+};
+
+// Distributes points over fixed-size chunks of faces. Points are
+// stored per chunk rather than per thread, so that concatenating
+// the chunks gives a result independent of the scheduling.
+class DistributeChunks
+{
+
+	public :
+
+		DistributeChunks( const DistributionState &state, std::vector<std::vector<V3f> > &chunkPoints )
+			:	m_state( state ), m_chunkPoints( chunkPoints )
+		{
+		}
+
+		void operator()( const tbb::blocked_range<size_t> &r ) const
+		{
+			const PointDistribution &distribution = PointDistribution::defaultInstance();
+			const size_t numFaces = m_state.verticesPerFace->size();
+			for( size_t chunk = r.begin(); chunk != r.end(); ++chunk )
+			{
+				std::vector<V3f> &points = m_chunkPoints[chunk];
+				for( size_t f = chunk * m_state.chunkSize, e = std::min( f + m_state.chunkSize, numFaces ); f < e; ++f )
+				{
+					const int faceOffset = m_state.faceOffsets[f];
+					for( int i = 1, ie = (*m_state.verticesPerFace)[f] - 1; i < ie; ++i )
+					{
+						Triangle triangle;
+						triangle.face = f;
+						triangle.faceVertices[0] = faceOffset;
+						triangle.faceVertices[1] = faceOffset + i;
+						triangle.faceVertices[2] = faceOffset + i + 1;
+						for( int c = 0; c < 3; ++c )
+						{
+							const int faceVertex = triangle.faceVertices[c];
+							triangle.vertices[c] = (*m_state.vertexIds)[faceVertex];
+							triangle.positions[c] = (*m_state.positions)[triangle.vertices[c]];
+							triangle.uvs[c] = (*m_state.uvs)[faceVertex] + m_state.offset;
+						}
+						distributeInTriangle( distribution, triangle, points );
+					}
+				}
+			}
+		}
+
+	private :
+
+		void distributeInTriangle( const PointDistribution &distribution, const Triangle &triangle, std::vector<V3f> &points ) const
+		{
+			const V2f uvE0 = triangle.uvs[1] - triangle.uvs[0];
+			const V2f uvE1 = triangle.uvs[2] - triangle.uvs[0];
+			const float uvArea = 0.5f * fabs( uvE0.x * uvE1.y - uvE1.x * uvE0.y );
+			if( uvArea == 0.0f )
+			{
+				return;
+			}
+
+			const float area = 0.5f * ( triangle.positions[1] - triangle.positions[0] ).cross( triangle.positions[2] - triangle.positions[0] ).length();
+
+			Box2f uvBound;
+			for( int c = 0; c < 3; ++c )
+			{
+				uvBound.extendBy( triangle.uvs[c] );
+			}
+
+			TriangleDensity density( triangle, *m_state.densityMask );
+			TriangleEmitter emitter( triangle, points );
+			distribution( uvBound, m_state.density * area / uvArea, density, emitter );
+		}
+
+		const DistributionState &m_state;
+		std::vector<std::vector<V3f> > &m_chunkPoints;
+
+};
+
+class ConcatenateChunks
+{
+
+	public :
+
+		ConcatenateChunks( const std::vector<std::vector<V3f> > &chunkPoints, const std::vector<size_t> &chunkOffsets, std::vector<V3f> &points )
+			:	m_chunkPoints( chunkPoints ), m_chunkOffsets( chunkOffsets ), m_points( points )
+		{
+		}
+
+		void operator()( const tbb::blocked_range<size_t> &r ) const
+		{
+			for( size_t chunk = r.begin(); chunk != r.end(); ++chunk )
+			{
+				std::copy( m_chunkPoints[chunk].begin(), m_chunkPoints[chunk].end(), m_points.begin() + m_chunkOffsets[chunk] );
+			}
+		}
+
+	private :
+
+		const std::vector<std::vector<V3f> > &m_chunkPoints;
+		const std::vector<size_t> &m_chunkOffsets;
+		std::vector<V3f> &m_points;
+
+};
+
+} // namespace
+
+PointsPrimitivePtr IECoreScenePreview::MeshAlgo::distributePoints( const MeshPrimitive *mesh, float density, const Imath::V2f &offset, const std::string &densityMask, const std::string &uvSet, const std::string &position )
+{
+	if( density < 0 )
+	{
+		throw InvalidArgumentException( "MeshAlgo::distributePoints : The density of the distribution cannot be negative." );
+	}
+
+	const V3fVectorData *positionData = mesh->variableData<V3fVectorData>( position, PrimitiveVariable::Vertex );
+	if( !positionData )
+	{
+		throw InvalidArgumentException( boost::str( boost::format( "MeshAlgo::distributePoints : MeshPrimitive has no Vertex \"%s\" primitive variable." ) % position ) );
+	}
+
+	PrimitiveVariableMap::const_iterator uvIt = mesh->variables.find( uvSet );
+	if(
+		uvIt == mesh->variables.end() ||
+		uvIt->second.interpolation != PrimitiveVariable::FaceVarying ||
+		uvIt->second.data->typeId() != V2fVectorDataTypeId ||
+		!mesh->isPrimitiveVariableValid( uvIt->second )
+	)
+	{
+		throw InvalidArgumentException( boost::str( boost::format( "MeshAlgo::distributePoints : MeshPrimitive has no uv primitive variable named \"%s\" of type FaceVarying." ) % uvSet ) );
+	}
+
+	const DensityMask mask( mesh, densityMask );
+
+	DistributionState state;
+	state.verticesPerFace = &mesh->verticesPerFace()->readable();
+	state.vertexIds = &mesh->vertexIds()->readable();
+	state.positions = &positionData->readable();
+	state.uvs = &static_cast<const V2fVectorData *>( uvIt->second.data.get() )->readable();
+	faceOffsets( mesh, state.faceOffsets );
+	state.density = density;
+	state.offset = offset;
+	state.densityMask = &mask;
+	state.chunkSize = 1000;
+
+	const size_t numChunks = ( state.verticesPerFace->size() + state.chunkSize - 1 ) / state.chunkSize;
+	std::vector<std::vector<V3f> > chunkPoints( numChunks );
+	DistributeChunks distributeChunks( state, chunkPoints );
+	tbb::parallel_for( tbb::blocked_range<size_t>( 0, numChunks ), distributeChunks );
+
+	std::vector<size_t> chunkOffsets( numChunks );
+	size_t numPoints = 0;
+	for( size_t i = 0; i < numChunks; ++i )
+	{
+		chunkOffsets[i] = numPoints;
+		numPoints += chunkPoints[i].size();
+	}
+
+	V3fVectorDataPtr pointsData = new V3fVectorData;
+	pointsData->setInterpretation( GeometricData::Point );
+	pointsData->writable().resize( numPoints );
+	ConcatenateChunks concatenateChunks( chunkPoints, chunkOffsets, pointsData->writable() );
+	tbb::parallel_for( tbb::blocked_range<size_t>( 0, numChunks ), concatenateChunks );
+
+	return new PointsPrimitive( pointsData );
+}
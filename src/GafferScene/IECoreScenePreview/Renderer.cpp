@@ -77,6 +77,38 @@ Renderer::~Renderer()
 
 }
 
+Renderer::Prototype::Prototype( const IECore::MurmurHash &hash, const IECore::Object *object )
+	:	m_hash( hash ), m_samples( 1, object )
+{
+
+}
+
+Renderer::Prototype::Prototype( const IECore::MurmurHash &hash, const std::vector<const IECore::Object *> &samples, const std::vector<float> &times )
+	:	m_hash( hash ), m_samples( samples.begin(), samples.end() ), m_times( times )
+{
+
+}
+
+Renderer::Prototype::~Prototype()
+{
+
+}
+
+const IECore::MurmurHash &Renderer::Prototype::hash() const
+{
+	return m_hash;
+}
+
+const std::vector<IECore::ConstObjectPtr> &Renderer::Prototype::samples() const
+{
+	return m_samples;
+}
+
+const std::vector<float> &Renderer::Prototype::times() const
+{
+	return m_times;
+}
+
 Renderer::AttributesInterface::~AttributesInterface()
 {
 
@@ -87,6 +119,22 @@ Renderer::ObjectInterface::~ObjectInterface()
 
 }
 
+Renderer::ObjectInterfacePtr Renderer::instance( const std::string &name, const Prototype *prototype, const AttributesInterface *attributes )
+{
+	const vector<IECore::ConstObjectPtr> &samples = prototype->samples();
+	if( prototype->times().empty() )
+	{
+		return object( name, samples.front().get(), attributes );
+	}
+
+	vector<const IECore::Object *> objects; objects.reserve( samples.size() );
+	for( vector<IECore::ConstObjectPtr>::const_iterator it = samples.begin(), eIt = samples.end(); it != eIt; ++it )
+	{
+		objects.push_back( it->get() );
+	}
+	return object( name, objects, prototype->times(), attributes );
+}
+
 const std::vector<IECore::InternedString> &Renderer::types()
 {
 	return ::types();
@@ -39,7 +39,12 @@
 #include "tbb/blocked_range.h"
 
 #include "boost/lexical_cast.hpp"
+#include "boost/format.hpp"
 
+#include "OpenEXR/ImathQuat.h"
+
+#include "IECore/MessageHandler.h"
+#include "IECore/NullObject.h"
 #include "IECore/VectorTypedData.h"
 #include "IECore/Primitive.h"
 
@@ -55,6 +60,184 @@ using namespace IECore;
 using namespace Gaffer;
 using namespace GafferScene;
 
+//////////////////////////////////////////////////////////////////////////
+// EngineData
+//////////////////////////////////////////////////////////////////////////
+
+namespace
+{
+
+template<typename T>
+const vector<T> *pointArray( const Primitive *primitive, const std::string &name, size_t size )
+{
+	if( name.empty() )
+	{
+		return nullptr;
+	}
+
+	typedef TypedData<vector<T> > DataType;
+	const DataType *data = primitive->variableData<DataType>( name );
+	if( !data )
+	{
+		return nullptr;
+	}
+
+	if( data->readable().size() != size )
+	{
+		throw IECore::Exception( boost::str( boost::format( "Primitive variable \"%s\" has wrong size (%d but should be %d)" ) % name % data->readable().size() % size ) );
+	}
+
+	return &data->readable();
+}
+
+} // namespace
+
+// Custom Data derived class used to store the flat arrays of per-point
+// data used to generate the instances, along with the prototype roots.
+// We are deliberately omitting a custom TypeId etc because this is just
+// a private class.
+class Instancer::EngineData : public Data
+{
+
+	public :
+
+		EngineData( ConstPrimitivePtr primitive, const std::vector<ScenePath> &prototypeRoots, const std::string &prototypeIndex, const std::string &orientation, const std::string &scale )
+			:	m_primitive( primitive ), m_prototypeRoots( prototypeRoots ), m_p( nullptr ), m_orientation( nullptr ), m_scale( nullptr ), m_uniformScale( nullptr ), m_prototypeIndex( nullptr )
+		{
+			if( !m_primitive )
+			{
+				return;
+			}
+
+			const V3fVectorData *p = m_primitive->variableData<V3fVectorData>( "P" );
+			if( !p )
+			{
+				return;
+			}
+
+			m_p = &p->readable();
+			const size_t size = m_p->size();
+
+			m_orientation = pointArray<Quatf>( m_primitive.get(), orientation, size );
+
+			m_scale = pointArray<V3f>( m_primitive.get(), scale, size );
+			if( !m_scale )
+			{
+				m_uniformScale = pointArray<float>( m_primitive.get(), scale, size );
+			}
+
+			// The prototype index is only used in prototype mode, so
+			// we don't want to throw for a bad one in any other mode.
+			if( m_prototypeRoots.size() )
+			{
+				m_prototypeIndex = pointArray<int>( m_primitive.get(), prototypeIndex, size );
+			}
+		}
+
+		size_t size() const
+		{
+			return m_p ? m_p->size() : 0;
+		}
+
+		const Imath::V3f &position( size_t pointIndex ) const
+		{
+			return (*m_p)[pointIndex];
+		}
+
+		Imath::M44f transform( size_t pointIndex ) const
+		{
+			M44f result;
+			if( m_scale )
+			{
+				result.setScale( (*m_scale)[pointIndex] );
+			}
+			else if( m_uniformScale )
+			{
+				result.setScale( (*m_uniformScale)[pointIndex] );
+			}
+
+			if( m_orientation )
+			{
+				result = result * (*m_orientation)[pointIndex].normalized().toMatrix44();
+			}
+
+			M44f translation;
+			translation.setTranslation( (*m_p)[pointIndex] );
+			return result * translation;
+		}
+
+		bool translationOnly() const
+		{
+			return !m_orientation && !m_scale && !m_uniformScale;
+		}
+
+		/// Empty unless in prototype mode.
+		const std::vector<ScenePath> &prototypeRoots() const
+		{
+			return m_prototypeRoots;
+		}
+
+		/// Returns the index into prototypeRoots() for the point.
+		/// Returns 0 if not in prototype mode.
+		size_t prototype( size_t pointIndex ) const
+		{
+			if( !m_prototypeIndex )
+			{
+				return 0;
+			}
+
+			// Wrap out of range indices, so that any integer
+			// primitive variable may be used.
+			const int numPrototypes = m_prototypeRoots.size();
+			const int index = (*m_prototypeIndex)[pointIndex] % numPrototypes;
+			return index < 0 ? index + numPrototypes : index;
+		}
+
+		/// Throws if the instance doesn't exist.
+		void validateInstance( size_t instance ) const
+		{
+			if( instance >= size() )
+			{
+				throw IECore::Exception( boost::str( boost::format( "Instance %d does not exist" ) % instance ) );
+			}
+		}
+
+	protected :
+
+		void copyFrom( const Object *other, CopyContext *context ) override
+		{
+			Data::copyFrom( other, context );
+			msg( Msg::Warning, "EngineData::copyFrom", "Not implemented" );
+		}
+
+		void save( SaveContext *context ) const override
+		{
+			Data::save( context );
+			msg( Msg::Warning, "EngineData::save", "Not implemented" );
+		}
+
+		void load( LoadContextPtr context ) override
+		{
+			Data::load( context );
+			msg( Msg::Warning, "EngineData::load", "Not implemented" );
+		}
+
+	private :
+
+		ConstPrimitivePtr m_primitive;
+		const std::vector<ScenePath> m_prototypeRoots;
+		const std::vector<Imath::V3f> *m_p;
+		const std::vector<Imath::Quatf> *m_orientation;
+		const std::vector<Imath::V3f> *m_scale;
+		const std::vector<float> *m_uniformScale;
+		const std::vector<int> *m_prototypeIndex;
+
+};
+
+//////////////////////////////////////////////////////////////////////////
+// Instancer
+//////////////////////////////////////////////////////////////////////////
+
 IE_CORE_DEFINERUNTIMETYPED( Instancer );
 
 size_t Instancer::g_firstPlugIndex = 0;
@@ -67,6 +250,12 @@ Instancer::Instancer( const std::string &name )
 	storeIndexOfNextChild( g_firstPlugIndex );
 	addChild( new StringPlug( "name", Plug::In, "instances" ) );
 	addChild( new ScenePlug( "instance" ) );
+	addChild( new BoolPlug( "approximateBounds", Plug::In, false ) );
+	addChild( new StringVectorDataPlug( "prototypeRoots", Plug::In, new StringVectorData() ) );
+	addChild( new StringPlug( "prototypeIndex", Plug::In, "prototypeIndex" ) );
+	addChild( new StringPlug( "orientation" ) );
+	addChild( new StringPlug( "scale" ) );
+	addChild( new ObjectPlug( "__engine", Plug::Out, NullObject::defaultNullObject() ) );
 }
 
 Instancer::~Instancer()
@@ -93,6 +282,66 @@ const ScenePlug *Instancer::instancePlug() const
 	return getChild<ScenePlug>( g_firstPlugIndex + 1 );
 }
 
+Gaffer::BoolPlug *Instancer::approximateBoundsPlug()
+{
+	return getChild<BoolPlug>( g_firstPlugIndex + 2 );
+}
+
+const Gaffer::BoolPlug *Instancer::approximateBoundsPlug() const
+{
+	return getChild<BoolPlug>( g_firstPlugIndex + 2 );
+}
+
+Gaffer::StringVectorDataPlug *Instancer::prototypeRootsPlug()
+{
+	return getChild<StringVectorDataPlug>( g_firstPlugIndex + 3 );
+}
+
+const Gaffer::StringVectorDataPlug *Instancer::prototypeRootsPlug() const
+{
+	return getChild<StringVectorDataPlug>( g_firstPlugIndex + 3 );
+}
+
+Gaffer::StringPlug *Instancer::prototypeIndexPlug()
+{
+	return getChild<StringPlug>( g_firstPlugIndex + 4 );
+}
+
+const Gaffer::StringPlug *Instancer::prototypeIndexPlug() const
+{
+	return getChild<StringPlug>( g_firstPlugIndex + 4 );
+}
+
+Gaffer::StringPlug *Instancer::orientationPlug()
+{
+	return getChild<StringPlug>( g_firstPlugIndex + 5 );
+}
+
+const Gaffer::StringPlug *Instancer::orientationPlug() const
+{
+	return getChild<StringPlug>( g_firstPlugIndex + 5 );
+}
+
+Gaffer::StringPlug *Instancer::scalePlug()
+{
+	return getChild<StringPlug>( g_firstPlugIndex + 6 );
+}
+
+const Gaffer::StringPlug *Instancer::scalePlug() const
+{
+	return getChild<StringPlug>( g_firstPlugIndex + 6 );
+}
+
+Gaffer::ObjectPlug *Instancer::enginePlug()
+{
+	return getChild<ObjectPlug>( g_firstPlugIndex + 7 );
+}
+
+const Gaffer::ObjectPlug *Instancer::enginePlug() const
+{
+	return getChild<ObjectPlug>( g_firstPlugIndex + 7 );
+}
+
 void Instancer::affects( const Plug *input, AffectedPlugsContainer &outputs ) const
 {
 	BranchCreator::affects( input, outputs );
@@ -100,17 +349,93 @@ void Instancer::affects( const Plug *input, AffectedPlugsContainer &outputs ) co
 	if( input->parent<ScenePlug>() == instancePlug() )
 	{
 		outputs.push_back( outPlug()->getChild<ValuePlug>( input->getName() ) );
+		if( input == instancePlug()->transformPlug() )
+		{
+			// Prototype bounds include the prototype root transforms.
+			outputs.push_back( outPlug()->boundPlug() );
+		}
 	}
 	else if( input == namePlug() )
 	{
 		outputs.push_back( outPlug()->childNamesPlug() );
 	}
-	else if( input == inPlug()->objectPlug() )
+	else if( input == approximateBoundsPlug() )
+	{
+		outputs.push_back( outPlug()->boundPlug() );
+	}
+	else if(
+		input == inPlug()->objectPlug() ||
+		input == prototypeRootsPlug() ||
+		input == prototypeIndexPlug() ||
+		input == orientationPlug() ||
+		input == scalePlug()
+	)
+	{
+		outputs.push_back( enginePlug() );
+	}
+	else if( input == enginePlug() )
 	{
-		outputs.push_back( outPlug()->childNamesPlug() );
 		outputs.push_back( outPlug()->boundPlug() );
 		outputs.push_back( outPlug()->transformPlug() );
+		outputs.push_back( outPlug()->childNamesPlug() );
+		// In prototype mode, the engine determines
+		// which prototype each instance uses.
+		outputs.push_back( outPlug()->attributesPlug() );
+		outputs.push_back( outPlug()->objectPlug() );
+	}
+}
+
+void Instancer::hash( const Gaffer::ValuePlug *output, const Gaffer::Context *context, IECore::MurmurHash &h ) const
+{
+	BranchCreator::hash( output, context, h );
+
+	if( output == enginePlug() )
+	{
+		inPlug()->objectPlug()->hash( h );
+		prototypeRootsPlug()->hash( h );
+		prototypeIndexPlug()->hash( h );
+		orientationPlug()->hash( h );
+		scalePlug()->hash( h );
+	}
+}
+
+void Instancer::compute( Gaffer::ValuePlug *output, const Gaffer::Context *context ) const
+{
+	if( output == enginePlug() )
+	{
+		ConstStringVectorDataPtr rootsData = prototypeRootsPlug()->getValue();
+		const vector<string> &rootStrings = rootsData->readable();
+		vector<ScenePath> roots( rootStrings.size() );
+		for( size_t i = 0, e = rootStrings.size(); i < e; ++i )
+		{
+			ScenePlug::stringToPath( rootStrings[i], roots[i] );
+		}
+
+		static_cast<ObjectPlug *>( output )->setValue(
+			new EngineData(
+				runTimeCast<const Primitive>( inPlug()->objectPlug()->getValue() ),
+				roots,
+				prototypeIndexPlug()->getValue(),
+				orientationPlug()->getValue(),
+				scalePlug()->getValue()
+			)
+		);
+		return;
 	}
+
+	BranchCreator::compute( output, context );
+}
+
+IECore::MurmurHash Instancer::engineHash( const ScenePath &parentPath, const Gaffer::Context *context ) const
+{
+	ScenePlug::PathScope scope( context, parentPath );
+	return enginePlug()->hash();
+}
+
+Instancer::ConstEngineDataPtr Instancer::engine( const ScenePath &parentPath, const Gaffer::Context *context ) const
+{
+	ScenePlug::PathScope scope( context, parentPath );
+	return boost::static_pointer_cast<const EngineData>( enginePlug()->getValue() );
 }
 
 struct Instancer::BoundHash
@@ -170,20 +495,32 @@ void Instancer::hashBranchBound( const ScenePath &parentPath, const ScenePath &b
 
 		BranchCreator::hashBranchBound( parentPath, branchPath, context, h );
 
-		ConstV3fVectorDataPtr p = sourcePoints( parentPath );
-		if( p )
+		h.append( engineHash( parentPath, context ) );
+
+		ConstEngineDataPtr e = engine( parentPath, context );
+		if( e->prototypeRoots().size() )
 		{
-			p->hash( h );
+			hashPrototypeBound( e.get(), context, h );
+			return;
+		}
 
+		if( e->size() )
+		{
 			ScenePath branchChildPath( branchPath );
 			if( branchChildPath.size() == 0 )
 			{
 				branchChildPath.push_back( namePlug()->getValue() );
 			}
 
+			if( approximateBoundsPlug()->getValue() )
+			{
+				hashApproximateBound( branchChildPath, context, h );
+				return;
+			}
+
 			BoundHash hasher( this, branchChildPath, context );
 			parallel_deterministic_reduce(
-				blocked_range<size_t>( 0, p->readable().size(), 100 ),
+				blocked_range<size_t>( 0, e->size(), 100 ),
 				hasher
 			);
 
@@ -192,7 +529,7 @@ void Instancer::hashBranchBound( const ScenePath &parentPath, const ScenePath &b
 	}
 	else
 	{
-		InstanceScope instanceScope( context, branchPath );
+		InstanceScope instanceScope( this, parentPath, context, branchPath );
 		h = instancePlug()->boundPlug()->hash();
 	}
 }
@@ -200,13 +537,13 @@ void Instancer::hashBranchBound( const ScenePath &parentPath, const ScenePath &b
 struct Instancer::BoundUnion
 {
 
-	BoundUnion( const Instancer *instancer, const ScenePath &branchPath, const Context *c, const V3fVectorData *p )
-		:	m_instancer( instancer ), m_branchPath( branchPath ), m_context( c ), m_p( p ), m_union()
+	BoundUnion( const Instancer *instancer, const ScenePath &branchPath, const Context *c, const EngineData *engine )
+		:	m_instancer( instancer ), m_branchPath( branchPath ), m_context( c ), m_engine( engine ), m_union()
 	{
 	}
 
 	BoundUnion( const BoundUnion &rhs, split )
-		:	m_instancer( rhs.m_instancer ), m_branchPath( rhs.m_branchPath ), m_context( rhs.m_context ), m_p( rhs.m_p ), m_union()
+		:	m_instancer( rhs.m_instancer ), m_branchPath( rhs.m_branchPath ), m_context( rhs.m_context ), m_engine( rhs.m_engine ), m_union()
 	{
 	}
 
@@ -223,7 +560,7 @@ struct Instancer::BoundUnion
 			instanceScope.update( branchChildPath, i );
 
 			Box3f branchChildBound = m_instancer->instancePlug()->boundPlug()->getValue();
-			branchChildBound = transform( branchChildBound, m_instancer->instanceTransform( m_p, i ) );
+			branchChildBound = transform( branchChildBound, m_engine->transform( i ) );
 			m_union.extendBy( branchChildBound );
 		}
 	}
@@ -243,7 +580,7 @@ struct Instancer::BoundUnion
 		const Instancer *m_instancer;
 		const ScenePath &m_branchPath;
 		const Context *m_context;
-		const V3fVectorData *m_p;
+		const EngineData *m_engine;
 		Box3f m_union;
 
 };
@@ -253,9 +590,14 @@ Imath::Box3f Instancer::computeBranchBound( const ScenePath &parentPath, const S
 	if( branchPath.size() <= 1 )
 	{
 		// "/" or "/name"
+		ConstEngineDataPtr e = engine( parentPath, context );
+		if( e->prototypeRoots().size() )
+		{
+			return computePrototypeBound( e.get(), context );
+		}
+
 		Box3f result;
-		ConstV3fVectorDataPtr p = sourcePoints( parentPath );
-		if( p )
+		if( e->size() )
 		{
 			ScenePath branchChildPath( branchPath );
 			if( branchChildPath.size() == 0 )
@@ -263,9 +605,14 @@ Imath::Box3f Instancer::computeBranchBound( const ScenePath &parentPath, const S
 				branchChildPath.push_back( namePlug()->getValue() );
 			}
 
-			BoundUnion unioner( this, branchChildPath, context, p.get() );
+			if( approximateBoundsPlug()->getValue() )
+			{
+				return computeApproximateBound( branchChildPath, e.get(), context );
+			}
+
+			BoundUnion unioner( this, branchChildPath, context, e.get() );
 			parallel_reduce(
-				blocked_range<size_t>( 0, p->readable().size() ),
+				blocked_range<size_t>( 0, e->size() ),
 				unioner
 			);
 
@@ -276,7 +623,7 @@ Imath::Box3f Instancer::computeBranchBound( const ScenePath &parentPath, const S
 	}
 	else
 	{
-		InstanceScope instanceScope( context, branchPath );
+		InstanceScope instanceScope( this, parentPath, context, branchPath );
 		return instancePlug()->boundPlug()->getValue();
 	}
 }
@@ -292,12 +639,22 @@ void Instancer::hashBranchTransform( const ScenePath &parentPath, const ScenePat
 	{
 		// "/name/instanceNumber"
 		BranchCreator::hashBranchTransform( parentPath, branchPath, context, h );
-		h.append( inPlug()->objectHash( parentPath ) );
-		h.append( instanceIndex( branchPath ) );
+		h.append( engineHash( parentPath, context ) );
+		const size_t index = instanceIndex( branchPath );
+		h.append( (uint64_t)index );
+
+		ConstEngineDataPtr e = engine( parentPath, context );
+		if( e->prototypeRoots().size() )
+		{
+			e->validateInstance( index );
+			InstanceScope instanceScope( context );
+			instanceScope.set( ScenePlug::scenePathContextName, e->prototypeRoots()[e->prototype( index )] );
+			instancePlug()->transformPlug()->hash( h );
+		}
 	}
 	else
 	{
-		InstanceScope instanceScope( context, branchPath );
+		InstanceScope instanceScope( this, parentPath, context, branchPath );
 		h = instancePlug()->transformPlug()->hash();
 	}
 }
@@ -312,13 +669,24 @@ Imath::M44f Instancer::computeBranchTransform( const ScenePath &parentPath, cons
 	else if( branchPath.size() == 2 )
 	{
 		// "/name/instanceNumber"
-		int index = instanceIndex( branchPath );
-		ConstV3fVectorDataPtr p = sourcePoints( parentPath );
-		return instanceTransform( p.get(), index );
+		const size_t index = instanceIndex( branchPath );
+		ConstEngineDataPtr e = engine( parentPath, context );
+		e->validateInstance( index );
+
+		M44f result = e->transform( index );
+		if( e->prototypeRoots().size() )
+		{
+			// The instance is the prototype root itself, so
+			// must include its transform.
+			InstanceScope instanceScope( context );
+			instanceScope.set( ScenePlug::scenePathContextName, e->prototypeRoots()[e->prototype( index )] );
+			result = instancePlug()->transformPlug()->getValue() * result;
+		}
+		return result;
 	}
 	else
 	{
-		InstanceScope instanceScope( context, branchPath );
+		InstanceScope instanceScope( this, parentPath, context, branchPath );
 		return instancePlug()->transformPlug()->getValue();
 	}
 }
@@ -332,7 +700,7 @@ void Instancer::hashBranchAttributes( const ScenePath &parentPath, const ScenePa
 	}
 	else
 	{
-		InstanceScope instanceScope( context, branchPath );
+		InstanceScope instanceScope( this, parentPath, context, branchPath );
 		h = instancePlug()->attributesPlug()->hash();
 	}
 }
@@ -346,7 +714,7 @@ IECore::ConstCompoundObjectPtr Instancer::computeBranchAttributes( const ScenePa
 	}
 	else
 	{
-		InstanceScope instanceScope( context, branchPath );
+		InstanceScope instanceScope( this, parentPath, context, branchPath );
 		return instancePlug()->attributesPlug()->getValue();
 	}
 }
@@ -360,7 +728,7 @@ void Instancer::hashBranchObject( const ScenePath &parentPath, const ScenePath &
 	}
 	else
 	{
-		InstanceScope instanceScope( context, branchPath );
+		InstanceScope instanceScope( this, parentPath, context, branchPath );
 		h = instancePlug()->objectPlug()->hash();
 	}
 }
@@ -374,7 +742,7 @@ IECore::ConstObjectPtr Instancer::computeBranchObject( const ScenePath &parentPa
 	}
 	else
 	{
-		InstanceScope instanceScope( context, branchPath );
+		InstanceScope instanceScope( this, parentPath, context, branchPath );
 		return instancePlug()->objectPlug()->getValue();
 	}
 }
@@ -391,12 +759,12 @@ void Instancer::hashBranchChildNames( const ScenePath &parentPath, const ScenePa
 	{
 		// "/name"
 		BranchCreator::hashBranchChildNames( parentPath, branchPath, context, h );
-		h.append( inPlug()->objectHash( parentPath ) );
+		h.append( engineHash( parentPath, context ) );
 	}
 	else
 	{
 		// "/name/..."
-		InstanceScope instanceScope( context, branchPath );
+		InstanceScope instanceScope( this, parentPath, context, branchPath );
 		h = instancePlug()->childNamesPlug()->hash();
 	}
 }
@@ -417,13 +785,13 @@ IECore::ConstInternedStringVectorDataPtr Instancer::computeBranchChildNames( con
 	}
 	else if( branchPath.size() == 1 )
 	{
-		ConstV3fVectorDataPtr p = sourcePoints( parentPath );
-		if( !p || !p->readable().size() )
+		ConstEngineDataPtr e = engine( parentPath, context );
+		if( !e->size() )
 		{
 			return outPlug()->childNamesPlug()->defaultValue();
 		}
 
-		const size_t s = p->readable().size();
+		const size_t s = e->size();
 		InternedStringVectorDataPtr resultData = new InternedStringVectorData();
 		vector<InternedString> &result = resultData->writable();
 		result.resize( s );
@@ -437,36 +805,38 @@ IECore::ConstInternedStringVectorDataPtr Instancer::computeBranchChildNames( con
 	}
 	else
 	{
-		InstanceScope instanceScope( context, branchPath );
+		InstanceScope instanceScope( this, parentPath, context, branchPath );
 		return instancePlug()->childNamesPlug()->getValue();
 	}
 }
 
-ConstV3fVectorDataPtr Instancer::sourcePoints( const ScenePath &parentPath ) const
+size_t Instancer::instanceIndex( const ScenePath &branchPath )
 {
-	ConstPrimitivePtr primitive = runTimeCast<const Primitive>( inPlug()->object( parentPath ) );
-	if( !primitive )
-	{
-		return nullptr;
-	}
-
-	return primitive->variableData<V3fVectorData>( "P" );
+	return boost::lexical_cast<size_t>( branchPath[1].value() );
 }
 
-int Instancer::instanceIndex( const ScenePath &branchPath )
-{
-	return boost::lexical_cast<int>( branchPath[1].value() );
-}
+//////////////////////////////////////////////////////////////////////////
+// InstanceScope
+//////////////////////////////////////////////////////////////////////////
 
 Instancer::InstanceScope::InstanceScope( const Gaffer::Context *context )
 	:	EditableScope( context )
 {
 }
 
-Instancer::InstanceScope::InstanceScope( const Gaffer::Context *context, const ScenePath &branchPath )
+Instancer::InstanceScope::InstanceScope( const Instancer *instancer, const ScenePath &parentPath, const Gaffer::Context *context, const ScenePath &branchPath )
 	:	EditableScope( context )
 {
-	update( branchPath );
+	ConstEngineDataPtr engine = instancer->engine( parentPath, context );
+	if( engine->prototypeRoots().empty() )
+	{
+		update( branchPath );
+		return;
+	}
+
+	const size_t instance = instanceIndex( branchPath );
+	engine->validateInstance( instance );
+	updatePrototype( engine->prototypeRoots()[engine->prototype( instance )], branchPath );
 }
 
 void Instancer::InstanceScope::update( const ScenePath &branchPath )
@@ -483,9 +853,151 @@ void Instancer::InstanceScope::update( const ScenePath &branchPath, int instance
 	set( idContextName, instanceId );
 }
 
-Imath::M44f Instancer::instanceTransform( const IECore::V3fVectorData *p, int instanceId ) const
+void Instancer::InstanceScope::updatePrototype( const ScenePath &prototypeRoot, const ScenePath &branchPath )
+{
+	assert( branchPath.size() >= 2 );
+	ScenePath instancePath( prototypeRoot );
+	instancePath.insert( instancePath.end(), branchPath.begin() + 2, branchPath.end() );
+	set( ScenePlug::scenePathContextName, instancePath );
+}
+
+//////////////////////////////////////////////////////////////////////////
+// Bounds
+//////////////////////////////////////////////////////////////////////////
+
+struct Instancer::TransformedBoundUnion
 {
-	M44f result;
-	result.translate( p->readable()[instanceId] );
-	return result;
+
+	TransformedBoundUnion( const EngineData *engine, const vector<Box3f> &prototypeBounds )
+		:	m_engine( engine ), m_prototypeBounds( prototypeBounds ), m_union()
+	{
+	}
+
+	TransformedBoundUnion( const TransformedBoundUnion &rhs, split )
+		:	m_engine( rhs.m_engine ), m_prototypeBounds( rhs.m_prototypeBounds ), m_union()
+	{
+	}
+
+	void operator() ( const blocked_range<size_t> &r )
+	{
+		for( size_t i=r.begin(); i!=r.end(); ++i )
+		{
+			const Box3f &b = m_prototypeBounds[m_engine->prototype( i )];
+			if( !b.isEmpty() )
+			{
+				m_union.extendBy( transform( b, m_engine->transform( i ) ) );
+			}
+		}
+	}
+
+	void join( const TransformedBoundUnion &rhs )
+	{
+		m_union.extendBy( rhs.m_union );
+	}
+
+	const Box3f &result()
+	{
+		return m_union;
+	}
+
+	private :
+
+		const EngineData *m_engine;
+		const vector<Box3f> &m_prototypeBounds;
+		Box3f m_union;
+
+};
+
+Imath::Box3f Instancer::unionOfInstanceBounds( const EngineData *engine, const std::vector<Imath::Box3f> &prototypeBounds ) const
+{
+	if( engine->translationOnly() && prototypeBounds.size() == 1 )
+	{
+		// The union of the translated instance bounds is just
+		// the bound of the points expanded by the instance bound.
+		const Box3f &instanceBound = prototypeBounds[0];
+		if( instanceBound.isEmpty() )
+		{
+			return Box3f();
+		}
+
+		Box3f pointsBound;
+		for( size_t i = 0, e = engine->size(); i < e; ++i )
+		{
+			pointsBound.extendBy( engine->position( i ) );
+		}
+
+		return Box3f( pointsBound.min + instanceBound.min, pointsBound.max + instanceBound.max );
+	}
+
+	TransformedBoundUnion unioner( engine, prototypeBounds );
+	parallel_reduce(
+		blocked_range<size_t>( 0, engine->size(), 1000 ),
+		unioner
+	);
+	return unioner.result();
+}
+
+void Instancer::hashPrototypeBound( const EngineData *engine, const Gaffer::Context *context, IECore::MurmurHash &h ) const
+{
+	h.append( "prototypes" );
+
+	InstanceScope instanceScope( context );
+	for( vector<ScenePath>::const_iterator it = engine->prototypeRoots().begin(), eIt = engine->prototypeRoots().end(); it != eIt; ++it )
+	{
+		instanceScope.set( ScenePlug::scenePathContextName, *it );
+		instancePlug()->boundPlug()->hash( h );
+		instancePlug()->transformPlug()->hash( h );
+	}
+}
+
+Imath::Box3f Instancer::computePrototypeBound( const EngineData *engine, const Gaffer::Context *context ) const
+{
+	if( !engine->size() )
+	{
+		return Box3f();
+	}
+
+	// Compute each prototype's bound once, and then transform
+	// them by the points. The instances include the transforms
+	// of the prototype roots, so the bounds do too.
+
+	vector<Box3f> prototypeBounds;
+	prototypeBounds.reserve( engine->prototypeRoots().size() );
+	{
+		InstanceScope instanceScope( context );
+		for( vector<ScenePath>::const_iterator it = engine->prototypeRoots().begin(), eIt = engine->prototypeRoots().end(); it != eIt; ++it )
+		{
+			instanceScope.set( ScenePlug::scenePathContextName, *it );
+			prototypeBounds.push_back(
+				transform( instancePlug()->boundPlug()->getValue(), instancePlug()->transformPlug()->getValue() )
+			);
+		}
+	}
+
+	return unionOfInstanceBounds( engine, prototypeBounds );
+}
+
+void Instancer::hashApproximateBound( const ScenePath &branchChildPath, const Gaffer::Context *context, IECore::MurmurHash &h ) const
+{
+	h.append( "approximate" );
+
+	ScenePath firstInstancePath( branchChildPath );
+	firstInstancePath.push_back( InternedString( 0 ) );
+	InstanceScope instanceScope( context );
+	instanceScope.update( firstInstancePath );
+	instancePlug()->boundPlug()->hash( h );
+}
+
+Imath::Box3f Instancer::computeApproximateBound( const ScenePath &branchChildPath, const EngineData *engine, const Gaffer::Context *context ) const
+{
+	vector<Box3f> instanceBound( 1 );
+	{
+		ScenePath firstInstancePath( branchChildPath );
+		firstInstancePath.push_back( InternedString( 0 ) );
+		InstanceScope instanceScope( context );
+		instanceScope.update( firstInstancePath );
+		instanceBound[0] = instancePlug()->boundPlug()->getValue();
+	}
+
+	return unionOfInstanceBounds( engine, instanceBound );
 }
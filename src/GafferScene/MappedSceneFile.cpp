@@ -0,0 +1,270 @@
+//////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (c) 2018, Image Engine Design Inc. All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//
+//      * Redistributions of source code must retain the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer.
+//
+//      * Redistributions in binary form must reproduce the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer in the documentation and/or other materials provided with
+//        the distribution.
+//
+//      * Neither the name of John Haddon nor the names of
+//        any other contributors to this software may be used to endorse or
+//        promote products derived from this software without specific prior
+//        written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+//  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+//  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+//  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+//  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+//  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+//  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+//  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//////////////////////////////////////////////////////////////////////////
+
+#include "GafferScene/Private/MappedSceneFile.h"
+
+#include "IECore/MemoryIndexedIO.h"
+#include "IECore/VectorTypedData.h"
+
+#include "boost/format.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+using namespace std;
+using namespace IECore;
+using namespace GafferScene;
+using namespace GafferScene::Private;
+
+//////////////////////////////////////////////////////////////////////////
+// Internal utilities
+//////////////////////////////////////////////////////////////////////////
+
+namespace
+{
+
+// Returns true if `count` elements of `elementSize` bytes, starting at
+// `offset`, fit within `size` bytes. Arranged so that it can't overflow,
+// whatever values are read from the file.
+bool fits( uint64_t offset, uint64_t count, uint64_t elementSize, uint64_t size )
+{
+	return offset <= size && count <= ( size - offset ) / elementSize;
+}
+
+} // namespace
+
+//////////////////////////////////////////////////////////////////////////
+// MappedSceneFile
+//////////////////////////////////////////////////////////////////////////
+
+const char MappedSceneFile::g_magic[8] = { 'G', 'A', 'F', 'F', 'M', 'S', 'C', 0 };
+const uint64_t MappedSceneFile::g_version = 1;
+const uint64_t MappedSceneFile::g_invalidLocation = ~uint64_t( 0 );
+
+MappedSceneFile::MappedSceneFile( const std::string &fileName )
+	:	m_fileName( fileName ), m_header( nullptr )
+{
+	try
+	{
+		m_file.open( fileName );
+	}
+	catch( const std::exception &e )
+	{
+		throw IECore::Exception( boost::str( boost::format( "Unable to open file \"%s\" : %s" ) % fileName % e.what() ) );
+	}
+
+	// Validate the header and the extents of the sections up front.
+	// The tables have explicit sizes, and the remaining sections span
+	// the space up to the next section. Indices and ranges read from
+	// the tables are validated against these extents as they are used.
+
+	const uint64_t size = m_file.size();
+	if( size < sizeof( Header ) )
+	{
+		throwCorrupt();
+	}
+
+	const Header *header = reinterpret_cast<const Header *>( m_file.data() );
+	if(
+		memcmp( header->magic, g_magic, sizeof( g_magic ) ) ||
+		header->version != g_version ||
+		header->numLocations == 0 ||
+		( header->locationsOffset | header->sortedChildrenOffset | header->setsOffset | header->setMembersOffset ) % sizeof( uint64_t ) ||
+		!fits( header->locationsOffset, header->numLocations, sizeof( Location ), size ) ||
+		!fits( header->sortedChildrenOffset, header->numLocations, sizeof( uint64_t ), size ) ||
+		!fits( header->setsOffset, header->numSets, sizeof( Set ), size ) ||
+		header->setMembersOffset > header->namesOffset ||
+		header->namesOffset > header->blobsOffset ||
+		header->blobsOffset > size
+	)
+	{
+		throwCorrupt();
+	}
+
+	m_header = header;
+}
+
+MappedSceneFile::~MappedSceneFile()
+{
+}
+
+const MappedSceneFile::Header &MappedSceneFile::header() const
+{
+	return *m_header;
+}
+
+uint64_t MappedSceneFile::find( const ScenePlug::ScenePath &path ) const
+{
+	const uint64_t *sortedChildren = reinterpret_cast<const uint64_t *>( m_file.data() + m_header->sortedChildrenOffset );
+
+	uint64_t result = 0;
+	for( ScenePlug::ScenePath::const_iterator it = path.begin(), eIt = path.end(); it != eIt; ++it )
+	{
+		// Binary search the children for the next name. The
+		// children range and the entries themselves are
+		// validated by `location()`.
+		const Location &l = location( result );
+		const uint64_t *first = sortedChildren + l.firstChild;
+		uint64_t count = l.numChildren;
+		while( count > 0 )
+		{
+			const uint64_t step = count / 2;
+			if( compare( location( first[step] ).name, *it ) < 0 )
+			{
+				first += step + 1;
+				count -= step + 1;
+			}
+			else
+			{
+				count = step;
+			}
+		}
+
+		if( first == sortedChildren + l.firstChild + l.numChildren || compare( location( *first ).name, *it ) != 0 )
+		{
+			return g_invalidLocation;
+		}
+		result = *first;
+	}
+
+	return result;
+}
+
+const MappedSceneFile::Location &MappedSceneFile::location( uint64_t index ) const
+{
+	if( index >= m_header->numLocations )
+	{
+		throwCorrupt();
+	}
+
+	const Location &result = reinterpret_cast<const Location *>( m_file.data() + m_header->locationsOffset )[index];
+	if( !fits( result.firstChild, result.numChildren, 1, m_header->numLocations ) )
+	{
+		throwCorrupt();
+	}
+
+	return result;
+}
+
+void MappedSceneFile::path( uint64_t index, ScenePlug::ScenePath &path ) const
+{
+	path.clear();
+	while( index != 0 )
+	{
+		// No valid path can be deeper than the number of
+		// locations, so this guards against cycles.
+		if( path.size() >= m_header->numLocations )
+		{
+			throwCorrupt();
+		}
+		const Location &l = location( index );
+		path.push_back( name( l.name ) );
+		index = l.parent;
+	}
+	std::reverse( path.begin(), path.end() );
+}
+
+const MappedSceneFile::Set &MappedSceneFile::set( uint64_t index ) const
+{
+	if( index >= m_header->numSets )
+	{
+		throwCorrupt();
+	}
+	return reinterpret_cast<const Set *>( m_file.data() + m_header->setsOffset )[index];
+}
+
+const uint64_t *MappedSceneFile::setMembers( const Set &set ) const
+{
+	const uint64_t numMembers = ( m_header->namesOffset - m_header->setMembersOffset ) / sizeof( uint64_t );
+	if( !fits( set.firstMember, set.numMembers, 1, numMembers ) )
+	{
+		throwCorrupt();
+	}
+	return reinterpret_cast<const uint64_t *>( m_file.data() + m_header->setMembersOffset ) + set.firstMember;
+}
+
+IECore::InternedString MappedSceneFile::name( const NameRange &range ) const
+{
+	return InternedString( data( m_header->namesOffset, m_header->blobsOffset, range.offset, range.size ), range.size );
+}
+
+IECore::ObjectPtr MappedSceneFile::object( const BlobRange &range ) const
+{
+	if( !range.size )
+	{
+		return nullptr;
+	}
+
+	// MemoryIndexedIO requires a buffer it can hold on to, so we
+	// must copy the blob out of the mapping. This is a single
+	// memcpy though, with no decompression or parsing of the
+	// file required to locate it.
+	const char *begin = data( m_header->blobsOffset, m_file.size(), range.offset, range.size );
+	CharVectorDataPtr buffer = new CharVectorData( std::vector<char>( begin, begin + range.size ) );
+	MemoryIndexedIOPtr io = new MemoryIndexedIO( buffer, IndexedIO::rootPath, IndexedIO::Read );
+	return Object::load( io, "object" );
+}
+
+IECore::MurmurHash MappedSceneFile::hash( const BlobRange &range )
+{
+	return MurmurHash( range.hash[0], range.hash[1] );
+}
+
+const char *MappedSceneFile::data( uint64_t sectionBegin, uint64_t sectionEnd, uint64_t offset, uint64_t size ) const
+{
+	// The constructor guarantees that `sectionBegin <= sectionEnd <= m_file.size()`.
+	if( !fits( offset, size, 1, sectionEnd - sectionBegin ) )
+	{
+		throwCorrupt();
+	}
+	return m_file.data() + sectionBegin + offset;
+}
+
+void MappedSceneFile::throwCorrupt() const
+{
+	throw IECore::Exception( boost::str( boost::format( "File \"%s\" is not a valid mapped scene file" ) % m_fileName ) );
+}
+
+int MappedSceneFile::compare( const NameRange &range, const IECore::InternedString &name ) const
+{
+	const std::string &s = name.string();
+	const int c = memcmp( data( m_header->namesOffset, m_header->blobsOffset, range.offset, range.size ), s.c_str(), std::min<uint64_t>( range.size, s.size() ) );
+	if( c != 0 )
+	{
+		return c;
+	}
+	return range.size < s.size() ? -1 : ( range.size > s.size() ? 1 : 0 );
+}
@@ -0,0 +1,428 @@
+//////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (c) 2018, Image Engine Design Inc. All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//
+//      * Redistributions of source code must retain the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer.
+//
+//      * Redistributions in binary form must reproduce the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer in the documentation and/or other materials provided with
+//        the distribution.
+//
+//      * Neither the name of John Haddon nor the names of
+//        any other contributors to this software may be used to endorse or
+//        promote products derived from this software without specific prior
+//        written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+//  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+//  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+//  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+//  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+//  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+//  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+//  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//////////////////////////////////////////////////////////////////////////
+
+#include "GafferScene/MappedSceneReader.h"
+
+#include "GafferScene/PathMatcherData.h"
+#include "GafferScene/Private/MappedSceneFile.h"
+
+#include "Gaffer/StringPlug.h"
+
+#include "IECore/LRUCache.h"
+
+#include "boost/bind.hpp"
+#include "boost/format.hpp"
+
+#include <cstring>
+
+using namespace std;
+using namespace Imath;
+using namespace IECore;
+using namespace Gaffer;
+using namespace GafferScene;
+using namespace GafferScene::Private;
+
+//////////////////////////////////////////////////////////////////////////
+// Cache of mapped files
+//////////////////////////////////////////////////////////////////////////
+
+namespace
+{
+
+// Mapping a file is cheap, but keeping the mapping alive also keeps
+// its pages resident, so that traversals after the first don't incur
+// page faults. Refreshing a MappedSceneReader evicts just its own file.
+ConstMappedSceneFilePtr fileGetter( const std::string &fileName, size_t &cost )
+{
+	cost = 1;
+	return new MappedSceneFile( fileName );
+}
+
+typedef LRUCache<std::string, ConstMappedSceneFilePtr> FileCache;
+
+FileCache *fileCache()
+{
+	static FileCache *c = new FileCache( fileGetter, 200 );
+	return c;
+}
+
+// Returns the location at `path`, or null if the
+// file doesn't exist or doesn't contain it.
+const MappedSceneFile::Location *location( const MappedSceneFile *file, const ScenePlug::ScenePath &path )
+{
+	if( !file )
+	{
+		return nullptr;
+	}
+
+	const uint64_t index = file->find( path );
+	if( index == MappedSceneFile::g_invalidLocation )
+	{
+		return nullptr;
+	}
+
+	return &file->location( index );
+}
+
+// Loads a blob which must hold a CompoundObject, as is the case
+// for attributes and globals.
+ConstCompoundObjectPtr compoundObject( const MappedSceneFile *file, const MappedSceneFile::BlobRange &range )
+{
+	ObjectPtr object = file->object( range );
+	ConstCompoundObjectPtr result = runTimeCast<const CompoundObject>( object );
+	if( !result )
+	{
+		throw IECore::Exception( boost::str(
+			boost::format( "Expected CompoundObject but got %s" ) % ( object ? object->typeName() : "null" )
+		) );
+	}
+	return result;
+}
+
+} // namespace
+
+//////////////////////////////////////////////////////////////////////////
+// MappedSceneReader implementation
+//////////////////////////////////////////////////////////////////////////
+
+IE_CORE_DEFINERUNTIMETYPED( MappedSceneReader );
+
+size_t MappedSceneReader::g_firstPlugIndex = 0;
+
+MappedSceneReader::MappedSceneReader( const std::string &name )
+	:	SceneNode( name )
+{
+	storeIndexOfNextChild( g_firstPlugIndex );
+	addChild( new StringPlug( "fileName" ) );
+	addChild( new IntPlug( "refreshCount" ) );
+	plugSetSignal().connect( boost::bind( &MappedSceneReader::plugSet, this, ::_1 ) );
+}
+
+MappedSceneReader::~MappedSceneReader()
+{
+}
+
+Gaffer::StringPlug *MappedSceneReader::fileNamePlug()
+{
+	return getChild<StringPlug>( g_firstPlugIndex );
+}
+
+const Gaffer::StringPlug *MappedSceneReader::fileNamePlug() const
+{
+	return getChild<StringPlug>( g_firstPlugIndex );
+}
+
+Gaffer::IntPlug *MappedSceneReader::refreshCountPlug()
+{
+	return getChild<IntPlug>( g_firstPlugIndex + 1 );
+}
+
+const Gaffer::IntPlug *MappedSceneReader::refreshCountPlug() const
+{
+	return getChild<IntPlug>( g_firstPlugIndex + 1 );
+}
+
+void MappedSceneReader::affects( const Gaffer::Plug *input, AffectedPlugsContainer &outputs ) const
+{
+	SceneNode::affects( input, outputs );
+
+	if( input == fileNamePlug() || input == refreshCountPlug() )
+	{
+		outputs.push_back( outPlug()->boundPlug() );
+		outputs.push_back( outPlug()->transformPlug() );
+		outputs.push_back( outPlug()->attributesPlug() );
+		outputs.push_back( outPlug()->objectPlug() );
+		outputs.push_back( outPlug()->childNamesPlug() );
+		outputs.push_back( outPlug()->globalsPlug() );
+		outputs.push_back( outPlug()->setNamesPlug() );
+		outputs.push_back( outPlug()->setPlug() );
+	}
+}
+
+void MappedSceneReader::hashBound( const ScenePath &path, const Gaffer::Context *context, const ScenePlug *parent, IECore::MurmurHash &h ) const
+{
+	SceneNode::hashBound( path, context, parent, h );
+
+	ConstMappedSceneFilePtr f = file();
+	if( const MappedSceneFile::Location *l = location( f.get(), path ) )
+	{
+		h.append( l->bound, 6 );
+	}
+}
+
+Imath::Box3f MappedSceneReader::computeBound( const ScenePath &path, const Gaffer::Context *context, const ScenePlug *parent ) const
+{
+	ConstMappedSceneFilePtr f = file();
+	const MappedSceneFile::Location *l = location( f.get(), path );
+	if( !l )
+	{
+		return Box3f();
+	}
+
+	return Box3f(
+		V3f( l->bound[0], l->bound[1], l->bound[2] ),
+		V3f( l->bound[3], l->bound[4], l->bound[5] )
+	);
+}
+
+void MappedSceneReader::hashTransform( const ScenePath &path, const Gaffer::Context *context, const ScenePlug *parent, IECore::MurmurHash &h ) const
+{
+	SceneNode::hashTransform( path, context, parent, h );
+
+	ConstMappedSceneFilePtr f = file();
+	if( const MappedSceneFile::Location *l = location( f.get(), path ) )
+	{
+		h.append( l->transform, 16 );
+	}
+}
+
+Imath::M44f MappedSceneReader::computeTransform( const ScenePath &path, const Gaffer::Context *context, const ScenePlug *parent ) const
+{
+	M44f result;
+
+	ConstMappedSceneFilePtr f = file();
+	if( const MappedSceneFile::Location *l = location( f.get(), path ) )
+	{
+		memcpy( result.getValue(), l->transform, sizeof( l->transform ) );
+	}
+
+	return result;
+}
+
+void MappedSceneReader::hashAttributes( const ScenePath &path, const Gaffer::Context *context, const ScenePlug *parent, IECore::MurmurHash &h ) const
+{
+	ConstMappedSceneFilePtr f = file();
+	const MappedSceneFile::Location *l = location( f.get(), path );
+	if( !l || !l->attributes.size )
+	{
+		h = parent->attributesPlug()->defaultValue()->Object::hash();
+		return;
+	}
+
+	SceneNode::hashAttributes( path, context, parent, h );
+	h.append( MappedSceneFile::hash( l->attributes ) );
+}
+
+IECore::ConstCompoundObjectPtr MappedSceneReader::computeAttributes( const ScenePath &path, const Gaffer::Context *context, const ScenePlug *parent ) const
+{
+	ConstMappedSceneFilePtr f = file();
+	const MappedSceneFile::Location *l = location( f.get(), path );
+	if( !l || !l->attributes.size )
+	{
+		return parent->attributesPlug()->defaultValue();
+	}
+
+	return compoundObject( f.get(), l->attributes );
+}
+
+void MappedSceneReader::hashObject( const ScenePath &path, const Gaffer::Context *context, const ScenePlug *parent, IECore::MurmurHash &h ) const
+{
+	ConstMappedSceneFilePtr f = file();
+	const MappedSceneFile::Location *l = location( f.get(), path );
+	if( !l || !l->object.size )
+	{
+		h = parent->objectPlug()->defaultValue()->hash();
+		return;
+	}
+
+	// The hash stored in the file is the hash of the object's content,
+	// so identical objects share a hash and are loaded only once, and
+	// different objects never share a hash, even across files.
+	SceneNode::hashObject( path, context, parent, h );
+	h.append( MappedSceneFile::hash( l->object ) );
+}
+
+IECore::ConstObjectPtr MappedSceneReader::computeObject( const ScenePath &path, const Gaffer::Context *context, const ScenePlug *parent ) const
+{
+	ConstMappedSceneFilePtr f = file();
+	const MappedSceneFile::Location *l = location( f.get(), path );
+	if( !l || !l->object.size )
+	{
+		return parent->objectPlug()->defaultValue();
+	}
+
+	return f->object( l->object );
+}
+
+void MappedSceneReader::hashChildNames( const ScenePath &path, const Gaffer::Context *context, const ScenePlug *parent, IECore::MurmurHash &h ) const
+{
+	ConstMappedSceneFilePtr f = file();
+	const MappedSceneFile::Location *l = location( f.get(), path );
+	if( !l || !l->numChildren )
+	{
+		h = parent->childNamesPlug()->defaultValue()->Object::hash();
+		return;
+	}
+
+	SceneNode::hashChildNames( path, context, parent, h );
+	fileNamePlug()->hash( h );
+	refreshCountPlug()->hash( h );
+	h.append( l->firstChild );
+}
+
+IECore::ConstInternedStringVectorDataPtr MappedSceneReader::computeChildNames( const ScenePath &path, const Gaffer::Context *context, const ScenePlug *parent ) const
+{
+	ConstMappedSceneFilePtr f = file();
+	const MappedSceneFile::Location *l = location( f.get(), path );
+	if( !l || !l->numChildren )
+	{
+		return parent->childNamesPlug()->defaultValue();
+	}
+
+	InternedStringVectorDataPtr resultData = new InternedStringVectorData;
+	vector<InternedString> &result = resultData->writable();
+	result.reserve( l->numChildren );
+	for( uint64_t i = l->firstChild, e = l->firstChild + l->numChildren; i < e; ++i )
+	{
+		result.push_back( f->name( f->location( i ).name ) );
+	}
+
+	return resultData;
+}
+
+void MappedSceneReader::hashGlobals( const Gaffer::Context *context, const ScenePlug *parent, IECore::MurmurHash &h ) const
+{
+	ConstMappedSceneFilePtr f = file();
+	if( !f || !f->header().globals.size )
+	{
+		h = parent->globalsPlug()->defaultValue()->Object::hash();
+		return;
+	}
+
+	SceneNode::hashGlobals( context, parent, h );
+	h.append( MappedSceneFile::hash( f->header().globals ) );
+}
+
+IECore::ConstCompoundObjectPtr MappedSceneReader::computeGlobals( const Gaffer::Context *context, const ScenePlug *parent ) const
+{
+	ConstMappedSceneFilePtr f = file();
+	if( !f || !f->header().globals.size )
+	{
+		return parent->globalsPlug()->defaultValue();
+	}
+
+	return compoundObject( f.get(), f->header().globals );
+}
+
+void MappedSceneReader::hashSetNames( const Gaffer::Context *context, const ScenePlug *parent, IECore::MurmurHash &h ) const
+{
+	SceneNode::hashSetNames( context, parent, h );
+	fileNamePlug()->hash( h );
+	refreshCountPlug()->hash( h );
+}
+
+IECore::ConstInternedStringVectorDataPtr MappedSceneReader::computeSetNames( const Gaffer::Context *context, const ScenePlug *parent ) const
+{
+	ConstMappedSceneFilePtr f = file();
+	if( !f )
+	{
+		return parent->setNamesPlug()->defaultValue();
+	}
+
+	InternedStringVectorDataPtr resultData = new InternedStringVectorData;
+	vector<InternedString> &result = resultData->writable();
+	for( uint64_t i = 0, e = f->header().numSets; i < e; ++i )
+	{
+		result.push_back( f->name( f->set( i ).name ) );
+	}
+
+	return resultData;
+}
+
+void MappedSceneReader::hashSet( const IECore::InternedString &setName, const Gaffer::Context *context, const ScenePlug *parent, IECore::MurmurHash &h ) const
+{
+	SceneNode::hashSet( setName, context, parent, h );
+	fileNamePlug()->hash( h );
+	refreshCountPlug()->hash( h );
+	h.append( setName );
+}
+
+GafferScene::ConstPathMatcherDataPtr MappedSceneReader::computeSet( const IECore::InternedString &setName, const Gaffer::Context *context, const ScenePlug *parent ) const
+{
+	ConstMappedSceneFilePtr f = file();
+	if( !f )
+	{
+		return parent->setPlug()->defaultValue();
+	}
+
+	for( uint64_t i = 0, e = f->header().numSets; i < e; ++i )
+	{
+		const MappedSceneFile::Set &set = f->set( i );
+		if( f->name( set.name ) != setName )
+		{
+			continue;
+		}
+
+		PathMatcherDataPtr resultData = new PathMatcherData;
+		PathMatcher &result = resultData->writable();
+		const uint64_t *members = f->setMembers( set );
+		ScenePath path;
+		for( uint64_t m = 0; m < set.numMembers; ++m )
+		{
+			f->path( members[m], path );
+			result.addPath( path );
+		}
+		return resultData;
+	}
+
+	return parent->setPlug()->defaultValue();
+}
+
+void MappedSceneReader::plugSet( Gaffer::Plug *plug )
+{
+	// Release our file every time the refresh count is updated, so
+	// that it is mapped afresh. Other files, and other readers of
+	// other files, are unaffected.
+	if( plug == refreshCountPlug() )
+	{
+		const std::string fileName = fileNamePlug()->getValue();
+		if( fileName.size() )
+		{
+			fileCache()->erase( fileName );
+		}
+	}
+}
+
+ConstMappedSceneFilePtr MappedSceneReader::file() const
+{
+	const std::string fileName = fileNamePlug()->getValue();
+	if( !fileName.size() )
+	{
+		return nullptr;
+	}
+
+	return fileCache()->get( fileName );
+}
@@ -0,0 +1,626 @@
+//////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (c) 2018, Image Engine Design Inc. All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//
+//      * Redistributions of source code must retain the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer.
+//
+//      * Redistributions in binary form must reproduce the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer in the documentation and/or other materials provided with
+//        the distribution.
+//
+//      * Neither the name of John Haddon nor the names of
+//        any other contributors to this software may be used to endorse or
+//        promote products derived from this software without specific prior
+//        written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+//  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+//  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+//  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+//  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+//  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+//  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+//  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//////////////////////////////////////////////////////////////////////////
+
+#include "GafferScene/MappedSceneWriter.h"
+
+#include "GafferScene/Filter.h"
+#include "GafferScene/PathMatcherData.h"
+#include "GafferScene/Private/MappedSceneFile.h"
+#include "GafferScene/SceneAlgo.h"
+
+#include "Gaffer/Context.h"
+#include "Gaffer/StringPlug.h"
+
+#include "IECore/MemoryIndexedIO.h"
+#include "IECore/NullObject.h"
+#include "IECore/VectorTypedData.h"
+
+#include "tbb/concurrent_hash_map.h"
+#include "tbb/mutex.h"
+#include "tbb/parallel_for.h"
+
+#include "boost/filesystem.hpp"
+#include "boost/format.hpp"
+#include "boost/noncopyable.hpp"
+
+#include <cstring>
+#include <fstream>
+
+using namespace std;
+using namespace Imath;
+using namespace IECore;
+using namespace Gaffer;
+using namespace GafferScene;
+using namespace GafferScene::Private;
+
+//////////////////////////////////////////////////////////////////////////
+// Scene traversal
+//////////////////////////////////////////////////////////////////////////
+
+namespace
+{
+
+// Rounds up to the 8 byte alignment used for all sections
+// of the file, and for the blobs within the blob section.
+uint64_t alignedSize( uint64_t size )
+{
+	return ( size + 7 ) & ~uint64_t( 7 );
+}
+
+// Stores serialised objects in a temporary file as soon as they are
+// computed, so that we don't need to hold them all in memory until the
+// scene file is written. Offsets are relative to the start of the spool,
+// which is copied verbatim into the blob section of the scene file.
+class BlobSpool : boost::noncopyable
+{
+
+	public :
+
+		BlobSpool( const std::string &fileName )
+			:	m_stream( fileName.c_str(), std::ios::in | std::ios::out | std::ios::binary | std::ios::trunc ), m_fileName( fileName ), m_size( 0 )
+		{
+			if( !m_stream.good() )
+			{
+				throw IECore::Exception( boost::str( boost::format( "Unable to open file \"%s\" for writing" ) % fileName ) );
+			}
+		}
+
+		~BlobSpool()
+		{
+			m_stream.close();
+			boost::system::error_code e;
+			boost::filesystem::remove( m_fileName, e );
+		}
+
+		// Appends the blob, returning its offset.
+		uint64_t append( const std::vector<char> &blob )
+		{
+			const char padding[8] = { 0, 0, 0, 0, 0, 0, 0, 0 };
+			tbb::mutex::scoped_lock lock( m_mutex );
+			const uint64_t offset = m_size;
+			m_stream.write( blob.data(), blob.size() );
+			m_size = alignedSize( offset + blob.size() );
+			m_stream.write( padding, m_size - offset - blob.size() );
+			if( m_stream.fail() )
+			{
+				throw IECore::Exception( boost::str( boost::format( "Error writing file \"%s\"" ) % m_fileName ) );
+			}
+			return offset;
+		}
+
+		uint64_t size() const
+		{
+			return m_size;
+		}
+
+		// Copies the contents of the spool to `stream`.
+		// Must not be called concurrently with `append()`.
+		void copy( std::ostream &stream )
+		{
+			if( !m_size )
+			{
+				// Streaming an empty buffer would set the
+				// failbit on `stream`.
+				return;
+			}
+			m_stream.flush();
+			m_stream.seekg( 0 );
+			stream << m_stream.rdbuf();
+		}
+
+	private :
+
+		tbb::mutex m_mutex;
+		std::fstream m_stream;
+		std::string m_fileName;
+		uint64_t m_size;
+
+};
+
+// The location of a serialised object within the spool, along with the
+// hash of its content. A size of 0 represents an empty object, which is
+// not written to the file.
+struct Blob
+{
+	uint64_t offset;
+	uint64_t size;
+	MurmurHash contentHash;
+};
+
+// Holds the blobs, keyed by the hash of the plug they were computed
+// from. Plug hashes are only meaningful within this process, so it is
+// the content hash that is stored in the file.
+typedef tbb::concurrent_hash_map<MurmurHash, Blob> BlobMap;
+
+// The data for a single location. Objects and attributes are
+// serialised into the BlobSpool as soon as they are computed, so
+// only their hashes are held here.
+struct LocationData
+{
+	InternedString name;
+	Box3f bound;
+	M44f transform;
+	MurmurHash objectHash;
+	MurmurHash attributesHash;
+	std::vector<LocationData> children;
+	// Assigned when flattening the hierarchy.
+	uint64_t index;
+};
+
+struct TraversalState
+{
+	const ScenePlug *scene;
+	const Context *context;
+	BlobMap *blobs;
+	BlobSpool *spool;
+};
+
+bool isEmpty( const Object *object )
+{
+	if( const CompoundObject *c = runTimeCast<const CompoundObject>( object ) )
+	{
+		return c->members().empty();
+	}
+	return runTimeCast<const NullObject>( object );
+}
+
+// Computes the value of `plug` and serialises it, unless an
+// identical value has been serialised already. Returns the hash
+// used to refer to the blob.
+template<typename PlugType>
+MurmurHash addBlob( const TraversalState &state, const PlugType *plug )
+{
+	const MurmurHash h = plug->hash();
+	{
+		BlobMap::const_accessor readAccessor;
+		if( state.blobs->find( readAccessor, h ) )
+		{
+			return h;
+		}
+	}
+
+	// Compute and serialise outside the lock, so that other threads
+	// requiring the same blob aren't blocked on our compute (which
+	// may itself wait on TBB tasks). If another thread beats us to
+	// the insertion, its result is kept. Appending to the spool
+	// doesn't wait on tasks, so is done with the lock held, to
+	// avoid writing the same blob twice.
+	typename PlugType::ConstValuePtr value = plug->getValue( &h );
+	ConstCharVectorDataPtr data;
+	if( !isEmpty( value.get() ) )
+	{
+		MemoryIndexedIOPtr io = new MemoryIndexedIO( new CharVectorData, IndexedIO::rootPath, IndexedIO::Exclusive | IndexedIO::Write );
+		value->save( io, "object" );
+		data = io->buffer();
+	}
+
+	BlobMap::accessor writeAccessor;
+	if( state.blobs->insert( writeAccessor, h ) )
+	{
+		Blob &blob = writeAccessor->second;
+		blob.offset = 0;
+		blob.size = data ? data->readable().size() : 0;
+		blob.contentHash = value->Object::hash();
+		if( blob.size )
+		{
+			blob.offset = state.spool->append( data->readable() );
+		}
+	}
+	return h;
+}
+
+void computeLocation( const TraversalState &state, const ScenePlug::ScenePath &path, LocationData &location );
+
+struct ComputeChildren
+{
+
+	ComputeChildren( const TraversalState &state, const ScenePlug::ScenePath &parentPath, std::vector<LocationData> &children )
+		:	m_state( state ), m_parentPath( parentPath ), m_children( children )
+	{
+	}
+
+	void operator()( const tbb::blocked_range<size_t> &r ) const
+	{
+		ScenePlug::ScenePath childPath( m_parentPath );
+		childPath.push_back( InternedString() ); // room for the child name
+		for( size_t i = r.begin(); i != r.end(); ++i )
+		{
+			childPath.back() = m_children[i].name;
+			computeLocation( m_state, childPath, m_children[i] );
+		}
+	}
+
+	private :
+
+		const TraversalState &m_state;
+		const ScenePlug::ScenePath &m_parentPath;
+		std::vector<LocationData> &m_children;
+
+};
+
+void computeLocation( const TraversalState &state, const ScenePlug::ScenePath &path, LocationData &location )
+{
+	ConstInternedStringVectorDataPtr childNamesData;
+	{
+		ScenePlug::PathScope scope( state.context, path );
+		const ScenePlug *scene = state.scene;
+
+		location.bound = scene->boundPlug()->getValue();
+		location.transform = scene->transformPlug()->getValue();
+		location.objectHash = addBlob( state, scene->objectPlug() );
+		location.attributesHash = addBlob( state, scene->attributesPlug() );
+		childNamesData = scene->childNamesPlug()->getValue();
+	}
+
+	const std::vector<InternedString> &childNames = childNamesData->readable();
+	location.children.resize( childNames.size() );
+	for( size_t i = 0, e = childNames.size(); i < e; ++i )
+	{
+		location.children[i].name = childNames[i];
+	}
+
+	ComputeChildren computeChildren( state, path, location.children );
+	tbb::parallel_for( tbb::blocked_range<size_t>( 0, childNames.size() ), computeChildren );
+}
+
+void setMembers( const PathMatcher &set, const LocationData &location, ScenePlug::ScenePath &path, std::vector<uint64_t> &members )
+{
+	const unsigned m = set.match( path );
+	if( m & Filter::ExactMatch )
+	{
+		members.push_back( location.index );
+	}
+
+	if( !( m & Filter::DescendantMatch ) )
+	{
+		return;
+	}
+
+	path.push_back( InternedString() );
+	for( std::vector<LocationData>::const_iterator it = location.children.begin(), eIt = location.children.end(); it != eIt; ++it )
+	{
+		path.back() = it->name;
+		setMembers( set, *it, path, members );
+	}
+	path.pop_back();
+}
+
+} // namespace
+
+//////////////////////////////////////////////////////////////////////////
+// File writing
+//////////////////////////////////////////////////////////////////////////
+
+namespace
+{
+
+class FileWriter
+{
+
+	public :
+
+		FileWriter( const std::string &fileName )
+			:	m_stream( fileName.c_str(), std::ios::out | std::ios::binary | std::ios::trunc ), m_fileName( fileName )
+		{
+			if( !m_stream.good() )
+			{
+				throw IECore::Exception( boost::str( boost::format( "Unable to open file \"%s\" for writing" ) % fileName ) );
+			}
+		}
+
+		template<typename T>
+		void write( const T *data, size_t count )
+		{
+			m_stream.write( reinterpret_cast<const char *>( data ), count * sizeof( T ) );
+		}
+
+		// Pads the file to the next multiple of 8 bytes.
+		void align()
+		{
+			const char padding[8] = { 0, 0, 0, 0, 0, 0, 0, 0 };
+			const uint64_t position = m_stream.tellp();
+			m_stream.write( padding, alignedSize( position ) - position );
+		}
+
+		// Copies the blobs from the spool.
+		void write( BlobSpool &spool )
+		{
+			spool.copy( m_stream );
+		}
+
+		void close()
+		{
+			m_stream.close();
+			if( m_stream.fail() )
+			{
+				throw IECore::Exception( boost::str( boost::format( "Error writing file \"%s\"" ) % m_fileName ) );
+			}
+		}
+
+	private :
+
+		std::ofstream m_stream;
+		std::string m_fileName;
+
+};
+
+MappedSceneFile::BlobRange blobRange( const BlobMap &blobs, const MurmurHash &h )
+{
+	MappedSceneFile::BlobRange result;
+	result.offset = result.size = 0;
+	result.hash[0] = h.h1();
+	result.hash[1] = h.h2();
+
+	BlobMap::const_accessor accessor;
+	if( blobs.find( accessor, h ) )
+	{
+		result.offset = accessor->second.offset;
+		result.size = accessor->second.size;
+		result.hash[0] = accessor->second.contentHash.h1();
+		result.hash[1] = accessor->second.contentHash.h2();
+	}
+
+	return result;
+}
+
+MappedSceneFile::NameRange addName( std::string &names, const std::string &name )
+{
+	MappedSceneFile::NameRange result;
+	result.offset = names.size();
+	result.size = name.size();
+	names += name;
+	return result;
+}
+
+void writeFile( const std::string &fileName, LocationData &root, const BlobMap &blobs, BlobSpool &spool, const MurmurHash &globalsHash, const CompoundData *sets )
+{
+	// Flatten the hierarchy breadth first, so that the children
+	// of each location are contiguous.
+
+	std::vector<LocationData *> order( 1, &root );
+	std::vector<uint64_t> parents( 1, MappedSceneFile::g_invalidLocation );
+	std::vector<uint64_t> firstChildren;
+	root.index = 0;
+	for( size_t i = 0; i < order.size(); ++i )
+	{
+		firstChildren.push_back( order.size() );
+		for( std::vector<LocationData>::iterator it = order[i]->children.begin(), eIt = order[i]->children.end(); it != eIt; ++it )
+		{
+			it->index = order.size();
+			order.push_back( &*it );
+			parents.push_back( i );
+		}
+	}
+
+	// Build the tables.
+
+	std::string names;
+	std::vector<MappedSceneFile::Location> locations( order.size() );
+	std::vector<uint64_t> sortedChildren;
+	sortedChildren.reserve( order.size() );
+	sortedChildren.push_back( 0 ); // root
+	for( size_t i = 0, e = order.size(); i < e; ++i )
+	{
+		const LocationData *data = order[i];
+		MappedSceneFile::Location &location = locations[i];
+		location.name = addName( names, data->name.string() );
+		location.parent = parents[i];
+		location.firstChild = firstChildren[i];
+		location.numChildren = data->children.size();
+		location.bound[0] = data->bound.min.x;
+		location.bound[1] = data->bound.min.y;
+		location.bound[2] = data->bound.min.z;
+		location.bound[3] = data->bound.max.x;
+		location.bound[4] = data->bound.max.y;
+		location.bound[5] = data->bound.max.z;
+		memcpy( location.transform, data->transform.getValue(), sizeof( location.transform ) );
+		location.object = blobRange( blobs, data->objectHash );
+		location.attributes = blobRange( blobs, data->attributesHash );
+
+		std::vector<std::pair<std::string, uint64_t> > childNames;
+		for( std::vector<LocationData>::const_iterator it = data->children.begin(), eIt = data->children.end(); it != eIt; ++it )
+		{
+			childNames.push_back( std::make_pair( it->name.string(), it->index ) );
+		}
+		std::sort( childNames.begin(), childNames.end() );
+		for( std::vector<std::pair<std::string, uint64_t> >::const_iterator it = childNames.begin(), eIt = childNames.end(); it != eIt; ++it )
+		{
+			sortedChildren.push_back( it->second );
+		}
+	}
+
+	std::vector<MappedSceneFile::Set> setTable;
+	std::vector<uint64_t> setMemberTable;
+	ScenePlug::ScenePath path;
+	for( CompoundDataMap::const_iterator it = sets->readable().begin(), eIt = sets->readable().end(); it != eIt; ++it )
+	{
+		MappedSceneFile::Set set;
+		set.name = addName( names, it->first.string() );
+		set.firstMember = setMemberTable.size();
+		setMembers( static_cast<const PathMatcherData *>( it->second.get() )->readable(), root, path, setMemberTable );
+		set.numMembers = setMemberTable.size() - set.firstMember;
+		setTable.push_back( set );
+	}
+
+	// Write the file.
+
+	MappedSceneFile::Header header;
+	memcpy( header.magic, MappedSceneFile::g_magic, sizeof( header.magic ) );
+	header.version = MappedSceneFile::g_version;
+	header.numLocations = locations.size();
+	header.locationsOffset = sizeof( MappedSceneFile::Header );
+	header.sortedChildrenOffset = header.locationsOffset + locations.size() * sizeof( MappedSceneFile::Location );
+	header.numSets = setTable.size();
+	header.setsOffset = header.sortedChildrenOffset + sortedChildren.size() * sizeof( uint64_t );
+	header.setMembersOffset = header.setsOffset + setTable.size() * sizeof( MappedSceneFile::Set );
+	header.namesOffset = header.setMembersOffset + setMemberTable.size() * sizeof( uint64_t );
+	header.blobsOffset = alignedSize( header.namesOffset + names.size() );
+	header.globals = blobRange( blobs, globalsHash );
+
+	FileWriter writer( fileName );
+	writer.write( &header, 1 );
+	writer.write( locations.data(), locations.size() );
+	writer.write( sortedChildren.data(), sortedChildren.size() );
+	writer.write( setTable.data(), setTable.size() );
+	writer.write( setMemberTable.data(), setMemberTable.size() );
+	writer.write( names.data(), names.size() );
+	writer.align();
+	writer.write( spool );
+	writer.close();
+}
+
+} // namespace
+
+//////////////////////////////////////////////////////////////////////////
+// MappedSceneWriter
+//////////////////////////////////////////////////////////////////////////
+
+IE_CORE_DEFINERUNTIMETYPED( MappedSceneWriter );
+
+size_t MappedSceneWriter::g_firstPlugIndex = 0;
+
+MappedSceneWriter::MappedSceneWriter( const std::string &name )
+	: TaskNode( name )
+{
+	storeIndexOfNextChild( g_firstPlugIndex );
+	addChild( new ScenePlug( "in", Plug::In ) );
+	addChild( new StringPlug( "fileName" ) );
+	addChild( new ScenePlug( "out", Plug::Out, Plug::Default & ~Plug::Serialisable ) );
+	outPlug()->setInput( inPlug() );
+}
+
+MappedSceneWriter::~MappedSceneWriter()
+{
+}
+
+ScenePlug *MappedSceneWriter::inPlug()
+{
+	return getChild<ScenePlug>( g_firstPlugIndex );
+}
+
+const ScenePlug *MappedSceneWriter::inPlug() const
+{
+	return getChild<ScenePlug>( g_firstPlugIndex );
+}
+
+StringPlug *MappedSceneWriter::fileNamePlug()
+{
+	return getChild<StringPlug>( g_firstPlugIndex + 1 );
+}
+
+const StringPlug *MappedSceneWriter::fileNamePlug() const
+{
+	return getChild<StringPlug>( g_firstPlugIndex + 1 );
+}
+
+ScenePlug *MappedSceneWriter::outPlug()
+{
+	return getChild<ScenePlug>( g_firstPlugIndex + 2 );
+}
+
+const ScenePlug *MappedSceneWriter::outPlug() const
+{
+	return getChild<ScenePlug>( g_firstPlugIndex + 2 );
+}
+
+IECore::MurmurHash MappedSceneWriter::hash( const Gaffer::Context *context ) const
+{
+	Context::Scope scope( context );
+	const ScenePlug *scenePlug = inPlug()->source<ScenePlug>();
+	if ( ( fileNamePlug()->getValue() == "" ) || ( scenePlug == inPlug() ) )
+	{
+		return IECore::MurmurHash();
+	}
+
+	IECore::MurmurHash h = TaskNode::hash( context );
+	h.append( fileNamePlug()->hash() );
+	/// \todo hash the actual scene when we have a hierarchyHash
+	h.append( (uint64_t)scenePlug );
+	h.append( context->hash() );
+
+	return h;
+}
+
+void MappedSceneWriter::execute() const
+{
+	const ScenePlug *scene = inPlug()->getInput<ScenePlug>();
+	if( !scene )
+	{
+		throw IECore::Exception( "No input scene" );
+	}
+
+	const std::string fileName = fileNamePlug()->getValue();
+	const boost::filesystem::path directory = boost::filesystem::path( fileName ).parent_path();
+	if( !directory.empty() )
+	{
+		boost::filesystem::create_directories( directory );
+	}
+
+	// Blobs are spooled to a temporary file while the scene is traversed,
+	// and the scene file is written to another temporary file, which is
+	// then renamed into place. Renaming replaces the directory entry rather
+	// than the file contents, so readers which have the previous file mapped
+	// are unaffected.
+
+	const boost::filesystem::path tempFileName = boost::filesystem::unique_path( fileName + ".%%%%%%%%.tmp" );
+	BlobSpool spool( tempFileName.string() + ".blobs" );
+	BlobMap blobs;
+
+	MurmurHash globalsHash;
+	ConstCompoundDataPtr sets;
+	{
+		ScenePlug::GlobalScope globalScope( Context::current() );
+		TraversalState state = { scene, Context::current(), &blobs, &spool };
+		globalsHash = addBlob( state, scene->globalsPlug() );
+		sets = SceneAlgo::sets( scene );
+	}
+
+	LocationData root;
+	TraversalState state = { scene, Context::current(), &blobs, &spool };
+	computeLocation( state, ScenePlug::ScenePath(), root );
+
+	try
+	{
+		writeFile( tempFileName.string(), root, blobs, spool, globalsHash, sets.get() );
+		boost::filesystem::rename( tempFileName, fileName );
+	}
+	catch( ... )
+	{
+		boost::system::error_code e;
+		boost::filesystem::remove( tempFileName, e );
+		throw;
+	}
+}
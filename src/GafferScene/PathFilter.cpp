@@ -122,9 +122,15 @@ void PathFilter::affects( const Gaffer::Plug *input, AffectedPlugsContainer &out
 	else if( input == pathMatcherPlug() )
 	{
 		outputs.push_back( outPlug() );
+		outputs.push_back( matchingPathsPlug() );
 	}
 }
 
+bool PathFilter::canComputeMatchingPaths() const
+{
+	return m_pathMatcher != nullptr;
+}
+
 void PathFilter::hash( const Gaffer::ValuePlug *output, const Gaffer::Context *context, IECore::MurmurHash &h ) const
 {
 	Filter::hash( output, context, h );
@@ -183,3 +189,22 @@ unsigned PathFilter::computeMatch( const ScenePlug *scene, const Gaffer::Context
 	}
 	return NoMatch;
 }
+
+void PathFilter::hashMatchingPaths( const ScenePlug *scene, const Gaffer::Context *context, IECore::MurmurHash &h ) const
+{
+	if( m_pathMatcher )
+	{
+		m_pathMatcher->hash( h );
+	}
+	else
+	{
+		pathMatcherPlug()->hash( h );
+	}
+}
+
+ConstPathMatcherDataPtr PathFilter::computeMatchingPaths( const ScenePlug *scene, const Gaffer::Context *context ) const
+{
+	// Our matches don't depend on the scene at all, so we
+	// can simply return the PathMatcher we use in computeMatch().
+	return m_pathMatcher ? m_pathMatcher : pathMatcherPlug()->getValue();
+}
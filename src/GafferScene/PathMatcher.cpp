@@ -38,8 +38,13 @@
 #include "Gaffer/StringAlgo.h"
 
 #include "GafferScene/PathMatcher.h"
+#include "GafferScene/Filter.h"
 #include "GafferScene/ScenePlug.h"
 
+#include "tbb/parallel_for.h"
+
+#include <algorithm>
+
 using namespace std;
 using namespace GafferScene;
 
@@ -64,6 +69,190 @@ inline bool PathMatcher::Name::operator < ( const Name &other ) const
 	return type < other.type || ( ( type == other.type ) && name < other.name );
 }
 
+//////////////////////////////////////////////////////////////////////////
+// ChildMap implementation
+//////////////////////////////////////////////////////////////////////////
+
+namespace
+{
+
+const uint32_t g_emptySlot = std::numeric_limits<uint32_t>::max();
+
+// Nodes with more children than this get a hash table to
+// accelerate lookups. Below it, a linear search through a
+// few cache lines is faster.
+const size_t g_hashTableThreshold = 16;
+
+} // namespace
+
+PathMatcher::Node::ChildMap::ChildMap()
+	:	m_numPlain( 0 )
+{
+}
+
+PathMatcher::NodePtr &PathMatcher::Node::ChildMap::operator[]( const Name &name )
+{
+	const size_t existingIndex = index( name );
+	if( existingIndex < m_children.size() )
+	{
+		return m_children[existingIndex].second;
+	}
+
+	if( name.type == Name::Plain )
+	{
+		m_numPlain++;
+	}
+
+	if( m_hashTable.empty() )
+	{
+		// Small node. Insert in sorted order so that iteration
+		// order is independent of the order of insertion.
+		const value_type child( name, nullptr );
+		std::vector<value_type>::iterator it = std::lower_bound( m_children.begin(), m_children.end(), child );
+		it = m_children.insert( it, child );
+		const size_t newIndex = it - m_children.begin();
+		if( m_children.size() > g_hashTableThreshold )
+		{
+			rebuildHashTable();
+		}
+		return m_children[newIndex].second;
+	}
+
+	// Large node. Append to the appropriate partition, so that
+	// insertion is constant time.
+
+	m_children.push_back( value_type( name, nullptr ) );
+	size_t newIndex = m_children.size() - 1;
+	if( name.type == Name::Plain && m_numPlain <= newIndex )
+	{
+		// Make room at the end of the plain partition by
+		// moving the first wildcarded child to the very end.
+		moveChild( m_numPlain - 1, newIndex );
+		newIndex = m_numPlain - 1;
+		m_children[newIndex] = value_type( name, nullptr );
+	}
+
+	if( m_children.size() * 2 > m_hashTable.size() )
+	{
+		rebuildHashTable();
+	}
+	else
+	{
+		m_hashTable[slot( name )] = newIndex;
+	}
+
+	return m_children[newIndex].second;
+}
+
+size_t PathMatcher::Node::ChildMap::erase( const Name &name )
+{
+	const size_t i = index( name );
+	if( i == m_children.size() )
+	{
+		return 0;
+	}
+
+	if( m_hashTable.empty() )
+	{
+		if( i < m_numPlain )
+		{
+			m_numPlain--;
+		}
+		m_children.erase( m_children.begin() + i );
+		return 1;
+	}
+
+	// Large node. Fill the hole by moving the last child of
+	// the same partition into it, and then (for plain names)
+	// moving the last wildcarded child into the hole that
+	// leaves. This keeps erasure constant time.
+
+	hashTableErase( name );
+
+	const size_t partitionEnd = i < m_numPlain ? m_numPlain : m_children.size();
+	if( i != partitionEnd - 1 )
+	{
+		moveChild( partitionEnd - 1, i );
+	}
+
+	if( i < m_numPlain )
+	{
+		if( partitionEnd != m_children.size() )
+		{
+			moveChild( m_children.size() - 1, partitionEnd - 1 );
+		}
+		m_numPlain--;
+	}
+
+	m_children.pop_back();
+
+	if( m_children.size() <= g_hashTableThreshold / 2 )
+	{
+		// Back to being a small node, so restore
+		// the sorted order.
+		std::vector<uint32_t>().swap( m_hashTable );
+		std::sort( m_children.begin(), m_children.end() );
+	}
+
+	return 1;
+}
+
+void PathMatcher::Node::ChildMap::clear()
+{
+	m_children.clear();
+	m_numPlain = 0;
+	std::vector<uint32_t>().swap( m_hashTable );
+}
+
+void PathMatcher::Node::ChildMap::moveChild( size_t from, size_t to )
+{
+	if( m_hashTable.size() )
+	{
+		m_hashTable[slot( m_children[from].first )] = to;
+	}
+	m_children[to] = std::move( m_children[from] );
+}
+
+void PathMatcher::Node::ChildMap::hashTableErase( const Name &name )
+{
+	if( m_hashTable.empty() )
+	{
+		return;
+	}
+
+	// Backward-shift deletion, so that we don't need
+	// tombstones and lookups never get slower over time.
+	const size_t mask = m_hashTable.size() - 1;
+	size_t hole = slot( name );
+	for( size_t s = ( hole + 1 ) & mask; m_hashTable[s] != g_emptySlot; s = ( s + 1 ) & mask )
+	{
+		// Move the entry into the hole unless its ideal slot
+		// lies cyclically between the hole and its current slot.
+		const size_t ideal = hash( m_children[m_hashTable[s]].first ) & mask;
+		if( ( ( s - ideal ) & mask ) >= ( ( s - hole ) & mask ) )
+		{
+			m_hashTable[hole] = m_hashTable[s];
+			hole = s;
+		}
+	}
+	m_hashTable[hole] = g_emptySlot;
+}
+
+void PathMatcher::Node::ChildMap::rebuildHashTable()
+{
+	size_t size = 32;
+	while( size < m_children.size() * 3 )
+	{
+		size *= 2;
+	}
+
+	m_hashTable.assign( size, g_emptySlot );
+	for( size_t i = 0, e = m_children.size(); i < e; ++i )
+	{
+		m_hashTable[slot( m_children[i].first )] = i;
+	}
+}
+
 //////////////////////////////////////////////////////////////////////////
 // Node implementation
 //////////////////////////////////////////////////////////////////////////
@@ -84,9 +273,7 @@ PathMatcher::Node::~Node()
 
 inline PathMatcher::Node::ConstChildMapIterator PathMatcher::Node::wildcardsBegin() const
 {
-	// The value for name used here will never be inserted in the map,
-	// but it marks the transition from non-wildcarded to wildcarded names.
-	return children.lower_bound( Name( IECore::InternedString(), Name::Boundary ) );
+	return children.wildcardsBegin();
 }
 
 inline PathMatcher::Node *PathMatcher::Node::child( const Name &name )
@@ -411,6 +598,16 @@ bool PathMatcher::addPaths( const PathMatcher &paths, const std::vector<IECore::
 
 bool PathMatcher::removePaths( const PathMatcher &paths )
 {
+	if( paths.m_root == m_root )
+	{
+		// Removing ourselves from ourselves. Special case this
+		// because removePathsWalk() would otherwise be erasing
+		// children from the very containers it is iterating.
+		const bool result = !isEmpty();
+		clear();
+		return result;
+	}
+
 	bool result = false;
 	NodePtr newRoot = removePathsWalk( m_root.get(), paths.m_root.get(), /* shared = */ false, result );
 	if( newRoot )
@@ -422,20 +619,12 @@ bool PathMatcher::removePaths( const PathMatcher &paths )
 
 PathMatcher PathMatcher::intersection( const PathMatcher &paths )
 {
-	PathMatcher result = PathMatcher();
-	for( Iterator it = (*this).begin(); it != (*this).end(); ++it )
+	NodePtr root = intersectionWalk( m_root.get(), paths.m_root.get() );
+	if( !root )
 	{
-		RawIterator rit = paths.find( *it );
-		if( rit == paths.end() )
-		{
-			it.prune();
-		}
-		else if( rit.exactMatch() )
-		{
-			result.addPath( *it );
-		}
+		return PathMatcher();
 	}
-	return result;
+	return PathMatcher( root );
 }
 
 bool PathMatcher::prune( const std::string &path )
@@ -635,26 +824,9 @@ PathMatcher::NodePtr PathMatcher::addPathsWalk( Node *node, const Node *srcNode,
 		writable( node, result, shared )->terminator = true;
 	}
 
-	for( Node::ChildMap::const_iterator it = srcNode->children.begin(), eIt = srcNode->children.end(); it != eIt; ++it )
+	if( childrenWalk( AddPaths, node, srcNode, result, shared ) )
 	{
-		Node *srcChild = it->second.get();
-		NodePtr newChild;
-		if( Node *child = node->child( it->first ) )
-		{
-			if( child != srcChild )
-			{
-				newChild = addPathsWalk( child, srcChild, shared, added );
-			}
-		}
-		else
-		{
-			newChild = srcChild;
-			added = true; // source node can only exist if it or a descendant is a terminator
-		}
-		if( newChild )
-		{
-			writable( node, result, shared )->children[it->first] = newChild;
-		}
+		added = true;
 	}
 
 	return result;
@@ -714,24 +886,176 @@ PathMatcher::NodePtr PathMatcher::removePathsWalk( Node *node, const Node *srcNo
 		removed = true;
 	}
 
-	for( Node::ChildMap::const_iterator it = srcNode->children.begin(), eIt = srcNode->children.end(); it != eIt; ++it )
+	if( childrenWalk( RemovePaths, node, srcNode, result, shared ) )
 	{
-		const Node::ChildMapIterator childIt = node->children.find( it->first );
-		if( childIt != node->children.end() )
+		removed = true;
+	}
+
+	return result;
+}
+
+PathMatcher::NodePtr PathMatcher::intersectionWalk( Node *node, Node *srcNode )
+{
+	if( node == srcNode )
+	{
+		// Identical subtrees, which we can share.
+		return node;
+	}
+
+	if( node->children.size() < srcNode->children.size() )
+	{
+		// Intersection is commutative, so we can iterate
+		// over whichever node has the fewest children.
+		std::swap( node, srcNode );
+	}
+
+	const bool terminator = node->terminator && srcNode->terminator;
+	if( srcNode->children.empty() || node->children.empty() )
+	{
+		return terminator ? Node::leaf() : nullptr;
+	}
+
+	// Passing `shared = true` with a non-null result
+	// causes the edits to be applied to the result.
+	NodePtr result = new Node( terminator );
+	childrenWalk( Intersection, node, srcNode, result, /* shared = */ true );
+
+	if( result->children.empty() )
+	{
+		return terminator ? Node::leaf() : nullptr;
+	}
+	return result;
+}
+
+PathMatcher::ChildEdit::ChildEdit()
+	:	erase( false ), changed( false )
+{
+}
+
+PathMatcher::ChildEdit PathMatcher::childWalk( WalkType type, Node *node, const Node::ChildMapValue &srcChild, bool shared )
+{
+	ChildEdit result;
+	Node *child = node->child( srcChild.first );
+	Node *srcChildNode = srcChild.second.get();
+
+	switch( type )
+	{
+		case AddPaths :
+			if( !child )
+			{
+				result.node = srcChildNode;
+				result.changed = true; // source node can only exist if it or a descendant is a terminator
+			}
+			else if( child != srcChildNode )
+			{
+				result.node = addPathsWalk( child, srcChildNode, shared, result.changed );
+			}
+			break;
+		case RemovePaths :
+			if( child )
+			{
+				NodePtr newChild = removePathsWalk( child, srcChildNode, shared, result.changed );
+				if( newChild && !newChild->isEmpty() )
+				{
+					result.node = newChild;
+				}
+				else if( child->isEmpty() || newChild )
+				{
+					result.erase = true;
+				}
+			}
+			break;
+		case Intersection :
+			if( child )
+			{
+				result.node = intersectionWalk( child, srcChildNode );
+			}
+			break;
+	}
+
+	return result;
+}
+
+namespace
+{
+
+// Nodes with at least this many children
+// have their children walked in parallel.
+const size_t g_parallelWalkThreshold = 64;
+
+} // namespace
+
+class PathMatcher::ParallelChildrenWalk
+{
+
+	public :
+
+		ParallelChildrenWalk( PathMatcher *matcher, WalkType type, Node *node, const Node *srcNode, bool shared, std::vector<ChildEdit> &edits )
+			:	m_matcher( matcher ), m_type( type ), m_node( node ), m_srcNode( srcNode ), m_shared( shared ), m_edits( edits )
 		{
-			Node *child = childIt->second.get();
-			NodePtr newChild = removePathsWalk( child, it->second.get(), shared, removed );
+		}
 
-			if( newChild && !newChild->isEmpty() )
+		void operator()( const tbb::blocked_range<size_t> &r ) const
+		{
+			// The walks only edit nodes which are unique to the subtree being
+			// walked, so it is safe to walk siblings concurrently. Edits to
+			// `m_node` itself are deferred until all the walks are complete.
+			Node::ConstChildMapIterator it = m_srcNode->children.begin() + r.begin();
+			for( size_t i = r.begin(); i != r.end(); ++i, ++it )
+			{
+				m_edits[i] = m_matcher->childWalk( m_type, m_node, *it, m_shared );
+			}
+		}
+
+	private :
+
+		PathMatcher *m_matcher;
+		const WalkType m_type;
+		Node *m_node;
+		const Node *m_srcNode;
+		const bool m_shared;
+		std::vector<ChildEdit> &m_edits;
+
+};
+
+bool PathMatcher::childrenWalk( WalkType type, Node *node, const Node *srcNode, NodePtr &result, bool shared )
+{
+	bool changed = false;
+	if( srcNode->children.size() < g_parallelWalkThreshold )
+	{
+		for( Node::ConstChildMapIterator it = srcNode->children.begin(), eIt = srcNode->children.end(); it != eIt; ++it )
+		{
+			const ChildEdit edit = childWalk( type, node, *it, shared );
+			if( edit.erase )
 			{
-				writable( node, result, shared )->children[childIt->first] = newChild;
+				writable( node, result, shared )->children.erase( it->first );
 			}
-			else if( child->isEmpty() || ( newChild && newChild->isEmpty() ) )
+			else if( edit.node )
 			{
-				writable( node, result, shared )->children.erase( childIt->first );
+				writable( node, result, shared )->children[it->first] = edit.node;
 			}
+			changed = changed || edit.changed;
 		}
+		return changed;
 	}
 
-	return result;
+	std::vector<ChildEdit> edits( srcNode->children.size() );
+	ParallelChildrenWalk parallelWalk( this, type, node, srcNode, shared, edits );
+	tbb::parallel_for( tbb::blocked_range<size_t>( 0, edits.size() ), parallelWalk );
+
+	Node::ConstChildMapIterator it = srcNode->children.begin();
+	for( std::vector<ChildEdit>::const_iterator eIt = edits.begin(), eEIt = edits.end(); eIt != eEIt; ++eIt, ++it )
+	{
+		if( eIt->erase )
+		{
+			writable( node, result, shared )->children.erase( it->first );
+		}
+		else if( eIt->node )
+		{
+			writable( node, result, shared )->children[it->first] = eIt->node;
+		}
+		changed = changed || eIt->changed;
+	}
+
+	return changed;
 }
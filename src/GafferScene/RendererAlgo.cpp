@@ -34,7 +34,12 @@
 //
 //////////////////////////////////////////////////////////////////////////
 
+#include <unordered_map>
+#include <algorithm>
+#include <iterator>
+
 #include "tbb/task.h"
+#include "tbb/concurrent_hash_map.h"
 #include "tbb/parallel_reduce.h"
 #include "tbb/blocked_range.h"
 
@@ -59,6 +64,7 @@
 
 #include "Gaffer/Context.h"
 #include "Gaffer/Metadata.h"
+#include "Gaffer/StringAlgo.h"
 
 #include "GafferScene/RendererAlgo.h"
 #include "GafferScene/PathMatcherData.h"
@@ -86,6 +92,74 @@ void motionTimes( size_t segments, const V2f &shutter, std::set<float> &times )
 	}
 }
 
+// Implementation of `RendererAlgo::objectSamples()`. If `objectHashes` is
+// non-null, it must contain the object hash for each of the sample times, and
+// is used instead of recomputing the hashes.
+void objectSamplesInternal( const ScenePlug *scene, size_t segments, const Imath::V2f &shutter, const std::vector<MurmurHash> *objectHashes, std::vector<IECore::ConstVisibleRenderablePtr> &samples, std::set<float> &sampleTimes )
+{
+
+	// Static case
+
+	if( !segments )
+	{
+		ConstObjectPtr object = scene->objectPlug()->getValue( objectHashes ? &objectHashes->front() : nullptr );
+		if( const VisibleRenderable *renderable = runTimeCast<const VisibleRenderable>( object.get() ) )
+		{
+			samples.push_back( renderable );
+		}
+		return;
+	}
+
+	// Motion case
+
+	motionTimes( segments, shutter, sampleTimes );
+
+	Context::EditableScope timeContext( Context::current() );
+
+	bool moving = false;
+	MurmurHash lastHash;
+	samples.reserve( sampleTimes.size() );
+	size_t i = 0;
+	for( std::set<float>::const_iterator it = sampleTimes.begin(), eIt = sampleTimes.end(); it != eIt; ++it, ++i )
+	{
+		timeContext.setFrame( *it );
+
+		const MurmurHash objectHash = objectHashes ? (*objectHashes)[i] : scene->objectPlug()->hash();
+		ConstObjectPtr object = scene->objectPlug()->getValue( &objectHash );
+
+		if( const Primitive *primitive = runTimeCast<const Primitive>( object.get() ) )
+		{
+			// We can support multiple samples for these, so check to see
+			// if we actually have something moving.
+			if( !moving && !samples.empty() && objectHash != lastHash )
+			{
+				moving = true;
+			}
+			samples.push_back( primitive );
+			lastHash = objectHash;
+		}
+		else if( const VisibleRenderable *renderable = runTimeCast< const VisibleRenderable >( object.get() ) )
+		{
+			// We can't motion blur these chappies, so just take the one
+			// sample.
+			samples.push_back( renderable );
+			break;
+		}
+		else
+		{
+			// We don't even know what these chappies are, so
+			// don't take any samples at all.
+			break;
+		}
+	}
+
+	if( !moving )
+	{
+		samples.resize( std::min<size_t>( samples.size(), 1 ) );
+		sampleTimes.clear();
+	}
+}
+
 } // namespace
 
 //////////////////////////////////////////////////////////////////////////
@@ -153,66 +227,7 @@ void transformSamples( const ScenePlug *scene, size_t segments, const Imath::V2f
 
 void objectSamples( const ScenePlug *scene, size_t segments, const Imath::V2f &shutter, std::vector<IECore::ConstVisibleRenderablePtr> &samples, std::set<float> &sampleTimes )
 {
-
-	// Static case
-
-	if( !segments )
-	{
-		ConstObjectPtr object = scene->objectPlug()->getValue();
-		if( const VisibleRenderable *renderable = runTimeCast<const VisibleRenderable>( object.get() ) )
-		{
-			samples.push_back( renderable );
-		}
-		return;
-	}
-
-	// Motion case
-
-	motionTimes( segments, shutter, sampleTimes );
-
-	Context::EditableScope timeContext( Context::current() );
-
-	bool moving = false;
-	MurmurHash lastHash;
-	samples.reserve( sampleTimes.size() );
-	for( std::set<float>::const_iterator it = sampleTimes.begin(), eIt = sampleTimes.end(); it != eIt; ++it )
-	{
-		timeContext.setFrame( *it );
-
-		const MurmurHash objectHash = scene->objectPlug()->hash();
-		ConstObjectPtr object = scene->objectPlug()->getValue( &objectHash );
-
-		if( const Primitive *primitive = runTimeCast<const Primitive>( object.get() ) )
-		{
-			// We can support multiple samples for these, so check to see
-			// if we actually have something moving.
-			if( !moving && !samples.empty() && objectHash != lastHash )
-			{
-				moving = true;
-			}
-			samples.push_back( primitive );
-			lastHash = objectHash;
-		}
-		else if( const VisibleRenderable *renderable = runTimeCast< const VisibleRenderable >( object.get() ) )
-		{
-			// We can't motion blur these chappies, so just take the one
-			// sample.
-			samples.push_back( renderable );
-			break;
-		}
-		else
-		{
-			// We don't even know what these chappies are, so
-			// don't take any samples at all.
-			break;
-		}
-	}
-
-	if( !moving )
-	{
-		samples.resize( std::min<size_t>( samples.size(), 1 ) );
-		sampleTimes.clear();
-	}
+	objectSamplesInternal( scene, segments, shutter, nullptr, samples, sampleTimes );
 }
 
 } // namespace RendererAlgo
@@ -287,6 +302,19 @@ InternedString g_camerasSetName( "__cameras" );
 InternedString g_lightsSetName( "__lights" );
 std::string g_renderSetsPrefix( "render:" );
 ConstInternedStringVectorDataPtr g_emptySetsAttribute = new InternedStringVectorData;
+InternedString g_ellipsis( "..." );
+
+bool hasWildcards( const PathMatcher &set )
+{
+	for( PathMatcher::RawIterator it = set.begin(), eIt = set.end(); it != eIt; ++it )
+	{
+		if( it->size() && ( it->back() == g_ellipsis || StringAlgo::hasWildcards( it->back().c_str() ) ) )
+		{
+			return true;
+		}
+	}
+	return false;
+}
 
 } // namespace
 
@@ -365,6 +393,24 @@ struct RenderSets::Updater
 
 };
 
+struct RenderSets::IndexNode
+{
+
+	typedef std::unordered_map<InternedString, std::unique_ptr<IndexNode> > Children;
+
+	IndexNode()
+		:	membership( nullptr )
+	{
+	}
+
+	// Applies to this location, and to any descendants
+	// which don't have an IndexNode of their own.
+	const Memberships::value_type *membership;
+	// Allocated lazily, since most nodes are leaves.
+	std::unique_ptr<Children> children;
+
+};
+
 RenderSets::RenderSets()
 {
 }
@@ -376,6 +422,10 @@ RenderSets::RenderSets( const ScenePlug *scene )
 	update( scene );
 }
 
+RenderSets::~RenderSets()
+{
+}
+
 unsigned RenderSets::update( const ScenePlug *scene )
 {
 	unsigned changed = NothingChanged;
@@ -415,6 +465,11 @@ unsigned RenderSets::update( const ScenePlug *scene )
 	Updater updater( scene, Context::current(), *this, changed );
 	parallel_reduce( tbb::blocked_range<size_t>( 0, m_sets.size() + 2 ), updater );
 
+	if( updater.changed & RenderSetsChanged )
+	{
+		updateIndex();
+	}
+
 	return updater.changed;
 }
 
@@ -423,6 +478,104 @@ void RenderSets::clear()
 	m_sets.clear();
 	m_camerasSet = Set();
 	m_lightsSet = Set();
+	m_index.reset();
+	m_memberships.clear();
+	m_wildcardedSets.clear();
+}
+
+void RenderSets::updateIndex()
+{
+	m_index.reset( new IndexNode );
+	m_memberships.clear();
+	m_wildcardedSets.clear();
+
+	// Add the locations of all the sets to the index, recording
+	// the sets each belongs to directly.
+
+	typedef std::unordered_map<const IndexNode *, vector<size_t> > DirectMemberships;
+	DirectMemberships directMemberships;
+
+	size_t setIndex = 0;
+	for( Sets::const_iterator it = m_sets.begin(), eIt = m_sets.end(); it != eIt; ++it, ++setIndex )
+	{
+		const PathMatcher &set = it->second.set;
+		if( hasWildcards( set ) )
+		{
+			m_wildcardedSets.push_back( setIndex );
+			continue;
+		}
+
+		for( PathMatcher::Iterator pIt = set.begin(), peIt = set.end(); pIt != peIt; ++pIt )
+		{
+			IndexNode *node = m_index.get();
+			for( vector<InternedString>::const_iterator nIt = pIt->begin(), neIt = pIt->end(); nIt != neIt; ++nIt )
+			{
+				if( !node->children )
+				{
+					node->children.reset( new IndexNode::Children );
+				}
+				std::unique_ptr<IndexNode> &child = (*node->children)[*nIt];
+				if( !child )
+				{
+					child.reset( new IndexNode );
+				}
+				node = child.get();
+			}
+			directMemberships[node].push_back( setIndex );
+			// Descendants inherit membership from this
+			// location, so there's no need to visit them.
+			pIt.prune();
+		}
+	}
+
+	// Propagate membership from each location to its descendants,
+	// sharing a single attribute value between all locations with
+	// the same membership.
+
+	m_memberships[vector<size_t>()] = g_emptySetsAttribute;
+
+	vector<IndexNode *> stack;
+	stack.push_back( m_index.get() );
+	m_index->membership = &*m_memberships.begin();
+	while( !stack.empty() )
+	{
+		IndexNode *node = stack.back();
+		stack.pop_back();
+
+		DirectMemberships::const_iterator dIt = directMemberships.find( node );
+		if( dIt != directMemberships.end() )
+		{
+			// Set indices are always sorted, because we visited the
+			// sets in order above.
+			vector<size_t> sets;
+			std::set_union(
+				node->membership->first.begin(), node->membership->first.end(),
+				dIt->second.begin(), dIt->second.end(),
+				std::back_inserter( sets )
+			);
+
+			Memberships::iterator mIt = m_memberships.find( sets );
+			if( mIt == m_memberships.end() )
+			{
+				InternedStringVectorDataPtr setsAttribute = new InternedStringVectorData;
+				for( vector<size_t>::const_iterator sIt = sets.begin(), seIt = sets.end(); sIt != seIt; ++sIt )
+				{
+					setsAttribute->writable().push_back( ( m_sets.begin() + *sIt )->second.unprefixedName );
+				}
+				mIt = m_memberships.insert( Memberships::value_type( sets, setsAttribute ) ).first;
+			}
+			node->membership = &*mIt;
+		}
+
+		if( node->children )
+		{
+			for( IndexNode::Children::const_iterator it = node->children->begin(), eIt = node->children->end(); it != eIt; ++it )
+			{
+				it->second->membership = node->membership;
+				stack.push_back( it->second.get() );
+			}
+		}
+	}
 }
 
 const PathMatcher &RenderSets::camerasSet() const
@@ -437,21 +590,58 @@ const PathMatcher &RenderSets::lightsSet() const
 
 ConstInternedStringVectorDataPtr RenderSets::setsAttribute( const std::vector<IECore::InternedString> &path ) const
 {
-	InternedStringVectorDataPtr resultData = nullptr;
-	vector<InternedString> *result = nullptr;
-	for( Sets::const_iterator it = m_sets.begin(), eIt = m_sets.end(); it != eIt; ++it )
+	if( !m_index )
+	{
+		return g_emptySetsAttribute;
+	}
+
+	// Find the deepest location in the index
+	// which is an ancestor of (or equal to) path.
+
+	const IndexNode *node = m_index.get();
+	for( vector<InternedString>::const_iterator it = path.begin(), eIt = path.end(); it != eIt; ++it )
 	{
-		if( it->second.set.match( path ) & ( Filter::ExactMatch | Filter::AncestorMatch ) )
+		if( !node->children )
 		{
-			if( !result )
-			{
-				resultData = new InternedStringVectorData;
-				result = &resultData->writable();
-			}
-			result->push_back( it->second.unprefixedName );
+			break;
+		}
+		IndexNode::Children::const_iterator cIt = node->children->find( *it );
+		if( cIt == node->children->end() )
+		{
+			break;
+		}
+		node = cIt->second.get();
+	}
+
+	if( m_wildcardedSets.empty() )
+	{
+		return node->membership->second;
+	}
+
+	// Fall back to matching individually against
+	// any sets which couldn't be indexed.
+
+	vector<size_t> sets = node->membership->first;
+	for( vector<size_t>::const_iterator it = m_wildcardedSets.begin(), eIt = m_wildcardedSets.end(); it != eIt; ++it )
+	{
+		if( ( m_sets.begin() + *it )->second.set.match( path ) & ( Filter::ExactMatch | Filter::AncestorMatch ) )
+		{
+			sets.push_back( *it );
 		}
 	}
-	return resultData ? resultData : g_emptySetsAttribute;
+
+	if( sets.size() == node->membership->first.size() )
+	{
+		return node->membership->second;
+	}
+
+	std::sort( sets.begin(), sets.end() );
+	InternedStringVectorDataPtr resultData = new InternedStringVectorData;
+	for( vector<size_t>::const_iterator it = sets.begin(), eIt = sets.end(); it != eIt; ++it )
+	{
+		resultData->writable().push_back( ( m_sets.begin() + *it )->second.unprefixedName );
+	}
+	return resultData;
 }
 
 } // namespace RendererAlgo
@@ -795,11 +985,18 @@ struct LightOutput : public LocationOutput
 
 };
 
+// Maps from the hash of an object's samples to the prototype used to
+// share them between all locations with that hash. An entry is made the
+// first time a hash is seen, but the prototype itself is only stored
+// once the hash is seen again, so that we don't keep the samples for
+// every unique object alive for the duration of the output.
+typedef tbb::concurrent_hash_map<IECore::MurmurHash, IECoreScenePreview::Renderer::PrototypePtr> PrototypeMap;
+
 struct ObjectOutput : public LocationOutput
 {
 
-	ObjectOutput( IECoreScenePreview::Renderer *renderer, const IECore::CompoundObject *globals, const GafferScene::RendererAlgo::RenderSets &renderSets, const ScenePlug::ScenePath &root )
-		:	LocationOutput( renderer, globals, renderSets, root ), m_cameraSet( renderSets.camerasSet() ), m_lightSet( renderSets.lightsSet() )
+	ObjectOutput( IECoreScenePreview::Renderer *renderer, const IECore::CompoundObject *globals, const GafferScene::RendererAlgo::RenderSets &renderSets, const ScenePlug::ScenePath &root, PrototypeMap &prototypes )
+		:	LocationOutput( renderer, globals, renderSets, root ), m_cameraSet( renderSets.camerasSet() ), m_lightSet( renderSets.lightsSet() ), m_prototypes( prototypes )
 	{
 	}
 
@@ -815,38 +1012,110 @@ struct ObjectOutput : public LocationOutput
 			return true;
 		}
 
-		vector<ConstVisibleRenderablePtr> samples; set<float> sampleTimes;
-		RendererAlgo::objectSamples( scene, deformationSegments(), shutter(), samples, sampleTimes );
-		if( !samples.size() )
-		{
-			return true;
-		}
+		// Locations with identical object hashes share a single prototype,
+		// so that the samples are computed only once, and the renderer is
+		// free to translate them only once too.
 
-		IECoreScenePreview::Renderer::ObjectInterfacePtr objectInterface;
-		IECoreScenePreview::Renderer::AttributesInterfacePtr attributesInterface = attributes();
-		if( !sampleTimes.size() )
+		const size_t segments = deformationSegments();
+		vector<IECore::MurmurHash> objectHashes;
+		const IECore::MurmurHash hash = samplesHash( scene, segments, objectHashes );
+
+		IECoreScenePreview::Renderer::PrototypePtr prototype;
+		bool seenBefore = false;
 		{
-			objectInterface = renderer()->object( name( path ), samples[0].get(), attributesInterface.get() );
+			PrototypeMap::accessor accessor;
+			if( !m_prototypes.insert( accessor, hash ) )
+			{
+				prototype = accessor->second;
+				seenBefore = true;
+			}
 		}
-		else
+
+		if( !prototype )
 		{
-			/// \todo Can we rejig things so these conversions aren't necessary?
-			vector<const Object *> objectsVector; objectsVector.reserve( samples.size() );
-			vector<float> timesVector( sampleTimes.begin(), sampleTimes.end() );
-			for( vector<ConstVisibleRenderablePtr>::const_iterator it = samples.begin(), eIt = samples.end(); it != eIt; ++it )
+			// We compute the samples without holding a lock, because the
+			// computation may itself wait on TBB tasks. Occasionally this
+			// means two threads compute the same prototype, in which case
+			// the first one to be stored wins.
+			vector<ConstVisibleRenderablePtr> samples; set<float> sampleTimes;
+			objectSamplesInternal( scene, segments, shutter(), &objectHashes, samples, sampleTimes );
+			if( !samples.size() )
+			{
+				// No renderable samples
+				return true;
+			}
+			else if( !sampleTimes.size() )
+			{
+				prototype = new IECoreScenePreview::Renderer::Prototype( hash, samples[0].get() );
+			}
+			else
 			{
-				objectsVector.push_back( it->get() );
+				/// \todo Can we rejig things so these conversions aren't necessary?
+				vector<const Object *> objectsVector; objectsVector.reserve( samples.size() );
+				vector<float> timesVector( sampleTimes.begin(), sampleTimes.end() );
+				for( vector<ConstVisibleRenderablePtr>::const_iterator it = samples.begin(), eIt = samples.end(); it != eIt; ++it )
+				{
+					objectsVector.push_back( it->get() );
+				}
+				prototype = new IECoreScenePreview::Renderer::Prototype( hash, objectsVector, timesVector );
+			}
+
+			if( seenBefore )
+			{
+				PrototypeMap::accessor accessor;
+				m_prototypes.insert( accessor, hash );
+				if( accessor->second )
+				{
+					prototype = accessor->second;
+				}
+				else
+				{
+					accessor->second = prototype;
+				}
 			}
-			objectInterface = renderer()->object( name( path ), objectsVector, timesVector, attributesInterface.get() );
 		}
 
+		IECoreScenePreview::Renderer::AttributesInterfacePtr attributesInterface = attributes();
+		IECoreScenePreview::Renderer::ObjectInterfacePtr objectInterface = renderer()->instance( name( path ), prototype.get(), attributesInterface.get() );
+
 		applyTransform( objectInterface.get() );
 
 		return true;
 	}
 
-	const PathMatcher &m_cameraSet;
-	const PathMatcher &m_lightSet;
+	private :
+
+		// Returns a hash uniquely identifying the result of
+		// `RendererAlgo::objectSamples( scene, segments, ... )`,
+		// filling `objectHashes` with the object hash for each
+		// sample time, so they needn't be computed again.
+		IECore::MurmurHash samplesHash( const ScenePlug *scene, size_t segments, vector<IECore::MurmurHash> &objectHashes ) const
+		{
+			if( !segments )
+			{
+				objectHashes.push_back( scene->objectPlug()->hash() );
+				return objectHashes.back();
+			}
+
+			IECore::MurmurHash result;
+			set<float> sampleTimes;
+			motionTimes( segments, shutter(), sampleTimes );
+			objectHashes.reserve( sampleTimes.size() );
+
+			Context::EditableScope timeContext( Context::current() );
+			for( set<float>::const_iterator it = sampleTimes.begin(), eIt = sampleTimes.end(); it != eIt; ++it )
+			{
+				timeContext.setFrame( *it );
+				objectHashes.push_back( scene->objectPlug()->hash() );
+				result.append( *it );
+				result.append( objectHashes.back() );
+			}
+			return result;
+		}
+
+		const PathMatcher &m_cameraSet;
+		const PathMatcher &m_lightSet;
+		PrototypeMap &m_prototypes;
 
 };
 
@@ -1028,7 +1297,8 @@ void outputLights( const ScenePlug *scene, const IECore::CompoundObject *globals
 
 void outputObjects( const ScenePlug *scene, const IECore::CompoundObject *globals, const RenderSets &renderSets, IECoreScenePreview::Renderer *renderer, const ScenePlug::ScenePath &root )
 {
-	ObjectOutput output( renderer, globals, renderSets, root );
+	PrototypeMap prototypes;
+	ObjectOutput output( renderer, globals, renderSets, root, prototypes );
 	SceneAlgo::parallelProcessLocations( scene, output, root );
 }
 
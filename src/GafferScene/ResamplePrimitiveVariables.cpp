@@ -37,6 +37,7 @@
 #include "boost/format.hpp"
 
 #include "GafferScene/ResamplePrimitiveVariables.h"
+#include "GafferScene/Private/IECoreScenePreview/MeshAlgo.h"
 
 #include "IECore/MeshPrimitive.h"
 #include "IECore/CurvesPrimitive.h"
@@ -58,6 +59,7 @@ ResamplePrimitiveVariables::ResamplePrimitiveVariables( const std::string &name
 	storeIndexOfNextChild( g_firstPlugIndex );
 
 	addChild( new IntPlug( "interpolation", Plug::In, PrimitiveVariable::Vertex, PrimitiveVariable::Constant, PrimitiveVariable::FaceVarying ) );
+	addChild( new BoolPlug( "parallel", Plug::In, false ) );
 }
 
 ResamplePrimitiveVariables::~ResamplePrimitiveVariables()
@@ -74,11 +76,21 @@ const Gaffer::IntPlug *ResamplePrimitiveVariables::interpolationPlug() const
 	return getChild<IntPlug>( g_firstPlugIndex );
 }
 
+Gaffer::BoolPlug *ResamplePrimitiveVariables::parallelPlug()
+{
+	return getChild<BoolPlug>( g_firstPlugIndex + 1 );
+}
+
+const Gaffer::BoolPlug *ResamplePrimitiveVariables::parallelPlug() const
+{
+	return getChild<BoolPlug>( g_firstPlugIndex + 1 );
+}
+
 void ResamplePrimitiveVariables::affects( const Gaffer::Plug *input, AffectedPlugsContainer &outputs ) const
 {
 	PrimitiveVariableProcessor::affects( input, outputs );
 
-	if( input == interpolationPlug() )
+	if( input == interpolationPlug() || input == parallelPlug() )
 	{
 		outputs.push_back( outPlug()->objectPlug() );
 	}
@@ -89,6 +101,7 @@ void ResamplePrimitiveVariables::hashProcessedObject( const ScenePath &path, con
 	PrimitiveVariableProcessor::hashProcessedObject( path, context, h );
 
 	interpolationPlug()->hash( h );
+	parallelPlug()->hash( h );
 }
 
 void ResamplePrimitiveVariables::processPrimitiveVariable( const ScenePath &path, const Gaffer::Context *context, IECore::ConstPrimitivePtr inputGeometry, IECore::PrimitiveVariable &variable ) const
@@ -97,7 +110,14 @@ void ResamplePrimitiveVariables::processPrimitiveVariable( const ScenePath &path
 
 	if( const MeshPrimitive *meshPrimitive = IECore::runTimeCast<const MeshPrimitive>( inputGeometry.get() ) )
 	{
-		MeshAlgo::resamplePrimitiveVariable( meshPrimitive, variable, interpolation );
+		if( parallelPlug()->getValue() )
+		{
+			IECoreScenePreview::MeshAlgo::resamplePrimitiveVariable( meshPrimitive, variable, interpolation );
+		}
+		else
+		{
+			MeshAlgo::resamplePrimitiveVariable( meshPrimitive, variable, interpolation );
+		}
 	}
 	else if( const CurvesPrimitive *curvesPrimitive = IECore::runTimeCast<const CurvesPrimitive>( inputGeometry.get() ) )
 	{
@@ -34,7 +34,6 @@
 //
 //////////////////////////////////////////////////////////////////////////
 
-#include "tbb/spin_mutex.h"
 #include "tbb/task.h"
 #include "tbb/parallel_for.h"
 
@@ -104,22 +103,185 @@ bool GafferScene::SceneAlgo::visible( const ScenePlug *scene, const ScenePlug::S
 namespace
 {
 
-struct ThreadablePathAccumulator
+// Filter evaluation for MatchingPathsTask, using a filter plug.
+struct FilterPlugMatcher
 {
-	ThreadablePathAccumulator( GafferScene::PathMatcher &result): m_result( result ){}
 
-	bool operator()( const GafferScene::ScenePlug *scene, const GafferScene::ScenePlug::ScenePath &path )
+	FilterPlugMatcher( const Gaffer::IntPlug *filterPlug )
+		:	m_filterPlug( filterPlug )
 	{
-		tbb::spin_mutex::scoped_lock lock( m_mutex );
-		m_result.addPath( path );
-		return true;
 	}
 
-	tbb::spin_mutex m_mutex;
-	GafferScene::PathMatcher &m_result;
+	unsigned operator()( const ScenePlug::ScenePath &path ) const
+	{
+		return m_filterPlug->getValue();
+	}
+
+	private :
+
+		const Gaffer::IntPlug *m_filterPlug;
 
 };
 
+// Filter evaluation for MatchingPathsTask, using a PathMatcher.
+struct PathMatcherMatcher
+{
+
+	PathMatcherMatcher( const PathMatcher &filter )
+		:	m_filter( filter )
+	{
+	}
+
+	unsigned operator()( const ScenePlug::ScenePath &path ) const
+	{
+		return m_filter.match( path );
+	}
+
+	private :
+
+		const PathMatcher &m_filter;
+
+};
+
+// Result of a MatchingPathsTask.
+struct MatchingPathsResult
+{
+	MatchingPathsResult()
+		:	exactMatch( false )
+	{
+	}
+
+	bool exactMatch;
+	// Relative to the location itself.
+	PathMatcher descendantMatches;
+};
+
+// Continuation for a MatchingPathsTask, merging the results
+// of its children once they are all complete.
+class MatchingPathsMergeTask : public tbb::task
+{
+
+	public :
+
+		MatchingPathsMergeTask( const ConstInternedStringVectorDataPtr &childNames, MatchingPathsResult &result )
+			:	childResults( childNames->readable().size() ), m_childNames( childNames ), m_result( result )
+		{
+		}
+
+		task *execute() override
+		{
+			const vector<InternedString> &childNames = m_childNames->readable();
+			ScenePlug::ScenePath relativeChildPath( 1 );
+			for( size_t i = 0, e = childNames.size(); i < e; ++i )
+			{
+				relativeChildPath[0] = childNames[i];
+				const MatchingPathsResult &childResult = childResults[i];
+				m_result.descendantMatches.addPaths( childResult.descendantMatches, relativeChildPath );
+				if( childResult.exactMatch )
+				{
+					m_result.descendantMatches.addPath( relativeChildPath );
+				}
+			}
+
+			return nullptr;
+		}
+
+		vector<MatchingPathsResult> childResults;
+
+	private :
+
+		const ConstInternedStringVectorDataPtr m_childNames;
+		MatchingPathsResult &m_result;
+
+};
+
+// Task used to implement matchingPaths(). Rather than have all tasks
+// add their matches to a single PathMatcher guarded by a mutex, each task
+// collects the matches below its location into its own PathMatcher, with
+// paths relative to that location. When all children are complete, a
+// continuation grafts the results for each child into the parent's results.
+// Since sibling locations can't have overlapping subtrees, grafting needs
+// only to copy the child's top-level nodes, sharing everything below via
+// PathMatcher's copy-on-write mechanism. The merging is therefore cheap,
+// and performed in parallel throughout the tree, without any thread
+// blocking while it waits for its children.
+template<typename Matcher>
+class MatchingPathsTask : public tbb::task
+{
+
+	public :
+
+		typedef MatchingPathsResult Result;
+
+		MatchingPathsTask(
+			const Matcher &matcher,
+			const ScenePlug *scene,
+			const Gaffer::Context *context,
+			const ScenePlug::Location &location,
+			Result &result
+		)
+			:	m_matcher( matcher ), m_scene( scene ), m_context( context ), m_location( location ), m_result( result )
+		{
+		}
+
+		task *execute() override
+		{
+			ScenePlug::PathScope pathScope( m_context, m_location );
+
+			const unsigned match = m_matcher( m_location.path() );
+			m_result.exactMatch = match & Filter::ExactMatch;
+			if( !( match & Filter::DescendantMatch ) )
+			{
+				return nullptr;
+			}
+
+			ConstInternedStringVectorDataPtr childNamesData = m_scene->childNamesPlug()->getValue();
+			const vector<InternedString> &childNames = childNamesData->readable();
+			if( childNames.empty() )
+			{
+				return nullptr;
+			}
+
+			MatchingPathsMergeTask *continuation = new( allocate_continuation() ) MatchingPathsMergeTask( childNamesData, m_result );
+			continuation->set_ref_count( childNames.size() );
+
+			for( size_t i = 0, e = childNames.size() - 1; i < e; ++i )
+			{
+				MatchingPathsTask *t = new( continuation->allocate_child() ) MatchingPathsTask( m_matcher, m_scene, m_context, ScenePlug::Location( m_location, childNames[i] ), continuation->childResults[i] );
+				spawn( *t );
+			}
+
+			// Bypass the scheduler and execute the last child immediately.
+			return new( continuation->allocate_child() ) MatchingPathsTask( m_matcher, m_scene, m_context, ScenePlug::Location( m_location, childNames.back() ), continuation->childResults.back() );
+		}
+
+	private :
+
+		const Matcher &m_matcher;
+		const ScenePlug *m_scene;
+		const Gaffer::Context *m_context;
+		const ScenePlug::Location m_location;
+		Result &m_result;
+
+};
+
+template<typename Matcher>
+void matchingPathsInternal( const Matcher &matcher, const ScenePlug *scene, PathMatcher &paths )
+{
+	FilterPlug::SceneScope sceneScope( Gaffer::Context::current(), scene );
+
+	typedef MatchingPathsTask<Matcher> Task;
+	typename Task::Result result;
+	Task *task = new( tbb::task::allocate_root() ) Task( matcher, scene, Gaffer::Context::current(), ScenePlug::Location(), result );
+	tbb::task::spawn_root_and_wait( *task );
+
+	paths.addPaths( result.descendantMatches );
+	if( result.exactMatch )
+	{
+		paths.addPath( ScenePlug::ScenePath() );
+	}
+}
+
 } // namespace
 
 void GafferScene::SceneAlgo::matchingPaths( const Filter *filter, const ScenePlug *scene, PathMatcher &paths )
@@ -129,14 +291,84 @@ void GafferScene::SceneAlgo::matchingPaths( const Filter *filter, const ScenePlu
 
 void GafferScene::SceneAlgo::matchingPaths( const Gaffer::IntPlug *filterPlug, const ScenePlug *scene, PathMatcher &paths )
 {
-	ThreadablePathAccumulator f( paths );
-	GafferScene::SceneAlgo::filteredParallelTraverse( scene, filterPlug, f );
+	if( const Filter *filter = Filter::matchingPathsFilter( filterPlug ) )
+	{
+		// Compute the filter's matches in bulk, so that
+		// we don't need to evaluate it for every location.
+		ConstPathMatcherDataPtr filterPaths;
+		{
+			FilterPlug::MatchingPathsScope matchingPathsScope( Gaffer::Context::current(), scene );
+			filterPaths = filter->matchingPathsPlug()->getValue();
+		}
+		matchingPathsInternal( PathMatcherMatcher( filterPaths->readable() ), scene, paths );
+		return;
+	}
+
+	matchingPathsInternal( FilterPlugMatcher( filterPlug ), scene, paths );
 }
 
 void GafferScene::SceneAlgo::matchingPaths( const PathMatcher &filter, const ScenePlug *scene, PathMatcher &paths )
 {
-	ThreadablePathAccumulator f( paths );
-	GafferScene::SceneAlgo::filteredParallelTraverse( scene, filter, f );
+	matchingPathsInternal( PathMatcherMatcher( filter ), scene, paths );
+}
+
+GafferScene::SceneAlgo::LocationAccumulator::LocationAccumulator( unsigned components )
+	:	m_components( components ), m_initialised( false )
+{
+}
+
+void GafferScene::SceneAlgo::LocationAccumulator::update( const ScenePlug *scene, const ScenePlug::ScenePath &path )
+{
+	if( !m_initialised )
+	{
+		// First location in the traversal, so we have nothing
+		// to accumulate from and must do it the slow way.
+		if( m_components & Transform )
+		{
+			m_fullTransform = scene->fullTransform( path );
+		}
+		if( m_components & Attributes )
+		{
+			m_fullAttributes = scene->fullAttributes( path );
+		}
+		m_initialised = true;
+		return;
+	}
+
+	if( m_components & Transform )
+	{
+		m_fullTransform = scene->transformPlug()->getValue() * m_fullTransform;
+	}
+
+	if( m_components & Attributes )
+	{
+		ConstCompoundObjectPtr attributes = scene->attributesPlug()->getValue();
+		const CompoundObject::ObjectMap &members = attributes->members();
+		if( members.empty() )
+		{
+			// Share our parent's attributes.
+			return;
+		}
+
+		CompoundObjectPtr fullAttributes = new CompoundObject;
+		CompoundObject::ObjectMap &fullMembers = fullAttributes->members();
+		fullMembers = m_fullAttributes->members();
+		for( CompoundObject::ObjectMap::const_iterator it = members.begin(), eIt = members.end(); it != eIt; ++it )
+		{
+			fullMembers[it->first] = it->second;
+		}
+		m_fullAttributes = fullAttributes;
+	}
+}
+
+const Imath::M44f &GafferScene::SceneAlgo::LocationAccumulator::fullTransform() const
+{
+	return m_fullTransform;
+}
+
+const IECore::CompoundObject *GafferScene::SceneAlgo::LocationAccumulator::fullAttributes() const
+{
+	return m_fullAttributes.get();
 }
 
 IECore::ConstCompoundObjectPtr GafferScene::SceneAlgo::globalAttributes( const IECore::CompoundObject *globals )
@@ -35,6 +35,9 @@
 //
 //////////////////////////////////////////////////////////////////////////
 
+#include "tbb/parallel_reduce.h"
+#include "tbb/blocked_range.h"
+
 #include "Gaffer/Context.h"
 
 #include "GafferScene/SceneNode.h"
@@ -45,6 +48,110 @@ using namespace IECore;
 using namespace GafferScene;
 using namespace Gaffer;
 
+namespace
+{
+
+// Minimum number of children to be processed by each task in
+// the child bound reductions. Most locations have few children,
+// so this means we only pay for parallelism when it is worthwhile.
+const size_t g_childBoundsGrainSize = 100;
+
+struct TransformedChildBoundsHash
+{
+
+	TransformedChildBoundsHash( const ScenePlug *out, const Context *context, const ScenePlug::Location &parent, const vector<InternedString> &childNames )
+		:	m_out( out ), m_context( context ), m_parent( parent ), m_childNames( childNames )
+	{
+	}
+
+	TransformedChildBoundsHash( const TransformedChildBoundsHash &rhs, tbb::split )
+		:	m_out( rhs.m_out ), m_context( rhs.m_context ), m_parent( rhs.m_parent ), m_childNames( rhs.m_childNames )
+	{
+	}
+
+	void operator()( const tbb::blocked_range<size_t> &r )
+	{
+		// Declared before the scope, since the scope references it.
+		ScenePlug::Location location;
+		ScenePlug::PathScope pathScope( m_context );
+		for( size_t i = r.begin(); i != r.end(); ++i )
+		{
+			location = ScenePlug::Location( m_parent, m_childNames[i] );
+			pathScope.setPath( location );
+			m_out->boundPlug()->hash( m_hash );
+			m_out->transformPlug()->hash( m_hash );
+		}
+	}
+
+	void join( const TransformedChildBoundsHash &rhs )
+	{
+		m_hash.append( rhs.m_hash );
+	}
+
+	const MurmurHash &result() const
+	{
+		return m_hash;
+	}
+
+	private :
+
+		const ScenePlug *m_out;
+		const Context *m_context;
+		const ScenePlug::Location &m_parent;
+		const vector<InternedString> &m_childNames;
+		MurmurHash m_hash;
+
+};
+
+struct TransformedChildBoundsUnion
+{
+
+	TransformedChildBoundsUnion( const ScenePlug *out, const Context *context, const ScenePlug::Location &parent, const vector<InternedString> &childNames )
+		:	m_out( out ), m_context( context ), m_parent( parent ), m_childNames( childNames )
+	{
+	}
+
+	TransformedChildBoundsUnion( const TransformedChildBoundsUnion &rhs, tbb::split )
+		:	m_out( rhs.m_out ), m_context( rhs.m_context ), m_parent( rhs.m_parent ), m_childNames( rhs.m_childNames )
+	{
+	}
+
+	void operator()( const tbb::blocked_range<size_t> &r )
+	{
+		ScenePlug::Location location;
+		ScenePlug::PathScope pathScope( m_context );
+		for( size_t i = r.begin(); i != r.end(); ++i )
+		{
+			location = ScenePlug::Location( m_parent, m_childNames[i] );
+			pathScope.setPath( location );
+			Box3f childBound = m_out->boundPlug()->getValue();
+			childBound = transform( childBound, m_out->transformPlug()->getValue() );
+			m_union.extendBy( childBound );
+		}
+	}
+
+	void join( const TransformedChildBoundsUnion &rhs )
+	{
+		m_union.extendBy( rhs.m_union );
+	}
+
+	const Box3f &result() const
+	{
+		return m_union;
+	}
+
+	private :
+
+		const ScenePlug *m_out;
+		const Context *m_context;
+		const ScenePlug::Location &m_parent;
+		const vector<InternedString> &m_childNames;
+		Box3f m_union;
+
+};
+
+} // namespace
+
 IE_CORE_DEFINERUNTIMETYPED( SceneNode );
 
 size_t SceneNode::g_firstPlugIndex = 0;
@@ -362,17 +469,15 @@ IECore::MurmurHash SceneNode::hashOfTransformedChildBounds( const ScenePath &pat
 	IECore::MurmurHash result;
 	if( childNames.size() )
 	{
-		ScenePlug::PathScope pathScope( Context::current() );
-
-		ScenePath childPath( path );
-		childPath.push_back( InternedString() ); // room for the child name
-		for( vector<InternedString>::const_iterator it = childNames.begin(); it != childNames.end(); it++ )
-		{
-			childPath[path.size()] = *it;
-			pathScope.setPath( childPath );
-			out->boundPlug()->hash( result );
-			out->transformPlug()->hash( result );
-		}
+		// Wide hierarchies are hashed in parallel. The deterministic
+		// reduction guarantees the same hash for every evaluation.
+		const ScenePlug::Location location( path );
+		TransformedChildBoundsHash hasher( out, Context::current(), location, childNames );
+		tbb::parallel_deterministic_reduce(
+			tbb::blocked_range<size_t>( 0, childNames.size(), g_childBoundsGrainSize ),
+			hasher
+		);
+		result = hasher.result();
 	}
 	else
 	{
@@ -395,18 +500,13 @@ Imath::Box3f SceneNode::unionOfTransformedChildBounds( const ScenePath &path, co
 	Box3f result;
 	if( childNames.size() )
 	{
-		ScenePlug::PathScope pathScope( Context::current() );
-
-		ScenePath childPath( path );
-		childPath.push_back( InternedString() ); // room for the child name
-		for( vector<InternedString>::const_iterator it = childNames.begin(); it != childNames.end(); it++ )
-		{
-			childPath[path.size()] = *it;
-			pathScope.setPath( childPath );
-			Box3f childBound = out->boundPlug()->getValue();
-			childBound = transform( childBound, out->transformPlug()->getValue() );
-			result.extendBy( childBound );
-		}
+		const ScenePlug::Location location( path );
+		TransformedChildBoundsUnion unioner( out, Context::current(), location, childNames );
+		tbb::parallel_reduce(
+			tbb::blocked_range<size_t>( 0, childNames.size(), g_childBoundsGrainSize ),
+			unioner
+		);
+		result = unioner.result();
 	}
 	return result;
 }
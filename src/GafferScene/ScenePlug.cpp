@@ -35,6 +35,10 @@
 //
 //////////////////////////////////////////////////////////////////////////
 
+#include <algorithm>
+
+#include "tbb/parallel_for.h"
+
 #include "IECore/NullObject.h"
 
 #include "Gaffer/Context.h"
@@ -46,6 +50,75 @@
 using namespace Gaffer;
 using namespace GafferScene;
 
+namespace
+{
+
+// Evaluates the requested components in the current context.
+void evaluateLocationBundle( const ScenePlug *scene, unsigned components, ScenePlug::LocationBundle &bundle )
+{
+	if( components & ScenePlug::BoundComponent )
+	{
+		bundle.bound = scene->boundPlug()->getValue();
+	}
+	if( components & ScenePlug::TransformComponent )
+	{
+		bundle.transform = scene->transformPlug()->getValue();
+	}
+	if( components & ScenePlug::AttributesComponent )
+	{
+		bundle.attributes = scene->attributesPlug()->getValue();
+	}
+	if( components & ScenePlug::ObjectComponent )
+	{
+		bundle.object = scene->objectPlug()->getValue();
+	}
+	if( components & ScenePlug::ChildNamesComponent )
+	{
+		bundle.childNames = scene->childNamesPlug()->getValue();
+	}
+}
+
+struct ChildLocationBundles
+{
+
+	ChildLocationBundles(
+		const ScenePlug *scene,
+		const Context *context,
+		const ScenePlug::Location &parent,
+		const std::vector<IECore::InternedString> &childNames,
+		unsigned components,
+		std::vector<ScenePlug::LocationBundle> &bundles
+	)
+		:	m_scene( scene ), m_context( context ), m_parent( parent ), m_childNames( childNames ), m_components( components ), m_bundles( bundles )
+	{
+	}
+
+	void operator()( const tbb::blocked_range<size_t> &r ) const
+	{
+		// Declared before the scope, since the scope references it.
+		ScenePlug::Location location;
+		ScenePlug::PathScope pathScope( m_context );
+		for( size_t i = r.begin(); i != r.end(); ++i )
+		{
+			location.setChild( m_parent, m_childNames[i] );
+			pathScope.setPath( location );
+			evaluateLocationBundle( m_scene, m_components, m_bundles[i] );
+		}
+	}
+
+	private :
+
+		const ScenePlug *m_scene;
+		const Context *m_context;
+		const ScenePlug::Location &m_parent;
+		const std::vector<IECore::InternedString> &m_childNames;
+		const unsigned m_components;
+		std::vector<ScenePlug::LocationBundle> &m_bundles;
+
+};
+
+} // namespace
+
 IE_CORE_DEFINERUNTIMETYPED( ScenePlug );
 
 const IECore::InternedString ScenePlug::scenePathContextName( "scene:path" );
@@ -245,6 +318,70 @@ const PathMatcherDataPlug *ScenePlug::setPlug() const
 	return getChild<PathMatcherDataPlug>( 7 );
 }
 
+ScenePlug::Location::Location()
+	:	m_pathData( new IECore::InternedStringVectorData )
+{
+	m_pathHash = Context::variableHash( m_pathData.get() );
+}
+
+ScenePlug::Location::Location( const ScenePath &path )
+	:	m_pathData( new IECore::InternedStringVectorData( path ) )
+{
+	m_pathHash = Context::variableHash( m_pathData.get() );
+}
+
+ScenePlug::Location::Location( const Location &parent, const IECore::InternedString &childName )
+{
+	setChild( parent, childName );
+}
+
+void ScenePlug::Location::setChild( const Location &parent, const IECore::InternedString &childName )
+{
+	const ScenePath &parentPath = parent.path();
+	if(
+		m_pathData && m_pathData->refCount() == 1 &&
+		m_pathData->readable().size() == parentPath.size() + 1 &&
+		std::equal( parentPath.begin(), parentPath.end(), m_pathData->readable().begin() )
+	)
+	{
+		// We're a sibling of the new child, and no-one else
+		// is using our storage, so we can just rename the last
+		// element. The const_cast is safe because we are the
+		// sole owner of the data.
+		const_cast<IECore::InternedStringVectorData *>( m_pathData.get() )->writable().back() = childName;
+	}
+	else
+	{
+		// The path can't be shared with the parent, because
+		// PathScope needs the full path to put in the context.
+		IECore::InternedStringVectorDataPtr pathData = new IECore::InternedStringVectorData;
+		ScenePath &path = pathData->writable();
+		path.reserve( parentPath.size() + 1 );
+		path.insert( path.end(), parentPath.begin(), parentPath.end() );
+		path.push_back( childName );
+		m_pathData = pathData;
+	}
+
+	// See Context::variableHash().
+	m_pathHash = parent.m_pathHash;
+	m_pathHash.append( childName );
+}
+
+const ScenePlug::ScenePath &ScenePlug::Location::path() const
+{
+	return m_pathData->readable();
+}
+
+const IECore::InternedStringVectorData *ScenePlug::Location::pathData() const
+{
+	return m_pathData.get();
+}
+
+const IECore::MurmurHash &ScenePlug::Location::pathHash() const
+{
+	return m_pathHash;
+}
+
 ScenePlug::PathScope::PathScope( const Gaffer::Context *context )
 	:	EditableScope( context )
 {
@@ -256,11 +393,22 @@ ScenePlug::PathScope::PathScope( const Gaffer::Context *context, const ScenePath
 	setPath( scenePath );
 }
 
+ScenePlug::PathScope::PathScope( const Gaffer::Context *context, const Location &location )
+	:	EditableScope( context )
+{
+	setPath( location );
+}
+
 void ScenePlug::PathScope::setPath( const ScenePath &scenePath )
 {
 	set( scenePathContextName, scenePath );
 }
 
+void ScenePlug::PathScope::setPath( const Location &location )
+{
+	set( scenePathContextName, location.pathData(), location.pathHash() );
+}
+
 ScenePlug::SetScope::SetScope( const Gaffer::Context *context )
 	:	EditableScope( context )
 {
@@ -458,6 +606,37 @@ IECore::MurmurHash ScenePlug::setHash( const IECore::InternedString &setName ) c
 	return setPlug()->hash();
 }
 
+void ScenePlug::locationBundle( const ScenePath &scenePath, unsigned components, LocationBundle &bundle ) const
+{
+	PathScope scope( Context::current(), scenePath );
+	evaluateLocationBundle( this, components, bundle );
+}
+
+void ScenePlug::locationBundle( const Location &location, unsigned components, LocationBundle &bundle ) const
+{
+	PathScope scope( Context::current(), location );
+	evaluateLocationBundle( this, components, bundle );
+}
+
+void ScenePlug::childLocationBundles( const ScenePath &scenePath, unsigned components, std::vector<LocationBundle> &bundles ) const
+{
+	const Location location( scenePath );
+	IECore::ConstInternedStringVectorDataPtr childNamesData;
+	{
+		PathScope scope( Context::current(), location );
+		childNamesData = childNamesPlug()->getValue();
+	}
+
+	const std::vector<IECore::InternedString> &childNames = childNamesData->readable();
+	bundles.clear();
+	bundles.resize( childNames.size() );
+
+	tbb::parallel_for(
+		tbb::blocked_range<size_t>( 0, childNames.size() ),
+		ChildLocationBundles( this, Context::current(), location, childNames, components, bundles )
+	);
+}
+
 void ScenePlug::stringToPath( const std::string &s, ScenePlug::ScenePath &path )
 {
 	path.clear();
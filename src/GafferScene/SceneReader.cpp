@@ -34,9 +34,14 @@
 //
 //////////////////////////////////////////////////////////////////////////
 
+#include "tbb/parallel_for.h"
+#include "tbb/concurrent_hash_map.h"
+
 #include "boost/bind.hpp"
+#include "boost/chrono.hpp"
+#include "boost/filesystem.hpp"
 
-#include "IECore/SharedSceneInterfaces.h"
+#include "IECore/LRUCache.h"
 #include "IECore/InternedString.h"
 #include "IECore/SceneCache.h"
 
@@ -57,6 +62,168 @@ typedef boost::tokenizer<boost::char_separator<char> > Tokenizer;
 
 IE_CORE_DEFINERUNTIMETYPED( SceneReader );
 
+//////////////////////////////////////////////////////////////////////////
+// Implementation of an LRUCache of SceneInterfaces.
+//////////////////////////////////////////////////////////////////////////
+
+namespace
+{
+
+// Unlike SharedSceneInterfaces, this allows individual files to be
+// evicted, so that refreshing one SceneReader doesn't force all the
+// others to reopen their files.
+struct CachedScene
+{
+	ConstSceneInterfacePtr scene;
+	std::time_t modificationTime;
+};
+
+std::time_t modificationTime( const std::string &fileName )
+{
+	boost::system::error_code e;
+	const std::time_t result = boost::filesystem::last_write_time( fileName, e );
+	return e ? 0 : result;
+}
+
+// Querying the file system is relatively expensive, and would otherwise
+// be done for every hash and compute when refreshOnFileChangePlug() is
+// on. So we reuse the modification time of each file for up to a second
+// before querying it again.
+struct ModificationTimeCheck
+{
+	boost::chrono::steady_clock::time_point checkTime;
+	std::time_t modificationTime;
+};
+
+typedef tbb::concurrent_hash_map<std::string, ModificationTimeCheck> ModificationTimeChecks;
+
+ModificationTimeChecks &modificationTimeChecks()
+{
+	static ModificationTimeChecks *c = new ModificationTimeChecks;
+	return *c;
+}
+
+std::time_t throttledModificationTime( const std::string &fileName )
+{
+	const boost::chrono::steady_clock::time_point now = boost::chrono::steady_clock::now();
+
+	{
+		ModificationTimeChecks::const_accessor readAccessor;
+		if( modificationTimeChecks().find( readAccessor, fileName ) && now - readAccessor->second.checkTime < boost::chrono::seconds( 1 ) )
+		{
+			return readAccessor->second.modificationTime;
+		}
+	}
+
+	const std::time_t result = modificationTime( fileName );
+
+	ModificationTimeChecks::accessor writeAccessor;
+	modificationTimeChecks().insert( writeAccessor, fileName );
+	writeAccessor->second.checkTime = now;
+	writeAccessor->second.modificationTime = result;
+	return result;
+}
+
+CachedScene sceneGetter( const std::string &fileName, size_t &cost )
+{
+	cost = 1;
+	CachedScene result;
+	// Query the time before opening, so that a write made while we
+	// are opening will be detected as a change on the next access.
+	result.modificationTime = modificationTime( fileName );
+	result.scene = SceneInterface::create( fileName, IndexedIO::Read );
+	return result;
+}
+
+typedef LRUCache<std::string, CachedScene> SceneInterfaceCache;
+
+SceneInterfaceCache *sceneInterfaceCache()
+{
+	static SceneInterfaceCache *c = new SceneInterfaceCache( sceneGetter, 200 );
+	return c;
+}
+
+} // namespace
+
+//////////////////////////////////////////////////////////////////////////
+// Tag index building
+//////////////////////////////////////////////////////////////////////////
+
+namespace
+{
+
+// Maps from tag name to the tagged locations, with paths
+// relative to the location the index was built for.
+typedef std::map<InternedString, PathMatcher> TagIndex;
+
+void buildTagIndex( const SceneInterface *s, TagIndex &index );
+
+struct BuildChildTagIndices
+{
+
+	BuildChildTagIndices( const SceneInterface *s, const SceneInterface::NameList &childNames, vector<TagIndex> &childIndices )
+		:	m_scene( s ), m_childNames( childNames ), m_childIndices( childIndices )
+	{
+	}
+
+	void operator()( const tbb::blocked_range<size_t> &r ) const
+	{
+		for( size_t i = r.begin(); i != r.end(); ++i )
+		{
+			ConstSceneInterfacePtr child = m_scene->child( m_childNames[i] );
+			buildTagIndex( child.get(), m_childIndices[i] );
+		}
+	}
+
+	private :
+
+		const SceneInterface *m_scene;
+		const SceneInterface::NameList &m_childNames;
+		vector<TagIndex> &m_childIndices;
+
+};
+
+void buildTagIndex( const SceneInterface *s, TagIndex &index )
+{
+	SceneInterface::NameList tags;
+	s->readTags( tags, SceneInterface::LocalTag );
+	for( SceneInterface::NameList::const_iterator it = tags.begin(), eIt = tags.end(); it != eIt; ++it )
+	{
+		index[*it].addPath( ScenePlug::ScenePath() );
+	}
+
+	// Prune the walk where no descendants are tagged.
+
+	tags.clear();
+	s->readTags( tags, SceneInterface::DescendantTag );
+	if( tags.empty() )
+	{
+		return;
+	}
+
+	// Index the children in parallel, and then graft their
+	// indices into ours.
+
+	SceneInterface::NameList childNames;
+	s->childNames( childNames );
+
+	vector<TagIndex> childIndices( childNames.size() );
+	BuildChildTagIndices buildChildren( s, childNames, childIndices );
+	tbb::parallel_for( tbb::blocked_range<size_t>( 0, childNames.size() ), buildChildren );
+
+	vector<InternedString> childPath( 1 );
+	for( size_t i = 0, e = childNames.size(); i < e; ++i )
+	{
+		childPath[0] = childNames[i];
+		for( TagIndex::const_iterator it = childIndices[i].begin(), eIt = childIndices[i].end(); it != eIt; ++it )
+		{
+			index[it->first].addPaths( it->second, childPath );
+		}
+	}
+}
+
+} // namespace
+
 //////////////////////////////////////////////////////////////////////////
 // SceneReader implementation
 //////////////////////////////////////////////////////////////////////////
@@ -72,6 +239,8 @@ SceneReader::SceneReader( const std::string &name )
 	addChild( new StringPlug( "fileName" ) );
 	addChild( new IntPlug( "refreshCount" ) );
 	addChild( new StringPlug( "tags" ) );
+	addChild( new BoolPlug( "refreshOnFileChange" ) );
+	addChild( new ObjectPlug( "__tagIndex", Plug::Out, new CompoundData() ) );
 	plugSetSignal().connect( boost::bind( &SceneReader::plugSet, this, ::_1 ) );
 }
 
@@ -109,12 +278,33 @@ const Gaffer::StringPlug *SceneReader::tagsPlug() const
 	return getChild<StringPlug>( g_firstPlugIndex + 2 );
 }
 
+Gaffer::BoolPlug *SceneReader::refreshOnFileChangePlug()
+{
+	return getChild<BoolPlug>( g_firstPlugIndex + 3 );
+}
+
+const Gaffer::BoolPlug *SceneReader::refreshOnFileChangePlug() const
+{
+	return getChild<BoolPlug>( g_firstPlugIndex + 3 );
+}
+
+Gaffer::ObjectPlug *SceneReader::tagIndexPlug()
+{
+	return getChild<ObjectPlug>( g_firstPlugIndex + 4 );
+}
+
+const Gaffer::ObjectPlug *SceneReader::tagIndexPlug() const
+{
+	return getChild<ObjectPlug>( g_firstPlugIndex + 4 );
+}
+
 void SceneReader::affects( const Gaffer::Plug *input, AffectedPlugsContainer &outputs ) const
 {
 	SceneNode::affects( input, outputs );
 
-	if( input == fileNamePlug() || input == refreshCountPlug() )
+	if( input == fileNamePlug() || input == refreshCountPlug() || input == refreshOnFileChangePlug() )
 	{
+		outputs.push_back( tagIndexPlug() );
 		outputs.push_back( outPlug()->boundPlug() );
 		outputs.push_back( outPlug()->transformPlug() );
 		outputs.push_back( outPlug()->attributesPlug() );
@@ -131,12 +321,51 @@ void SceneReader::affects( const Gaffer::Plug *input, AffectedPlugsContainer &ou
 	}
 }
 
+void SceneReader::hash( const Gaffer::ValuePlug *output, const Gaffer::Context *context, IECore::MurmurHash &h ) const
+{
+	SceneNode::hash( output, context, h );
+
+	if( output == tagIndexPlug() )
+	{
+		fileNamePlug()->hash( h );
+		hashRefresh( h );
+	}
+}
+
+void SceneReader::compute( Gaffer::ValuePlug *output, const Gaffer::Context *context ) const
+{
+	if( output == tagIndexPlug() )
+	{
+		TagIndex index;
+		ConstSceneInterfacePtr rootScene = scene( ScenePath() );
+		if( rootScene )
+		{
+			buildTagIndex( rootScene.get(), index );
+		}
+
+		CompoundDataPtr result = new CompoundData;
+		for( TagIndex::const_iterator it = index.begin(), eIt = index.end(); it != eIt; ++it )
+		{
+			result->writable()[it->first] = new PathMatcherData( it->second );
+		}
+		static_cast<ObjectPlug *>( output )->setValue( result );
+		return;
+	}
+
+	SceneNode::compute( output, context );
+}
+
 size_t SceneReader::supportedExtensions( std::vector<std::string> &extensions )
 {
 	extensions = SceneInterface::supportedExtensions();
 	return extensions.size();
 }
 
+IECore::ConstSceneInterfacePtr SceneReader::cachedScene( const std::string &fileName )
+{
+	return sceneInterfaceCache()->get( fileName ).scene;
+}
+
 void SceneReader::hashBound( const ScenePath &path, const Gaffer::Context *context, const ScenePlug *parent, IECore::MurmurHash &h ) const
 {
 	SceneNode::hashBound( path, context, parent, h );
@@ -147,7 +376,7 @@ void SceneReader::hashBound( const ScenePath &path, const Gaffer::Context *conte
 		return;
 	}
 
-	refreshCountPlug()->hash( h );
+	hashRefresh( h );
 
 	if( s->hasBound() )
 	{
@@ -193,7 +422,7 @@ void SceneReader::hashTransform( const ScenePath &path, const Gaffer::Context *c
 		return;
 	}
 
-	refreshCountPlug()->hash( h );
+	hashRefresh( h );
 	s->hash( SceneInterface::TransformHash, context->getTime(), h );
 }
 
@@ -226,7 +455,7 @@ void SceneReader::hashAttributes( const ScenePath &path, const Gaffer::Context *
 
 	SceneNode::hashAttributes( path, context, parent, h );
 
-	refreshCountPlug()->hash( h );
+	hashRefresh( h );
 	s->hash( SceneInterface::AttributesHash, context->getTime(), h );
 }
 
@@ -277,7 +506,7 @@ void SceneReader::hashObject( const ScenePath &path, const Gaffer::Context *cont
 
 	SceneNode::hashObject( path, context, parent, h );
 
-	refreshCountPlug()->hash( h );
+	hashRefresh( h );
 	s->hash( SceneInterface::ObjectHash, context->getTime(), h );
 }
 
@@ -303,7 +532,7 @@ void SceneReader::hashChildNames( const ScenePath &path, const Gaffer::Context *
 
 	SceneNode::hashChildNames( path, context, parent, h );
 
-	refreshCountPlug()->hash( h );
+	hashRefresh( h );
 
 	// append a hash of the tags plug, as restricting the tags can affect the hierarchy
 	tagsPlug()->hash( h );
@@ -335,18 +564,31 @@ IECore::ConstInternedStringVectorDataPtr SceneReader::computeChildNames( const S
 		vector<InternedString> tags;
 		std::copy( tagsTokenizer.begin(), tagsTokenizer.end(), back_inserter( tags ) );
 
+		// Look up the tagged locations in the index, rather than
+		// reading the tags from each child in turn. A child is kept
+		// if it, an ancestor or a descendant has a matching tag.
+
+		ConstCompoundDataPtr index = tagIndex( context );
+		vector<const PathMatcher *> taggedPaths;
+		for( vector<InternedString>::const_iterator tIt = tags.begin(), tEIt = tags.end(); tIt != tEIt; ++tIt )
+		{
+			if( const PathMatcherData *d = index->member<PathMatcherData>( *tIt ) )
+			{
+				taggedPaths.push_back( &d->readable() );
+			}
+		}
+
 		vector<InternedString>::iterator newResultEnd = result.begin();
-		SceneInterface::NameList childTags;
+		ScenePath childPath( path );
+		childPath.push_back( InternedString() ); // room for the child name
 		for( vector<InternedString>::const_iterator cIt = result.begin(), cEIt = result.end(); cIt != cEIt; ++cIt )
 		{
-			ConstSceneInterfacePtr child = s->child( *cIt );
-			childTags.clear();
-			child->readTags( childTags, IECore::SceneInterface::EveryTag );
+			childPath.back() = *cIt;
 
 			bool childMatches = false;
-			for( SceneInterface::NameList::const_iterator tIt = childTags.begin(), tEIt = childTags.end(); tIt != tEIt; ++tIt )
+			for( vector<const PathMatcher *>::const_iterator pIt = taggedPaths.begin(), pEIt = taggedPaths.end(); pIt != pEIt; ++pIt )
 			{
-				if( find( tags.begin(), tags.end(), *tIt ) != tags.end() )
+				if( (*pIt)->match( childPath ) )
 				{
 					childMatches = true;
 					break;
@@ -379,7 +621,7 @@ void SceneReader::hashSetNames( const Gaffer::Context *context, const ScenePlug
 {
 	SceneNode::hashSetNames( context, parent, h );
 	fileNamePlug()->hash( h );
-	refreshCountPlug()->hash( h );
+	hashRefresh( h );
 }
 
 IECore::ConstInternedStringVectorDataPtr SceneReader::computeSetNames( const Gaffer::Context *context, const ScenePlug *parent ) const
@@ -400,61 +642,60 @@ void SceneReader::hashSet( const IECore::InternedString &setName, const Gaffer::
 {
 	SceneNode::hashSet( setName, context, parent, h );
 	fileNamePlug()->hash( h );
-	refreshCountPlug()->hash( h );
+	hashRefresh( h );
 	h.append( setName );
 }
 
-static void loadSetWalk( const SceneInterface *s, const InternedString &setName, PathMatcher &set, const vector<InternedString> &path )
+GafferScene::ConstPathMatcherDataPtr SceneReader::computeSet( const IECore::InternedString &setName, const Gaffer::Context *context, const ScenePlug *parent ) const
 {
-	if( s->hasTag( setName, SceneInterface::LocalTag ) )
+	ConstCompoundDataPtr index = tagIndex( context );
+	if( const PathMatcherData *set = index->member<PathMatcherData>( setName ) )
 	{
-		set.addPath( path );
+		return set;
 	}
+	return parent->setPlug()->defaultValue();
+}
 
-	// Figure out if we need to recurse by querying descendant tags to see if they include
-	// anything we're interested in.
-
-	if( !s->hasTag( setName, SceneInterface::DescendantTag ) )
+void SceneReader::plugSet( Gaffer::Plug *plug )
+{
+	// Evict the files we have been reading from the cache every time the
+	// refresh count is updated, so you don't get entries from old files
+	// hanging around and screwing up the hierarchy. Other files, and other
+	// readers of other files, are unaffected.
+	if( plug == refreshCountPlug() )
 	{
-		return;
-	}
-
-	// Recurse to the children.
+		for( tbb::enumerable_thread_specific<LastScene>::const_iterator it = m_lastScene.begin(), eIt = m_lastScene.end(); it != eIt; ++it )
+		{
+			if( it->fileName.size() )
+			{
+				sceneInterfaceCache()->erase( it->fileName );
+				modificationTimeChecks().erase( it->fileName );
+			}
+		}
+		m_lastScene.clear();
 
-	SceneInterface::NameList childNames;
-	s->childNames( childNames );
-	vector<InternedString> childPath( path );
-	childPath.push_back( InternedString() ); // room for the child name
-	for( SceneInterface::NameList::const_iterator it = childNames.begin(), eIt = childNames.end(); it != eIt; ++it )
-	{
-		ConstSceneInterfacePtr child = s->child( *it );
-		childPath.back() = *it;
-		loadSetWalk( child.get(), setName, set, childPath );
+		const std::string fileName = fileNamePlug()->getValue();
+		if( fileName.size() )
+		{
+			sceneInterfaceCache()->erase( fileName );
+			modificationTimeChecks().erase( fileName );
+		}
 	}
 }
 
-GafferScene::ConstPathMatcherDataPtr SceneReader::computeSet( const IECore::InternedString &setName, const Gaffer::Context *context, const ScenePlug *parent ) const
+void SceneReader::hashRefresh( IECore::MurmurHash &h ) const
 {
-	PathMatcherDataPtr result = new PathMatcherData;
-	ConstSceneInterfacePtr rootScene = scene( ScenePath() );
-	if( rootScene )
+	refreshCountPlug()->hash( h );
+	if( refreshOnFileChangePlug()->getValue() )
 	{
-		loadSetWalk( rootScene.get(), setName, result->writable(), ScenePath() );
+		h.append( (uint64_t)throttledModificationTime( fileNamePlug()->getValue() ) );
 	}
-	return result;
 }
 
-void SceneReader::plugSet( Gaffer::Plug *plug )
+IECore::ConstCompoundDataPtr SceneReader::tagIndex( const Gaffer::Context *context ) const
 {
-	// this clears the cache every time the refresh count is updated, so you don't get entries
-	// from old files hanging around and screwing up the hierarchy.
-	/// \todo The fact that this clears the cache for all nodes, ever is a problem - find a better
-	// way of doing this!
-	if( plug == refreshCountPlug() )
-	{
-		SharedSceneInterfaces::clear();
-		m_lastScene.clear();
-	}
+	ScenePlug::GlobalScope globalScope( context );
+	return boost::static_pointer_cast<const CompoundData>( tagIndexPlug()->getValue() );
 }
 
 ConstSceneInterfacePtr SceneReader::scene( const ScenePath &path ) const
@@ -466,25 +707,51 @@ ConstSceneInterfacePtr SceneReader::scene( const ScenePath &path ) const
 	}
 
 	LastScene &lastScene = m_lastScene.local();
-	if( lastScene.fileName == fileName )
+
+	// Find the root of the file, reusing the last one
+	// if we can.
+
+	const bool checkModification = refreshOnFileChangePlug()->getValue();
+	const std::time_t currentModificationTime = checkModification ? throttledModificationTime( fileName ) : 0;
+	if(
+		lastScene.fileName != fileName ||
+		( checkModification && lastScene.modificationTime != currentModificationTime )
+	)
 	{
-		if( lastScene.path == path )
+		CachedScene cachedScene = sceneInterfaceCache()->get( fileName );
+		if( checkModification && cachedScene.modificationTime != currentModificationTime )
 		{
-			return lastScene.pathScene;
-		}
-		else
-		{
-			lastScene.pathScene = lastScene.fileNameScene->scene( path );
-			lastScene.path = path;
-			return lastScene.pathScene;
+			sceneInterfaceCache()->erase( fileName );
+			cachedScene = sceneInterfaceCache()->get( fileName );
 		}
+
+		lastScene.fileName = fileName;
+		lastScene.modificationTime = cachedScene.modificationTime;
+		lastScene.path.clear();
+		lastScene.ancestry.assign( 1, cachedScene.scene );
 	}
 
-	lastScene.fileNameScene = SharedSceneInterfaces::get( fileName );
-	lastScene.fileName = fileName;
+	// Find the deepest location shared by the requested path and the
+	// last one, and navigate from there. This makes queries for the
+	// same location, its children and its siblings cheap.
 
-	lastScene.pathScene = lastScene.fileNameScene->scene( path );
-	lastScene.path = path;
+	const size_t maxCommon = std::min( path.size(), lastScene.path.size() );
+	size_t common = 0;
+	while( common < maxCommon && path[common] == lastScene.path[common] )
+	{
+		++common;
+	}
+
+	lastScene.path.resize( common );
+	lastScene.ancestry.resize( common + 1 );
+	for( size_t i = common, e = path.size(); i < e; ++i )
+	{
+		// May throw if the child doesn't exist, so we update
+		// the path one element at a time to keep it in sync
+		// with the ancestry.
+		lastScene.ancestry.push_back( lastScene.ancestry.back()->child( path[i] ) );
+		lastScene.path.push_back( path[i] );
+	}
 
-	return lastScene.pathScene;
+	return lastScene.ancestry.back();
 }
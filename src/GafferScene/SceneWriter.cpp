@@ -44,8 +44,13 @@
 #include "GafferScene/SceneAlgo.h"
 #include "GafferScene/SceneWriter.h"
 
-#include "tbb/mutex.h"
-#include "tbb/concurrent_unordered_map.h"
+#include "tbb/concurrent_queue.h"
+#include "tbb/parallel_for.h"
+
+#include "boost/bind.hpp"
+
+#include <algorithm>
+#include <thread>
 
 using namespace std;
 using namespace IECore;
@@ -55,97 +60,480 @@ using namespace GafferScene;
 namespace
 {
 
-struct LocationWriter
+// The data for a single location, computed by queueLocation()
+// and then written to file by LocationQueue. Each component holds
+// either one sample per time, or a single sample if it is static
+// across all the frames being written.
+struct LocationData : public IECore::RefCounted
 {
-	LocationWriter(SceneInterfacePtr output, ConstCompoundDataPtr sets, float time, tbb::mutex& mutex) : m_output( output ), m_sets(sets), m_time( time ), m_mutex( mutex )
-	{
-	}
 
-	/// first half of this function can be lock free reading data from ScenePlug
-	/// once all the data has been read then we take a global lock and write
-	/// into the SceneInterface
-	bool operator()( const ScenePlug *scene, const ScenePlug::ScenePath &scenePath )
-	{
-		ConstCompoundObjectPtr attributes = scene->attributesPlug()->getValue();
+	IE_CORE_DECLAREMEMBERPTR( LocationData )
 
-		ConstCompoundObjectPtr globals;
+	// Parent locations are always pushed onto the queue
+	// before their children, so by the time a location is
+	// written, its parent has created `output` for it to
+	// create its own from.
+	Ptr parent;
+	IECore::InternedString name;
+	SceneInterfacePtr output;
 
-		ConstObjectPtr object = scene->objectPlug()->getValue();
-		Imath::Box3f bound = scene->boundPlug()->getValue();
+	std::vector<float> times;
+	std::vector<ConstCompoundObjectPtr> attributes;
+	std::vector<ConstCompoundObjectPtr> globals;
+	std::vector<ConstObjectPtr> objects;
+	std::vector<Imath::Box3f> bounds;
+	std::vector<Imath::M44f> transforms;
+	SceneInterface::NameList sets;
 
-		IECore::M44dDataPtr transformData;
+};
+
+// Writes LocationData to file on a dedicated thread, allowing
+// the scene to be computed concurrently by all the TBB threads
+// rather than serialising them all on a single lock. The queue
+// is bounded so that computation can't run arbitrarily far ahead
+// of writing, holding the whole scene in memory. Since each location
+// may hold a sample for every frame, the bound is specified as a
+// number of samples, and divided between the frames.
+class LocationQueue
+{
 
-		if( scenePath.empty() )
+	public :
+
+		LocationQueue( SceneInterfacePtr output, size_t numFrames, size_t maxSamples = 10000 )
+			:	m_output( output )
 		{
-			globals = scene->globalsPlug()->getValue();
+			m_queue.set_capacity( std::max<size_t>( 1, maxSamples / std::max<size_t>( 1, numFrames ) ) );
+			m_thread = std::thread( boost::bind( &LocationQueue::writeLocations, this ) );
 		}
-		else
+
+		~LocationQueue()
 		{
-			Imath::M44f t = scene->transformPlug()->getValue();
-			transformData = new IECore::M44dData( Imath::M44d (
-				t[0][0], t[0][1], t[0][2], t[0][3],
-				t[1][0], t[1][1], t[1][2], t[1][3],
-				t[2][0], t[2][1], t[2][2], t[2][3],
-				t[3][0], t[3][1], t[3][2], t[3][3]
-			) );
+			if( m_thread.joinable() )
+			{
+				// Only reached if an exception prevented
+				// a call to finish().
+				m_queue.push( LocationData::Ptr() );
+				m_thread.join();
+			}
+		}
+
+		// May be called concurrently from any thread. Blocks
+		// if the queue is full.
+		void push( const LocationData::Ptr &location )
+		{
+			m_queue.push( location );
+		}
+
+		// Waits for all queued locations to be written, rethrowing
+		// any exception thrown during writing.
+		void finish()
+		{
+			m_queue.push( LocationData::Ptr() );
+			m_thread.join();
+			if( m_exception )
+			{
+				std::rethrow_exception( m_exception );
+			}
 		}
 
-		SceneInterface::NameList locationSets;
-		const CompoundDataMap &setsMap = m_sets->readable();
-		locationSets.reserve( setsMap.size() );
+	private :
+
+		void writeLocations()
+		{
+			LocationData::Ptr location;
+			while( true )
+			{
+				m_queue.pop( location );
+				if( !location )
+				{
+					return;
+				}
+
+				if( m_exception )
+				{
+					// Keep draining so that pushes don't block
+					// forever, but don't write anything more.
+					continue;
+				}
+
+				try
+				{
+					writeLocation( location.get() );
+				}
+				catch( ... )
+				{
+					m_exception = std::current_exception();
+				}
+			}
+		}
 
-		for( CompoundDataMap::const_iterator it = setsMap.begin(); it != setsMap.end(); ++it)
+		void writeLocation( LocationData *location )
 		{
-			ConstPathMatcherDataPtr pathMatcher = IECore::runTimeCast<PathMatcherData>( it->second );
+			const bool isRoot = !location->parent;
+			if( !isRoot )
+			{
+				location->output = location->parent->output->child( location->name, SceneInterface::CreateIfMissing );
+				// We no longer need our parent, and releasing it
+				// allows it to be freed as soon as its other
+				// children have been written.
+				location->parent = nullptr;
+			}
+			else
+			{
+				location->output = m_output;
+			}
+
+			SceneInterface *output = location->output.get();
+			const std::vector<float> &times = location->times;
+
+			for( size_t i = 0, e = location->attributes.size(); i < e; ++i )
+			{
+				const CompoundObject::ObjectMap &attributes = location->attributes[i]->members();
+				for( CompoundObject::ObjectMap::const_iterator it = attributes.begin(), eIt = attributes.end(); it != eIt; it++ )
+				{
+					output->writeAttribute( it->first, it->second.get(), times[i] );
+				}
+			}
+
+			for( size_t i = 0, e = location->globals.size(); i < e; ++i )
+			{
+				output->writeAttribute( "gaffer:globals", location->globals[i].get(), times[i] );
+			}
+
+			if( !isRoot )
+			{
+				for( size_t i = 0, e = location->objects.size(); i < e; ++i )
+				{
+					if( location->objects[i]->typeId() != IECore::NullObjectTypeId )
+					{
+						output->writeObject( location->objects[i].get(), times[i] );
+					}
+				}
+			}
 
-			if( pathMatcher->readable().match( scenePath ) & Filter::ExactMatch )
+			for( size_t i = 0, e = location->bounds.size(); i < e; ++i )
 			{
-				locationSets.push_back( it->first );
+				const Imath::Box3f &b = location->bounds[i];
+				output->writeBound( Imath::Box3d( Imath::V3f( b.min ), Imath::V3f( b.max ) ), times[i] );
 			}
+
+			for( size_t i = 0, e = location->transforms.size(); i < e; ++i )
+			{
+				const Imath::M44f &t = location->transforms[i];
+				M44dDataPtr transformData = new IECore::M44dData( Imath::M44d (
+					t[0][0], t[0][1], t[0][2], t[0][3],
+					t[1][0], t[1][1], t[1][2], t[1][3],
+					t[2][0], t[2][1], t[2][2], t[2][3],
+					t[3][0], t[3][1], t[3][2], t[3][3]
+				) );
+				output->writeTransform( transformData.get(), times[i] );
+			}
+
+			output->writeTags( location->sets );
+
+			// Release the data now it has been written. Only `output`
+			// is needed from here on, by our children.
+			location->attributes.clear();
+			location->globals.clear();
+			location->objects.clear();
+			location->bounds.clear();
+			location->transforms.clear();
 		}
 
-		tbb::mutex::scoped_lock scopedLock( m_mutex );
+		SceneInterfacePtr m_output;
+		tbb::concurrent_bounded_queue<LocationData::Ptr> m_queue;
+		std::exception_ptr m_exception;
+		std::thread m_thread;
+
+};
 
-		if( !scenePath.empty() )
+// Shared state for writing a sequence of frames.
+struct SequenceState
+{
+	const ScenePlug *scene;
+	// One per frame, in order of increasing time.
+	std::vector<ContextPtr> contexts;
+	std::vector<ConstCompoundDataPtr> sets;
+	LocationQueue *queue;
+};
+
+template<typename PlugType, typename ValueType>
+struct ComputeSamples
+{
+
+	ComputeSamples( const SequenceState &state, const ScenePlug::Location &location, const std::vector<size_t> &frames, const PlugType *plug, std::vector<ValueType> &samples )
+		:	m_state( state ), m_location( location ), m_frames( frames ), m_plug( plug ), m_samples( samples )
+	{
+	}
+
+	void operator()( const tbb::blocked_range<size_t> &r ) const
+	{
+		for( size_t i = r.begin(); i != r.end(); ++i )
 		{
-			m_output = m_output->child( scenePath.back(), SceneInterface::CreateIfMissing );
+			ScenePlug::PathScope scope( m_state.contexts[m_frames[i]].get(), m_location );
+			m_samples[i] = m_plug->getValue();
 		}
+	}
+
+	private :
 
-		for( CompoundObject::ObjectMap::const_iterator it = attributes->members().begin(), eIt = attributes->members().end(); it != eIt; it++ )
+		const SequenceState &m_state;
+		const ScenePlug::Location &m_location;
+		const std::vector<size_t> &m_frames;
+		const PlugType *m_plug;
+		std::vector<ValueType> &m_samples;
+
+};
+
+// Fills `samples` with the values of `plug` for each of the frames
+// where the location exists. If the hash is the same on all frames,
+// only a single sample is computed. Otherwise the frames are computed
+// in parallel. Returns true if the plug is static.
+template<typename PlugType, typename ValueType>
+bool computeSamples( const SequenceState &state, const ScenePlug::Location &location, const std::vector<size_t> &frames, const PlugType *plug, std::vector<ValueType> &samples )
+{
+	bool isStatic = true;
+	IECore::MurmurHash firstHash;
+	for( size_t i = 0, e = frames.size(); i < e && isStatic; ++i )
+	{
+		ScenePlug::PathScope scope( state.contexts[frames[i]].get(), location );
+		const IECore::MurmurHash h = plug->hash();
+		if( i == 0 )
 		{
-			m_output->writeAttribute( it->first, it->second.get(), m_time );
+			firstHash = h;
 		}
+		else if( h != firstHash )
+		{
+			isStatic = false;
+		}
+	}
 
-		if( globals )
+	samples.resize( isStatic ? 1 : frames.size() );
+	ComputeSamples<PlugType, ValueType> compute( state, location, frames, plug, samples );
+	tbb::parallel_for( tbb::blocked_range<size_t>( 0, samples.size() ), compute );
+
+	return isStatic;
+}
+
+// Returns the subset of `components` whose hashes vary across `frames`.
+// All components are hashed in a single scope per frame, and we stop
+// hashing a component as soon as it is known to vary.
+unsigned varyingComponents( const SequenceState &state, const ScenePlug::Location &location, const std::vector<size_t> &frames, unsigned components )
+{
+	if( frames.size() < 2 )
+	{
+		return ScenePlug::NoComponents;
+	}
+
+	const ScenePlug *scene = state.scene;
+	const ValuePlug *plugs[] = { scene->boundPlug(), scene->transformPlug(), scene->attributesPlug(), scene->objectPlug(), scene->childNamesPlug() };
+	const unsigned plugComponents[] = { ScenePlug::BoundComponent, ScenePlug::TransformComponent, ScenePlug::AttributesComponent, ScenePlug::ObjectComponent, ScenePlug::ChildNamesComponent };
+	const size_t numPlugs = sizeof( plugs ) / sizeof( plugs[0] );
+
+	unsigned result = ScenePlug::NoComponents;
+	IECore::MurmurHash firstHashes[numPlugs];
+	for( size_t i = 0, e = frames.size(); i < e; ++i )
+	{
+		const unsigned undecided = components & ~result;
+		if( !undecided )
 		{
-			m_output->writeAttribute( "gaffer:globals", globals.get(), m_time );
+			break;
 		}
 
-		if( object->typeId() != IECore::NullObjectTypeId && scenePath.size() > 0 )
+		ScenePlug::PathScope scope( state.contexts[frames[i]].get(), location );
+		for( size_t j = 0; j < numPlugs; ++j )
 		{
-			m_output->writeObject( object.get(), m_time );
+			if( !( undecided & plugComponents[j] ) )
+			{
+				continue;
+			}
+			const IECore::MurmurHash h = plugs[j]->hash();
+			if( i == 0 )
+			{
+				firstHashes[j] = h;
+			}
+			else if( h != firstHashes[j] )
+			{
+				result |= plugComponents[j];
+			}
 		}
+	}
 
-		m_output->writeBound( Imath::Box3d( Imath::V3f( bound.min ), Imath::V3f( bound.max ) ), m_time );
+	return result;
+}
+
+// Evaluates a LocationBundle per frame. The first frame evaluates
+// all components, and the others only the varying ones.
+struct ComputeBundles
+{
 
-		if( transformData )
+	ComputeBundles( const SequenceState &state, const ScenePlug::Location &location, const std::vector<size_t> &frames, unsigned components, unsigned varyingComponents, std::vector<ScenePlug::LocationBundle> &bundles )
+		:	m_state( state ), m_location( location ), m_frames( frames ), m_components( components ), m_varyingComponents( varyingComponents ), m_bundles( bundles )
+	{
+	}
+
+	void operator()( const tbb::blocked_range<size_t> &r ) const
+	{
+		for( size_t i = r.begin(); i != r.end(); ++i )
 		{
-			m_output->writeTransform( transformData.get(), m_time );
+			Context::Scope scope( m_state.contexts[m_frames[i]].get() );
+			m_state.scene->locationBundle( m_location, i == 0 ? m_components : m_varyingComponents, m_bundles[i] );
 		}
+	}
+
+	private :
+
+		const SequenceState &m_state;
+		const ScenePlug::Location &m_location;
+		const std::vector<size_t> &m_frames;
+		const unsigned m_components;
+		const unsigned m_varyingComponents;
+		std::vector<ScenePlug::LocationBundle> &m_bundles;
+
+};
+
+// Extracts the samples for one component from `bundles`, taking
+// just the first if the component is static.
+template<typename T>
+void gatherSamples( const std::vector<ScenePlug::LocationBundle> &bundles, bool varying, T ScenePlug::LocationBundle::*member, std::vector<T> &samples )
+{
+	samples.resize( varying ? bundles.size() : 1 );
+	for( size_t i = 0, e = samples.size(); i < e; ++i )
+	{
+		samples[i] = bundles[i].*member;
+	}
+}
 
-		m_output->writeTags( locationSets );
+void queueLocation( const SequenceState &state, const ScenePlug::Location &location, const std::vector<size_t> &frames, const LocationData::Ptr &parent );
+
+struct WriteChildren
+{
 
-		return true;
+	WriteChildren( const SequenceState &state, const ScenePlug::Location &parentLocation, const std::vector<InternedString> &childNames, const std::vector<std::vector<size_t> > &childFrames, const LocationData::Ptr &parent )
+		:	m_state( state ), m_parentLocation( parentLocation ), m_childNames( childNames ), m_childFrames( childFrames ), m_parent( parent )
+	{
 	}
 
-	SceneInterfacePtr m_output;
-	ConstCompoundDataPtr m_sets;
-	float m_time;
-	tbb::mutex &m_mutex;
+	void operator()( const tbb::blocked_range<size_t> &r ) const
+	{
+		for( size_t i = r.begin(); i != r.end(); ++i )
+		{
+			const ScenePlug::Location childLocation( m_parentLocation, m_childNames[i] );
+			queueLocation( m_state, childLocation, m_childFrames[i], m_parent );
+		}
+	}
+
+	private :
+
+		const SequenceState &m_state;
+		const ScenePlug::Location &m_parentLocation;
+		const std::vector<InternedString> &m_childNames;
+		const std::vector<std::vector<size_t> > &m_childFrames;
+		const LocationData::Ptr &m_parent;
+
 };
 
+// Computes the data for `location` on all the frames where it exists,
+// queues it to be written, and then recurses to the union of the children
+// on all those frames.
+void queueLocation( const SequenceState &state, const ScenePlug::Location &location, const std::vector<size_t> &frames, const LocationData::Ptr &parent )
+{
+	const ScenePlug::ScenePath &path = location.path();
+	const ScenePlug *scene = state.scene;
+
+	LocationData::Ptr locationData = new LocationData;
+	locationData->parent = parent;
+	if( path.size() )
+	{
+		locationData->name = path.back();
+	}
+
+	locationData->times.reserve( frames.size() );
+	for( std::vector<size_t>::const_iterator it = frames.begin(), eIt = frames.end(); it != eIt; ++it )
+	{
+		locationData->times.push_back( state.contexts[*it]->getTime() );
+
+		const CompoundDataMap &setsMap = state.sets[*it]->readable();
+		for( CompoundDataMap::const_iterator sIt = setsMap.begin(); sIt != setsMap.end(); ++sIt )
+		{
+			const PathMatcherData *pathMatcher = IECore::runTimeCast<const PathMatcherData>( sIt->second.get() );
+			if(
+				( pathMatcher->readable().match( path ) & Filter::ExactMatch ) &&
+				std::find( locationData->sets.begin(), locationData->sets.end(), sIt->first ) == locationData->sets.end()
+			)
+			{
+				locationData->sets.push_back( sIt->first );
+			}
+		}
+	}
+
+	// Evaluate all the components we need for each frame in a single
+	// bundle, rather than one plug at a time. When writing a single
+	// frame, there is no need to hash anything in advance.
+
+	unsigned components = ScenePlug::BoundComponent | ScenePlug::AttributesComponent | ScenePlug::ObjectComponent | ScenePlug::ChildNamesComponent;
+	if( path.size() )
+	{
+		components |= ScenePlug::TransformComponent;
+	}
+
+	const unsigned varying = varyingComponents( state, location, frames, components );
+	std::vector<ScenePlug::LocationBundle> bundles( varying ? frames.size() : 1 );
+	ComputeBundles computeBundles( state, location, frames, components, varying, bundles );
+	tbb::parallel_for( tbb::blocked_range<size_t>( 0, bundles.size() ), computeBundles );
+
+	gatherSamples( bundles, varying & ScenePlug::AttributesComponent, &ScenePlug::LocationBundle::attributes, locationData->attributes );
+	gatherSamples( bundles, varying & ScenePlug::ObjectComponent, &ScenePlug::LocationBundle::object, locationData->objects );
+	gatherSamples( bundles, varying & ScenePlug::BoundComponent, &ScenePlug::LocationBundle::bound, locationData->bounds );
+	if( path.empty() )
+	{
+		computeSamples( state, location, frames, scene->globalsPlug(), locationData->globals );
+	}
+	else
+	{
+		gatherSamples( bundles, varying & ScenePlug::TransformComponent, &ScenePlug::LocationBundle::transform, locationData->transforms );
+	}
+
+	std::vector<ConstInternedStringVectorDataPtr> childNamesSamples;
+	gatherSamples( bundles, varying & ScenePlug::ChildNamesComponent, &ScenePlug::LocationBundle::childNames, childNamesSamples );
+	const bool childNamesStatic = !( varying & ScenePlug::ChildNamesComponent );
+
+	state.queue->push( locationData );
+
+	// Gather the union of the child names, and the frames on
+	// which each child exists.
+
+	std::vector<InternedString> childNames;
+	std::vector<std::vector<size_t> > childFrames;
+	if( childNamesStatic )
+	{
+		childNames = childNamesSamples[0]->readable();
+		childFrames.resize( childNames.size(), frames );
+	}
+	else
+	{
+		for( size_t i = 0, e = frames.size(); i < e; ++i )
+		{
+			const std::vector<InternedString> &frameChildNames = childNamesSamples[i]->readable();
+			for( std::vector<InternedString>::const_iterator it = frameChildNames.begin(), eIt = frameChildNames.end(); it != eIt; ++it )
+			{
+				const size_t childIndex = std::find( childNames.begin(), childNames.end(), *it ) - childNames.begin();
+				if( childIndex == childNames.size() )
+				{
+					childNames.push_back( *it );
+					childFrames.push_back( std::vector<size_t>() );
+				}
+				childFrames[childIndex].push_back( frames[i] );
+			}
+		}
+	}
+
+	WriteChildren writeChildren( state, location, childNames, childFrames, locationData );
+	tbb::parallel_for( tbb::blocked_range<size_t>( 0, childNames.size() ), writeChildren );
 }
 
+} // namespace
+
 IE_CORE_DEFINERUNTIMETYPED( SceneWriter );
 
 size_t SceneWriter::g_firstPlugIndex = 0;
@@ -229,19 +617,40 @@ void SceneWriter::executeSequence( const std::vector<float> &frames ) const
 	const std::string fileName = fileNamePlug()->getValue();
 	createDirectories( fileName );
 	SceneInterfacePtr output = SceneInterface::create( fileName, IndexedIO::Write );
-	tbb::mutex mutex;
-	ContextPtr context = new Context( *Context::current() );
-	Context::Scope scopedContext( context.get() );
 
-	for( std::vector<float>::const_iterator it = frames.begin(); it != frames.end(); ++it )
+	// Rather than traversing the scene once per frame, we traverse
+	// it once, computing all frames for each location. This lets us
+	// detect static data via the hashes, computing and writing it only
+	// once, and lets us write the samples for each location in order.
+
+	std::vector<float> sortedFrames( frames );
+	std::sort( sortedFrames.begin(), sortedFrames.end() );
+	sortedFrames.erase( std::unique( sortedFrames.begin(), sortedFrames.end() ), sortedFrames.end() );
+
+	LocationQueue queue( output, sortedFrames.size() );
+
+	SequenceState state;
+	state.scene = scene;
+	state.queue = &queue;
+	for( std::vector<float>::const_iterator it = sortedFrames.begin(); it != sortedFrames.end(); ++it )
 	{
+		ContextPtr context = new Context( *Context::current() );
 		context->setFrame( *it );
+		state.contexts.push_back( context );
 
-		ConstCompoundDataPtr sets = SceneAlgo::sets( scene );
-		LocationWriter locationWriter( output, sets, context->getTime(), mutex );
+		Context::Scope scopedContext( context.get() );
+		state.sets.push_back( SceneAlgo::sets( scene ) );
+	}
 
-		SceneAlgo::parallelProcessLocations( scene, locationWriter );
+	std::vector<size_t> allFrames( sortedFrames.size() );
+	for( size_t i = 0; i < allFrames.size(); ++i )
+	{
+		allFrames[i] = i;
 	}
+
+	queueLocation( state, ScenePlug::Location(), allFrames, LocationData::Ptr() );
+
+	queue.finish();
 }
 
 bool SceneWriter::requiresSequenceExecution() const
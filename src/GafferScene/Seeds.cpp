@@ -40,6 +40,7 @@
 #include "Gaffer/StringPlug.h"
 
 #include "GafferScene/Seeds.h"
+#include "GafferScene/Private/IECoreScenePreview/MeshAlgo.h"
 
 using namespace std;
 using namespace Imath;
@@ -59,6 +60,7 @@ Seeds::Seeds( const std::string &name )
 	addChild( new FloatPlug( "density", Plug::In, 1.0f, 0.0f ) );
 	addChild( new StringPlug( "densityPrimitiveVariable" ) );
 	addChild( new StringPlug( "pointType", Plug::In, "gl:point" ) );
+	addChild( new BoolPlug( "parallel", Plug::In, false ) );
 }
 
 Seeds::~Seeds()
@@ -105,11 +107,21 @@ const Gaffer::StringPlug *Seeds::pointTypePlug() const
 	return getChild<StringPlug>( g_firstPlugIndex + 3 );
 }
 
+Gaffer::BoolPlug *Seeds::parallelPlug()
+{
+	return getChild<BoolPlug>( g_firstPlugIndex + 4 );
+}
+
+const Gaffer::BoolPlug *Seeds::parallelPlug() const
+{
+	return getChild<BoolPlug>( g_firstPlugIndex + 4 );
+}
+
 void Seeds::affects( const Plug *input, AffectedPlugsContainer &outputs ) const
 {
 	BranchCreator::affects( input, outputs );
 
-	if( input == densityPlug() || input == densityPrimitiveVariablePlug() || input == pointTypePlug() )
+	if( input == densityPlug() || input == densityPrimitiveVariablePlug() || input == pointTypePlug() || input == parallelPlug() )
 	{
 		outputs.push_back( outPlug()->objectPlug() );
 	}
@@ -167,6 +179,7 @@ void Seeds::hashBranchObject( const ScenePath &parentPath, const ScenePath &bran
 		densityPlug()->hash( h );
 		densityPrimitiveVariablePlug()->hash( h );
 		pointTypePlug()->hash( h );
+		parallelPlug()->hash( h );
 		return;
 	}
 
@@ -184,12 +197,25 @@ IECore::ConstObjectPtr Seeds::computeBranchObject( const ScenePath &parentPath,
 			return outPlug()->objectPlug()->defaultValue();
 		}
 
-		PointsPrimitivePtr result = MeshAlgo::distributePoints(
-			mesh.get(),
-			densityPlug()->getValue(),
-			V2f( 0 ),
-			densityPrimitiveVariablePlug()->getValue()
-		);
+		PointsPrimitivePtr result;
+		if( parallelPlug()->getValue() )
+		{
+			result = IECoreScenePreview::MeshAlgo::distributePoints(
+				mesh.get(),
+				densityPlug()->getValue(),
+				V2f( 0 ),
+				densityPrimitiveVariablePlug()->getValue()
+			);
+		}
+		else
+		{
+			result = MeshAlgo::distributePoints(
+				mesh.get(),
+				densityPlug()->getValue(),
+				V2f( 0 ),
+				densityPrimitiveVariablePlug()->getValue()
+			);
+		}
 		result->variables["type"] = PrimitiveVariable( PrimitiveVariable::Constant, new StringData( pointTypePlug()->getValue() ) );
 
 		return result;
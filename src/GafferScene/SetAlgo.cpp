@@ -49,8 +49,12 @@
 
 #include "GafferScene/SetAlgo.h"
 
+#include "Gaffer/Context.h"
+
 #include "IECore/MessageHandler.h"
 
+#include "tbb/parallel_invoke.h"
+
 using namespace Gaffer;
 using namespace GafferScene;
 
@@ -220,6 +224,7 @@ struct AstEvaluator
 	AstEvaluator( const ScenePlug *scene )
 	{
 		m_scene = scene;
+		m_context = Context::current();
 	}
 
 	result_type operator()( const SetName &set ) const
@@ -247,8 +252,22 @@ struct AstEvaluator
 
 	result_type operator()( const BinaryOp &expr ) const
 	{
-		PathMatcher left = boost::apply_visitor( *this, expr.left.expr );
-		PathMatcher right = boost::apply_visitor( *this, expr.right.expr );
+		PathMatcher left;
+		PathMatcher right;
+		if( trivial( expr.left ) || trivial( expr.right ) )
+		{
+			left = boost::apply_visitor( *this, expr.left.expr );
+			right = boost::apply_visitor( *this, expr.right.expr );
+		}
+		else
+		{
+			// Both operands require sets to be computed, and
+			// are independent, so we evaluate them concurrently.
+			tbb::parallel_invoke(
+				OperandEvaluator( *this, expr.left, left ),
+				OperandEvaluator( *this, expr.right, right )
+			);
+		}
 
 		switch( expr.op )
 		{
@@ -273,7 +292,35 @@ struct AstEvaluator
 		}
 	}
 
+	// Returns true if the expression can be evaluated
+	// without computing any sets.
+	static bool trivial( const ExpressionAst &ast )
+	{
+		return boost::get<Nil>( &ast.expr ) || boost::get<ObjectName>( &ast.expr );
+	}
+
+	struct OperandEvaluator
+	{
+
+		OperandEvaluator( const AstEvaluator &evaluator, const ExpressionAst &operand, PathMatcher &result )
+			:	m_evaluator( evaluator ), m_operand( operand ), m_result( result )
+		{
+		}
+
+		void operator()() const
+		{
+			Context::Scope scopedContext( m_evaluator.m_context );
+			m_result = boost::apply_visitor( m_evaluator, m_operand.expr );
+		}
+
+		const AstEvaluator &m_evaluator;
+		const ExpressionAst &m_operand;
+		PathMatcher &m_result;
+
+	};
+
 	const ScenePlug *m_scene;
+	const Context *m_context;
 
 };
 
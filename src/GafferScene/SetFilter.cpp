@@ -96,6 +96,7 @@ void SetFilter::affects( const Gaffer::Plug *input, AffectedPlugsContainer &outp
 	if( input == expressionResultPlug() )
 	{
 		outputs.push_back( outPlug() );
+		outputs.push_back( matchingPathsPlug() );
 	}
 
 }
@@ -110,6 +111,11 @@ bool SetFilter::sceneAffectsMatch( const ScenePlug *scene, const Gaffer::ValuePl
 	return child == scene->setPlug();
 }
 
+bool SetFilter::canComputeMatchingPaths() const
+{
+	return true;
+}
+
 void SetFilter::hash( const Gaffer::ValuePlug *output, const Gaffer::Context *context, IECore::MurmurHash &h ) const
 {
 	Filter::hash( output, context, h );
@@ -180,3 +186,23 @@ unsigned SetFilter::computeMatch( const ScenePlug *scene, const Gaffer::Context
 
 	return set->readable().match( path );
 }
+
+void SetFilter::hashMatchingPaths( const ScenePlug *scene, const Gaffer::Context *context, IECore::MurmurHash &h ) const
+{
+	if( !scene )
+	{
+		return;
+	}
+
+	expressionResultPlug()->hash( h );
+}
+
+ConstPathMatcherDataPtr SetFilter::computeMatchingPaths( const ScenePlug *scene, const Gaffer::Context *context ) const
+{
+	if( !scene )
+	{
+		return matchingPathsPlug()->defaultValue();
+	}
+
+	return expressionResultPlug()->getValue();
+}
@@ -60,9 +60,27 @@ void UnionFilter::affects( const Gaffer::Plug *input, AffectedPlugsContainer &ou
 	if( input->parent<ArrayPlug>() == inPlugs() )
 	{
 		outputs.push_back( outPlug() );
+		outputs.push_back( matchingPathsPlug() );
 	}
 }
 
+bool UnionFilter::canComputeMatchingPaths() const
+{
+	for( InputIntPlugIterator it( inPlugs() ); !it.done(); ++it )
+	{
+		if( !(*it)->getInput() && (*it)->getValue() == NoMatch )
+		{
+			// Unconnected inputs contribute nothing to the union.
+			continue;
+		}
+		if( !matchingPathsFilter( it->get() ) )
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
 void UnionFilter::hashMatch( const ScenePlug *scene, const Gaffer::Context *context, IECore::MurmurHash &h ) const
 {
 	for( InputIntPlugIterator it( inPlugs() ); !it.done(); ++it )
@@ -80,3 +98,28 @@ unsigned UnionFilter::computeMatch( const ScenePlug *scene, const Gaffer::Contex
 	}
 	return result;
 }
+
+void UnionFilter::hashMatchingPaths( const ScenePlug *scene, const Gaffer::Context *context, IECore::MurmurHash &h ) const
+{
+	for( InputIntPlugIterator it( inPlugs() ); !it.done(); ++it )
+	{
+		if( const Filter *filter = matchingPathsFilter( it->get() ) )
+		{
+			filter->matchingPathsPlug()->hash( h );
+		}
+	}
+}
+
+ConstPathMatcherDataPtr UnionFilter::computeMatchingPaths( const ScenePlug *scene, const Gaffer::Context *context ) const
+{
+	PathMatcherDataPtr result = new PathMatcherData;
+	for( InputIntPlugIterator it( inPlugs() ); !it.done(); ++it )
+	{
+		if( const Filter *filter = matchingPathsFilter( it->get() ) )
+		{
+			ConstPathMatcherDataPtr matchingPaths = filter->matchingPathsPlug()->getValue();
+			result->writable().addPaths( matchingPaths->readable() );
+		}
+	}
+	return result;
+}
@@ -173,6 +173,58 @@ IECore::CompoundObjectPtr fullAttributesWrapper( const ScenePlug &plug, const Sc
 	return plug.fullAttributes( scenePath );
 }
 
+boost::python::dict locationBundleToDict( const ScenePlug::LocationBundle &bundle, unsigned components, bool copy )
+{
+	boost::python::dict result;
+	if( components & ScenePlug::BoundComponent )
+	{
+		result["bound"] = bundle.bound;
+	}
+	if( components & ScenePlug::TransformComponent )
+	{
+		result["transform"] = bundle.transform;
+	}
+	if( components & ScenePlug::AttributesComponent )
+	{
+		result["attributes"] = copy ? bundle.attributes->copy() : boost::const_pointer_cast<IECore::CompoundObject>( bundle.attributes );
+	}
+	if( components & ScenePlug::ObjectComponent )
+	{
+		result["object"] = copy ? bundle.object->copy() : boost::const_pointer_cast<IECore::Object>( bundle.object );
+	}
+	if( components & ScenePlug::ChildNamesComponent )
+	{
+		result["childNames"] = copy ? bundle.childNames->copy() : boost::const_pointer_cast<IECore::InternedStringVectorData>( bundle.childNames );
+	}
+	return result;
+}
+
+boost::python::dict locationBundleWrapper( const ScenePlug &plug, const ScenePlug::ScenePath &scenePath, unsigned components, bool copy )
+{
+	ScenePlug::LocationBundle bundle;
+	{
+		IECorePython::ScopedGILRelease gilRelease;
+		plug.locationBundle( scenePath, components, bundle );
+	}
+	return locationBundleToDict( bundle, components, copy );
+}
+
+boost::python::list childLocationBundlesWrapper( const ScenePlug &plug, const ScenePlug::ScenePath &scenePath, unsigned components, bool copy )
+{
+	std::vector<ScenePlug::LocationBundle> bundles;
+	{
+		IECorePython::ScopedGILRelease gilRelease;
+		plug.childLocationBundles( scenePath, components, bundles );
+	}
+
+	boost::python::list result;
+	for( std::vector<ScenePlug::LocationBundle>::const_iterator it = bundles.begin(), eIt = bundles.end(); it != eIt; ++it )
+	{
+		result.append( locationBundleToDict( *it, components, copy ) );
+	}
+	return result;
+}
+
 IECore::CompoundObjectPtr globalsWrapper( const ScenePlug &plug, bool copy )
 {
 	IECorePython::ScopedGILRelease gilRelease;
@@ -273,43 +325,57 @@ std::string pathToStringWrapper( const ScenePlug::ScenePath &scenePath )
 void GafferSceneModule::bindCore()
 {
 
-	PlugClass<ScenePlug>()
-		.def( init<const std::string &, Plug::Direction, unsigned>(
-				(
-					arg( "name" ) = Gaffer::GraphComponent::defaultName<ScenePlug>(),
-					arg( "direction" ) = Gaffer::Plug::In,
-					arg( "flags" ) = Gaffer::Plug::Default
+	{
+		scope s = PlugClass<ScenePlug>()
+			.def( init<const std::string &, Plug::Direction, unsigned>(
+					(
+						arg( "name" ) = Gaffer::GraphComponent::defaultName<ScenePlug>(),
+						arg( "direction" ) = Gaffer::Plug::In,
+						arg( "flags" ) = Gaffer::Plug::Default
+					)
 				)
 			)
-		)
-		// value accessors
-		.def( "bound", &boundWrapper )
-		.def( "transform", &transformWrapper )
-		.def( "fullTransform", &fullTransformWrapper )
-		.def( "object", &objectWrapper, ( boost::python::arg_( "_copy" ) = true ) )
-		.def( "childNames", &childNamesWrapper, ( boost::python::arg_( "_copy" ) = true ) )
-		.def( "attributes", &attributesWrapper, ( boost::python::arg_( "_copy" ) = true ) )
-		.def( "fullAttributes", &fullAttributesWrapper )
-		.def( "globals", &globalsWrapper, ( boost::python::arg_( "_copy" ) = true ) )
-		.def( "setNames", &setNamesWrapper, ( boost::python::arg_( "_copy" ) = true ) )
-		.def( "set", &setWrapper, ( boost::python::arg_( "_copy" ) = true ) )
-		// hash accessors
-		.def( "boundHash", &boundHashWrapper )
-		.def( "transformHash", &transformHashWrapper )
-		.def( "fullTransformHash", &fullTransformHashWrapper )
-		.def( "objectHash", &objectHashWrapper )
-		.def( "childNamesHash", &childNamesHashWrapper )
-		.def( "attributesHash", &attributesHashWrapper )
-		.def( "fullAttributesHash", &fullAttributesHashWrapper )
-		.def( "globalsHash", &globalsHashWrapper )
-		.def( "setNamesHash", &setNamesHashWrapper )
-		.def( "setHash", &setHashWrapper )
-		// string utilities
-		.def( "stringToPath", &stringToPathWrapper )
-		.staticmethod( "stringToPath" )
-		.def( "pathToString", &pathToStringWrapper )
-		.staticmethod( "pathToString" )
-	;
+			// value accessors
+			.def( "bound", &boundWrapper )
+			.def( "transform", &transformWrapper )
+			.def( "fullTransform", &fullTransformWrapper )
+			.def( "object", &objectWrapper, ( boost::python::arg_( "_copy" ) = true ) )
+			.def( "childNames", &childNamesWrapper, ( boost::python::arg_( "_copy" ) = true ) )
+			.def( "attributes", &attributesWrapper, ( boost::python::arg_( "_copy" ) = true ) )
+			.def( "fullAttributes", &fullAttributesWrapper )
+			.def( "globals", &globalsWrapper, ( boost::python::arg_( "_copy" ) = true ) )
+			.def( "setNames", &setNamesWrapper, ( boost::python::arg_( "_copy" ) = true ) )
+			.def( "set", &setWrapper, ( boost::python::arg_( "_copy" ) = true ) )
+			// batched queries
+			.def( "locationBundle", &locationBundleWrapper, ( boost::python::arg_( "scenePath" ), boost::python::arg_( "components" ) = (unsigned)ScenePlug::AllComponents, boost::python::arg_( "_copy" ) = true ) )
+			.def( "childLocationBundles", &childLocationBundlesWrapper, ( boost::python::arg_( "scenePath" ), boost::python::arg_( "components" ) = (unsigned)ScenePlug::AllComponents, boost::python::arg_( "_copy" ) = true ) )
+			// hash accessors
+			.def( "boundHash", &boundHashWrapper )
+			.def( "transformHash", &transformHashWrapper )
+			.def( "fullTransformHash", &fullTransformHashWrapper )
+			.def( "objectHash", &objectHashWrapper )
+			.def( "childNamesHash", &childNamesHashWrapper )
+			.def( "attributesHash", &attributesHashWrapper )
+			.def( "fullAttributesHash", &fullAttributesHashWrapper )
+			.def( "globalsHash", &globalsHashWrapper )
+			.def( "setNamesHash", &setNamesHashWrapper )
+			.def( "setHash", &setHashWrapper )
+			// string utilities
+			.def( "stringToPath", &stringToPathWrapper )
+			.staticmethod( "stringToPath" )
+			.def( "pathToString", &pathToStringWrapper )
+			.staticmethod( "pathToString" )
+		;
+
+		enum_<ScenePlug::LocationComponents>( "LocationComponents" )
+			.value( "Bound", ScenePlug::BoundComponent )
+			.value( "Transform", ScenePlug::TransformComponent )
+			.value( "Attributes", ScenePlug::AttributesComponent )
+			.value( "Object", ScenePlug::ObjectComponent )
+			.value( "ChildNames", ScenePlug::ChildNamesComponent )
+			.value( "All", ScenePlug::AllComponents )
+		;
+	}
 
 	ScenePathFromInternedStringVectorData();
 	ScenePathFromString();
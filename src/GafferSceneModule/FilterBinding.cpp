@@ -64,6 +64,11 @@ ScenePlugPtr getInputScene( const Gaffer::Context *context )
 	return const_cast<ScenePlug *>( Filter::getInputScene( context ) );
 }
 
+FilterPtr matchingPathsFilter( const Gaffer::Plug *filterPlug )
+{
+	return const_cast<Filter *>( Filter::matchingPathsFilter( filterPlug ) );
+}
+
 } // namespace
 
 void GafferSceneModule::bindFilter()
@@ -75,6 +80,9 @@ void GafferSceneModule::bindFilter()
 			.staticmethod( "setInputScene" )
 			.def( "getInputScene", &getInputScene )
 			.staticmethod( "getInputScene" )
+			.def( "canComputeMatchingPaths", &Filter::canComputeMatchingPaths )
+			.def( "matchingPathsFilter", &matchingPathsFilter )
+			.staticmethod( "matchingPathsFilter" )
 		;
 
 		enum_<Filter::Result>( "Result" )
@@ -96,6 +96,14 @@ void GafferSceneModule::bindHierarchy()
 		.def( "scene", &scene )
 		.def( "root", &root )
 		.def( "context", &context )
+		.def( "getExpansionCacheMemoryLimit", &Capsule::getExpansionCacheMemoryLimit )
+		.staticmethod( "getExpansionCacheMemoryLimit" )
+		.def( "setExpansionCacheMemoryLimit", &Capsule::setExpansionCacheMemoryLimit )
+		.staticmethod( "setExpansionCacheMemoryLimit" )
+		.def( "expansionCacheMemoryUsage", &Capsule::expansionCacheMemoryUsage )
+		.staticmethod( "expansionCacheMemoryUsage" )
+		.def( "clearExpansionCache", &Capsule::clearExpansionCache )
+		.staticmethod( "clearExpansionCache" )
 	;
 
 	GafferBindings::DependencyNodeClass<Group>()
@@ -36,12 +36,18 @@
 
 #include "boost/python.hpp"
 
+#include "IECore/SampledSceneInterface.h"
+
+#include "IECorePython/ScopedGILRelease.h"
+
 #include "GafferBindings/DependencyNodeBinding.h"
 #include "GafferDispatchBindings/TaskNodeBinding.h"
 
 #include "GafferScene/SceneReader.h"
 #include "GafferScene/SceneWriter.h"
 #include "GafferScene/AlembicSource.h"
+#include "GafferScene/MappedSceneReader.h"
+#include "GafferScene/MappedSceneWriter.h"
 
 #include "IOBinding.h"
 
@@ -64,6 +70,33 @@ boost::python::list supportedExtensions()
 	return result;
 }
 
+// The cached scene is shared by all SceneReaders, so we don't expose
+// it to Python directly, where its constness couldn't be enforced.
+// Instead we bind the read-only queries needed by the UI.
+boost::python::list cachedSceneBoundSampleTimes( const std::string &fileName )
+{
+	std::vector<double> times;
+	{
+		IECorePython::ScopedGILRelease gilRelease;
+		IECore::ConstSceneInterfacePtr scene = SceneReader::cachedScene( fileName );
+		if( const IECore::SampledSceneInterface *sampledScene = IECore::runTimeCast<const IECore::SampledSceneInterface>( scene.get() ) )
+		{
+			for( size_t i = 0, e = sampledScene->numBoundSamples(); i < e; ++i )
+			{
+				times.push_back( sampledScene->boundSampleTime( i ) );
+			}
+		}
+	}
+
+	boost::python::list result;
+	for( std::vector<double>::const_iterator it = times.begin(), eIt = times.end(); it != eIt; ++it )
+	{
+		result.append( *it );
+	}
+
+	return result;
+}
+
 } // namespace
 
 void GafferSceneModule::bindIO()
@@ -72,10 +105,15 @@ void GafferSceneModule::bindIO()
 	GafferBindings::DependencyNodeClass<SceneReader>()
 		.def( "supportedExtensions", &supportedExtensions )
 		.staticmethod( "supportedExtensions" )
+		.def( "cachedSceneBoundSampleTimes", &cachedSceneBoundSampleTimes )
+		.staticmethod( "cachedSceneBoundSampleTimes" )
 	;
 
 	GafferDispatchBindings::TaskNodeClass<SceneWriter>();
 
 	GafferBindings::DependencyNodeClass<AlembicSource>();
 
+	GafferBindings::DependencyNodeClass<MappedSceneReader>();
+	GafferDispatchBindings::TaskNodeClass<MappedSceneWriter>();
+
 }
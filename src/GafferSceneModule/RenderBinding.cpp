@@ -95,6 +95,17 @@ IECoreScenePreview::Renderer::ObjectInterfacePtr rendererObject2( Renderer &rend
 	return renderer.object( name, samples, times, attributes );
 }
 
+Renderer::PrototypePtr prototypeConstructor( const IECore::MurmurHash &hash, object pythonSamples, object pythonTimes )
+{
+	std::vector<const IECore::Object *> samples;
+	container_utils::extend_container( samples, pythonSamples );
+
+	std::vector<float> times;
+	container_utils::extend_container( times, pythonTimes );
+
+	return new Renderer::Prototype( hash, samples, times );
+}
+
 void objectInterfaceTransform1( Renderer::ObjectInterface &objectInterface, const Imath::M44f &transform )
 {
 	objectInterface.transform( transform );
@@ -206,6 +217,12 @@ void GafferSceneModule::bindRender()
 				.def( "transform", objectInterfaceTransform2 )
 				.def( "attributes", &Renderer::ObjectInterface::attributes )
 			;
+
+			IECorePython::RefCountedClass<Renderer::Prototype, IECore::RefCounted>( "Prototype" )
+				.def( init<const IECore::MurmurHash &, const IECore::Object *>() )
+				.def( "__init__", make_constructor( prototypeConstructor ) )
+				.def( "hash", &Renderer::Prototype::hash, return_value_policy<copy_const_reference>() )
+			;
 		}
 
 		renderer
@@ -225,6 +242,7 @@ void GafferSceneModule::bindRender()
 
 			.def( "object", &rendererObject1 )
 			.def( "object", &rendererObject2 )
+			.def( "instance", &Renderer::instance )
 
 			.def( "render", &Renderer::render )
 			.def( "pause", &Renderer::pause )
@@ -37,6 +37,7 @@
 #include "boost/python.hpp"
 
 #include "IECorePython/ScopedGILLock.h"
+#include "IECorePython/ScopedGILRelease.h"
 
 #include "GafferScene/RendererAlgo.h"
 #include "GafferScene/SceneProcessor.h"
@@ -75,6 +76,19 @@ void registerAdaptorWrapper( const std::string &name, object adaptor )
 	RendererAlgo::registerAdaptor( name, AdaptorWrapper( adaptor ) );
 }
 
+unsigned renderSetsUpdateWrapper( RendererAlgo::RenderSets &renderSets, const ScenePlug *scene )
+{
+	IECorePython::ScopedGILRelease gilRelease;
+	return renderSets.update( scene );
+}
+
+IECore::InternedStringVectorDataPtr renderSetsSetsAttributeWrapper( const RendererAlgo::RenderSets &renderSets, const std::string &path )
+{
+	ScenePlug::ScenePath p;
+	ScenePlug::stringToPath( path, p );
+	return renderSets.setsAttribute( p )->copy();
+}
+
 } // namespace
 
 namespace GafferSceneModule
@@ -87,6 +101,23 @@ void bindRendererAlgo()
 	def( "deregisterAdaptor", &RendererAlgo::deregisterAdaptor );
 	def( "createAdaptors", &RendererAlgo::createAdaptors );
 
+	{
+		scope s = class_<RendererAlgo::RenderSets, boost::noncopyable>( "RenderSets" )
+			.def( "update", &renderSetsUpdateWrapper )
+			.def( "clear", &RendererAlgo::RenderSets::clear )
+			.def( "camerasSet", &RendererAlgo::RenderSets::camerasSet, return_value_policy<copy_const_reference>() )
+			.def( "lightsSet", &RendererAlgo::RenderSets::lightsSet, return_value_policy<copy_const_reference>() )
+			.def( "setsAttribute", &renderSetsSetsAttributeWrapper )
+		;
+
+		enum_<RendererAlgo::RenderSets::Changed>( "Changed" )
+			.value( "NothingChanged", RendererAlgo::RenderSets::NothingChanged )
+			.value( "CamerasSetChanged", RendererAlgo::RenderSets::CamerasSetChanged )
+			.value( "LightsSetChanged", RendererAlgo::RenderSets::LightsSetChanged )
+			.value( "RenderSetsChanged", RendererAlgo::RenderSets::RenderSetsChanged )
+		;
+	}
+
 }
 
 } // namespace GafferSceneModule
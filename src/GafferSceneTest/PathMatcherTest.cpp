@@ -40,6 +40,7 @@
 
 #include "GafferScene/PathMatcher.h"
 #include "GafferScene/ScenePlug.h"
+#include "GafferScene/Filter.h"
 
 #include "GafferSceneTest/PathMatcherTest.h"
 
@@ -48,6 +49,58 @@ using namespace boost;
 using namespace IECore;
 using namespace GafferScene;
 
+namespace
+{
+
+typedef vector<InternedString> Path;
+typedef vector<Path> Paths;
+
+// Appends paths for all the leaves of a hierarchy with the
+// specified depth and number of children at each branch.
+void leafPaths( size_t depth, size_t breadth, Paths &paths, Path &prefix )
+{
+	if( prefix.size() == depth )
+	{
+		paths.push_back( prefix );
+		return;
+	}
+
+	prefix.push_back( InternedString() );
+	for( size_t i = 0; i < breadth; ++i )
+	{
+		prefix.back() = InternedString( i );
+		leafPaths( depth, breadth, paths, prefix );
+	}
+	prefix.pop_back();
+}
+
+// Paths for a few typical hierarchies :
+//
+// - A very wide one, like the output of an Instancer.
+// - A deep one with moderate branching, like a typical asset.
+// - A deeper one with minimal branching.
+vector<Paths> benchmarkPaths()
+{
+	vector<Paths> result( 3 );
+	Path prefix;
+	leafPaths( 1, 1000000, result[0], prefix );
+	leafPaths( 6, 8, result[1], prefix );
+	leafPaths( 17, 2, result[2], prefix );
+	return result;
+}
+
+PathMatcher matcher( Paths::const_iterator begin, Paths::const_iterator end )
+{
+	PathMatcher result;
+	for( Paths::const_iterator it = begin; it != end; ++it )
+	{
+		result.addPath( *it );
+	}
+	return result;
+}
+
+} // namespace
+
 void GafferSceneTest::testPathMatcherRawIterator()
 {
 	vector<InternedString> root;
@@ -159,3 +212,70 @@ void GafferSceneTest::testPathMatcherFind()
 	GAFFERTEST_ASSERT( it == m.end() );
 
 }
+
+void GafferSceneTest::testPathMatcherAddPerformance()
+{
+	const vector<Paths> paths = benchmarkPaths();
+	for( vector<Paths>::const_iterator it = paths.begin(), eIt = paths.end(); it != eIt; ++it )
+	{
+		PathMatcher m;
+		for( Paths::const_iterator pIt = it->begin(), pEIt = it->end(); pIt != pEIt; ++pIt )
+		{
+			GAFFERTEST_ASSERT( m.addPath( *pIt ) );
+		}
+	}
+}
+
+void GafferSceneTest::testPathMatcherMatchPerformance()
+{
+	const vector<Paths> paths = benchmarkPaths();
+	for( vector<Paths>::const_iterator it = paths.begin(), eIt = paths.end(); it != eIt; ++it )
+	{
+		const PathMatcher m = matcher( it->begin(), it->end() );
+		for( Paths::const_iterator pIt = it->begin(), pEIt = it->end(); pIt != pEIt; ++pIt )
+		{
+			GAFFERTEST_ASSERT( m.match( *pIt ) & Filter::ExactMatch );
+		}
+	}
+}
+
+void GafferSceneTest::testPathMatcherIteratorPerformance()
+{
+	const vector<Paths> paths = benchmarkPaths();
+	for( vector<Paths>::const_iterator it = paths.begin(), eIt = paths.end(); it != eIt; ++it )
+	{
+		const PathMatcher m = matcher( it->begin(), it->end() );
+		size_t numPaths = 0;
+		for( PathMatcher::Iterator mIt = m.begin(), mEIt = m.end(); mIt != mEIt; ++mIt )
+		{
+			numPaths++;
+		}
+		GAFFERTEST_ASSERT( numPaths == it->size() );
+	}
+}
+
+void GafferSceneTest::testPathMatcherAddPathsPerformance()
+{
+	const vector<Paths> paths = benchmarkPaths();
+	for( vector<Paths>::const_iterator it = paths.begin(), eIt = paths.end(); it != eIt; ++it )
+	{
+		// Two interleaved halves of the hierarchy, so
+		// that addPaths() has to merge every branch.
+		Paths evenPaths, oddPaths;
+		for( size_t i = 0; i < it->size(); ++i )
+		{
+			( i % 2 ? oddPaths : evenPaths ).push_back( (*it)[i] );
+		}
+
+		const PathMatcher even = matcher( evenPaths.begin(), evenPaths.end() );
+		const PathMatcher odd = matcher( oddPaths.begin(), oddPaths.end() );
+
+		PathMatcher m = even;
+		GAFFERTEST_ASSERT( m.addPaths( odd ) );
+		GAFFERTEST_ASSERT( !m.addPaths( odd ) );
+		GAFFERTEST_ASSERT( m == matcher( it->begin(), it->end() ) );
+
+		GAFFERTEST_ASSERT( m.removePaths( odd ) );
+		GAFFERTEST_ASSERT( m == even );
+	}
+}
@@ -0,0 +1,209 @@
+//////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (c) 2018, Image Engine Design Inc. All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//
+//      * Redistributions of source code must retain the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer.
+//
+//      * Redistributions in binary form must reproduce the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer in the documentation and/or other materials provided with
+//        the distribution.
+//
+//      * Neither the name of John Haddon nor the names of
+//        any other contributors to this software may be used to endorse or
+//        promote products derived from this software without specific prior
+//        written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+//  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+//  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+//  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+//  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+//  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+//  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+//  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//////////////////////////////////////////////////////////////////////////
+
+#include <map>
+#include <set>
+
+#include "tbb/concurrent_vector.h"
+
+#include "GafferTest/Assert.h"
+
+#include "GafferScene/RendererAlgo.h"
+
+#include "GafferSceneTest/RendererAlgoTest.h"
+
+using namespace std;
+using namespace IECore;
+using namespace Gaffer;
+using namespace GafferScene;
+
+namespace
+{
+
+class CapturedObject : public IECoreScenePreview::Renderer::ObjectInterface
+{
+
+	public :
+
+		CapturedObject( const std::string &name, const IECoreScenePreview::Renderer::Prototype *prototype )
+			:	m_name( name ), m_prototype( prototype )
+		{
+		}
+
+		void transform( const Imath::M44f &transform ) override
+		{
+		}
+
+		void transform( const std::vector<Imath::M44f> &samples, const std::vector<float> &times ) override
+		{
+		}
+
+		bool attributes( const IECoreScenePreview::Renderer::AttributesInterface *attributes ) override
+		{
+			return true;
+		}
+
+		const std::string &name() const
+		{
+			return m_name;
+		}
+
+		const IECoreScenePreview::Renderer::Prototype *prototype() const
+		{
+			return m_prototype.get();
+		}
+
+	private :
+
+		const std::string m_name;
+		IECoreScenePreview::Renderer::ConstPrototypePtr m_prototype;
+
+};
+
+IE_CORE_DECLAREPTR( CapturedObject )
+
+class CapturedAttributes : public IECoreScenePreview::Renderer::AttributesInterface
+{
+};
+
+// Records the calls to `instance()`. The `object()` methods should not
+// be called by `RendererAlgo::outputObjects()`, so they assert.
+class CapturingRenderer : public IECoreScenePreview::Renderer
+{
+
+	public :
+
+		typedef tbb::concurrent_vector<CapturedObjectPtr> Objects;
+
+		void option( const IECore::InternedString &name, const IECore::Object *value ) override
+		{
+		}
+
+		void output( const IECore::InternedString &name, const Output *output ) override
+		{
+		}
+
+		AttributesInterfacePtr attributes( const IECore::CompoundObject *attributes ) override
+		{
+			return new CapturedAttributes;
+		}
+
+		ObjectInterfacePtr camera( const std::string &name, const IECore::Camera *camera, const AttributesInterface *attributes ) override
+		{
+			return nullptr;
+		}
+
+		ObjectInterfacePtr light( const std::string &name, const IECore::Object *object, const AttributesInterface *attributes ) override
+		{
+			return nullptr;
+		}
+
+		ObjectInterfacePtr object( const std::string &name, const IECore::Object *object, const AttributesInterface *attributes ) override
+		{
+			GAFFERTEST_ASSERT( false );
+			return nullptr;
+		}
+
+		ObjectInterfacePtr object( const std::string &name, const std::vector<const IECore::Object *> &samples, const std::vector<float> &times, const AttributesInterface *attributes ) override
+		{
+			GAFFERTEST_ASSERT( false );
+			return nullptr;
+		}
+
+		ObjectInterfacePtr instance( const std::string &name, const Prototype *prototype, const AttributesInterface *attributes ) override
+		{
+			CapturedObjectPtr result = new CapturedObject( name, prototype );
+			m_objects.push_back( result );
+			return result;
+		}
+
+		void render() override
+		{
+		}
+
+		void pause() override
+		{
+		}
+
+		const Objects &objects() const
+		{
+			return m_objects;
+		}
+
+	private :
+
+		Objects m_objects;
+
+};
+
+IE_CORE_DECLAREPTR( CapturingRenderer )
+
+} // namespace
+
+void GafferSceneTest::testOutputObjectsSharesPrototypes( const GafferScene::ScenePlug *scene )
+{
+	ConstCompoundObjectPtr globals = scene->globalsPlug()->getValue();
+	RendererAlgo::RenderSets renderSets( scene );
+
+	CapturingRendererPtr renderer = new CapturingRenderer;
+	RendererAlgo::outputObjects( scene, globals.get(), renderSets, renderer.get() );
+
+	// Each location must be instanced exactly once, with a prototype
+	// keyed by the hash of its object.
+
+	typedef std::map<MurmurHash, std::set<const IECoreScenePreview::Renderer::Prototype *> > PrototypesByHash;
+	PrototypesByHash prototypesByHash;
+	std::set<std::string> names;
+	for( CapturingRenderer::Objects::const_iterator it = renderer->objects().begin(), eIt = renderer->objects().end(); it != eIt; ++it )
+	{
+		GAFFERTEST_ASSERT( names.insert( (*it)->name() ).second );
+
+		ScenePlug::ScenePath path;
+		ScenePlug::stringToPath( (*it)->name(), path );
+		GAFFERTEST_ASSERT( (*it)->prototype()->hash() == scene->objectHash( path ) );
+
+		prototypesByHash[(*it)->prototype()->hash()].insert( (*it)->prototype() );
+	}
+
+	// The first location with a particular object is given a prototype
+	// of its own, so that unique objects aren't retained for the whole
+	// output. All subsequent locations must share a single prototype.
+
+	for( PrototypesByHash::const_iterator it = prototypesByHash.begin(), eIt = prototypesByHash.end(); it != eIt; ++it )
+	{
+		GAFFERTEST_ASSERT( it->second.size() <= 2 );
+	}
+}
@@ -0,0 +1,146 @@
+//////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (c) 2018, Image Engine Design Inc. All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//
+//      * Redistributions of source code must retain the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer.
+//
+//      * Redistributions in binary form must reproduce the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer in the documentation and/or other materials provided with
+//        the distribution.
+//
+//      * Neither the name of John Haddon nor the names of
+//        any other contributors to this software may be used to endorse or
+//        promote products derived from this software without specific prior
+//        written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+//  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+//  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+//  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+//  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+//  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+//  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+//  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//////////////////////////////////////////////////////////////////////////
+
+#include <thread>
+
+#include "tbb/task_scheduler_init.h"
+
+#include "Gaffer/Context.h"
+
+#include "GafferTest/Assert.h"
+
+#include "GafferScene/SceneAlgo.h"
+
+#include "GafferSceneTest/SceneAlgoTest.h"
+
+using namespace IECore;
+using namespace Gaffer;
+using namespace GafferScene;
+
+namespace
+{
+
+struct LocationAccumulatorTestFunctor
+{
+
+	bool operator()( const ScenePlug *scene, const ScenePlug::ScenePath &path )
+	{
+		m_accumulator.update( scene, path );
+
+		GAFFERTEST_ASSERT( m_accumulator.fullTransform() == scene->fullTransform( path ) );
+		GAFFERTEST_ASSERT( m_accumulator.fullAttributes()->isEqualTo( scene->fullAttributes( path ).get() ) );
+
+		return true;
+	}
+
+	SceneAlgo::LocationAccumulator m_accumulator;
+
+};
+
+struct LocationAccumulatorFunctor
+{
+
+	bool operator()( const ScenePlug *scene, const ScenePlug::ScenePath &path )
+	{
+		m_accumulator.update( scene, path );
+		return true;
+	}
+
+	SceneAlgo::LocationAccumulator m_accumulator;
+
+};
+
+struct SceneEvaluateFunctor
+{
+
+	bool operator()( const ScenePlug *scene, const ScenePlug::ScenePath &path )
+	{
+		scene->transformPlug()->getValue();
+		scene->boundPlug()->getValue();
+		scene->attributesPlug()->getValue();
+		scene->objectPlug()->getValue();
+		return true;
+	}
+
+};
+
+// Executed on a thread of its own, so that it can initialise its
+// own scheduler with a limited number of threads, hence the need to
+// store the context.
+struct ParallelTraverseWithThreads
+{
+
+	ParallelTraverseWithThreads( const ScenePlug *scene, const Context *context, int maxThreads, size_t grainSize )
+		:	m_scene( scene ), m_context( context ), m_maxThreads( maxThreads ), m_grainSize( grainSize )
+	{
+	}
+
+	void operator()() const
+	{
+		tbb::task_scheduler_init init( m_maxThreads );
+		Context::Scope scope( m_context );
+		SceneEvaluateFunctor f;
+		SceneAlgo::parallelTraverse( m_scene, f, m_grainSize );
+	}
+
+	private :
+
+		const ScenePlug *m_scene;
+		const Context *m_context;
+		int m_maxThreads;
+		size_t m_grainSize;
+
+};
+
+} // namespace
+
+void GafferSceneTest::testLocationAccumulator( const GafferScene::ScenePlug *scene )
+{
+	LocationAccumulatorTestFunctor f;
+	SceneAlgo::parallelProcessLocations( scene, f );
+}
+
+void GafferSceneTest::accumulateFullTransformsAndAttributes( const GafferScene::ScenePlug *scene )
+{
+	LocationAccumulatorFunctor f;
+	SceneAlgo::parallelProcessLocations( scene, f );
+}
+
+void GafferSceneTest::parallelTraverseWithThreads( const GafferScene::ScenePlug *scene, int maxThreads, size_t grainSize )
+{
+	std::thread thread( ParallelTraverseWithThreads( scene, Context::current(), maxThreads, grainSize ) );
+	thread.join();
+}
@@ -34,8 +34,14 @@
 //
 //////////////////////////////////////////////////////////////////////////
 
+#include "boost/lexical_cast.hpp"
+
 #include "IECore/Timer.h"
 
+#include "Gaffer/Context.h"
+
+#include "GafferTest/Assert.h"
+
 #include "GafferScene/ScenePlug.h"
 
 #include "GafferSceneTest/ScenePlugTest.h"
@@ -56,3 +62,103 @@ void GafferSceneTest::testManyStringToPathCalls()
 	// Uncomment to get timing information.
 	//std::cerr << t.stop() << std::endl;
 }
+
+void GafferSceneTest::testLocationPathScope()
+{
+	Gaffer::ContextPtr context = new Gaffer::Context;
+	context->set( "test", 10 );
+
+	ScenePlug::Location location;
+	ScenePlug::ScenePath path;
+	for( int i = 0; i < 10; ++i )
+	{
+		// Contexts made from a Location must be indistinguishable
+		// from those made from the equivalent ScenePath, even though
+		// the Location hash was computed incrementally.
+
+		ScenePlug::PathScope pathScope( context.get(), path );
+		const IECore::MurmurHash h = Gaffer::Context::current()->hash();
+
+		ScenePlug::PathScope locationScope( context.get(), location );
+		GAFFERTEST_ASSERT( Gaffer::Context::current()->hash() == h );
+		GAFFERTEST_ASSERT( Gaffer::Context::current()->get<ScenePlug::ScenePath>( ScenePlug::scenePathContextName ) == path );
+		// No copy should have been made.
+		GAFFERTEST_ASSERT( Gaffer::Context::current()->get<IECore::InternedStringVectorData>( ScenePlug::scenePathContextName ) == location.pathData() );
+
+		const IECore::InternedString name( "child" + boost::lexical_cast<std::string>( i ) );
+		path.push_back( name );
+		location = ScenePlug::Location( location, name );
+		GAFFERTEST_ASSERT( location.path() == path );
+		GAFFERTEST_ASSERT( location.pathHash() == ScenePlug::Location( path ).pathHash() );
+	}
+}
+
+void GafferSceneTest::testLocationSetChild()
+{
+	Gaffer::ContextPtr context = new Gaffer::Context;
+
+	ScenePlug::ScenePath parentPath;
+	ScenePlug::stringToPath( "/a/b", parentPath );
+	const ScenePlug::Location parent( parentPath );
+
+	ScenePlug::Location location( parent, "c" );
+	const IECore::InternedStringVectorData *storage = location.pathData();
+
+	ScenePlug::PathScope pathScope( context.get(), location );
+
+	// Siblings reuse the storage when it isn't shared.
+
+	location.setChild( parent, "d" );
+	GAFFERTEST_ASSERT( location.pathData() == storage );
+	GAFFERTEST_ASSERT( location.pathHash() == ScenePlug::Location( parent, "d" ).pathHash() );
+
+	pathScope.setPath( location );
+	GAFFERTEST_ASSERT( Gaffer::Context::current()->get<ScenePlug::ScenePath>( ScenePlug::scenePathContextName ) == location.path() );
+	const IECore::MurmurHash locationHash = Gaffer::Context::current()->hash();
+	{
+		ScenePlug::PathScope pathScope2( context.get(), location.path() );
+		GAFFERTEST_ASSERT( Gaffer::Context::current()->hash() == locationHash );
+	}
+
+	// But not when it is shared with a copy.
+
+	const ScenePlug::Location copy = location;
+	location.setChild( parent, "e" );
+	GAFFERTEST_ASSERT( location.pathData() != storage );
+	GAFFERTEST_ASSERT( copy.path().back() == "d" );
+	GAFFERTEST_ASSERT( location.path().back() == "e" );
+
+	// Or when the location isn't a child of the parent.
+
+	storage = location.pathData();
+	const ScenePlug::Location otherParent( ScenePlug::ScenePath( 1, parentPath[0] ) );
+	location.setChild( otherParent, "f" );
+	GAFFERTEST_ASSERT( location.pathData() != storage );
+	GAFFERTEST_ASSERT( location.path().size() == 2 );
+}
+
+void GafferSceneTest::testManyPathScopes()
+{
+	Gaffer::ContextPtr context = new Gaffer::Context;
+
+	ScenePlug::ScenePath path;
+	ScenePlug::stringToPath( "/i/am/a/fairly/deep/location/in/the/hierarchy", path );
+	const ScenePlug::Location location( path );
+
+	IECore::Timer t;
+	for( int i = 0; i < 100000; ++i )
+	{
+		ScenePlug::PathScope pathScope( context.get(), path );
+		Gaffer::Context::current()->hash();
+	}
+	// Uncomment to get timing information.
+	//std::cerr << "ScenePath " << t.stop() << std::endl;
+
+	IECore::Timer t2;
+	for( int i = 0; i < 100000; ++i )
+	{
+		ScenePlug::PathScope pathScope( context.get(), location );
+		Gaffer::Context::current()->hash();
+	}
+	//std::cerr << "Location " << t2.stop() << std::endl;
+}
@@ -47,6 +47,8 @@
 #include "GafferSceneTest/TestLight.h"
 #include "GafferSceneTest/ScenePlugTest.h"
 #include "GafferSceneTest/PathMatcherTest.h"
+#include "GafferSceneTest/SceneAlgoTest.h"
+#include "GafferSceneTest/RendererAlgoTest.h"
 
 using namespace boost::python;
 using namespace GafferSceneTest;
@@ -57,6 +59,30 @@ static void traverseSceneWrapper( const GafferScene::ScenePlug *scenePlug )
 	traverseScene( scenePlug );
 }
 
+static void testLocationAccumulatorWrapper( const GafferScene::ScenePlug *scenePlug )
+{
+	IECorePython::ScopedGILRelease gilRelease;
+	testLocationAccumulator( scenePlug );
+}
+
+static void accumulateFullTransformsAndAttributesWrapper( const GafferScene::ScenePlug *scenePlug )
+{
+	IECorePython::ScopedGILRelease gilRelease;
+	accumulateFullTransformsAndAttributes( scenePlug );
+}
+
+static void parallelTraverseWithThreadsWrapper( const GafferScene::ScenePlug *scenePlug, int maxThreads, size_t grainSize )
+{
+	IECorePython::ScopedGILRelease gilRelease;
+	parallelTraverseWithThreads( scenePlug, maxThreads, grainSize );
+}
+
+static void testOutputObjectsSharesPrototypesWrapper( const GafferScene::ScenePlug *scenePlug )
+{
+	IECorePython::ScopedGILRelease gilRelease;
+	testOutputObjectsSharesPrototypes( scenePlug );
+}
+
 BOOST_PYTHON_MODULE( _GafferSceneTest )
 {
 
@@ -70,9 +96,22 @@ BOOST_PYTHON_MODULE( _GafferSceneTest )
 	def( "connectTraverseSceneToPreDispatchSignal", &connectTraverseSceneToPreDispatchSignal );
 
 	def( "testManyStringToPathCalls", &testManyStringToPathCalls );
+	def( "testLocationPathScope", &testLocationPathScope );
+	def( "testLocationSetChild", &testLocationSetChild );
+	def( "testManyPathScopes", &testManyPathScopes );
+
+	def( "testLocationAccumulator", &testLocationAccumulatorWrapper );
+	def( "accumulateFullTransformsAndAttributes", &accumulateFullTransformsAndAttributesWrapper );
+	def( "parallelTraverseWithThreads", &parallelTraverseWithThreadsWrapper, ( arg( "scene" ), arg( "maxThreads" ), arg( "grainSize" ) = 0 ) );
+
+	def( "testOutputObjectsSharesPrototypes", &testOutputObjectsSharesPrototypesWrapper );
 
 	def( "testPathMatcherRawIterator", &testPathMatcherRawIterator );
 	def( "testPathMatcherIteratorPrune", &testPathMatcherIteratorPrune );
 	def( "testPathMatcherFind", &testPathMatcherFind );
+	def( "testPathMatcherAddPerformance", &testPathMatcherAddPerformance );
+	def( "testPathMatcherMatchPerformance", &testPathMatcherMatchPerformance );
+	def( "testPathMatcherIteratorPerformance", &testPathMatcherIteratorPerformance );
+	def( "testPathMatcherAddPathsPerformance", &testPathMatcherAddPathsPerformance );
 
 }
@@ -51,6 +51,8 @@
 
 #include "GafferUI/ViewportGadget.h"
 
+#include "GafferScene/Filter.h"
+
 #include "GafferSceneUI/SceneGadget.h"
 #include "GafferSceneUI/ObjectVisualiser.h"
 #include "GafferSceneUI/AttributeVisualiser.h"
@@ -269,6 +269,8 @@ if "APPLESEED" in os.environ :
 
 nodeMenu.append( "/Scene/File/Reader", GafferScene.SceneReader, searchText = "SceneReader" )
 nodeMenu.append( "/Scene/File/Writer", GafferScene.SceneWriter, searchText = "SceneWriter" )
+nodeMenu.append( "/Scene/File/Mapped Reader", GafferScene.MappedSceneReader, searchText = "MappedSceneReader" )
+nodeMenu.append( "/Scene/File/Mapped Writer", GafferScene.MappedSceneWriter, searchText = "MappedSceneWriter" )
 nodeMenu.append( "/Scene/Source/Object To Scene", GafferScene.ObjectToScene, searchText = "ObjectToScene" )
 nodeMenu.append( "/Scene/Source/Camera", GafferScene.Camera )
 nodeMenu.append( "/Scene/Source/Coordinate System", GafferScene.CoordinateSystem, searchText = "CoordinateSystem" )